@@ -5207,6 +5207,21 @@ typedef void (*GCCallback)(GCType type, GCCallbackFlags flags);
 
 typedef void (*InterruptCallback)(Isolate* isolate, void* data);
 
+/**
+ * This callback is invoked when a full garbage collection could not bring the
+ * heap sufficiently below the heap limit and V8 is about to abort with an
+ * out-of-memory error. The callback can raise the heap limit by returning a
+ * value greater than current_heap_limit. The initial heap limit is the limit
+ * configured when the isolate was created.
+ *
+ * To terminate the isolate instead of the process, the callback can call
+ * Isolate::TerminateExecution and return a moderately raised limit so that
+ * the pending allocation succeeds and the termination exception can unwind
+ * the running script.
+ */
+typedef size_t (*NearHeapLimitCallback)(void* data, size_t current_heap_limit,
+                                        size_t initial_heap_limit);
+
 
 /**
  * Collection of V8 heap information.
@@ -5291,6 +5306,34 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * Garbage collection work performed by Isolate::IdleTimeGarbageCollection.
+ */
+class V8_EXPORT IdleTimeGCResult {
+ public:
+  IdleTimeGCResult();
+  /** Idle time spent on garbage collection. */
+  int64_t used_time_in_microseconds() { return used_time_in_microseconds_; }
+  int scavenges() { return scavenges_; }
+  int incremental_marking_steps() { return incremental_marking_steps_; }
+  /** Full garbage collections, including finalized incremental marking. */
+  int mark_compacts() { return mark_compacts_; }
+  /**
+   * True if there is no garbage collection work left that could make use of
+   * more idle time until real work has been done.
+   */
+  bool done() { return done_; }
+
+ private:
+  int64_t used_time_in_microseconds_;
+  int scavenges_;
+  int incremental_marking_steps_;
+  int mark_compacts_;
+  bool done_;
+
+  friend class Isolate;
+};
+
 class RetainedObjectInfo;
 
 
@@ -6216,6 +6259,21 @@ class V8_EXPORT Isolate {
   V8_DEPRECATED("use IdleNotificationDeadline()",
                 bool IdleNotification(int idle_time_in_ms));
 
+  /**
+   * Optional notification for embedders that know exactly when they are
+   * idle, e.g. a server event loop that finished a batch of requests.
+   * V8 uses up to idle_time_in_microseconds starting now to perform a
+   * scavenge, incremental marking steps, finalization of incremental marking
+   * or a compacting full garbage collection. Each piece of work is sized by
+   * the collection speeds V8 measured so far such that no single pause
+   * exceeds latency_budget_in_microseconds. As with IdleNotificationDeadline,
+   * the limits are estimates and not guaranteed. The work done and the idle
+   * time used are reported in |result|.
+   */
+  void IdleTimeGarbageCollection(int64_t idle_time_in_microseconds,
+                                 int64_t latency_budget_in_microseconds,
+                                 IdleTimeGCResult* result);
+
   /**
    * Optional notification that the system is running low on memory.
    * V8 uses these notifications to attempt to free memory.
@@ -6308,6 +6366,20 @@ class V8_EXPORT Isolate {
   /** Set the callback to invoke in case of fatal errors. */
   void SetFatalErrorHandler(FatalErrorCallback that);
 
+  /**
+   * Adds a callback to invoke when the heap is close to the heap limit. Only
+   * the most recently added callback is invoked. See NearHeapLimitCallback.
+   */
+  void AddNearHeapLimitCallback(NearHeapLimitCallback callback, void* data);
+
+  /**
+   * Removes the given callback and restores the heap limit to heap_limit if
+   * it is not 0. The limit is not lowered below the current heap size plus
+   * some headroom. Does nothing if the callback was not added.
+   */
+  void RemoveNearHeapLimitCallback(NearHeapLimitCallback callback,
+                                   size_t heap_limit);
+
   /**
    * Set the callback to invoke to check if code generation from
    * strings should be allowed.
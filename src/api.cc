@@ -38,6 +38,7 @@
 #include "src/execution.h"
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
+#include "src/heap/gc-idle-time-handler.h"
 #include "src/icu_util.h"
 #include "src/isolate-inl.h"
 #include "src/json-parser.h"
@@ -5596,6 +5597,13 @@ HeapObjectStatistics::HeapObjectStatistics()
 HeapCodeStatistics::HeapCodeStatistics()
     : code_and_metadata_size_(0), bytecode_and_metadata_size_(0) {}
 
+IdleTimeGCResult::IdleTimeGCResult()
+    : used_time_in_microseconds_(0),
+      scavenges_(0),
+      incremental_marking_steps_(0),
+      mark_compacts_(0),
+      done_(false) {}
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -7731,6 +7739,29 @@ bool Isolate::IdleNotificationDeadline(double deadline_in_seconds) {
 }
 
 
+void Isolate::IdleTimeGarbageCollection(int64_t idle_time_in_microseconds,
+                                        int64_t latency_budget_in_microseconds,
+                                        IdleTimeGCResult* result) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  if (!i::FLAG_use_idle_notification) {
+    result->done_ = true;
+    return;
+  }
+  const double kMicrosecondsPerMillisecond =
+      static_cast<double>(base::Time::kMicrosecondsPerMillisecond);
+  i::GCIdleTimeReport report;
+  isolate->heap()->IdleTimeGarbageCollection(
+      idle_time_in_microseconds / kMicrosecondsPerMillisecond,
+      latency_budget_in_microseconds / kMicrosecondsPerMillisecond, &report);
+  result->used_time_in_microseconds_ = static_cast<int64_t>(
+      report.used_time_in_ms * kMicrosecondsPerMillisecond);
+  result->scavenges_ = report.scavenges;
+  result->incremental_marking_steps_ = report.incremental_marking_steps;
+  result->mark_compacts_ = report.mark_compacts;
+  result->done_ = report.done;
+}
+
+
 void Isolate::LowMemoryNotification() {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   {
@@ -7805,6 +7836,20 @@ void Isolate::SetFatalErrorHandler(FatalErrorCallback that) {
 }
 
 
+void Isolate::AddNearHeapLimitCallback(NearHeapLimitCallback callback,
+                                       void* data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->AddNearHeapLimitCallback(callback, data);
+}
+
+
+void Isolate::RemoveNearHeapLimitCallback(NearHeapLimitCallback callback,
+                                          size_t heap_limit) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
+  isolate->heap()->RemoveNearHeapLimitCallback(callback, heap_limit);
+}
+
+
 void Isolate::SetAllowCodeGenerationFromStringsCallback(
     AllowCodeGenerationFromStringsCallback callback) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
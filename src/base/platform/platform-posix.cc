@@ -134,6 +134,24 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+bool OS::DiscardSystemPages(void* address, const size_t size) {
+#if V8_OS_CYGWIN || V8_OS_NACL
+  return false;
+#else
+#if defined(MADV_FREE)
+  // MADV_FREE lets the kernel reclaim the pages lazily. Older kernels reject
+  // it with EINVAL, in which case we fall back to MADV_DONTNEED.
+  if (madvise(address, size, MADV_FREE) == 0) return true;
+#endif
+#if defined(MADV_DONTNEED)
+  return madvise(address, size, MADV_DONTNEED) == 0;
+#else
+  return false;
+#endif
+#endif
+}
+
+
 static LazyInstance<RandomNumberGenerator>::type
     platform_random_number_generator = LAZY_INSTANCE_INITIALIZER;
 
@@ -823,6 +823,13 @@ void OS::Guard(void* address, const size_t size) {
 }
 
 
+bool OS::DiscardSystemPages(void* address, const size_t size) {
+  // MEM_RESET keeps the range committed but allows the system to drop its
+  // contents instead of writing them to the paging file.
+  return VirtualAlloc(address, size, MEM_RESET, PAGE_READWRITE) != nullptr;
+}
+
+
 void OS::Sleep(TimeDelta interval) {
   ::Sleep(static_cast<DWORD>(interval.InMilliseconds()));
 }
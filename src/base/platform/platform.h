@@ -187,6 +187,12 @@ class OS {
   // Assign memory as a guard page so that access will cause an exception.
   static void Guard(void* address, const size_t size);
 
+  // Tells the OS that the contents of committed memory are no longer needed.
+  // The memory stays committed and accessible, but its physical pages may be
+  // reclaimed. Their contents are undefined afterwards. Returns false if the
+  // platform does not support discarding.
+  static bool DiscardSystemPages(void* address, const size_t size);
+
   // Generate a random address to be used for hinting mmap().
   static void* GetRandomMmapAddr();
 
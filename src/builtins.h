@@ -241,6 +241,7 @@ class CodeStubAssembler;
   V(InterpreterPushArgsAndTailCall, BUILTIN, kNoExtraICState)                \
   V(InterpreterPushArgsAndConstruct, BUILTIN, kNoExtraICState)               \
   V(InterpreterEnterBytecodeDispatch, BUILTIN, kNoExtraICState)              \
+  V(InterpreterOnStackReplacement, BUILTIN, kNoExtraICState)                 \
                                                                              \
   V(KeyedLoadIC_Miss, BUILTIN, kNoExtraICState)                              \
   V(StoreIC_Miss, BUILTIN, kNoExtraICState)                                  \
@@ -718,6 +719,7 @@ class Builtins {
   static void Generate_InterpreterEntryTrampoline(MacroAssembler* masm);
   static void Generate_InterpreterEnterBytecodeDispatch(MacroAssembler* masm);
   static void Generate_InterpreterMarkBaselineOnReturn(MacroAssembler* masm);
+  static void Generate_InterpreterOnStackReplacement(MacroAssembler* masm);
   static void Generate_InterpreterPushArgsAndCall(MacroAssembler* masm) {
     return Generate_InterpreterPushArgsAndCallImpl(masm,
                                                    TailCallMode::kDisallow);
@@ -1457,6 +1457,14 @@ class LoadFieldStub: public HandlerStub {
  private:
   class LoadFieldByIndexBits : public BitField<int, 0, 13> {};
 
+ public:
+  // Location of the field access stub key within Code::stub_key(), for
+  // generated code that inlines the handler. The sub minor key starts at
+  // the lowest bit of the minor key.
+  class CodeKeyFieldIndexBits
+      : public BitField<int, kStubMajorKeyBits + LoadFieldByIndexBits::kShift,
+                        LoadFieldByIndexBits::kSize> {};
+
   DEFINE_HANDLER_CODE_STUB(LoadField, HandlerStub);
 };
 
@@ -1567,6 +1575,16 @@ class StoreFieldStub : public HandlerStub {
   class StoreFieldByIndexBits : public BitField<int, 0, 13> {};
   class RepresentationBits : public BitField<uint8_t, 13, 4> {};
 
+ public:
+  // Location of the field access stub key and the encoded representation
+  // within Code::stub_key(), see LoadFieldStub::CodeKeyFieldIndexBits.
+  class CodeKeyFieldIndexBits
+      : public BitField<int, kStubMajorKeyBits + StoreFieldByIndexBits::kShift,
+                        StoreFieldByIndexBits::kSize> {};
+  class CodeKeyRepresentationBits
+      : public BitField<int, kStubMajorKeyBits + RepresentationBits::kShift,
+                        RepresentationBits::kSize> {};
+
   DEFINE_HANDLER_CODE_STUB(StoreField, HandlerStub);
 };
 
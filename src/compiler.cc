@@ -683,7 +683,8 @@ bool GetOptimizedCodeLater(CompilationJob* job) {
   CompilationInfo* info = job->info();
   Isolate* isolate = info->isolate();
 
-  if (!isolate->optimizing_compile_dispatcher()->IsQueueAvailable()) {
+  int priority = OptimizingCompileDispatcher::PriorityFor(*info->closure());
+  if (!isolate->optimizing_compile_dispatcher()->IsQueueAvailable(priority)) {
     if (FLAG_trace_concurrent_recompilation) {
       PrintF("  ** Compilation queue full, will retry optimizing ");
       info->closure()->ShortPrint();
@@ -714,7 +715,8 @@ bool GetOptimizedCodeLater(CompilationJob* job) {
   TRACE_EVENT0("v8", "V8.RecompileSynchronous");
 
   if (job->CreateGraph() != CompilationJob::SUCCEEDED) return false;
-  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job);
+  isolate->optimizing_compile_dispatcher()->QueueForOptimization(job,
+                                                                 priority);
 
   if (FLAG_trace_concurrent_recompilation) {
     PrintF("  ** Queued ");
@@ -753,7 +755,10 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   VMState<COMPILER> state(isolate);
   DCHECK(!isolate->has_pending_exception());
   PostponeInterruptsScope postpone(isolate);
-  bool use_turbofan = UseTurboFan(shared);
+  // On-stack replacement from an interpreted frame is only supported by
+  // TurboFan building its graph from the bytecode.
+  bool ignition_osr = osr_frame && osr_frame->is_interpreted();
+  bool use_turbofan = UseTurboFan(shared) || ignition_osr;
   base::SmartPointer<CompilationJob> job(
       use_turbofan ? compiler::Pipeline::NewCompilationJob(function)
                    : new HCompilationJob(function));
@@ -782,7 +787,7 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   TRACE_EVENT0("v8", "V8.OptimizeCode");
 
   // TurboFan can optimize directly from existing bytecode.
-  if (FLAG_turbo_from_bytecode && use_turbofan &&
+  if ((FLAG_turbo_from_bytecode || ignition_osr) && use_turbofan &&
       info->shared_info()->HasBytecodeArray()) {
     info->MarkAsOptimizeFromBytecode();
   }
@@ -1385,6 +1390,53 @@ bool Compiler::EnsureDeoptimizationSupport(CompilationInfo* info) {
   return true;
 }
 
+namespace {
+
+bool NeedsSourcePositions(Handle<SharedFunctionInfo> shared) {
+  return shared->HasBytecodeArray() &&
+         !shared->bytecode_array()->HasSourcePositionTable();
+}
+
+bool CollectSourcePositions(ParseInfo* parse_info) {
+  Isolate* isolate = parse_info->isolate();
+  // The source positions are usually requested for a stack trace. Collecting
+  // them must neither clobber an exception that is being thrown nor run into
+  // another stack overflow while reporting one.
+  if (isolate->has_pending_exception()) return false;
+  StackLimitCheck check(isolate);
+  if (check.HasOverflowed()) return false;
+
+  RuntimeCallTimerScope runtimeTimer(isolate,
+                                     &RuntimeCallStats::CompileIgnition);
+  PostponeInterruptsScope postpone(isolate);
+  CompilationInfo info(parse_info, Handle<JSFunction>::null());
+  if (!Compiler::ParseAndAnalyze(parse_info) ||
+      !interpreter::Interpreter::CollectSourcePositions(&info)) {
+    isolate->clear_pending_exception();
+    return false;
+  }
+  DCHECK(!isolate->has_pending_exception());
+  return true;
+}
+
+}  // namespace
+
+bool Compiler::EnsureSourcePositions(Handle<JSFunction> function) {
+  Handle<SharedFunctionInfo> shared(function->shared());
+  if (!NeedsSourcePositions(shared)) return true;
+  Zone zone(function->GetIsolate()->allocator());
+  ParseInfo parse_info(&zone, function);
+  return CollectSourcePositions(&parse_info);
+}
+
+bool Compiler::EnsureSourcePositions(Handle<SharedFunctionInfo> shared) {
+  if (!NeedsSourcePositions(shared)) return true;
+  if (!shared->allows_lazy_compilation_without_context()) return false;
+  Zone zone(shared->GetIsolate()->allocator());
+  ParseInfo parse_info(&zone, shared);
+  return CollectSourcePositions(&parse_info);
+}
+
 MaybeHandle<JSFunction> Compiler::GetFunctionFromEval(
     Handle<String> source, Handle<SharedFunctionInfo> outer_info,
     Handle<Context> context, LanguageMode language_mode,
@@ -1565,7 +1617,10 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfoForScript(
         RuntimeCallTimerScope runtimeTimer(isolate,
                                            &RuntimeCallStats::CompileSerialize);
         TRACE_EVENT0("v8", "V8.CompileSerialize");
-        *cached_data = CodeSerializer::Serialize(isolate, result, source);
+        // A script that is already in the compilation cache has been run
+        // before, which lets the serializer record what has been optimized.
+        *cached_data =
+            CodeSerializer::Serialize(isolate, result, source, maybe_result);
         if (FLAG_profile_deserialization) {
           PrintF("[Compiling and serializing took %0.3f ms]\n",
                  timer.Elapsed().InMillisecondsF());
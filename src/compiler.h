@@ -65,6 +65,14 @@ class Compiler : public AllStatic {
   // Adds deoptimization support, requires ParseAndAnalyze.
   static bool EnsureDeoptimizationSupport(CompilationInfo* info);
 
+  // Collects the source positions of the bytecode of the given function if
+  // they were omitted by --lazy-source-positions. Returns {false} if they
+  // could not be collected, in which case the positions remain unknown. The
+  // variant without closure requires a function that can be compiled lazily
+  // without context.
+  static bool EnsureSourcePositions(Handle<JSFunction> function);
+  static bool EnsureSourcePositions(Handle<SharedFunctionInfo> shared);
+
   // ===========================================================================
   // The following family of methods instantiates new functions for scripts or
   // function literals. The decision whether those functions will be compiled,
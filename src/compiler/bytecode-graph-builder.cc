@@ -7,6 +7,7 @@
 #include "src/compiler/bytecode-branch-analysis.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/operator-properties.h"
+#include "src/frames.h"
 #include "src/interpreter/bytecodes.h"
 
 namespace v8 {
@@ -60,6 +61,7 @@ class BytecodeGraphBuilder::Environment : public ZoneObject {
   Environment* CopyForConditional() const;
   Environment* CopyForLoop();
   void Merge(Environment* other);
+  void PrepareForOsrEntry();
 
  private:
   explicit Environment(const Environment* copy);
@@ -337,6 +339,47 @@ void BytecodeGraphBuilder::Environment::Merge(
 }
 
 
+void BytecodeGraphBuilder::Environment::PrepareForOsrEntry() {
+  DCHECK_EQ(IrOpcode::kLoop, GetControlDependency()->opcode());
+  DCHECK_EQ(1, GetControlDependency()->InputCount());
+  Node* start = graph()->start();
+
+  // Create a control node for the OSR entry point and merge it into the loop
+  // header. Update the current environment's control dependency accordingly.
+  Node* entry = graph()->NewNode(common()->OsrLoopEntry(), start, start);
+  Node* control = builder()->MergeControl(GetControlDependency(), entry);
+  UpdateControlDependency(control);
+
+  // Create a merge of the effect from the OSR entry and the existing effect
+  // dependency. Update the current environment's effect dependency accordingly.
+  Node* effect = builder()->MergeEffect(GetEffectDependency(), entry, control);
+  UpdateEffectDependency(effect);
+
+  // Rename all values in the environment which will extend or introduce Phi
+  // nodes to contain the OSR values available at the entry point. The indices
+  // follow {Linkage::GetOsrValueLocation}, registers are preceded by the fixed
+  // part of the interpreter frame. The accumulator is not part of the frame,
+  // but it is never live across a loop header.
+  Node* osr_context = graph()->NewNode(
+      common()->OsrValue(Linkage::kOsrContextSpillSlotIndex), entry);
+  context_ = builder()->MergeValue(context_, osr_context, control);
+  int size = static_cast<int>(values()->size());
+  for (int i = 0; i < size; i++) {
+    Node* osr_value;
+    if (i >= accumulator_base()) {
+      osr_value = builder()->jsgraph()->UndefinedConstant();
+    } else {
+      int index = i;
+      if (i >= register_base()) {
+        index += InterpreterFrameConstants::kExtraSlotCount;
+      }
+      osr_value = graph()->NewNode(common()->OsrValue(index), entry);
+    }
+    values_[i] = builder()->MergeValue(values_[i], osr_value, control);
+  }
+}
+
+
 void BytecodeGraphBuilder::Environment::PrepareForLoop() {
   // Create a control node for the loop header.
   Node* control = builder()->NewLoop();
@@ -452,6 +495,8 @@ BytecodeGraphBuilder::BytecodeGraphBuilder(Zone* local_zone,
       current_exception_handler_(0),
       input_buffer_size_(0),
       input_buffer_(nullptr),
+      osr_ast_id_(info->osr_ast_id()),
+      osr_loop_offset_(-1),
       exit_controls_(local_zone) {}
 
 Node* BytecodeGraphBuilder::GetNewTarget() {
@@ -521,6 +566,12 @@ bool BytecodeGraphBuilder::CreateGraph() {
                   GetFunctionContext());
   set_environment(&env);
 
+  if (!osr_ast_id_.IsNone()) {
+    // Use OSR normal entry as the start of the top-level environment.
+    // It will be replaced with {Dead} after typing and optimizations.
+    NewNode(common()->OsrNormalEntry());
+  }
+
   VisitBytecodes();
 
   // Finish the basic structure of the graph.
@@ -537,6 +588,18 @@ void BytecodeGraphBuilder::VisitBytecodes() {
   BytecodeBranchAnalysis analysis(bytecode_array(), local_zone());
   analysis.Analyze();
   set_branch_analysis(&analysis);
+  if (!osr_ast_id_.IsNone()) {
+    // The OSR entry is at the header of the loop that is closed by the
+    // backward jump at the bytecode offset recorded as OSR AST id.
+    interpreter::BytecodeArrayIterator osr_iterator(bytecode_array());
+    while (osr_iterator.current_offset() != osr_ast_id_.ToInt()) {
+      DCHECK(!osr_iterator.done());
+      osr_iterator.Advance();
+    }
+    DCHECK(interpreter::Bytecodes::IsJump(osr_iterator.current_bytecode()));
+    osr_loop_offset_ = osr_iterator.GetJumpTargetOffset();
+    DCHECK(analysis.backward_branches_target(osr_loop_offset_));
+  }
   interpreter::BytecodeArrayIterator iterator(bytecode_array());
   set_bytecode_iterator(&iterator);
   while (!iterator.done()) {
@@ -1241,6 +1304,31 @@ void BytecodeGraphBuilder::VisitTestLessThan() {
   BuildCompareOp(javascript()->LessThan(hints));
 }
 
+void BytecodeGraphBuilder::BuildLdarAndBinaryOp(const Operator* js_op) {
+  FrameStateBeforeAndAfter states(this);
+  Node* left =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(1));
+  Node* right =
+      environment()->LookupRegister(bytecode_iterator().GetRegisterOperand(0));
+  Node* node = NewNode(js_op, left, right);
+  environment()->BindAccumulator(node, &states);
+}
+
+void BytecodeGraphBuilder::VisitLdarAdd() {
+  BinaryOperationHints hints = BinaryOperationHints::Any();
+  BuildLdarAndBinaryOp(javascript()->Add(hints));
+}
+
+void BytecodeGraphBuilder::VisitLdarSub() {
+  BinaryOperationHints hints = BinaryOperationHints::Any();
+  BuildLdarAndBinaryOp(javascript()->Subtract(hints));
+}
+
+void BytecodeGraphBuilder::VisitLdarTestLessThan() {
+  CompareOperationHints hints = CompareOperationHints::Any();
+  BuildLdarAndBinaryOp(javascript()->LessThan(hints));
+}
+
 void BytecodeGraphBuilder::VisitTestGreaterThan() {
   CompareOperationHints hints = CompareOperationHints::Any();
   BuildCompareOp(javascript()->GreaterThan(hints));
@@ -1489,6 +1577,10 @@ void BytecodeGraphBuilder::BuildLoopHeaderEnvironment(int current_offset) {
     // Add loop header and store a copy so we can connect merged back
     // edge inputs to the loop header.
     merge_environments_[current_offset] = environment()->CopyForLoop();
+    if (current_offset == osr_loop_offset_) {
+      // The OSR entry joins the loop at its header.
+      environment()->PrepareForOsrEntry();
+    }
   }
 }
 
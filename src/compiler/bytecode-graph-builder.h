@@ -125,6 +125,7 @@ class BytecodeGraphBuilder {
   void BuildThrow();
   void BuildBinaryOp(const Operator* op);
   void BuildCompareOp(const Operator* op);
+  void BuildLdarAndBinaryOp(const Operator* op);
   void BuildDelete(LanguageMode language_mode);
   void BuildCastOperator(const Operator* op);
   void BuildForInPrepare();
@@ -237,6 +238,11 @@ class BytecodeGraphBuilder {
   SetOncePointer<Node> function_closure_;
   SetOncePointer<Node> new_target_;
 
+  // The bytecode offset of the backward jump at which on-stack replacement
+  // enters, and the offset of the header of the loop it closes.
+  BailoutId osr_ast_id_;
+  int osr_loop_offset_;
+
   // Control nodes that exit the function body.
   ZoneVector<Node*> exit_controls_;
 
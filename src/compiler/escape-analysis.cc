@@ -397,7 +397,7 @@ bool VirtualState::UpdateFrom(VirtualState* from, Zone* zone) {
 
     changed = ls->UpdateFrom(*rs) || changed;
   }
-  return false;
+  return changed;
 }
 
 namespace {
@@ -671,6 +671,17 @@ void EscapeStatusAnalysis::Process(Node* node) {
           RevisitInputs(rep);
           RevisitUses(rep);
         }
+      } else {
+        // The object analysis could not determine the loaded value, so the
+        // object has to stay around for the load to read it.
+        Node* from = object_analysis_->ResolveReplacement(
+            NodeProperties::GetValueInput(node, 0));
+        if (IsAllocation(from) && SetEscaped(from)) {
+          TRACE("Setting #%d (%s) to escaped because of unresolved load #%d\n",
+                from->id(), from->op()->mnemonic(), node->id());
+          RevisitInputs(from);
+          RevisitUses(from);
+        }
       }
       RevisitUses(node);
       break;
@@ -798,6 +809,7 @@ bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
       // handled by the EscapeAnalysisReducer (similar to ObjectIsSmi).
       case IrOpcode::kObjectIsCallable:
       case IrOpcode::kObjectIsNumber:
+      case IrOpcode::kObjectIsReceiver:
       case IrOpcode::kObjectIsString:
       case IrOpcode::kObjectIsUndetectable:
         if (SetEscaped(rep)) {
@@ -1067,6 +1079,7 @@ bool EscapeAnalysis::Process(Node* node) {
     default:
       if (node->op()->EffectInputCount() > 0) {
         ForwardVirtualState(node);
+        ProcessFrameStateUses(node);
       }
       ProcessAllocationUsers(node);
       break;
@@ -1108,6 +1121,70 @@ void EscapeAnalysis::ProcessAllocationUsers(Node* node) {
   }
 }
 
+void EscapeAnalysis::ProcessFrameStateUses(Node* node) {
+  VirtualState* state = virtual_states_[node->id()];
+  ZoneVector<VirtualObject*> visited(zone());
+  for (Node* input : node->inputs()) {
+    if (input->opcode() == IrOpcode::kFrameState) {
+      ProcessDeoptState(input, state, &visited);
+    }
+  }
+}
+
+void EscapeAnalysis::ProcessDeoptState(Node* node, VirtualState* state,
+                                       ZoneVector<VirtualObject*>* visited) {
+  DCHECK(node->opcode() == IrOpcode::kFrameState ||
+         node->opcode() == IrOpcode::kStateValues);
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    Node* input = NodeProperties::GetValueInput(node, i);
+    if (input->opcode() == IrOpcode::kStateValues) {
+      ProcessDeoptState(input, state, visited);
+    } else {
+      ProcessDeoptInput(ResolveReplacement(input), state, visited);
+    }
+  }
+  if (node->opcode() == IrOpcode::kFrameState) {
+    Node* outer_frame_state = NodeProperties::GetFrameStateInput(node, 0);
+    if (outer_frame_state->opcode() == IrOpcode::kFrameState) {
+      ProcessDeoptState(outer_frame_state, state, visited);
+    }
+  }
+}
+
+void EscapeAnalysis::ProcessDeoptInput(Node* node, VirtualState* state,
+                                       ZoneVector<VirtualObject*>* visited) {
+  if (!status_analysis_->IsAllocation(node) || IsEscaped(node)) return;
+  VirtualObject* object = GetVirtualObject(state, node);
+  if (object && std::find(visited->begin(), visited->end(), object) !=
+                    visited->end()) {
+    return;
+  }
+  // The deoptimizer needs the values of all fields to materialize a virtual
+  // object, so objects with unknown fields are allocated instead.
+  bool complete = object && object->IsTracked() && object->IsInitialized();
+  for (size_t i = 0; complete && i < object->field_count(); ++i) {
+    complete = object->GetField(i) != nullptr;
+  }
+  if (!complete) {
+    SetEscapedForDeopt(node);
+    return;
+  }
+  visited->push_back(object);
+  for (size_t i = 0; i < object->field_count(); ++i) {
+    ProcessDeoptInput(ResolveReplacement(object->GetField(i)), state, visited);
+  }
+}
+
+void EscapeAnalysis::SetEscapedForDeopt(Node* node) {
+  if (status_analysis_->SetEscaped(node)) {
+    TRACE("Setting #%d (%s) to escaped because it is incomplete at a deopt\n",
+          node->id(), node->op()->mnemonic());
+  }
+  if (node->opcode() == IrOpcode::kFinishRegion) {
+    SetEscapedForDeopt(NodeProperties::GetValueInput(node, 0));
+  }
+}
+
 VirtualState* EscapeAnalysis::CopyForModificationAt(VirtualState* state,
                                                     Node* node) {
   if (state->owner() != node) {
@@ -1344,6 +1421,17 @@ int OffsetForElementAccess(Node* node, int index) {
   return access.header_size / kPointerSize + index;
 }
 
+// Returns the index input of the element access {node}. Bounds checks are
+// looked through, since they pass the index on unchanged if they succeed;
+// this exposes the constant indices into inlined arguments objects.
+Node* IndexForElementAccess(Node* node) {
+  Node* index = NodeProperties::GetValueInput(node, 1);
+  while (index->opcode() == IrOpcode::kCheckBounds) {
+    index = NodeProperties::GetValueInput(index, 0);
+  }
+  return index;
+}
+
 }  // namespace
 
 void EscapeAnalysis::ProcessLoadFromPhi(int offset, Node* from, Node* load,
@@ -1412,7 +1500,7 @@ void EscapeAnalysis::ProcessLoadElement(Node* node) {
   ForwardVirtualState(node);
   Node* from = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
   VirtualState* state = virtual_states_[node->id()];
-  Node* index_node = node->InputAt(1);
+  Node* index_node = IndexForElementAccess(node);
   NumberMatcher index(index_node);
   DCHECK(index_node->opcode() != IrOpcode::kInt32Constant &&
          index_node->opcode() != IrOpcode::kInt64Constant &&
@@ -1477,7 +1565,7 @@ void EscapeAnalysis::ProcessStoreElement(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kStoreElement);
   ForwardVirtualState(node);
   Node* to = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
-  Node* index_node = node->InputAt(1);
+  Node* index_node = IndexForElementAccess(node);
   NumberMatcher index(index_node);
   DCHECK(index_node->opcode() != IrOpcode::kInt32Constant &&
          index_node->opcode() != IrOpcode::kInt64Constant &&
@@ -1525,10 +1613,14 @@ Node* EscapeAnalysis::GetOrCreateObjectState(Node* effect, Node* node) {
       if (Node* object_state = vobj->GetObjectState()) {
         return object_state;
       } else {
+        // The deoptimizer materializes objects from all of their fields in
+        // order, so there is no object state for incomplete objects.
         cache_->fields().clear();
         for (size_t i = 0; i < vobj->field_count(); ++i) {
           if (Node* field = vobj->GetField(i)) {
-            cache_->fields().push_back(field);
+            cache_->fields().push_back(ResolveReplacement(field));
+          } else {
+            return nullptr;
           }
         }
         int input_count = static_cast<int>(cache_->fields().size());
@@ -1542,13 +1634,12 @@ Node* EscapeAnalysis::GetOrCreateObjectState(Node* effect, Node* node) {
             new_object_state->id(), static_cast<void*>(vobj), node->id(),
             effect->id());
         // Now fix uses of other objects.
-        for (size_t i = 0; i < vobj->field_count(); ++i) {
-          if (Node* field = vobj->GetField(i)) {
-            if (Node* field_object_state =
-                    GetOrCreateObjectState(effect, field)) {
-              NodeProperties::ReplaceValueInput(
-                  new_object_state, field_object_state, static_cast<int>(i));
-            }
+        for (int i = 0; i < input_count; ++i) {
+          Node* field = NodeProperties::GetValueInput(new_object_state, i);
+          if (Node* field_object_state =
+                  GetOrCreateObjectState(effect, field)) {
+            NodeProperties::ReplaceValueInput(new_object_state,
+                                              field_object_state, i);
           }
         }
         return new_object_state;
@@ -32,6 +32,7 @@ class EscapeAnalysis {
   bool IsEscaped(Node* node);
   bool CompareVirtualObjects(Node* left, Node* right);
   Node* GetOrCreateObjectState(Node* effect, Node* node);
+  Node* ResolveReplacement(Node* node);
   bool ExistsVirtualAllocate();
 
  private:
@@ -42,6 +43,12 @@ class EscapeAnalysis {
   void ProcessLoadElement(Node* node);
   void ProcessStoreElement(Node* node);
   void ProcessAllocationUsers(Node* node);
+  void ProcessFrameStateUses(Node* node);
+  void ProcessDeoptState(Node* node, VirtualState* state,
+                         ZoneVector<VirtualObject*>* visited);
+  void ProcessDeoptInput(Node* node, VirtualState* state,
+                         ZoneVector<VirtualObject*>* visited);
+  void SetEscapedForDeopt(Node* node);
   void ProcessAllocation(Node* node);
   void ProcessFinishRegion(Node* node);
   void ProcessCall(Node* node);
@@ -56,7 +63,6 @@ class EscapeAnalysis {
                                        Node* node);
 
   Node* replacement(Node* node);
-  Node* ResolveReplacement(Node* node);
   bool SetReplacement(Node* node, Node* rep);
   bool UpdateReplacement(VirtualState* state, Node* node, Node* rep);
 
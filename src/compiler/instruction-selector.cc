@@ -1241,6 +1241,11 @@ void InstructionSelector::VisitNode(Node* node) {
     }
     case IrOpcode::kAtomicStore:
       return VisitAtomicStore(node);
+#define VISIT_SIMD_FLOAT_ARITHMETIC(Name) \
+  case IrOpcode::k##Name:                 \
+    return MarkAsSimd128(node), Visit##Name(node);
+      MACHINE_SIMD_FLOAT_ARITHMETIC_OP_LIST(VISIT_SIMD_FLOAT_ARITHMETIC)
+#undef VISIT_SIMD_FLOAT_ARITHMETIC
     default:
       V8_Fatal(__FILE__, __LINE__, "Unexpected operator #%d:%s @ node #%d",
                node->opcode(), node->op()->mnemonic(), node->id());
@@ -1534,6 +1539,14 @@ void InstructionSelector::VisitWord32PairShr(Node* node) { UNIMPLEMENTED(); }
 void InstructionSelector::VisitWord32PairSar(Node* node) { UNIMPLEMENTED(); }
 #endif  // V8_TARGET_ARCH_64_BIT
 
+// Only x64 implements the SIMD operations used for vectorized loops.
+#if !V8_TARGET_ARCH_X64
+#define VISIT_SIMD_FLOAT_ARITHMETIC(Name) \
+  void InstructionSelector::Visit##Name(Node* node) { UNIMPLEMENTED(); }
+MACHINE_SIMD_FLOAT_ARITHMETIC_OP_LIST(VISIT_SIMD_FLOAT_ARITHMETIC)
+#undef VISIT_SIMD_FLOAT_ARITHMETIC
+#endif  // !V8_TARGET_ARCH_X64
+
 void InstructionSelector::VisitFinishRegion(Node* node) { EmitIdentity(node); }
 
 void InstructionSelector::VisitParameter(Node* node) {
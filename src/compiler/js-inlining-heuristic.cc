@@ -5,7 +5,9 @@
 #include "src/compiler/js-inlining-heuristic.h"
 
 #include "src/compiler.h"
+#include "src/compiler/common-operator.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
@@ -19,51 +21,48 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (seen_.find(node->id()) != seen_.end()) return NoChange();
   seen_.insert(node->id());
 
+  Candidate candidate;
+  candidate.node = node;
+  candidate.num_functions = 0;
+
   Node* callee = node->InputAt(0);
   HeapObjectMatcher match(callee);
-  if (!match.HasValue() || !match.Value()->IsJSFunction()) return NoChange();
-  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
+  if (match.HasValue()) {
+    if (!match.Value()->IsJSFunction()) return NoChange();
+    Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
 
-  // Functions marked with %SetForceInlineFlag are immediately inlined.
-  if (function->shared()->force_inline()) {
-    return inliner_.ReduceJSCall(node, function);
-  }
+    // Functions marked with %SetForceInlineFlag are immediately inlined.
+    if (function->shared()->force_inline()) {
+      return inliner_.ReduceJSCall(node, function);
+    }
 
-  // Handling of special inlining modes right away:
-  //  - For restricted inlining: stop all handling at this point.
-  //  - For stressing inlining: immediately handle all functions.
-  switch (mode_) {
-    case kRestrictedInlining:
+    // Handling of special inlining modes right away:
+    //  - For restricted inlining: stop all handling at this point.
+    //  - For stressing inlining: immediately handle all functions.
+    switch (mode_) {
+      case kRestrictedInlining:
+        return NoChange();
+      case kStressInlining:
+        return inliner_.ReduceJSCall(node, function);
+      case kGeneralInlining:
+        break;
+    }
+
+    if (!IsInliningCandidate(function)) return NoChange();
+    candidate.functions[candidate.num_functions++] = function;
+  } else {
+    // Targets of polymorphic calls are only inlined by the general heuristic.
+    if (mode_ != kGeneralInlining || !FLAG_turbo_polymorphic_inlining) {
       return NoChange();
-    case kStressInlining:
-      return inliner_.ReduceJSCall(node, function);
-    case kGeneralInlining:
-      break;
+    }
   }
 
   // ---------------------------------------------------------------------------
   // Everything below this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
-  // Built-in functions are handled by the JSBuiltinReducer.
-  if (function->shared()->HasBuiltinFunctionId()) return NoChange();
-
-  // Don't inline builtins.
-  if (function->shared()->IsBuiltin()) return NoChange();
-
-  // Quick check on source code length to avoid parsing large candidate.
-  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
-    return NoChange();
-  }
-
-  // Quick check on the size of the AST to avoid parsing large candidate.
-  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
-    return NoChange();
-  }
-
   // Avoid inlining within or across the boundary of asm.js code.
   if (info_->shared_info()->asm_function()) return NoChange();
-  if (function->shared()->asm_function()) return NoChange();
 
   // Stop inlinining once the maximum allowed level is reached.
   int level = 0;
@@ -88,19 +87,27 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
       int const extra_index =
           p.feedback().vector()->GetIndex(p.feedback().slot()) + 1;
       Handle<Object> feedback_extra(p.feedback().vector()->get(extra_index),
-                                    function->GetIsolate());
+                                    info_->isolate());
       if (feedback_extra->IsSmi()) {
         calls = Handle<Smi>::cast(feedback_extra)->value();
       }
     }
   }
+  candidate.calls = calls;
+
+  // Without a constant target, fall back to the targets recorded by the
+  // CallIC for this call site.
+  if (candidate.num_functions == 0) {
+    CollectPolymorphicTargets(node, &candidate);
+    if (candidate.num_functions == 0) return NoChange();
+  }
 
   // ---------------------------------------------------------------------------
   // Everything above this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
   // In the general case we remember the candidate for later.
-  candidates_.insert({function, node, calls});
+  candidates_.insert(candidate);
   return NoChange();
 }
 
@@ -120,16 +127,139 @@ void JSInliningHeuristic::Finalize() {
     candidates_.erase(i);
     // Make sure we don't try to inline dead candidate nodes.
     if (!candidate.node->IsDead()) {
-      Reduction r = inliner_.ReduceJSCall(candidate.node, candidate.function);
-      if (r.Changed()) {
-        cumulative_count_ += candidate.function->shared()->ast_node_count();
-        return;
-      }
+      Reduction r = InlineCandidate(candidate);
+      if (r.Changed()) return;
     }
   }
 }
 
 
+bool JSInliningHeuristic::IsInliningCandidate(
+    Handle<JSFunction> function) const {
+  // Built-in functions are handled by the JSBuiltinReducer.
+  if (function->shared()->HasBuiltinFunctionId()) return false;
+
+  // Don't inline builtins.
+  if (function->shared()->IsBuiltin()) return false;
+
+  // Quick check on source code length to avoid parsing large candidate.
+  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
+    return false;
+  }
+
+  // Quick check on the size of the AST to avoid parsing large candidate.
+  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
+    return false;
+  }
+
+  // Avoid inlining across the boundary of asm.js code.
+  if (function->shared()->asm_function()) return false;
+  return true;
+}
+
+
+void JSInliningHeuristic::CollectPolymorphicTargets(Node* node,
+                                                    Candidate* candidate) {
+  // Only plain calls with CallIC feedback are dispatched on their target.
+  if (node->opcode() != IrOpcode::kJSCallFunction) return;
+  CallFunctionParameters const& p = CallFunctionParametersOf(node->op());
+  if (!p.feedback().IsValid()) return;
+  if (p.tail_call_mode() == TailCallMode::kAllow) return;
+
+  // The JSInliner does not support inlining into a try-block.
+  if (NodeProperties::IsExceptionalCall(node)) return;
+
+  CallICNexus nexus(p.feedback().vector(), p.feedback().slot());
+  Handle<JSFunction> functions[kMaxCallPolymorphism];
+  int counts[kMaxCallPolymorphism];
+  int const num_functions =
+      nexus.ExtractCallTargets(functions, counts, kMaxCallPolymorphism);
+  if (num_functions == 0) return;
+  int total = 0;
+  for (int i = 0; i < num_functions; ++i) total += counts[i];
+
+  // Every target gets a share of the size budget for a single inlining that
+  // matches its share of the calls, so that rarely called targets are only
+  // inlined if they are small, and are left to the generic call otherwise.
+  for (int i = 0; i < num_functions; ++i) {
+    Handle<JSFunction> function = functions[i];
+    if (!IsInliningCandidate(function)) continue;
+    if (!function->shared()->IsInlineable()) continue;
+    int64_t const size = function->shared()->ast_node_count();
+    if (size * total > static_cast<int64_t>(FLAG_max_inlined_nodes) *
+                           counts[i]) {
+      continue;
+    }
+    candidate->functions[candidate->num_functions++] = function;
+  }
+}
+
+
+Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate) {
+  Node* const node = candidate.node;
+  Node* const callee = NodeProperties::GetValueInput(node, 0);
+  HeapObjectMatcher match(callee);
+  if (match.HasValue()) {
+    Handle<JSFunction> function = candidate.functions[0];
+    Reduction const reduction = inliner_.ReduceJSCall(node, function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+    return reduction;
+  }
+
+  // Dispatch on the {callee} to a copy of the call site for every target,
+  // and to a copy of the generic call site for all other targets.
+  int const num_functions = candidate.num_functions;
+  int const num_calls = num_functions + 1;
+  int const input_count = node->InputCount();
+  Node** inputs = graph()->zone()->NewArray<Node*>(input_count);
+  for (int i = 0; i < input_count; ++i) inputs[i] = node->InputAt(i);
+  Node* control = NodeProperties::GetControlInput(node);
+  Node* calls[kMaxCallPolymorphism + 2];
+  Node* if_successes[kMaxCallPolymorphism + 1];
+  for (int i = 0; i < num_calls; ++i) {
+    if (i < num_functions) {
+      Node* target = jsgraph()->HeapConstant(candidate.functions[i]);
+      Node* check = graph()->NewNode(simplified()->ReferenceEqual(Type::Any()),
+                                     callee, target);
+      Node* branch = graph()->NewNode(common()->Branch(), check, control);
+      control = graph()->NewNode(common()->IfFalse(), branch);
+      if_successes[i] = graph()->NewNode(common()->IfTrue(), branch);
+      inputs[0] = target;
+    } else {
+      if_successes[i] = control;
+      inputs[0] = callee;
+    }
+    inputs[input_count - 1] = if_successes[i];
+    calls[i] = if_successes[i] =
+        graph()->NewNode(node->op(), input_count, inputs);
+    seen_.insert(calls[i]->id());
+  }
+
+  // Morph the original call site into a join of the dispatched call sites.
+  Node* merge =
+      graph()->NewNode(common()->Merge(num_calls), num_calls, if_successes);
+  calls[num_calls] = merge;
+  Node* effect = graph()->NewNode(common()->EffectPhi(num_calls),
+                                  num_calls + 1, calls);
+  Node* value = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, num_calls), num_calls + 1,
+      calls);
+  ReplaceWithValue(node, value, effect, merge);
+
+  // Inline the call sites with a known target.
+  for (int i = 0; i < num_functions; ++i) {
+    Handle<JSFunction> function = candidate.functions[i];
+    Reduction const reduction = inliner_.ReduceJSCall(calls[i], function);
+    if (reduction.Changed()) {
+      cumulative_count_ += function->shared()->ast_node_count();
+    }
+  }
+  return Replace(value);
+}
+
+
 bool JSInliningHeuristic::CandidateCompare::operator()(
     const Candidate& left, const Candidate& right) const {
   if (left.calls != right.calls) {
@@ -142,14 +272,31 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
 void JSInliningHeuristic::PrintCandidates() {
   PrintF("Candidates for inlining (size=%zu):\n", candidates_.size());
   for (const Candidate& candidate : candidates_) {
-    PrintF("  id:%d, calls:%d, size[source]:%d, size[ast]:%d / %s\n",
-           candidate.node->id(), candidate.calls,
-           candidate.function->shared()->SourceSize(),
-           candidate.function->shared()->ast_node_count(),
-           candidate.function->shared()->DebugName()->ToCString().get());
+    PrintF("  id:%d, calls:%d, targets:%d\n", candidate.node->id(),
+           candidate.calls, candidate.num_functions);
+    for (int i = 0; i < candidate.num_functions; ++i) {
+      Handle<JSFunction> function = candidate.functions[i];
+      PrintF("    size[source]:%d, size[ast]:%d / %s\n",
+             function->shared()->SourceSize(),
+             function->shared()->ast_node_count(),
+             function->shared()->DebugName()->ToCString().get());
+    }
   }
 }
 
+
+Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
+
+
+CommonOperatorBuilder* JSInliningHeuristic::common() const {
+  return jsgraph()->common();
+}
+
+
+SimplifiedOperatorBuilder* JSInliningHeuristic::simplified() const {
+  return jsgraph()->simplified();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
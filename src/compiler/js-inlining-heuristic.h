@@ -6,6 +6,7 @@
 #define V8_COMPILER_JS_INLINING_HEURISTIC_H_
 
 #include "src/compiler/js-inlining.h"
+#include "src/type-feedback-vector.h"
 
 namespace v8 {
 namespace internal {
@@ -21,7 +22,8 @@ class JSInliningHeuristic final : public AdvancedReducer {
         inliner_(editor, local_zone, info, jsgraph),
         candidates_(local_zone),
         seen_(local_zone),
-        info_(info) {}
+        info_(info),
+        jsgraph_(jsgraph) {}
 
   Reduction Reduce(Node* node) final;
 
@@ -30,10 +32,14 @@ class JSInliningHeuristic final : public AdvancedReducer {
   void Finalize() final;
 
  private:
+  // Maximum number of targets inlined at a polymorphic call site.
+  static const int kMaxCallPolymorphism = CallICNexus::kMaxCallTargets;
+
   struct Candidate {
-    Handle<JSFunction> function;  // The call target being inlined.
-    Node* node;                   // The call site at which to inline.
-    int calls;                    // Number of times the call site was hit.
+    Handle<JSFunction> functions[kMaxCallPolymorphism];  // The call targets.
+    int num_functions;  // Number of call targets being inlined.
+    Node* node;         // The call site at which to inline.
+    int calls;          // Number of times the call site was hit.
   };
 
   // Comparator for candidates.
@@ -44,14 +50,31 @@ class JSInliningHeuristic final : public AdvancedReducer {
   // Candidates are kept in a sorted set of unique candidates.
   typedef ZoneSet<Candidate, CandidateCompare> Candidates;
 
+  // Returns true if the heuristic considers {function} for inlining at all.
+  bool IsInliningCandidate(Handle<JSFunction> function) const;
+
+  // Collects the targets recorded for the call site {node} that are worth
+  // inlining, given how often each of them was called.
+  void CollectPolymorphicTargets(Node* node, Candidate* candidate);
+
+  // Inlines the {candidate}. Polymorphic call sites are first split into a
+  // dispatch on the target that falls back to the generic call.
+  Reduction InlineCandidate(Candidate const& candidate);
+
   // Dumps candidates to console.
   void PrintCandidates();
 
+  Graph* graph() const;
+  CommonOperatorBuilder* common() const;
+  SimplifiedOperatorBuilder* simplified() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+
   Mode const mode_;
   JSInliner inliner_;
   Candidates candidates_;
   ZoneSet<NodeId> seen_;
   CompilationInfo* info_;
+  JSGraph* const jsgraph_;
   int cumulative_count_ = 0;
 };
 
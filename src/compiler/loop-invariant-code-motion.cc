@@ -0,0 +1,351 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Upper limit for the depth of value trees compared or checked for
+// invariance.
+const int kMaxDepth = 8;
+
+// Returns the only effect use of {node} apart from a Terminate node, or
+// nullptr if there is none or more than one.
+Node* FindUniqueEffectUse(Node* node) {
+  Node* result = nullptr;
+  for (Edge edge : node->use_edges()) {
+    if (!NodeProperties::IsEffectEdge(edge)) continue;
+    if (edge.from()->opcode() == IrOpcode::kTerminate) continue;
+    if (result != nullptr) return nullptr;
+    result = edge.from();
+  }
+  return result;
+}
+
+// Skips over the renamings of objects introduced for property accesses.
+Node* ResolveRenames(Node* node) {
+  while (node->opcode() == IrOpcode::kCheckTaggedPointer) {
+    node = NodeProperties::GetValueInput(node, 0);
+  }
+  return node;
+}
+
+bool IsDeoptimizingNode(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kCheckTaggedPointer:
+    case IrOpcode::kCheckTaggedSigned:
+    case IrOpcode::kDeoptimizeIf:
+    case IrOpcode::kDeoptimizeUnless:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(JSGraph* jsgraph, Zone* zone)
+    : jsgraph_(jsgraph), zone_(zone), loop_tree_(nullptr), hoisted_(zone) {}
+
+void LoopInvariantCodeMotion::Run() {
+  loop_tree_ = LoopFinder::BuildLoopTree(graph(), zone());
+  ZoneVector<Loop*> loops(zone());
+  loops.insert(loops.end(), loop_tree_->outer_loops().begin(),
+               loop_tree_->outer_loops().end());
+  for (size_t i = 0; i < loops.size(); ++i) {
+    loops.insert(loops.end(), loops[i]->children().begin(),
+                 loops[i]->children().end());
+  }
+  // Visit inner loops before the loops containing them.
+  for (auto it = loops.rbegin(); it != loops.rend(); ++it) {
+    VisitLoop(*it);
+  }
+}
+
+void LoopInvariantCodeMotion::VisitLoop(Loop* loop) {
+  Node* const loop_node = loop_tree_->GetLoopControl(loop);
+  Node* effect_phi = nullptr;
+  for (Node* use : loop_node->uses()) {
+    if (use->opcode() == IrOpcode::kEffectPhi) {
+      effect_phi = use;
+      break;
+    }
+  }
+  if (effect_phi == nullptr || MayWrite(loop)) return;
+
+  // Walk the effect chain of the loop header up to the loop condition. Nodes
+  // that stay in the loop are passed over as long as later nodes cannot
+  // depend on them.
+  ZoneVector<Node*> hoisted(zone());
+  Node* frame_state = nullptr;
+  Node* checkpoint = nullptr;
+  bool seen_checkpoint = false;
+  Node* effect = effect_phi;
+  while (Node* node = FindUniqueEffectUse(effect)) {
+    if (node->op()->ControlInputCount() != 1 ||
+        NodeProperties::GetControlInput(node) != loop_node) {
+      break;
+    }
+    if (node->opcode() == IrOpcode::kCheckpoint) {
+      // Deoptimizing on loop entry has to resume right before the first
+      // iteration, which is what the first checkpoint of the header
+      // describes.
+      if (!seen_checkpoint) {
+        frame_state = GetEntryFrameState(
+            NodeProperties::GetFrameStateInput(node, 0), loop_node, loop);
+      }
+      seen_checkpoint = true;
+      effect = node;
+      continue;
+    }
+    if (CanHoist(node, loop, frame_state)) {
+      Node* entry_effect = NodeProperties::GetEffectInput(effect_phi, 0);
+      Node* entry_control = NodeProperties::GetControlInput(loop_node, 0);
+      if (IsDeoptimizingNode(node) && checkpoint == nullptr) {
+        checkpoint = graph()->NewNode(common()->Checkpoint(), frame_state,
+                                      entry_effect, entry_control);
+        entry_effect = checkpoint;
+      }
+      Unlink(node);
+      NodeProperties::ReplaceEffectInput(node, entry_effect);
+      NodeProperties::ReplaceControlInput(node, entry_control);
+      if (node->opcode() == IrOpcode::kDeoptimizeIf ||
+          node->opcode() == IrOpcode::kDeoptimizeUnless) {
+        NodeProperties::ReplaceValueInput(node, frame_state, 1);
+      }
+      NodeProperties::ReplaceEffectInput(effect_phi, node, 0);
+      if (node->op()->ControlOutputCount() > 0) {
+        NodeProperties::ReplaceControlInput(loop_node, node, 0);
+      }
+      hoisted.push_back(node);
+      hoisted_.insert(node);
+      continue;
+    }
+    // Checks that stay in the loop may guard the nodes after them.
+    if (IsDeoptimizingNode(node) ||
+        !node->op()->HasProperty(Operator::kNoWrite)) {
+      break;
+    }
+    effect = node;
+  }
+
+  if (!hoisted.empty()) RemoveRedundantNodes(loop, hoisted);
+}
+
+bool LoopInvariantCodeMotion::MayWrite(Loop* loop) {
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    if (node->op()->EffectOutputCount() == 0) continue;
+    if (node->op()->HasProperty(Operator::kNoWrite)) continue;
+    switch (node->opcode()) {
+      case IrOpcode::kCheckpoint:
+      case IrOpcode::kDeoptimizeIf:
+      case IrOpcode::kDeoptimizeUnless:
+      case IrOpcode::kCheckBounds:
+      case IrOpcode::kCheckTaggedPointer:
+      case IrOpcode::kCheckTaggedSigned:
+      case IrOpcode::kCheckFloat64Hole:
+      case IrOpcode::kCheckTaggedHole:
+      case IrOpcode::kSpeculativeNumberAdd:
+      case IrOpcode::kSpeculativeNumberSubtract:
+      case IrOpcode::kSpeculativeNumberMultiply:
+      case IrOpcode::kSpeculativeNumberDivide:
+      case IrOpcode::kSpeculativeNumberModulus:
+      case IrOpcode::kSpeculativeNumberEqual:
+      case IrOpcode::kSpeculativeNumberLessThan:
+      case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+        // Checks only deoptimize.
+        break;
+      case IrOpcode::kStoreBuffer:
+      case IrOpcode::kStoreElement:
+        // Element stores never change fields or maps.
+        break;
+      default:
+        // This includes stack checks, since interrupts and API callbacks can
+        // run arbitrary JavaScript.
+        return true;
+    }
+  }
+  return false;
+}
+
+bool LoopInvariantCodeMotion::IsInvariant(Node* node, Loop* loop, int depth) {
+  if (hoisted_.find(node) != hoisted_.end()) return true;
+  if (!loop_tree_->Contains(loop, node)) return true;
+  // Pure computations on invariant inputs are invariant as well.
+  if (depth >= kMaxDepth) return false;
+  if (!node->op()->HasProperty(Operator::kPure) ||
+      node->op()->EffectInputCount() > 0 ||
+      node->op()->ControlInputCount() > 0) {
+    return false;
+  }
+  for (Node* input : node->inputs()) {
+    if (!IsInvariant(input, loop, depth + 1)) return false;
+  }
+  return true;
+}
+
+bool LoopInvariantCodeMotion::CanHoist(Node* node, Loop* loop,
+                                       Node* frame_state) {
+  switch (node->opcode()) {
+    case IrOpcode::kLoadField:
+      return IsInvariant(NodeProperties::GetValueInput(node, 0), loop);
+    case IrOpcode::kCheckTaggedPointer:
+    case IrOpcode::kCheckTaggedSigned:
+    case IrOpcode::kDeoptimizeIf:
+    case IrOpcode::kDeoptimizeUnless:
+      return frame_state != nullptr &&
+             IsInvariant(NodeProperties::GetValueInput(node, 0), loop);
+    default:
+      return false;
+  }
+}
+
+Node* LoopInvariantCodeMotion::GetEntryFrameState(Node* frame_state,
+                                                  Node* loop_node,
+                                                  Loop* loop) {
+  ZoneMap<Node*, Node*> copies(zone());
+  return GetEntryValue(frame_state, loop_node, loop, &copies);
+}
+
+Node* LoopInvariantCodeMotion::GetEntryValue(Node* node, Node* loop_node,
+                                             Loop* loop,
+                                             ZoneMap<Node*, Node*>* copies) {
+  if (node->opcode() == IrOpcode::kPhi &&
+      NodeProperties::GetControlInput(node) == loop_node) {
+    return NodeProperties::GetValueInput(node, kAssumedLoopEntryIndex);
+  }
+  if (!loop_tree_->Contains(loop, node)) return node;
+  switch (node->opcode()) {
+    case IrOpcode::kFrameState:
+    case IrOpcode::kStateValues:
+    case IrOpcode::kTypedStateValues: {
+      auto it = copies->find(node);
+      if (it != copies->end()) return it->second;
+      NodeVector inputs(zone());
+      for (Node* input : node->inputs()) {
+        Node* value = GetEntryValue(input, loop_node, loop, copies);
+        if (value == nullptr) return nullptr;
+        inputs.push_back(value);
+      }
+      Node* copy = graph()->NewNode(node->op(), static_cast<int>(inputs.size()),
+                                    inputs.empty() ? nullptr : &inputs.front());
+      copies->insert(std::make_pair(node, copy));
+      return copy;
+    }
+    default:
+      // Some other value computed inside of the loop.
+      return nullptr;
+  }
+}
+
+void LoopInvariantCodeMotion::RemoveRedundantNodes(
+    Loop* loop, ZoneVector<Node*> const& hoisted) {
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    if (node->IsDead() || hoisted_.find(node) != hoisted_.end()) continue;
+    switch (node->opcode()) {
+      case IrOpcode::kLoadField:
+      case IrOpcode::kCheckTaggedPointer:
+      case IrOpcode::kCheckTaggedSigned:
+      case IrOpcode::kDeoptimizeIf:
+      case IrOpcode::kDeoptimizeUnless: {
+        Node* const replacement = FindHoistedEquivalent(node, hoisted);
+        if (replacement == nullptr) break;
+        Node* const effect = NodeProperties::GetEffectInput(node);
+        Node* const control = NodeProperties::GetControlInput(node);
+        NodeProperties::ReplaceUses(node, replacement, effect, control);
+        node->Kill();
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+Node* LoopInvariantCodeMotion::FindHoistedEquivalent(
+    Node* node, ZoneVector<Node*> const& hoisted) {
+  for (Node* candidate : hoisted) {
+    if (candidate->opcode() != node->opcode()) continue;
+    if (node->opcode() == IrOpcode::kLoadField) {
+      FieldAccess const& access = FieldAccessOf(node->op());
+      FieldAccess const& candidate_access = FieldAccessOf(candidate->op());
+      if (!(access == candidate_access) ||
+          !candidate_access.type->Is(access.type)) {
+        continue;
+      }
+    }
+    if (IsSameValue(NodeProperties::GetValueInput(node, 0),
+                    NodeProperties::GetValueInput(candidate, 0))) {
+      return candidate;
+    }
+  }
+  return nullptr;
+}
+
+bool LoopInvariantCodeMotion::IsSameValue(Node* a, Node* b, int depth) {
+  a = ResolveRenames(a);
+  b = ResolveRenames(b);
+  if (a == b) return true;
+  if (depth >= kMaxDepth || a->opcode() != b->opcode()) return false;
+  switch (a->opcode()) {
+    case IrOpcode::kHeapConstant: {
+      HeapObjectMatcher ma(a);
+      HeapObjectMatcher mb(b);
+      return ma.Value().is_identical_to(mb.Value());
+    }
+    case IrOpcode::kLoadField: {
+      // The loop neither writes fields nor maps, so loads of the same field
+      // of the same object agree.
+      if (!(FieldAccessOf(a->op()) == FieldAccessOf(b->op()))) return false;
+      return IsSameValue(NodeProperties::GetValueInput(a, 0),
+                         NodeProperties::GetValueInput(b, 0), depth + 1);
+    }
+    default: {
+      if (!a->op()->HasProperty(Operator::kPure) ||
+          a->op()->ControlInputCount() > 0 || !a->op()->Equals(b->op()) ||
+          a->InputCount() != b->InputCount()) {
+        return false;
+      }
+      for (int i = 0; i < a->InputCount(); ++i) {
+        if (!IsSameValue(a->InputAt(i), b->InputAt(i), depth + 1)) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+}
+
+// static
+void LoopInvariantCodeMotion::Unlink(Node* node) {
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+  for (Edge edge : node->use_edges()) {
+    if (NodeProperties::IsEffectEdge(edge)) {
+      edge.UpdateTo(effect);
+    } else if (NodeProperties::IsControlEdge(edge)) {
+      edge.UpdateTo(control);
+    }
+  }
+}
+
+Graph* LoopInvariantCodeMotion::graph() const { return jsgraph_->graph(); }
+
+CommonOperatorBuilder* LoopInvariantCodeMotion::common() const {
+  return jsgraph_->common();
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,84 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+#define V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class CommonOperatorBuilder;
+class JSGraph;
+
+// Hoists loop invariant field loads and checks out of loops.
+//
+// Only the straight-line part of the loop header that precedes the loop
+// condition is considered, since it runs at least once whenever the loop is
+// entered, and only loops that cannot change fields or maps, i.e. loops whose
+// only side effects are element stores. Loops with a stack check do not
+// qualify, since interrupts can run arbitrary JavaScript. Hoisted checks
+// deoptimize to the first checkpoint of the loop header as seen on loop
+// entry. Afterwards, checks and field loads inside of the loop that repeat a
+// hoisted one are removed.
+class LoopInvariantCodeMotion final {
+ public:
+  LoopInvariantCodeMotion(JSGraph* jsgraph, Zone* zone);
+
+  void Run();
+
+ private:
+  typedef LoopTree::Loop Loop;
+
+  void VisitLoop(Loop* loop);
+
+  // Returns true if any node in {loop} may change fields or maps.
+  bool MayWrite(Loop* loop);
+
+  // Returns true if {node} computes the same value in every iteration of
+  // {loop}.
+  bool IsInvariant(Node* node, Loop* loop, int depth = 0);
+
+  // Returns true if {node} from the loop header can be moved to the loop
+  // entry. {frame_state} is the frame state to deoptimize to on loop entry.
+  bool CanHoist(Node* node, Loop* loop, Node* frame_state);
+
+  // Returns a copy of the loop header's {frame_state} with the phis of
+  // {loop_node} replaced by their values on loop entry, or nullptr if the
+  // frame state refers to other values computed inside of {loop}.
+  Node* GetEntryFrameState(Node* frame_state, Node* loop_node, Loop* loop);
+  Node* GetEntryValue(Node* node, Node* loop_node, Loop* loop,
+                      ZoneMap<Node*, Node*>* copies);
+
+  // Removes checks and loads inside of {loop} that repeat one of the nodes
+  // {hoisted} out of it.
+  void RemoveRedundantNodes(Loop* loop, ZoneVector<Node*> const& hoisted);
+  Node* FindHoistedEquivalent(Node* node, ZoneVector<Node*> const& hoisted);
+
+  // Returns true if {a} and {b} are known to compute the same value in a
+  // loop that does not write fields.
+  bool IsSameValue(Node* a, Node* b, int depth = 0);
+
+  // Unlinks {node} from the effect and control chains.
+  static void Unlink(Node* node);
+
+  Graph* graph() const;
+  CommonOperatorBuilder* common() const;
+  Zone* zone() const { return zone_; }
+
+  JSGraph* const jsgraph_;
+  Zone* const zone_;
+  LoopTree* loop_tree_;
+  ZoneSet<Node*> hoisted_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
@@ -0,0 +1,388 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-variable-optimizer.h"
+
+#include <cmath>
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/type-cache.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Upper limit for the number of control nodes visited when searching for a
+// dominating loop condition.
+const int kMaxControlSteps = 64;
+
+// Upper limit for the number of effect nodes visited when checking that a
+// field was not changed between two loads.
+const int kMaxEffectSteps = 32;
+
+}  // namespace
+
+// static
+bool InductionVariable::Match(Node* node, InductionVariable* result) {
+  if (node->opcode() != IrOpcode::kPhi) return false;
+  if (node->op()->ValueInputCount() != 2) return false;
+  Node* const loop = NodeProperties::GetControlInput(node);
+  if (loop->opcode() != IrOpcode::kLoop) return false;
+  DCHECK_EQ(2, loop->InputCount());
+
+  Node* const increment = NodeProperties::GetValueInput(node, 1);
+  double sign;
+  switch (increment->opcode()) {
+    case IrOpcode::kJSAdd:
+    case IrOpcode::kNumberAdd:
+    case IrOpcode::kSpeculativeNumberAdd:
+      sign = 1;
+      break;
+    case IrOpcode::kJSSubtract:
+    case IrOpcode::kNumberSubtract:
+    case IrOpcode::kSpeculativeNumberSubtract:
+      sign = -1;
+      break;
+    default:
+      return false;
+  }
+  Node* input = NodeProperties::GetValueInput(increment, 0);
+  if (input->opcode() == IrOpcode::kJSToNumber) {
+    input = NodeProperties::GetValueInput(input, 0);
+  }
+  if (input != node) return false;
+  NumberMatcher mstep(NodeProperties::GetValueInput(increment, 1));
+  if (!mstep.HasValue() || mstep.Value() == 0 ||
+      !std::isfinite(mstep.Value()) ||
+      std::floor(mstep.Value()) != mstep.Value()) {
+    return false;
+  }
+
+  result->phi_ = node;
+  result->increment_ = increment;
+  result->step_ = sign * mstep.Value();
+  return true;
+}
+
+Node* InductionVariable::loop() const {
+  return NodeProperties::GetControlInput(phi());
+}
+
+Node* InductionVariable::init() const {
+  return NodeProperties::GetValueInput(phi(), 0);
+}
+
+Node* InductionVariable::FindBound(Node* control, bool* strict) const {
+  int budget = kMaxControlSteps;
+  while (budget-- > 0) {
+    switch (control->opcode()) {
+      case IrOpcode::kIfTrue:
+      case IrOpcode::kIfFalse: {
+        Node* const branch = NodeProperties::GetControlInput(control);
+        if (branch->opcode() != IrOpcode::kBranch) return nullptr;
+        Node* bound;
+        if (MatchBound(NodeProperties::GetValueInput(branch, 0),
+                       control->opcode() == IrOpcode::kIfTrue, &bound,
+                       strict)) {
+          return bound;
+        }
+        control = NodeProperties::GetControlInput(branch);
+        break;
+      }
+      case IrOpcode::kLoop: {
+        // Conditions outside of our own loop cannot constrain the variable.
+        if (control == loop()) return nullptr;
+        // Skip over nested loops through their entry.
+        control = NodeProperties::GetControlInput(control, 0);
+        break;
+      }
+      case IrOpcode::kMerge: {
+        Node* const branch = FindCommonBranch(control, &budget);
+        if (branch == nullptr) return nullptr;
+        control = NodeProperties::GetControlInput(branch);
+        break;
+      }
+      default: {
+        if (control->op()->ControlInputCount() != 1) return nullptr;
+        control = NodeProperties::GetControlInput(control);
+        break;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Returns the branch that all inputs of {merge} originate from, i.e. the
+// branch that dominates the diamond closed by {merge}, or nullptr.
+Node* InductionVariable::FindCommonBranch(Node* merge, int* budget) const {
+  Node* common_branch = nullptr;
+  for (Node* control : merge->inputs()) {
+    while (control->opcode() != IrOpcode::kIfTrue &&
+           control->opcode() != IrOpcode::kIfFalse) {
+      if (--*budget < 0) return nullptr;
+      if (control->opcode() == IrOpcode::kMerge) {
+        Node* const branch = FindCommonBranch(control, budget);
+        if (branch == nullptr) return nullptr;
+        control = NodeProperties::GetControlInput(branch);
+      } else if (control->opcode() != IrOpcode::kLoop &&
+                 control->op()->ControlInputCount() == 1) {
+        control = NodeProperties::GetControlInput(control);
+      } else {
+        return nullptr;
+      }
+    }
+    Node* const branch = NodeProperties::GetControlInput(control);
+    if (common_branch == nullptr) common_branch = branch;
+    if (branch != common_branch) return nullptr;
+  }
+  return common_branch;
+}
+
+bool InductionVariable::MatchBound(Node* condition, bool is_true, Node** bound,
+                                   bool* strict) const {
+  if (condition->opcode() == IrOpcode::kJSToBoolean) {
+    condition = NodeProperties::GetValueInput(condition, 0);
+  }
+  Node* lhs;
+  Node* rhs;
+  bool less_than;
+  switch (condition->opcode()) {
+    case IrOpcode::kJSLessThan:
+    case IrOpcode::kNumberLessThan:
+    case IrOpcode::kSpeculativeNumberLessThan:
+      lhs = NodeProperties::GetValueInput(condition, 0);
+      rhs = NodeProperties::GetValueInput(condition, 1);
+      less_than = true;
+      break;
+    case IrOpcode::kJSLessThanOrEqual:
+    case IrOpcode::kNumberLessThanOrEqual:
+    case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+      lhs = NodeProperties::GetValueInput(condition, 0);
+      rhs = NodeProperties::GetValueInput(condition, 1);
+      less_than = false;
+      break;
+    case IrOpcode::kJSGreaterThan:
+      lhs = NodeProperties::GetValueInput(condition, 1);
+      rhs = NodeProperties::GetValueInput(condition, 0);
+      less_than = true;
+      break;
+    case IrOpcode::kJSGreaterThanOrEqual:
+      lhs = NodeProperties::GetValueInput(condition, 1);
+      rhs = NodeProperties::GetValueInput(condition, 0);
+      less_than = false;
+      break;
+    default:
+      return false;
+  }
+  if (!is_true) {
+    // !(lhs < rhs) is rhs <= lhs and !(lhs <= rhs) is rhs < lhs, unless
+    // one of the operands is NaN.
+    std::swap(lhs, rhs);
+    less_than = !less_than;
+  }
+  if (step() > 0 && lhs == phi() && rhs != phi()) {
+    *bound = rhs;
+  } else if (step() < 0 && rhs == phi() && lhs != phi()) {
+    *bound = lhs;
+  } else {
+    return false;
+  }
+  *strict = less_than;
+  return true;
+}
+
+
+LoopVariableOptimizer::LoopVariableOptimizer(Editor* editor, JSGraph* jsgraph)
+    : AdvancedReducer(editor),
+      jsgraph_(jsgraph),
+      type_cache_(TypeCache::Get()) {}
+
+LoopVariableOptimizer::~LoopVariableOptimizer() {}
+
+Reduction LoopVariableOptimizer::Reduce(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kCheckBounds:
+      return ReduceCheckBounds(node);
+    case IrOpcode::kLoadBuffer:
+      return ReduceLoadBuffer(node);
+    case IrOpcode::kStoreBuffer:
+      return ReduceStoreBuffer(node);
+    default:
+      break;
+  }
+  return NoChange();
+}
+
+Reduction LoopVariableOptimizer::ReduceCheckBounds(Node* node) {
+  Node* const index = NodeProperties::GetValueInput(node, 0);
+  Node* const length = NodeProperties::GetValueInput(node, 1);
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+  bool strict;
+  Node* const bound = FindUpperBound(index, control, &strict);
+  if (bound == nullptr) return NoChange();
+  Type* const bound_type = NodeProperties::GetType(bound);
+  Type* const length_type = NodeProperties::GetType(length);
+  if (!length_type->IsInhabited()) return NoChange();
+  if (strict ? (IsSameLength(bound, length) ||
+                bound_type->Max() <= length_type->Min())
+             : bound_type->Max() < length_type->Min()) {
+    ReplaceWithValue(node, index, effect);
+    return Replace(index);
+  }
+  return NoChange();
+}
+
+Reduction LoopVariableOptimizer::ReduceLoadBuffer(Node* node) {
+  BufferAccess const access = BufferAccessOf(node->op());
+  Node* const buffer = NodeProperties::GetValueInput(node, 0);
+  Node* const offset = NodeProperties::GetValueInput(node, 1);
+  Node* const length = NodeProperties::GetValueInput(node, 2);
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+  int const k = ElementSizeLog2Of(access.machine_type().representation());
+  NumberMatcher mlength(length);
+  if (!mlength.HasValue()) return NoChange();
+  Node* const index = GetElementIndex(offset, k);
+  if (index == nullptr) return NoChange();
+  if (!IsIndexBelow(index, control, std::floor(mlength.Value() / (1 << k)))) {
+    return NoChange();
+  }
+  Node* const load = graph()->NewNode(
+      simplified()->LoadElement(AccessBuilder::ForTypedArrayElement(
+          access.external_array_type(), true)),
+      buffer, index, effect, control);
+  ReplaceWithValue(node, load, load);
+  return Replace(load);
+}
+
+Reduction LoopVariableOptimizer::ReduceStoreBuffer(Node* node) {
+  BufferAccess const access = BufferAccessOf(node->op());
+  Node* const offset = NodeProperties::GetValueInput(node, 1);
+  Node* const length = NodeProperties::GetValueInput(node, 2);
+  Node* const control = NodeProperties::GetControlInput(node);
+  int const k = ElementSizeLog2Of(access.machine_type().representation());
+  NumberMatcher mlength(length);
+  if (!mlength.HasValue()) return NoChange();
+  Node* const index = GetElementIndex(offset, k);
+  if (index == nullptr) return NoChange();
+  if (!IsIndexBelow(index, control, std::floor(mlength.Value() / (1 << k)))) {
+    return NoChange();
+  }
+  // Turn into StoreElement(buffer, index, value, effect, control).
+  node->ReplaceInput(1, index);
+  node->RemoveInput(2);
+  NodeProperties::ChangeOp(
+      node, simplified()->StoreElement(AccessBuilder::ForTypedArrayElement(
+                access.external_array_type(), true)));
+  return Changed(node);
+}
+
+bool LoopVariableOptimizer::IsIndexBelow(Node* index, Node* control,
+                                         double limit) {
+  bool strict;
+  Node* const bound = FindUpperBound(index, control, &strict);
+  if (bound == nullptr) return false;
+  Type* const bound_type = NodeProperties::GetType(bound);
+  return strict ? bound_type->Max() <= limit : bound_type->Max() < limit;
+}
+
+Node* LoopVariableOptimizer::FindUpperBound(Node* index, Node* control,
+                                            bool* strict) {
+  InductionVariable induction_var;
+  if (!InductionVariable::Match(index, &induction_var)) return nullptr;
+  if (induction_var.step() < 0) return nullptr;
+  Type* const index_type = NodeProperties::GetType(index);
+  if (!index_type->IsInhabited() ||
+      !index_type->Is(type_cache_.kInteger) || index_type->Min() < 0) {
+    return nullptr;
+  }
+  Node* const bound = induction_var.FindBound(control, strict);
+  if (bound == nullptr) return nullptr;
+  // Integral bounds exclude NaN, see InductionVariable::FindBound.
+  Type* const bound_type = NodeProperties::GetType(bound);
+  if (!bound_type->IsInhabited() || !bound_type->Is(type_cache_.kInteger)) {
+    return nullptr;
+  }
+  return bound;
+}
+
+Node* LoopVariableOptimizer::GetElementIndex(Node* offset,
+                                             int element_size_log2) {
+  if (element_size_log2 == 0) return offset;
+  if (offset->opcode() != IrOpcode::kWord32Shl) return nullptr;
+  Int32BinopMatcher m(offset);
+  if (!m.right().Is(element_size_log2)) return nullptr;
+  return m.left().node();
+}
+
+// static
+bool LoopVariableOptimizer::IsSameLength(Node* bound, Node* length) {
+  if (bound == length) return true;
+  if (bound->opcode() != IrOpcode::kLoadField ||
+      length->opcode() != IrOpcode::kLoadField) {
+    return false;
+  }
+  if (!(FieldAccessOf(bound->op()) == FieldAccessOf(length->op()))) {
+    return false;
+  }
+  // Look through renamings of the object, i.e. CheckTaggedPointer nodes
+  // introduced for the individual property accesses.
+  Node* bound_object = NodeProperties::GetValueInput(bound, 0);
+  Node* length_object = NodeProperties::GetValueInput(length, 0);
+  while (bound_object->opcode() == IrOpcode::kCheckTaggedPointer) {
+    bound_object = NodeProperties::GetValueInput(bound_object, 0);
+  }
+  while (length_object->opcode() == IrOpcode::kCheckTaggedPointer) {
+    length_object = NodeProperties::GetValueInput(length_object, 0);
+  }
+  if (bound_object != length_object) return false;
+  // Make sure nothing in between the two loads can change the field.
+  int budget = kMaxEffectSteps;
+  for (Node* effect = NodeProperties::GetEffectInput(length); effect != bound;
+       effect = NodeProperties::GetEffectInput(effect)) {
+    if (--budget < 0) return false;
+    switch (effect->opcode()) {
+      case IrOpcode::kCheckpoint:
+      case IrOpcode::kDeoptimizeIf:
+      case IrOpcode::kDeoptimizeUnless:
+      case IrOpcode::kCheckBounds:
+      case IrOpcode::kCheckTaggedPointer:
+      case IrOpcode::kCheckTaggedSigned:
+      case IrOpcode::kSpeculativeNumberLessThan:
+      case IrOpcode::kSpeculativeNumberLessThanOrEqual:
+      case IrOpcode::kStoreBuffer:
+      case IrOpcode::kStoreElement:
+        // These can never change a field.
+        break;
+      case IrOpcode::kJSStackCheck:
+        // Interrupts cannot change the field either.
+        break;
+      default: {
+        if (!effect->op()->HasProperty(Operator::kNoWrite) ||
+            effect->op()->EffectInputCount() != 1) {
+          return false;
+        }
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+Graph* LoopVariableOptimizer::graph() const { return jsgraph()->graph(); }
+
+SimplifiedOperatorBuilder* LoopVariableOptimizer::simplified() const {
+  return jsgraph()->simplified();
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
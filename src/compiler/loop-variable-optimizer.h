@@ -0,0 +1,112 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_VARIABLE_OPTIMIZER_H_
+#define V8_COMPILER_LOOP_VARIABLE_OPTIMIZER_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+
+// Forward declarations.
+class TypeCache;
+
+namespace compiler {
+
+// Forward declarations.
+class CommonOperatorBuilder;
+class JSGraph;
+class SimplifiedOperatorBuilder;
+
+// An induction variable is a loop phi of the form
+//
+//   phi = Phi(init, phi + step)
+//
+// with a single backedge and a non-zero integral constant {step}. The
+// increment may also be applied to ToNumber(phi), as generated for count
+// operations like i++.
+class InductionVariable final {
+ public:
+  InductionVariable() : phi_(nullptr), increment_(nullptr), step_(0) {}
+
+  // Returns true and initializes {result} if {node} is an induction variable.
+  static bool Match(Node* node, InductionVariable* result);
+
+  Node* phi() const { return phi_; }
+  Node* loop() const;
+  Node* init() const;
+  Node* increment() const { return increment_; }
+  double step() const { return step_; }
+
+  // Walks up the dominating control flow of {control} and returns the bound
+  // of the first branch condition that limits the variable in the direction
+  // of its step, i.e. phi < bound or phi <= bound for an increasing variable
+  // and bound < phi or bound <= phi for a decreasing one. Conditions that are
+  // only known to be false are negated, which is only valid if the bound is
+  // not NaN, so callers have to check the type of the bound before relying on
+  // it. Returns nullptr if no such condition is found before the loop header.
+  Node* FindBound(Node* control, bool* strict) const;
+
+ private:
+  bool MatchBound(Node* condition, bool is_true, Node** bound,
+                  bool* strict) const;
+  Node* FindCommonBranch(Node* merge, int* budget) const;
+
+  Node* phi_;
+  Node* increment_;
+  double step_;
+};
+
+
+// Removes bounds checks on induction variables in counted loops.
+//
+// A CheckBounds(index, length) is redundant if {index} is a non-negative,
+// increasing induction variable and a dominating loop condition already
+// established index < length, either because the condition compares against
+// the same length (possibly reloaded from the same field with nothing in
+// between that could change it) or because the bound is known to be smaller
+// than the length. The same reasoning turns LoadBuffer and StoreBuffer nodes
+// on constant typed arrays into unchecked element accesses.
+class LoopVariableOptimizer final : public AdvancedReducer {
+ public:
+  LoopVariableOptimizer(Editor* editor, JSGraph* jsgraph);
+  ~LoopVariableOptimizer() final;
+
+  Reduction Reduce(Node* node) final;
+
+ private:
+  Reduction ReduceCheckBounds(Node* node);
+  Reduction ReduceLoadBuffer(Node* node);
+  Reduction ReduceStoreBuffer(Node* node);
+
+  // Returns true if the induction variable {index} is known to be within
+  // [0, limit) at {control}.
+  bool IsIndexBelow(Node* index, Node* control, double limit);
+
+  // Returns the bound of a condition dominating {control} that limits the
+  // non-negative, increasing integral induction variable {index} from above,
+  // or nullptr if there is none.
+  Node* FindUpperBound(Node* index, Node* control, bool* strict);
+
+  // Returns the element index accessed through the byte {offset} of a buffer
+  // access, or nullptr if it cannot be determined.
+  Node* GetElementIndex(Node* offset, int element_size_log2);
+
+  // Returns true if {length} has the same value as {bound}.
+  static bool IsSameLength(Node* bound, Node* length);
+
+  Graph* graph() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+  SimplifiedOperatorBuilder* simplified() const;
+
+  JSGraph* const jsgraph_;
+  TypeCache const& type_cache_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_VARIABLE_OPTIMIZER_H_
@@ -0,0 +1,668 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-vectorizer.h"
+
+#include <algorithm>
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/conversions-inl.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Upper limit for the number of memory accesses in a loop, which bounds the
+// number of alias checks.
+const size_t kMaxAccesses = 8;
+
+// Upper limit for the depth of the value trees that are vectorized.
+const int kMaxDepth = 8;
+
+// Returns the representation of the float element access {node}, or kNone if
+// {node} is not one.
+MachineRepresentation AccessRepresentationOf(Node* node) {
+  MachineRepresentation rep = MachineRepresentation::kNone;
+  if (node->opcode() == IrOpcode::kLoad) {
+    rep = LoadRepresentationOf(node->op()).representation();
+  } else if (node->opcode() == IrOpcode::kStore) {
+    StoreRepresentation const& store_rep = StoreRepresentationOf(node->op());
+    if (store_rep.write_barrier_kind() != kNoWriteBarrier) {
+      return MachineRepresentation::kNone;
+    }
+    rep = store_rep.representation();
+  }
+  if (rep == MachineRepresentation::kFloat32 ||
+      rep == MachineRepresentation::kFloat64) {
+    return rep;
+  }
+  return MachineRepresentation::kNone;
+}
+
+bool IsFloat64Binop(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kFloat64Add:
+    case IrOpcode::kFloat64Sub:
+    case IrOpcode::kFloat64Mul:
+    case IrOpcode::kFloat64Div:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool HasOnlyValueUse(Node* node, Node* use) {
+  for (Edge edge : node->use_edges()) {
+    if (edge.from() != use) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+struct LoopVectorizer::Candidate {
+  Candidate(Loop* loop, Zone* zone)
+      : loop(loop),
+        accesses(zone),
+        lanes(zone),
+        known(zone),
+        alias_checks(zone),
+        copies(zone) {}
+
+  Loop* const loop;
+  Node* loop_node = nullptr;
+  Node* phi = nullptr;
+  Node* effect_phi = nullptr;
+  Node* branch = nullptr;
+  Node* condition = nullptr;
+  Node* bound = nullptr;
+  // The value phi + 1, and the Int32AddWithOverflow and DeoptimizeIf it comes
+  // from if the addition was not known to stay in range.
+  Node* increment = nullptr;
+  Node* overflow = nullptr;
+  Node* overflow_check = nullptr;
+  // The element representation of all accesses.
+  MachineRepresentation rep = MachineRepresentation::kNone;
+  // The float loads and stores in program order.
+  ZoneVector<Node*> accesses;
+  // The loop values that become vectors.
+  ZoneVector<Node*> lanes;
+  // The other loop nodes that are accounted for.
+  ZoneSet<Node*> known;
+  // The pairs of {earlier, later} accesses whose bases might overlap.
+  ZoneVector<std::pair<Node*, Node*>> alias_checks;
+  // The copies of the loop nodes in the vector loop.
+  ZoneMap<Node*, Node*> copies;
+};
+
+LoopVectorizer::LoopVectorizer(JSGraph* jsgraph, Zone* zone)
+    : jsgraph_(jsgraph), zone_(zone), loop_tree_(nullptr) {}
+
+void LoopVectorizer::Run() {
+  loop_tree_ = LoopFinder::BuildLoopTree(graph(), zone());
+  ZoneVector<Loop*> loops(zone());
+  loops.insert(loops.end(), loop_tree_->outer_loops().begin(),
+               loop_tree_->outer_loops().end());
+  for (size_t i = 0; i < loops.size(); ++i) {
+    loops.insert(loops.end(), loops[i]->children().begin(),
+                 loops[i]->children().end());
+  }
+  // Innermost loops are disjoint, so vectorizing one of them leaves the nodes
+  // of the others alone.
+  for (Loop* loop : loops) {
+    if (!loop->children().empty()) continue;
+    Candidate candidate(loop, zone());
+    if (Analyze(&candidate)) Vectorize(&candidate);
+  }
+}
+
+bool LoopVectorizer::Analyze(Candidate* c) {
+  if (!MatchHeader(c) || !MatchEffects(c) || !MatchAccesses(c)) return false;
+
+  // Loops that are known to run only a few iterations are not worth it.
+  int const lanes = kSimd128Size >> ElementSizeLog2Of(c->rep);
+  Int32Matcher minit(NodeProperties::GetValueInput(c->phi, 0));
+  Int32Matcher mbound(c->bound);
+  if (minit.HasValue() && mbound.HasValue() &&
+      static_cast<int64_t>(mbound.Value()) - minit.Value() < 2 * lanes) {
+    return false;
+  }
+
+  // Vectors must not leak into anything but other vectors and stores.
+  for (Node* lane : c->lanes) {
+    for (Edge edge : lane->use_edges()) {
+      if (!NodeProperties::IsValueEdge(edge)) continue;
+      Node* const use = edge.from();
+      if (std::find(c->lanes.begin(), c->lanes.end(), use) != c->lanes.end()) {
+        continue;
+      }
+      if (use->opcode() == IrOpcode::kStore && edge.index() == 2 &&
+          c->known.count(use)) {
+        continue;
+      }
+      return false;
+    }
+  }
+
+  // Every other node has to be part of the loop structure, the stack check,
+  // the element indices or the frame states.
+  for (Node* node : loop_tree_->LoopNodes(c->loop)) {
+    if (c->known.count(node)) continue;
+    if (std::find(c->lanes.begin(), c->lanes.end(), node) != c->lanes.end()) {
+      continue;
+    }
+    switch (node->opcode()) {
+      case IrOpcode::kFrameState:
+      case IrOpcode::kStateValues:
+      case IrOpcode::kTypedStateValues:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool LoopVectorizer::MatchHeader(Candidate* c) {
+  Node* const loop_node = loop_tree_->GetLoopControl(c->loop);
+  if (loop_node->InputCount() != 2) return false;
+  c->loop_node = loop_node;
+  for (Node* use : loop_node->uses()) {
+    switch (use->opcode()) {
+      case IrOpcode::kPhi:
+        if (c->phi != nullptr ||
+            PhiRepresentationOf(use->op()) != MachineRepresentation::kWord32) {
+          return false;
+        }
+        c->phi = use;
+        break;
+      case IrOpcode::kEffectPhi:
+        if (c->effect_phi != nullptr) return false;
+        c->effect_phi = use;
+        break;
+      case IrOpcode::kBranch:
+        if (c->branch != nullptr) return false;
+        c->branch = use;
+        break;
+      case IrOpcode::kTerminate:
+        break;
+      default:
+        return false;
+    }
+  }
+  if (c->phi == nullptr || c->effect_phi == nullptr || c->branch == nullptr) {
+    return false;
+  }
+
+  // The loop variable has to count up by one.
+  Node* const increment = NodeProperties::GetValueInput(c->phi, 1);
+  Node* add = increment;
+  if (increment->opcode() == IrOpcode::kProjection) {
+    if (ProjectionIndexOf(increment->op()) != 0) return false;
+    add = increment->InputAt(0);
+    if (add->opcode() != IrOpcode::kInt32AddWithOverflow) return false;
+    c->overflow = add;
+  } else if (increment->opcode() != IrOpcode::kInt32Add) {
+    return false;
+  }
+  Int32BinopMatcher madd(add);
+  if (madd.left().node() != c->phi || !madd.right().Is(1)) return false;
+  c->increment = increment;
+  for (Node* use : increment->uses()) {
+    if (use != c->phi && use->opcode() != IrOpcode::kStateValues &&
+        use->opcode() != IrOpcode::kTypedStateValues) {
+      return false;
+    }
+  }
+
+  // The loop condition has to be phi < bound on the true branch.
+  Node* const condition = NodeProperties::GetValueInput(c->branch, 0);
+  if (condition->opcode() != IrOpcode::kInt32LessThan &&
+      condition->opcode() != IrOpcode::kUint32LessThan) {
+    return false;
+  }
+  if (condition->InputAt(0) != c->phi || condition->UseCount() != 1) {
+    return false;
+  }
+  c->condition = condition;
+  c->bound = condition->InputAt(1);
+  if (Contains(c, c->bound)) return false;
+  Node* if_true = nullptr;
+  for (Node* use : c->branch->uses()) {
+    if (use->opcode() == IrOpcode::kIfTrue) {
+      if (!Contains(c, use)) return false;
+      if_true = use;
+    } else if (Contains(c, use)) {
+      return false;
+    }
+  }
+  if (if_true == nullptr) return false;
+
+  c->known.insert(loop_node);
+  c->known.insert(c->phi);
+  c->known.insert(c->effect_phi);
+  c->known.insert(c->branch);
+  c->known.insert(if_true);
+  c->known.insert(condition);
+  c->known.insert(increment);
+  c->known.insert(add);
+  return true;
+}
+
+bool LoopVectorizer::MatchEffects(Candidate* c) {
+  bool seen_stack_check = false;
+  Node* effect = NodeProperties::GetEffectInput(c->effect_phi, 1);
+  while (effect != c->effect_phi) {
+    switch (effect->opcode()) {
+      case IrOpcode::kLoad:
+      case IrOpcode::kStore:
+        if (AccessRepresentationOf(effect) == MachineRepresentation::kNone) {
+          return false;
+        }
+        // Deoptimizing after the stack check must not see any vectorized
+        // accesses, so all of them come after it.
+        if (seen_stack_check || c->accesses.size() == kMaxAccesses) {
+          return false;
+        }
+        c->accesses.push_back(effect);
+        c->known.insert(effect);
+        break;
+      case IrOpcode::kDeoptimizeIf: {
+        Node* const check = NodeProperties::GetValueInput(effect, 0);
+        if (c->overflow == nullptr || c->overflow_check != nullptr ||
+            check->opcode() != IrOpcode::kProjection ||
+            ProjectionIndexOf(check->op()) != 1 ||
+            check->InputAt(0) != c->overflow) {
+          return false;
+        }
+        c->overflow_check = effect;
+        c->known.insert(effect);
+        c->known.insert(check);
+        break;
+      }
+      case IrOpcode::kEffectPhi:
+        if (seen_stack_check) return false;
+        effect = MatchStackCheck(effect, c);
+        if (effect == nullptr) return false;
+        seen_stack_check = true;
+        continue;
+      default:
+        return false;
+    }
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  // An overflow check that is not on the effect chain cannot be removed.
+  if (c->overflow != nullptr && c->overflow_check == nullptr) return false;
+  std::reverse(c->accesses.begin(), c->accesses.end());
+  return !c->accesses.empty();
+}
+
+Node* LoopVectorizer::MatchStackCheck(Node* effect_phi, Candidate* c) {
+  // JSGenericLowering turns JSStackCheck into a diamond that compares the
+  // stack limit with the stack pointer and calls the StackGuard runtime
+  // function on the false side.
+  if (effect_phi->op()->EffectInputCount() != 2) return nullptr;
+  Node* const merge = NodeProperties::GetControlInput(effect_phi);
+  Node* const limit = NodeProperties::GetEffectInput(effect_phi, 0);
+  Node* const call = NodeProperties::GetEffectInput(effect_phi, 1);
+  if (limit->opcode() != IrOpcode::kLoad || call->opcode() != IrOpcode::kCall ||
+      NodeProperties::GetEffectInput(call) != limit) {
+    return nullptr;
+  }
+  ExternalReferenceMatcher mlimit(limit->InputAt(0));
+  ExternalReferenceMatcher mcall(call->InputAt(1));
+  if (!mlimit.Is(ExternalReference::address_of_stack_limit(isolate())) ||
+      !mcall.Is(ExternalReference(Runtime::kStackGuard, isolate()))) {
+    return nullptr;
+  }
+  Node* const if_false = NodeProperties::GetControlInput(call);
+  if (if_false->opcode() != IrOpcode::kIfFalse) return nullptr;
+  Node* const branch = NodeProperties::GetControlInput(if_false);
+  Node* const check = NodeProperties::GetValueInput(branch, 0);
+  if (check->InputAt(0) != limit) return nullptr;
+  Node* const if_true = NodeProperties::GetControlInput(merge, 0);
+  Node* const if_success = NodeProperties::GetControlInput(merge, 1);
+  if (if_true->opcode() != IrOpcode::kIfTrue ||
+      NodeProperties::GetControlInput(if_true) != branch) {
+    return nullptr;
+  }
+  if (if_success != if_false &&
+      (if_success->opcode() != IrOpcode::kIfSuccess ||
+       NodeProperties::GetControlInput(if_success) != call)) {
+    return nullptr;
+  }
+  for (Node* use : call->uses()) {
+    if (use->opcode() == IrOpcode::kIfException) return nullptr;
+  }
+  c->known.insert(effect_phi);
+  c->known.insert(merge);
+  c->known.insert(limit);
+  c->known.insert(call);
+  c->known.insert(if_false);
+  c->known.insert(branch);
+  c->known.insert(check);
+  c->known.insert(if_true);
+  c->known.insert(if_success);
+  return NodeProperties::GetEffectInput(limit);
+}
+
+bool LoopVectorizer::MatchAccesses(Candidate* c) {
+  bool has_store = false;
+  for (Node* access : c->accesses) {
+    MachineRepresentation const rep = AccessRepresentationOf(access);
+    if (c->rep == MachineRepresentation::kNone) c->rep = rep;
+    if (c->rep != rep) return false;
+    if (Contains(c, access->InputAt(0)) ||
+        !MatchIndex(access->InputAt(1), ElementSizeLog2Of(rep), c)) {
+      return false;
+    }
+    if (access->opcode() == IrOpcode::kLoad) {
+      c->lanes.push_back(access);
+    } else {
+      has_store = true;
+    }
+  }
+  if (!has_store) return false;
+
+  for (Node* access : c->accesses) {
+    if (access->opcode() != IrOpcode::kStore) continue;
+    Node* const value = access->InputAt(2);
+    if (Contains(c, value) && !MatchLane(value, c, 0)) return false;
+  }
+
+  // The vector loop performs the accesses of several iterations at once, so
+  // an access must not touch the elements that an earlier access of the
+  // same iteration touches in the next few iterations.
+  for (size_t i = 0; i < c->accesses.size(); ++i) {
+    for (size_t j = i + 1; j < c->accesses.size(); ++j) {
+      Node* const earlier = c->accesses[i];
+      Node* const later = c->accesses[j];
+      if (earlier->opcode() == IrOpcode::kLoad &&
+          later->opcode() == IrOpcode::kLoad) {
+        continue;
+      }
+      Node* const earlier_base = earlier->InputAt(0);
+      Node* const later_base = later->InputAt(0);
+      if (earlier_base == later_base) continue;
+      Int64Matcher mearlier(earlier_base);
+      Int64Matcher mlater(later_base);
+      if (mearlier.HasValue() && mlater.HasValue()) {
+        int64_t const distance = mlater.Value() - mearlier.Value();
+        if (distance > 0 && distance < kSimd128Size) return false;
+      } else {
+        c->alias_checks.push_back(std::make_pair(earlier, later));
+      }
+    }
+  }
+  return true;
+}
+
+bool LoopVectorizer::MatchIndex(Node* index, int element_size_log2,
+                                Candidate* c) {
+  // MemoryOptimizer::ComputeIndex for typed array elements on 64-bit.
+  if (index->opcode() != IrOpcode::kChangeUint32ToUint64) return false;
+  Node* const offset = index->InputAt(0);
+  if (offset->opcode() != IrOpcode::kWord32Shl) return false;
+  Int32BinopMatcher m(offset);
+  if (m.left().node() != c->phi || !m.right().Is(element_size_log2)) {
+    return false;
+  }
+  c->known.insert(index);
+  c->known.insert(offset);
+  return true;
+}
+
+bool LoopVectorizer::MatchLane(Node* node, Candidate* c, int depth) {
+  if (std::find(c->lanes.begin(), c->lanes.end(), node) != c->lanes.end()) {
+    return true;
+  }
+  if (depth >= kMaxDepth) return false;
+  if (c->rep == MachineRepresentation::kFloat32) {
+    // Float32 arithmetic is done in float64 and rounded right away, which
+    // gives the same result as doing it in float32.
+    if (node->opcode() != IrOpcode::kTruncateFloat64ToFloat32) return false;
+    Node* const binop = node->InputAt(0);
+    if (!IsFloat64Binop(binop) || !Contains(c, binop) ||
+        !HasOnlyValueUse(binop, node) ||
+        !MatchFloat32Operand(binop->InputAt(0), c, depth + 1) ||
+        !MatchFloat32Operand(binop->InputAt(1), c, depth + 1)) {
+      return false;
+    }
+    c->lanes.push_back(binop);
+  } else {
+    if (!IsFloat64Binop(node)) return false;
+    for (Node* input : node->inputs()) {
+      if (Contains(c, input) && !MatchLane(input, c, depth + 1)) return false;
+    }
+  }
+  c->lanes.push_back(node);
+  return true;
+}
+
+bool LoopVectorizer::MatchFloat32Operand(Node* node, Candidate* c,
+                                         int depth) {
+  if (node->opcode() == IrOpcode::kChangeFloat32ToFloat64) {
+    Node* const value = node->InputAt(0);
+    if (!Contains(c, value)) return true;
+    if (std::find(c->lanes.begin(), c->lanes.end(), node) != c->lanes.end()) {
+      return true;
+    }
+    if (!MatchLane(value, c, depth)) return false;
+    c->lanes.push_back(node);
+    return true;
+  }
+  Float64Matcher m(node);
+  return m.HasValue() && DoubleToFloat32(m.Value()) == m.Value();
+}
+
+void LoopVectorizer::Vectorize(Candidate* c) {
+  int const lanes = kSimd128Size >> ElementSizeLog2Of(c->rep);
+  Node* const entry = NodeProperties::GetControlInput(c->loop_node, 0);
+  Node* const entry_effect = NodeProperties::GetEffectInput(c->effect_phi, 0);
+  Node* const init = NodeProperties::GetValueInput(c->phi, 0);
+
+  // Skip to the scalar loop if accesses might overlap.
+  Node* control = entry;
+  Node* skip = nullptr;
+  if (!c->alias_checks.empty()) {
+    Node* check = nullptr;
+    for (auto const& pair : c->alias_checks) {
+      // The distance between the bases must not be in [1, kSimd128Size).
+      Node* distance = graph()->NewNode(machine()->Int64Sub(),
+                                        pair.second->InputAt(0),
+                                        pair.first->InputAt(0));
+      distance = graph()->NewNode(machine()->Int64Sub(), distance,
+                                  jsgraph()->Int64Constant(1));
+      Node* const disjoint = graph()->NewNode(
+          machine()->Uint64LessThanOrEqual(),
+          jsgraph()->Int64Constant(kSimd128Size - 1), distance);
+      check = (check == nullptr)
+                  ? disjoint
+                  : graph()->NewNode(machine()->Word32And(), check, disjoint);
+    }
+    Node* const branch =
+        graph()->NewNode(common()->Branch(BranchHint::kTrue), check, entry);
+    control = graph()->NewNode(common()->IfTrue(), branch);
+    skip = graph()->NewNode(common()->IfFalse(), branch);
+  }
+
+  // Copy the loop, sharing all nodes defined outside of it.
+  for (Node* node : loop_tree_->LoopNodes(c->loop)) {
+    c->copies.insert(std::make_pair(node, graph()->CloneNode(node)));
+  }
+  for (Node* node : loop_tree_->LoopNodes(c->loop)) {
+    Node* const copy = Copy(node, c);
+    for (int i = 0; i < copy->InputCount(); ++i) {
+      copy->ReplaceInput(i, Copy(node->InputAt(i), c));
+    }
+  }
+  Node* const loop_node = Copy(c->loop_node, c);
+  Node* const phi = Copy(c->phi, c);
+  Node* const effect_phi = Copy(c->effect_phi, c);
+  Node* const branch = Copy(c->branch, c);
+  loop_node->ReplaceInput(0, control);
+
+  // Step over all lanes at once. The loop condition below already rules out
+  // an overflow, so the check for it is dropped.
+  Node* const increment = graph()->NewNode(machine()->Int32Add(), phi,
+                                           jsgraph()->Int32Constant(lanes));
+  Copy(c->increment, c)->ReplaceUses(increment);
+  Copy(c->increment, c)->Kill();
+  if (c->overflow != nullptr) {
+    Node* const check = Copy(c->overflow_check, c);
+    NodeProperties::ReplaceUses(check, nullptr,
+                                NodeProperties::GetEffectInput(check),
+                                NodeProperties::GetControlInput(check));
+    Node* const projection = check->InputAt(0);
+    check->Kill();
+    projection->Kill();
+    Copy(c->overflow, c)->Kill();
+  }
+
+  // Continue while the last lane is below the bound, computed in 64 bits so
+  // that it cannot overflow.
+  bool const is_signed = c->condition->opcode() == IrOpcode::kInt32LessThan;
+  const Operator* const extend = is_signed ? machine()->ChangeInt32ToInt64()
+                                           : machine()->ChangeUint32ToUint64();
+  Node* const last =
+      graph()->NewNode(machine()->Int64Add(), graph()->NewNode(extend, phi),
+                       jsgraph()->Int64Constant(lanes - 1));
+  Node* const condition = graph()->NewNode(
+      is_signed ? machine()->Int64LessThan() : machine()->Uint64LessThan(),
+      last, graph()->NewNode(extend, c->bound));
+  Node* const old_condition = Copy(c->condition, c);
+  branch->ReplaceInput(0, condition);
+  old_condition->Kill();
+
+  // Turn the accesses and the arithmetic into vector operations.
+  for (Node* access : c->accesses) {
+    Node* const copy = Copy(access, c);
+    if (access->opcode() == IrOpcode::kLoad) {
+      NodeProperties::ChangeOp(copy, machine()->Load(MachineType::Simd128()));
+    } else {
+      copy->ReplaceInput(2, VectorValue(access->InputAt(2), c));
+      NodeProperties::ChangeOp(
+          copy, machine()->Store(StoreRepresentation(
+                    MachineRepresentation::kSimd128, kNoWriteBarrier)));
+    }
+  }
+  for (Node* lane : c->lanes) {
+    if (!IsFloat64Binop(lane)) continue;
+    Node* const copy = Copy(lane, c);
+    copy->ReplaceInput(0, VectorOperand(lane->InputAt(0), c));
+    copy->ReplaceInput(1, VectorOperand(lane->InputAt(1), c));
+    NodeProperties::ChangeOp(copy, VectorOperatorFor(lane, c->rep));
+  }
+  // The conversions between float32 and float64 are not needed anymore.
+  for (Node* lane : c->lanes) {
+    if (lane->opcode() == IrOpcode::kChangeFloat32ToFloat64) {
+      Copy(lane, c)->Kill();
+    }
+  }
+  for (Node* lane : c->lanes) {
+    if (lane->opcode() == IrOpcode::kTruncateFloat64ToFloat32) {
+      Copy(lane, c)->Kill();
+    }
+  }
+
+  // The original loop finishes the remaining iterations.
+  Node* exit = graph()->NewNode(common()->IfFalse(), branch);
+  Node* exit_value = phi;
+  Node* exit_effect = effect_phi;
+  if (skip != nullptr) {
+    exit = graph()->NewNode(common()->Merge(2), exit, skip);
+    exit_value = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kWord32, 2), phi, init, exit);
+    exit_effect = graph()->NewNode(common()->EffectPhi(2), effect_phi,
+                                   entry_effect, exit);
+  }
+  c->loop_node->ReplaceInput(0, exit);
+  c->phi->ReplaceInput(0, exit_value);
+  c->effect_phi->ReplaceInput(0, exit_effect);
+
+  Node* const terminate =
+      graph()->NewNode(common()->Terminate(), effect_phi, loop_node);
+  NodeProperties::MergeControlToEnd(graph(), common(), terminate);
+}
+
+Node* LoopVectorizer::Copy(Node* node, Candidate* c) {
+  auto it = c->copies.find(node);
+  return it == c->copies.end() ? node : it->second;
+}
+
+Node* LoopVectorizer::Vectorized(Node* node, Candidate* c) {
+  if (node->opcode() == IrOpcode::kTruncateFloat64ToFloat32) {
+    node = node->InputAt(0);
+  }
+  return Copy(node, c);
+}
+
+Node* LoopVectorizer::VectorOperand(Node* node, Candidate* c) {
+  if (c->rep == MachineRepresentation::kFloat32) {
+    if (node->opcode() == IrOpcode::kChangeFloat32ToFloat64) {
+      return VectorValue(node->InputAt(0), c);
+    }
+    Float64Matcher m(node);
+    DCHECK(m.HasValue());
+    return Splat(jsgraph()->Float32Constant(DoubleToFloat32(m.Value())),
+                 c->rep);
+  }
+  return VectorValue(node, c);
+}
+
+Node* LoopVectorizer::VectorValue(Node* node, Candidate* c) {
+  return Contains(c, node) ? Vectorized(node, c) : Splat(node, c->rep);
+}
+
+Node* LoopVectorizer::Splat(Node* node, MachineRepresentation rep) {
+  return graph()->NewNode(rep == MachineRepresentation::kFloat32
+                              ? machine()->Float32x4Splat()
+                              : machine()->Float64x2Splat(),
+                          node);
+}
+
+const Operator* LoopVectorizer::VectorOperatorFor(Node* node,
+                                                  MachineRepresentation rep) {
+  bool const is_float32 = rep == MachineRepresentation::kFloat32;
+  switch (node->opcode()) {
+    case IrOpcode::kFloat64Add:
+      return is_float32 ? machine()->Float32x4Add() : machine()->Float64x2Add();
+    case IrOpcode::kFloat64Sub:
+      return is_float32 ? machine()->Float32x4Sub() : machine()->Float64x2Sub();
+    case IrOpcode::kFloat64Mul:
+      return is_float32 ? machine()->Float32x4Mul() : machine()->Float64x2Mul();
+    case IrOpcode::kFloat64Div:
+      return is_float32 ? machine()->Float32x4Div() : machine()->Float64x2Div();
+    default:
+      break;
+  }
+  UNREACHABLE();
+  return nullptr;
+}
+
+bool LoopVectorizer::Contains(Candidate* c, Node* node) {
+  return loop_tree_->Contains(c->loop, node);
+}
+
+Graph* LoopVectorizer::graph() const { return jsgraph_->graph(); }
+
+Isolate* LoopVectorizer::isolate() const { return jsgraph_->isolate(); }
+
+CommonOperatorBuilder* LoopVectorizer::common() const {
+  return jsgraph_->common();
+}
+
+MachineOperatorBuilder* LoopVectorizer::machine() const {
+  return jsgraph_->machine();
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,99 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_VECTORIZER_H_
+#define V8_COMPILER_LOOP_VECTORIZER_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/machine-type.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Forward declarations.
+class CommonOperatorBuilder;
+class JSGraph;
+class MachineOperatorBuilder;
+
+// Vectorizes counted loops over Float32Array and Float64Array elements.
+//
+// Runs on the machine level graph after memory optimization, where element
+// accesses to constant typed arrays are plain Load and Store nodes. An
+// innermost loop
+//
+//   for (i = init; i < n; i++) { <stack check> a[i] = b[i] op c[i]; ... }
+//
+// whose only loop variable is {i}, whose only side effects apart from the
+// stack check are float loads and stores of one representation at element
+// {i}, and whose values are element-wise additions, subtractions,
+// multiplications and divisions of those loads and loop invariant values is
+// preceded by a copy that processes 128 bits per iteration as long as that
+// many elements are left. The original loop is kept as the scalar epilogue
+// for the remaining elements. If the arrays might overlap in a way that the
+// vector loop would observe, a guard in front of it skips right to the
+// scalar loop. The vector loop only deoptimizes lazily after its stack
+// check, which precedes all of its memory accesses, so the copied frame
+// state still describes the scalar loop at the start of the iteration.
+class LoopVectorizer final {
+ public:
+  LoopVectorizer(JSGraph* jsgraph, Zone* zone);
+
+  void Run();
+
+ private:
+  typedef LoopTree::Loop Loop;
+  struct Candidate;
+
+  // Returns true if {c}'s loop can be vectorized and fills in {c}.
+  bool Analyze(Candidate* c);
+  bool MatchHeader(Candidate* c);
+  bool MatchEffects(Candidate* c);
+  bool MatchAccesses(Candidate* c);
+
+  // Matches the lowered JSStackCheck that ends in {effect_phi} and returns
+  // the effect before it, or nullptr if {effect_phi} is something else.
+  Node* MatchStackCheck(Node* effect_phi, Candidate* c);
+
+  // Returns true if {index} is the byte offset of element {i}.
+  bool MatchIndex(Node* index, int element_size_log2, Candidate* c);
+
+  // Returns true if {node} computes one element of a vector in the loop.
+  bool MatchLane(Node* node, Candidate* c, int depth);
+  bool MatchFloat32Operand(Node* node, Candidate* c, int depth);
+
+  void Vectorize(Candidate* c);
+
+  // Returns the copy of {node} in the vector loop, or {node} itself if it is
+  // defined outside of the loop.
+  Node* Copy(Node* node, Candidate* c);
+
+  // Returns the vector computing the lanes {node}, {node}'s float64 operand
+  // or the store value {node} in the vector loop.
+  Node* Vectorized(Node* node, Candidate* c);
+  Node* VectorOperand(Node* node, Candidate* c);
+  Node* VectorValue(Node* node, Candidate* c);
+  Node* Splat(Node* node, MachineRepresentation rep);
+  const Operator* VectorOperatorFor(Node* node, MachineRepresentation rep);
+
+  bool Contains(Candidate* c, Node* node);
+
+  Graph* graph() const;
+  Isolate* isolate() const;
+  CommonOperatorBuilder* common() const;
+  MachineOperatorBuilder* machine() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+  Zone* zone() const { return zone_; }
+
+  JSGraph* const jsgraph_;
+  Zone* const zone_;
+  LoopTree* loop_tree_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_VECTORIZER_H_
@@ -215,6 +215,12 @@ MachineRepresentation AtomicStoreRepresentationOf(Operator const* op) {
   V(Float32x4Shuffle, Operator::kNoProperties, 6, 0, 1)                       \
   V(Float32x4FromInt32x4, Operator::kNoProperties, 1, 0, 1)                   \
   V(Float32x4FromUint32x4, Operator::kNoProperties, 1, 0, 1)                  \
+  V(Float32x4Splat, Operator::kNoProperties, 1, 0, 1)                         \
+  V(Float64x2Splat, Operator::kNoProperties, 1, 0, 1)                         \
+  V(Float64x2Add, Operator::kCommutative, 2, 0, 1)                            \
+  V(Float64x2Sub, Operator::kNoProperties, 2, 0, 1)                           \
+  V(Float64x2Mul, Operator::kCommutative, 2, 0, 1)                            \
+  V(Float64x2Div, Operator::kNoProperties, 2, 0, 1)                           \
   V(CreateInt32x4, Operator::kNoProperties, 4, 0, 1)                          \
   V(Int32x4ExtractLane, Operator::kNoProperties, 2, 0, 1)                     \
   V(Int32x4ReplaceLane, Operator::kNoProperties, 3, 0, 1)                     \
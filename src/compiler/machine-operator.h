@@ -115,6 +115,7 @@ class MachineOperatorBuilder final : public ZoneObject {
     kWord64ReverseBits = 1u << 21,
     kFloat32Neg = 1u << 22,
     kFloat64Neg = 1u << 23,
+    kSimd128FloatArithmetic = 1u << 24,
     kAllOptionalOps =
         kFloat32Max | kFloat32Min | kFloat64Max | kFloat64Min |
         kFloat32RoundDown | kFloat64RoundDown | kFloat32RoundUp |
@@ -213,6 +214,11 @@ class MachineOperatorBuilder final : public ZoneObject {
   const OptionalOperator Word32ReverseBits();
   const OptionalOperator Word64ReverseBits();
   bool Word32ShiftIsSafe() const { return flags_ & kWord32ShiftIsSafe; }
+  // Returns true if Load and Store of Simd128 values as well as the Float32x4
+  // and Float64x2 Splat, Add, Sub, Mul and Div operators are supported.
+  bool HasSimd128FloatArithmetic() const {
+    return flags_ & kSimd128FloatArithmetic;
+  }
 
   const Operator* Word64And();
   const Operator* Word64Or();
@@ -428,6 +434,13 @@ class MachineOperatorBuilder final : public ZoneObject {
   const Operator* Float32x4Shuffle();
   const Operator* Float32x4FromInt32x4();
   const Operator* Float32x4FromUint32x4();
+  const Operator* Float32x4Splat();
+
+  const Operator* Float64x2Splat();
+  const Operator* Float64x2Add();
+  const Operator* Float64x2Sub();
+  const Operator* Float64x2Mul();
+  const Operator* Float64x2Div();
 
   const Operator* CreateInt32x4();
   const Operator* Int32x4ExtractLane();
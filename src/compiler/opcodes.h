@@ -450,6 +450,12 @@
   V(Float32x4Shuffle)                       \
   V(Float32x4FromInt32x4)                   \
   V(Float32x4FromUint32x4)                  \
+  V(Float32x4Splat)                         \
+  V(Float64x2Splat)                         \
+  V(Float64x2Add)                           \
+  V(Float64x2Sub)                           \
+  V(Float64x2Mul)                           \
+  V(Float64x2Div)                           \
   V(CreateInt32x4)                          \
   V(Int32x4ReplaceLane)                     \
   V(Int32x4Neg)                             \
@@ -603,6 +609,20 @@
   V(Simd128Xor)                         \
   V(Simd128Not)
 
+// The subset of SIMD operators that instruction selection supports if the
+// MachineOperatorBuilder::kSimd128FloatArithmetic flag is set.
+#define MACHINE_SIMD_FLOAT_ARITHMETIC_OP_LIST(V) \
+  V(Float32x4Splat)                              \
+  V(Float32x4Add)                                \
+  V(Float32x4Sub)                                \
+  V(Float32x4Mul)                                \
+  V(Float32x4Div)                                \
+  V(Float64x2Splat)                              \
+  V(Float64x2Add)                                \
+  V(Float64x2Sub)                                \
+  V(Float64x2Mul)                                \
+  V(Float64x2Div)
+
 #define MACHINE_SIMD_OP_LIST(V)       \
   MACHINE_SIMD_RETURN_SIMD_OP_LIST(V) \
   MACHINE_SIMD_RETURN_NUM_OP_LIST(V)  \
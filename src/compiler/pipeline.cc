@@ -43,7 +43,10 @@
 #include "src/compiler/live-range-separator.h"
 #include "src/compiler/load-elimination.h"
 #include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-invariant-code-motion.h"
 #include "src/compiler/loop-peeling.h"
+#include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/loop-vectorizer.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/memory-optimizer.h"
 #include "src/compiler/move-optimizer.h"
@@ -66,6 +69,7 @@
 #include "src/compiler/verifier.h"
 #include "src/compiler/zone-pool.h"
 #include "src/isolate-inl.h"
+#include "src/optimizing-compile-dispatcher.h"
 #include "src/ostreams.h"
 #include "src/parsing/parser.h"
 #include "src/register-configuration.h"
@@ -92,7 +96,11 @@ class PipelineData {
         instruction_zone_scope_(zone_pool_),
         instruction_zone_(instruction_zone_scope_.zone()),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_),
+        profiler_ticks_(info_->has_shared_info()
+                            ? info_->shared_info()->profiler_ticks()
+                            : 0) {
     PhaseScope scope(pipeline_statistics, "init pipeline data");
     graph_ = new (graph_zone_) Graph(graph_zone_);
     source_positions_ = new (graph_zone_) SourcePositionTable(graph_);
@@ -119,7 +127,8 @@ class PipelineData {
         instruction_zone_scope_(zone_pool_),
         instruction_zone_(instruction_zone_scope_.zone()),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {}
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_) {}
 
   // For machine graph testing entry point.
   PipelineData(ZonePool* zone_pool, CompilationInfo* info, Graph* graph,
@@ -135,7 +144,8 @@ class PipelineData {
         instruction_zone_scope_(zone_pool_),
         instruction_zone_(instruction_zone_scope_.zone()),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {}
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_) {}
 
   // For register allocation testing entry point.
   PipelineData(ZonePool* zone_pool, CompilationInfo* info,
@@ -149,7 +159,8 @@ class PipelineData {
         instruction_zone_(sequence->zone()),
         sequence_(sequence),
         register_allocation_zone_scope_(zone_pool_),
-        register_allocation_zone_(register_allocation_zone_scope_.zone()) {}
+        register_allocation_zone_(register_allocation_zone_scope_.zone()),
+        fp_register_allocation_zone_scope_(zone_pool_) {}
 
   ~PipelineData() {
     DeleteRegisterAllocationZone();
@@ -162,6 +173,9 @@ class PipelineData {
   ZonePool* zone_pool() const { return zone_pool_; }
   PipelineStatistics* pipeline_statistics() { return pipeline_statistics_; }
   bool compilation_failed() const { return compilation_failed_; }
+  // The profiler ticks of the function when the compilation started, which
+  // can't be read from the concurrent recompilation thread.
+  int profiler_ticks() const { return profiler_ticks_; }
   void set_compilation_failed() { compilation_failed_ = true; }
   Handle<Code> code() { return code_; }
   void set_code(Handle<Code> code) {
@@ -253,6 +267,7 @@ class PipelineData {
   void DeleteRegisterAllocationZone() {
     if (register_allocation_zone_ == nullptr) return;
     register_allocation_zone_scope_.Destroy();
+    fp_register_allocation_zone_scope_.Destroy();
     register_allocation_zone_ = nullptr;
     register_allocation_data_ = nullptr;
   }
@@ -289,6 +304,14 @@ class PipelineData {
                                sequence(), debug_name_.get());
   }
 
+  // Gives the floating point register allocator a zone of its own, so that
+  // it can run concurrently with the general register allocator.
+  void InitializeParallelRegisterAllocation() {
+    DCHECK_NOT_NULL(register_allocation_data_);
+    register_allocation_data_->set_fp_allocation_zone(
+        fp_register_allocation_zone_scope_.zone());
+  }
+
   void BeginPhaseKind(const char* phase_kind_name) {
     if (pipeline_statistics() != nullptr) {
       pipeline_statistics()->BeginPhaseKind(phase_kind_name);
@@ -341,6 +364,12 @@ class PipelineData {
   ZonePool::Scope register_allocation_zone_scope_;
   Zone* register_allocation_zone_;
   RegisterAllocationData* register_allocation_data_ = nullptr;
+  // Zone for the data structures created by the floating point register
+  // allocator if it runs in parallel to the general register allocator.
+  // Destroyed together with register_allocation_zone_.
+  ZonePool::Scope fp_register_allocation_zone_scope_;
+
+  int const profiler_ticks_ = 0;
 
   // Basic block profiling support.
   BasicBlockProfiler::Data* profiler_data_ = nullptr;
@@ -385,6 +414,13 @@ class PipelineImpl final {
   bool ScheduleAndSelectInstructions(Linkage* linkage);
   void RunPrintAndVerify(const char* phase, bool untyped = false);
   Handle<Code> ScheduleAndGenerateCode(CallDescriptor* call_descriptor);
+  // Returns true if general and floating point registers should be allocated
+  // in parallel.
+  bool ShouldAllocateRegistersInParallel();
+  // Returns true if the function is hot and small enough to be worth the
+  // compile time of the greedy register allocator.
+  bool ShouldUseGreedyAllocator();
+
   void AllocateRegisters(const RegisterConfiguration* config,
                          CallDescriptor* descriptor, bool run_verifier);
 
@@ -601,7 +637,10 @@ PipelineCompilationJob::Status PipelineCompilationJob::CreateGraphImpl() {
     info()->MarkAsDeoptimizationEnabled();
   }
   if (!info()->is_optimizing_from_bytecode()) {
-    if (info()->is_deoptimization_enabled() && FLAG_turbo_type_feedback) {
+    // Functions that keep deoptimizing are compiled without speculating on
+    // their type feedback, trading peak performance for stable code.
+    if (info()->is_deoptimization_enabled() && FLAG_turbo_type_feedback &&
+        info()->shared_info()->deopt_count() < FLAG_deopt_storm_threshold) {
       info()->MarkAsTypeFeedbackEnabled();
     }
     if (!Compiler::EnsureDeoptimizationSupport(info())) return FAILED;
@@ -920,6 +959,29 @@ struct TypedLoweringPhase {
 };
 
 
+struct LoopVariableOptimizationPhase {
+  static const char* phase_name() { return "loop variable optimization"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    JSGraphReducer graph_reducer(data->jsgraph(), temp_zone);
+    LoopVariableOptimizer loop_variable_optimizer(&graph_reducer,
+                                                  data->jsgraph());
+    AddReducer(data, &graph_reducer, &loop_variable_optimizer);
+    graph_reducer.ReduceGraph();
+  }
+};
+
+
+struct LoopInvariantCodeMotionPhase {
+  static const char* phase_name() { return "loop invariant code motion"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopInvariantCodeMotion licm(data->jsgraph(), temp_zone);
+    licm.Run();
+  }
+};
+
+
 struct BranchEliminationPhase {
   static const char* phase_name() { return "branch condition elimination"; }
 
@@ -1057,6 +1119,15 @@ struct MemoryOptimizationPhase {
   }
 };
 
+struct LoopVectorizationPhase {
+  static const char* phase_name() { return "loop vectorization"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopVectorizer vectorizer(data->jsgraph(), temp_zone);
+    vectorizer.Run();
+  }
+};
+
 struct LateOptimizationPhase {
   static const char* phase_name() { return "late optimization"; }
 
@@ -1213,6 +1284,41 @@ struct AllocateFPRegistersPhase {
 };
 
 
+template <typename RegAllocator>
+class AllocateRegistersSubJob final : public CompilationSubJob {
+ public:
+  explicit AllocateRegistersSubJob(RegAllocator* allocator)
+      : allocator_(allocator) {}
+
+  void Run() final { allocator_->AllocateRegisters(); }
+
+ private:
+  RegAllocator* const allocator_;
+};
+
+// General and floating point registers are allocated for disjoint sets of
+// live ranges, and the floating point allocator has a zone of its own, see
+// PipelineData::InitializeParallelRegisterAllocation, so the two allocators
+// can run in parallel.
+template <typename RegAllocator>
+struct AllocateRegistersInParallelPhase {
+  static const char* phase_name() { return "allocate registers in parallel"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    ZonePool::Scope fp_zone_scope(data->zone_pool());
+    RegAllocator general_allocator(data->register_allocation_data(),
+                                   GENERAL_REGISTERS, temp_zone);
+    RegAllocator fp_allocator(data->register_allocation_data(), FP_REGISTERS,
+                              fp_zone_scope.zone());
+    AllocateRegistersSubJob<RegAllocator> general_job(&general_allocator);
+    AllocateRegistersSubJob<RegAllocator> fp_job(&fp_allocator);
+    CompilationSubJob* sub_jobs[] = {&general_job, &fp_job};
+    data->isolate()->optimizing_compile_dispatcher()->RunSubJobs(
+        sub_jobs, arraysize(sub_jobs));
+  }
+};
+
+
 struct MergeSplintersPhase {
   static const char* phase_name() { return "merge splintered ranges"; }
   void Run(PipelineData* pipeline_data, Zone* temp_zone) {
@@ -1435,6 +1541,16 @@ bool PipelineImpl::CreateGraph() {
     Run<TypedLoweringPhase>();
     RunPrintAndVerify("Lowered typed");
 
+    if (FLAG_turbo_loop_variable) {
+      Run<LoopVariableOptimizationPhase>();
+      RunPrintAndVerify("Loop variables optimized");
+    }
+
+    if (FLAG_turbo_licm) {
+      Run<LoopInvariantCodeMotionPhase>();
+      RunPrintAndVerify("Loop invariant code moved");
+    }
+
     if (FLAG_turbo_stress_loop_peeling) {
       Run<StressLoopPeelingPhase>();
       RunPrintAndVerify("Loop peeled");
@@ -1503,6 +1619,14 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   // TODO(jarin, rossberg): Remove UNTYPED once machine typing works.
   RunPrintAndVerify("Memory optimized", true);
 
+  // Vectorize loops over typed arrays.
+  if (FLAG_turbo_loop_vectorization && data->machine()->Is64() &&
+      data->machine()->HasSimd128FloatArithmetic()) {
+    Run<LoopVectorizationPhase>();
+    // TODO(jarin, rossberg): Remove UNTYPED once machine typing works.
+    RunPrintAndVerify("Loops vectorized", true);
+  }
+
   // Lower changes that have been inserted before.
   Run<LateOptimizationPhase>();
   // TODO(jarin, rossberg): Remove UNTYPED once machine typing works.
@@ -1765,6 +1889,8 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
 #endif
 
   data->InitializeRegisterAllocationData(config, descriptor);
+  bool const allocate_in_parallel = ShouldAllocateRegistersInParallel();
+  if (allocate_in_parallel) data->InitializeParallelRegisterAllocation();
   if (info()->is_osr()) {
     OsrHelper osr_helper(info());
     osr_helper.SetupFrame(data->frame());
@@ -1789,8 +1915,23 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
     Run<SplinterLiveRangesPhase>();
   }
 
-  Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
-  Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+  if (ShouldUseGreedyAllocator()) {
+    if (!kSimpleFPAliasing) {
+      // The greedy allocator does not handle aliased floating point registers.
+      Run<AllocateGeneralRegistersPhase<GreedyAllocator>>();
+      Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+    } else if (allocate_in_parallel) {
+      Run<AllocateRegistersInParallelPhase<GreedyAllocator>>();
+    } else {
+      Run<AllocateGeneralRegistersPhase<GreedyAllocator>>();
+      Run<AllocateFPRegistersPhase<GreedyAllocator>>();
+    }
+  } else if (allocate_in_parallel) {
+    Run<AllocateRegistersInParallelPhase<LinearScanAllocator>>();
+  } else {
+    Run<AllocateGeneralRegistersPhase<LinearScanAllocator>>();
+    Run<AllocateFPRegistersPhase<LinearScanAllocator>>();
+  }
 
   if (FLAG_turbo_preprocess_ranges) {
     Run<MergeSplintersPhase>();
@@ -1829,6 +1970,31 @@ void PipelineImpl::AllocateRegisters(const RegisterConfiguration* config,
   data->DeleteRegisterAllocationZone();
 }
 
+bool PipelineImpl::ShouldAllocateRegistersInParallel() {
+  if (!FLAG_turbo_parallel_register_allocation || FLAG_trace_alloc) {
+    return false;
+  }
+  if (!isolate()->concurrent_recompilation_enabled()) return false;
+  // Only worth it if both allocators have a substantial amount of work.
+  InstructionSequence* sequence = data_->sequence();
+  int fp_count = 0;
+  for (int vreg = 0; vreg < sequence->VirtualRegisterCount(); ++vreg) {
+    if (sequence->IsFP(vreg)) ++fp_count;
+  }
+  int general_count = sequence->VirtualRegisterCount() - fp_count;
+  return fp_count >= FLAG_turbo_parallel_register_allocation_min_ranges &&
+         general_count >= FLAG_turbo_parallel_register_allocation_min_ranges;
+}
+
+bool PipelineImpl::ShouldUseGreedyAllocator() {
+  if (!FLAG_turbo_greedy_regalloc) return false;
+  if (data_->profiler_ticks() < FLAG_turbo_greedy_regalloc_min_ticks) {
+    return false;
+  }
+  return data_->sequence()->instructions().size() <=
+         static_cast<size_t>(FLAG_turbo_greedy_regalloc_max_instructions);
+}
+
 CompilationInfo* PipelineImpl::info() const { return data_->info(); }
 
 Isolate* PipelineImpl::isolate() const { return info()->isolate(); }
@@ -1268,7 +1268,7 @@ bool SpillRange::TryMerge(SpillRange* other) {
   if (HasSlot() || other->HasSlot()) return false;
   // TODO(dcarney): byte widths should be compared here not kinds.
   if (live_ranges_[0]->kind() != other->live_ranges_[0]->kind() ||
-      IsIntersectingWith(other)) {
+      byte_width() != other->byte_width() || IsIntersectingWith(other)) {
     return false;
   }
 
@@ -1360,6 +1360,7 @@ RegisterAllocationData::RegisterAllocationData(
     const RegisterConfiguration* config, Zone* zone, Frame* frame,
     InstructionSequence* code, const char* debug_name)
     : allocation_zone_(zone),
+      fp_allocation_zone_(zone),
       frame_(frame),
       code_(code),
       debug_name_(debug_name),
@@ -1526,7 +1527,8 @@ SpillRange* RegisterAllocationData::AssignSpillRangeToLiveRange(
   SpillRange* spill_range = range->GetAllocatedSpillRange();
   if (spill_range == nullptr) {
     DCHECK(!range->IsSplinter());
-    spill_range = new (allocation_zone()) SpillRange(range, allocation_zone());
+    Zone* zone = allocation_zone(range->kind());
+    spill_range = new (zone) SpillRange(range, zone);
   }
   range->set_spill_type(TopLevelLiveRange::SpillType::kSpillRange);
 
@@ -1543,8 +1545,8 @@ SpillRange* RegisterAllocationData::CreateSpillRangeForLiveRange(
     TopLevelLiveRange* range) {
   DCHECK(!range->HasSpillOperand());
   DCHECK(!range->IsSplinter());
-  SpillRange* spill_range =
-      new (allocation_zone()) SpillRange(range, allocation_zone());
+  Zone* zone = allocation_zone(range->kind());
+  SpillRange* spill_range = new (zone) SpillRange(range, zone);
   return spill_range;
 }
 
@@ -1565,6 +1567,7 @@ void RegisterAllocationData::MarkAllocated(MachineRepresentation rep,
       }
       break;
     case MachineRepresentation::kFloat64:
+    case MachineRepresentation::kSimd128:
       assigned_double_registers_->Add(index);
       break;
     default:
@@ -3261,6 +3264,284 @@ void LinearScanAllocator::SpillBetweenUntil(LiveRange* range,
 }
 
 
+const float GreedyAllocator::kMaxWeight = std::numeric_limits<float>::max();
+
+
+GreedyAllocator::GreedyAllocator(RegisterAllocationData* data,
+                                 RegisterKind kind, Zone* local_zone)
+    : RegisterAllocator(data, kind),
+      local_zone_(local_zone),
+      queue_(local_zone),
+      allocations_(num_registers(), ZoneVector<LiveRange*>(local_zone),
+                   local_zone),
+      evicted_(local_zone),
+      loop_depths_(code()->InstructionBlockCount(), 0, local_zone) {
+  // Loop headers precede their loop bodies in RPO, and the loop_header of a
+  // loop header is the enclosing loop.
+  for (const InstructionBlock* block : code()->instruction_blocks()) {
+    const InstructionBlock* header =
+        block->IsLoopHeader() ? block : GetContainingLoop(code(), block);
+    if (header == nullptr) continue;
+    int depth = 1;
+    const InstructionBlock* outer = GetContainingLoop(code(), header);
+    if (outer != nullptr) depth += LoopDepth(outer);
+    loop_depths_[block->rpo_number().ToSize()] = depth;
+  }
+}
+
+
+void GreedyAllocator::AllocateRegisters() {
+  SplitAndSpillRangesDefinedByMemoryOperand(code()->VirtualRegisterCount() <=
+                                            num_allocatable_registers());
+
+  if (mode() == GENERAL_REGISTERS) {
+    for (TopLevelLiveRange* fixed : data()->fixed_live_ranges()) {
+      if (fixed != nullptr) {
+        allocations_[fixed->assigned_register()].push_back(fixed);
+      }
+    }
+  } else {
+    DCHECK(kSimpleFPAliasing);
+    for (TopLevelLiveRange* fixed : data()->fixed_float_live_ranges()) {
+      if (fixed != nullptr) {
+        allocations_[fixed->assigned_register()].push_back(fixed);
+      }
+    }
+    for (TopLevelLiveRange* fixed : data()->fixed_double_live_ranges()) {
+      if (fixed != nullptr) {
+        allocations_[fixed->assigned_register()].push_back(fixed);
+      }
+    }
+  }
+
+  for (TopLevelLiveRange* range : data()->live_ranges()) {
+    if (!CanProcessRange(range)) continue;
+    for (LiveRange* child = range; child != nullptr; child = child->next()) {
+      if (!child->spilled()) Enqueue(child);
+    }
+  }
+
+  while (!queue_.empty()) {
+    LiveRange* range = queue_.top().range;
+    queue_.pop();
+    TryAllocateRange(range);
+  }
+
+  for (ZoneVector<LiveRange*>& allocated : allocations_) {
+    for (LiveRange* range : allocated) {
+      if (range->TopLevel()->IsFixed()) continue;
+      int reg = range->assigned_register();
+      data()->MarkAllocated(range->representation(), reg);
+      if (range->IsTopLevel() && range->TopLevel()->is_phi()) {
+        data()->GetPhiMapValueFor(range->TopLevel())->set_assigned_register(
+            reg);
+      }
+    }
+  }
+}
+
+
+void GreedyAllocator::Enqueue(LiveRange* range) {
+  DCHECK(!range->IsEmpty() && !range->spilled());
+  QueueEntry entry = {range->End().value() - range->Start().value(), range};
+  queue_.push(entry);
+}
+
+
+void GreedyAllocator::TryAllocateRange(LiveRange* range) {
+  DCHECK(!range->HasRegisterAssigned() && !range->spilled());
+  TRACE("Processing interval %d:%d start=%d\n", range->TopLevel()->vreg(),
+        range->relative_id(), range->Start().value());
+
+  int hint_register;
+  if (range->FirstHintPosition(&hint_register) != nullptr &&
+      !HasConflict(range, hint_register)) {
+    AssignRegister(range, hint_register);
+    return;
+  }
+
+  const int* codes = allocatable_register_codes();
+  for (int i = 0; i < num_allocatable_registers(); ++i) {
+    if (!HasConflict(range, codes[i])) {
+      AssignRegister(range, codes[i]);
+      return;
+    }
+  }
+
+  if (evicted_.find(range) == evicted_.end()) {
+    // Pick the register whose conflicting ranges are cheapest to evict.
+    float weight = SpillWeight(range);
+    int best_reg = kUnassignedRegister;
+    float best_weight = weight;
+    for (int i = 0; i < num_allocatable_registers(); ++i) {
+      float conflict_weight = MaxConflictWeight(range, codes[i]);
+      if (conflict_weight < best_weight) {
+        best_weight = conflict_weight;
+        best_reg = codes[i];
+      }
+    }
+    if (best_reg != kUnassignedRegister) {
+      EvictAndAssignRegister(range, best_reg);
+      return;
+    }
+  }
+
+  SplitOrSpillBlockedRange(range);
+}
+
+
+void GreedyAllocator::AssignRegister(LiveRange* range, int reg) {
+  TRACE("Assigning register %s to live range %d:%d\n", RegisterName(reg),
+        range->TopLevel()->vreg(), range->relative_id());
+  range->set_assigned_register(reg);
+  range->SetUseHints(reg);
+  allocations_[reg].push_back(range);
+}
+
+
+void GreedyAllocator::EvictAndAssignRegister(LiveRange* range, int reg) {
+  ZoneVector<LiveRange*>& allocated = allocations_[reg];
+  for (size_t i = 0; i < allocated.size(); ++i) {
+    LiveRange* conflict = allocated[i];
+    if (!range->FirstIntersection(conflict).IsValid()) continue;
+    DCHECK(!conflict->TopLevel()->IsFixed());
+    TRACE("Evicting live range %d:%d from register %s\n",
+          conflict->TopLevel()->vreg(), conflict->relative_id(),
+          RegisterName(reg));
+    conflict->UnsetAssignedRegister();
+    conflict->UnsetUseHints();
+    evicted_.insert(conflict);
+    Enqueue(conflict);
+    allocated.erase(allocated.begin() + i);
+    --i;
+  }
+  AssignRegister(range, reg);
+}
+
+
+void GreedyAllocator::SplitOrSpillBlockedRange(LiveRange* range) {
+  UsePosition* register_use = range->NextRegisterPosition(range->Start());
+  if (register_use == nullptr) {
+    // Nothing in the range requires a register.
+    Spill(range);
+    return;
+  }
+
+  // The parts of a split range may evict others again.
+  evicted_.erase(range);
+
+  // Separate the parts inside and outside of loops, so that they compete for
+  // registers with their own spill weight.
+  LifetimePosition loop_boundary = FindLoopBoundary(range);
+  if (loop_boundary.IsValid()) {
+    LiveRange* tail = SplitRangeAt(range, loop_boundary);
+    Enqueue(range);
+    Enqueue(tail);
+    return;
+  }
+
+  LifetimePosition use_pos = register_use->pos();
+  if (LifetimePosition::ExistsGapPositionBetween(range->Start(), use_pos)) {
+    // Spill the part before the first register use, reloading it as late as
+    // possible but outside of loops.
+    LifetimePosition split_end = use_pos.PrevStart().End();
+    if (data()->IsBlockBoundary(use_pos.Start())) split_end = use_pos.Start();
+    LiveRange* tail = SplitBetween(range, range->Start().End(), split_end);
+    DCHECK(tail != range);
+    Spill(range);
+    Enqueue(tail);
+    return;
+  }
+
+  // The first register use is at the start of the range. Split right after
+  // it, the rest of the range is handled separately.
+  LifetimePosition split_pos = GetSplitPositionForInstruction(
+      range, use_pos.ToInstructionIndex() + 1);
+  // Instruction selection guarantees that the register uses of a single
+  // instruction can be satisfied, and minimal ranges have the highest spill
+  // weight, so they are never blocked.
+  CHECK(split_pos.IsValid());
+  LiveRange* tail = SplitRangeAt(range, split_pos);
+  Enqueue(range);
+  Enqueue(tail);
+}
+
+
+bool GreedyAllocator::HasConflict(LiveRange* range, int reg) const {
+  for (LiveRange* allocated : allocations_[reg]) {
+    if (allocated->End() <= range->Start() ||
+        allocated->Start() >= range->End()) {
+      continue;
+    }
+    if (range->FirstIntersection(allocated).IsValid()) return true;
+  }
+  return false;
+}
+
+
+float GreedyAllocator::MaxConflictWeight(LiveRange* range, int reg) {
+  float max_weight = 0.0f;
+  for (LiveRange* allocated : allocations_[reg]) {
+    if (allocated->End() <= range->Start() ||
+        allocated->Start() >= range->End()) {
+      continue;
+    }
+    if (!range->FirstIntersection(allocated).IsValid()) continue;
+    if (allocated->TopLevel()->IsFixed()) return kMaxWeight;
+    max_weight = Max(max_weight, SpillWeight(allocated));
+    if (max_weight == kMaxWeight) break;
+  }
+  return max_weight;
+}
+
+
+float GreedyAllocator::SpillWeight(LiveRange* range) {
+  UsePosition* register_use = range->NextRegisterPosition(range->Start());
+  if (register_use != nullptr &&
+      !LifetimePosition::ExistsGapPositionBetween(range->Start(),
+                                                  register_use->pos()) &&
+      !GetSplitPositionForInstruction(
+           range, register_use->pos().ToInstructionIndex() + 1)
+           .IsValid() &&
+      !FindLoopBoundary(range).IsValid()) {
+    // The range cannot be split any further.
+    return kMaxWeight;
+  }
+
+  // Each use that benefits from a register counts eight times as much per
+  // loop level it is nested in, capped at three levels.
+  float uses = 0.0f;
+  for (UsePosition* pos = range->first_pos(); pos != nullptr;
+       pos = pos->next()) {
+    if (!pos->RegisterIsBeneficial()) continue;
+    int depth = LoopDepth(GetInstructionBlock(code(), pos->pos()));
+    uses += static_cast<float>(1 << (3 * Min(depth, 3)));
+  }
+  int size = range->End().ToInstructionIndex() -
+             range->Start().ToInstructionIndex() + 1;
+  return uses / static_cast<float>(size);
+}
+
+
+LifetimePosition GreedyAllocator::FindLoopBoundary(LiveRange* range) const {
+  const InstructionBlock* block = GetInstructionBlock(code(), range->Start());
+  int last = GetInstructionBlock(code(), range->End().PrevStart())
+                 ->rpo_number()
+                 .ToInt();
+  for (int rpo = block->rpo_number().ToInt() + 1; rpo <= last; ++rpo) {
+    const InstructionBlock* next =
+        code()->InstructionBlockAt(RpoNumber::FromInt(rpo));
+    if (LoopDepth(next) != LoopDepth(block)) {
+      LifetimePosition pos = LifetimePosition::GapFromInstructionIndex(
+          next->first_instruction_index());
+      if (pos > range->Start() && pos < range->End()) return pos;
+    }
+    block = next;
+  }
+  return LifetimePosition::Invalid();
+}
+
+
 SpillSlotLocator::SpillSlotLocator(RegisterAllocationData* data)
     : data_(data) {}
 
@@ -787,6 +787,14 @@ class RegisterAllocationData final : public ZoneObject {
   // This zone is for data structures only needed during register allocation
   // phases.
   Zone* allocation_zone() const { return allocation_zone_; }
+  // This zone is for the parts of these data structures that are created while
+  // allocating registers of the given kind, i.e. split ranges and spill ranges.
+  // General and floating point registers can be allocated concurrently if
+  // they use different zones.
+  Zone* allocation_zone(RegisterKind kind) const {
+    return kind == FP_REGISTERS ? fp_allocation_zone_ : allocation_zone_;
+  }
+  void set_fp_allocation_zone(Zone* zone) { fp_allocation_zone_ = zone; }
   // This zone is for InstructionOperands and moves that live beyond register
   // allocation.
   Zone* code_zone() const { return code()->zone(); }
@@ -831,6 +839,7 @@ class RegisterAllocationData final : public ZoneObject {
   int GetNextLiveRangeId();
 
   Zone* const allocation_zone_;
+  Zone* fp_allocation_zone_;
   Frame* const frame_;
   InstructionSequence* const code_;
   const char* const debug_name_;
@@ -969,7 +978,7 @@ class RegisterAllocator : public ZoneObject {
   LifetimePosition GetSplitPositionForInstruction(const LiveRange* range,
                                                   int instruction_index);
 
-  Zone* allocation_zone() const { return data()->allocation_zone(); }
+  Zone* allocation_zone() const { return data()->allocation_zone(mode()); }
 
   // Find the optimal split for ranges defined by a memory operand, e.g.
   // constants or function parameters passed on the stack.
@@ -1084,6 +1093,66 @@ class LinearScanAllocator final : public RegisterAllocator {
 };
 
 
+// Allocates live ranges in order of decreasing size rather than by start
+// position. A range that finds no free register may evict ranges with a
+// lower spill weight, where uses inside loops weigh more. Otherwise it is
+// split at loop boundaries or around its register uses, and the parts
+// without register uses are spilled. This places spills and reloads outside
+// of hot loops more often than linear scan, at a higher compile time cost.
+class GreedyAllocator final : public RegisterAllocator {
+ public:
+  GreedyAllocator(RegisterAllocationData* data, RegisterKind kind,
+                  Zone* local_zone);
+
+  // Phase 4: compute register assignments.
+  void AllocateRegisters();
+
+ private:
+  struct QueueEntry {
+    int size;
+    LiveRange* range;
+    bool operator<(const QueueEntry& other) const {
+      return size < other.size ||
+             (size == other.size &&
+              range->Start() > other.range->Start());
+    }
+  };
+
+  static const float kMaxWeight;
+
+  void Enqueue(LiveRange* range);
+  void TryAllocateRange(LiveRange* range);
+  void AssignRegister(LiveRange* range, int reg);
+  void EvictAndAssignRegister(LiveRange* range, int reg);
+  void SplitOrSpillBlockedRange(LiveRange* range);
+
+  // Returns true if {range} intersects a range allocated to {reg}.
+  bool HasConflict(LiveRange* range, int reg) const;
+  // Returns the highest spill weight among the ranges allocated to {reg} that
+  // intersect {range}, or kMaxWeight if one of them cannot be evicted.
+  float MaxConflictWeight(LiveRange* range, int reg);
+
+  float SpillWeight(LiveRange* range);
+  int LoopDepth(const InstructionBlock* block) const {
+    return loop_depths_[block->rpo_number().ToSize()];
+  }
+  // Returns a position at which {range} enters or leaves a loop, or an
+  // invalid position.
+  LifetimePosition FindLoopBoundary(LiveRange* range) const;
+
+  Zone* const local_zone_;
+  ZonePriorityQueue<QueueEntry> queue_;
+  // The ranges allocated to each register, including the fixed ones.
+  ZoneVector<ZoneVector<LiveRange*>> allocations_;
+  // Ranges that were evicted are not allowed to evict others until they are
+  // split, which guarantees termination.
+  ZoneSet<LiveRange*> evicted_;
+  ZoneVector<int> loop_depths_;
+
+  DISALLOW_COPY_AND_ASSIGN(GreedyAllocator);
+};
+
+
 class SpillSlotLocator final : public ZoneObject {
  public:
   explicit SpillSlotLocator(RegisterAllocationData* data);
@@ -10,6 +10,7 @@
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph-reducer.h"
 #include "src/compiler/js-operator.h"
+#include "src/compiler/loop-variable-optimizer.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/node.h"
 #include "src/compiler/operation-typer.h"
@@ -79,7 +80,11 @@ Typer::~Typer() {
 class Typer::Visitor : public Reducer {
  public:
   explicit Visitor(Typer* typer)
-      : typer_(typer), weakened_nodes_(typer->zone()) {}
+      : typer_(typer),
+        weakened_nodes_(typer->zone()),
+        induction_vars_(typer->zone()),
+        induction_var_revisits_(0),
+        type_induction_vars_(true) {}
 
   Reduction Reduce(Node* node) override {
     if (node->op()->ValueOutputCount() == 0) return NoChange();
@@ -182,9 +187,35 @@ class Typer::Visitor : public Reducer {
 
   Type* TypeConstant(Handle<Object> value);
 
+  // The types of induction variables also depend on the bounds of their loop
+  // conditions, which are not inputs of the phis. Revisits the phis and
+  // returns true if any of their types changed. After too many rounds the
+  // remaining induction variables are typed like any other phi instead, which
+  // terminates thanks to weakening.
+  bool RevisitInductionVariables(GraphReducer* graph_reducer) {
+    if (induction_vars_.empty()) return false;
+    if (++induction_var_revisits_ > kMaxInductionVariableRevisits) {
+      type_induction_vars_ = false;
+    }
+    NodeVector phis(zone());
+    for (auto const& entry : induction_vars_) phis.push_back(entry.second);
+    bool changed = false;
+    for (Node* phi : phis) {
+      Type* const previous = NodeProperties::GetType(phi);
+      graph_reducer->ReduceNode(phi);
+      if (!NodeProperties::GetType(phi)->Is(previous)) changed = true;
+    }
+    return changed && type_induction_vars_;
+  }
+
  private:
   Typer* typer_;
   ZoneSet<NodeId> weakened_nodes_;
+  ZoneMap<NodeId, Node*> induction_vars_;
+  int induction_var_revisits_;
+  bool type_induction_vars_;
+
+  static const int kMaxInductionVariableRevisits = 8;
 
 #define DECLARE_METHOD(x) inline Type* Type##x(Node* node);
   DECLARE_METHOD(Start)
@@ -204,6 +235,9 @@ class Typer::Visitor : public Reducer {
 
   Type* WrapContextTypeForInput(Node* node);
   Type* Weaken(Node* node, Type* current_type, Type* previous_type);
+  Type* TypeInductionVariablePhi(Node* node,
+                                 InductionVariable const& induction_var);
+  bool IsLoopInvariantBound(Node* bound, Node* loop);
 
   Zone* zone() { return typer_->zone(); }
   Isolate* isolate() { return typer_->isolate(); }
@@ -218,6 +252,10 @@ class Typer::Visitor : public Reducer {
     return weakened_nodes_.find(node_id) != weakened_nodes_.end();
   }
 
+  bool IsInductionVariable(Node* node) {
+    return induction_vars_.find(node->id()) != induction_vars_.end();
+  }
+
   typedef Type* (*UnaryTyperFun)(Type*, Typer* t);
   typedef Type* (*BinaryTyperFun)(Type*, Type*, Typer* t);
 
@@ -275,7 +313,8 @@ class Typer::Visitor : public Reducer {
     if (NodeProperties::IsTyped(node)) {
       // Widen the type of a previously typed node.
       Type* previous = NodeProperties::GetType(node);
-      if (node->opcode() == IrOpcode::kPhi) {
+      if (node->opcode() == IrOpcode::kPhi &&
+          !IsInductionVariable(node)) {
         // Speed up termination in the presence of range types:
         current = Weaken(node, current, previous);
       }
@@ -306,6 +345,7 @@ void Typer::Run(const NodeVector& roots) {
   graph_reducer.AddReducer(&visitor);
   for (Node* const root : roots) graph_reducer.ReduceNode(root);
   graph_reducer.ReduceGraph();
+  while (visitor.RevisitInductionVariables(&graph_reducer)) continue;
 }
 
 
@@ -689,6 +729,12 @@ Type* Typer::Visitor::TypeSelect(Node* node) {
 
 
 Type* Typer::Visitor::TypePhi(Node* node) {
+  if (FLAG_turbo_loop_variable) {
+    InductionVariable induction_var;
+    if (InductionVariable::Match(node, &induction_var)) {
+      return TypeInductionVariablePhi(node, induction_var);
+    }
+  }
   int arity = node->op()->ValueInputCount();
   Type* type = Operand(node, 0);
   for (int i = 1; i < arity; ++i) {
@@ -698,6 +744,87 @@ Type* Typer::Visitor::TypePhi(Node* node) {
 }
 
 
+// Types an induction variable from its initial value and the loop condition
+// instead of iterating over the backedge, which would only terminate after
+// weakening the range towards infinity.
+Type* Typer::Visitor::TypeInductionVariablePhi(
+    Node* node, InductionVariable const& induction_var) {
+  Type* const integer = typer_->cache_.kInteger;
+  Type* const initial_type = Operand(node, 0);
+  bool strict = false;
+  Node* const bound = induction_var.FindBound(
+      NodeProperties::GetControlInput(induction_var.loop(), 1), &strict);
+  Type* type;
+  if (!type_induction_vars_ ||
+      (bound && !IsLoopInvariantBound(bound, induction_var.loop()))) {
+    // The type of the bound changes with the types of the loop's phis, so
+    // deriving the range from it need not reach a fixpoint. Fall back to the
+    // regular typing, which includes weakening.
+    induction_vars_.erase(node->id());
+    type = Type::Union(initial_type, Operand(node, 1), zone());
+  } else if (!initial_type->IsInhabited()) {
+    induction_vars_[node->id()] = node;
+    type = Type::None();
+  } else if (initial_type->Is(integer)) {
+    // Starting from an integer, the variable only ever takes integral values
+    // in the direction of its step, until the loop condition fails.
+    induction_vars_[node->id()] = node;
+    double const step = induction_var.step();
+    double min = initial_type->Min();
+    double max = initial_type->Max();
+    Type* const bound_type = bound ? TypeOrNone(bound) : Type::Any();
+    if (!bound_type->Is(integer)) {
+      if (step > 0) {
+        max = V8_INFINITY;
+      } else {
+        min = -V8_INFINITY;
+      }
+    } else if (bound_type->IsInhabited()) {
+      double const offset = strict ? 1 : 0;
+      if (step > 0) {
+        max = std::max(max, bound_type->Max() - offset + step);
+      } else {
+        min = std::min(min, bound_type->Min() + offset + step);
+      }
+    }
+    type = Type::Range(min, max, zone());
+  } else {
+    // Fall back to the regular typing, which includes weakening.
+    induction_vars_.erase(node->id());
+    type = Type::Union(initial_type, Operand(node, 1), zone());
+  }
+  // The types of the initial value and the bound may have changed since the
+  // last visit; make sure the type of the phi only ever grows.
+  if (NodeProperties::IsTyped(node)) {
+    type = Type::Union(type, NodeProperties::GetType(node), zone());
+  }
+  return type;
+}
+
+// Returns true if the value of {bound} does not depend on any phi of {loop},
+// which includes the induction variable itself. Bounds whose computation is
+// too large to inspect are treated as loop variant.
+bool Typer::Visitor::IsLoopInvariantBound(Node* bound, Node* loop) {
+  static const size_t kMaxVisitedNodes = 32;
+  ZoneSet<Node*> visited(zone());
+  NodeVector stack(zone());
+  stack.push_back(bound);
+  while (!stack.empty()) {
+    Node* const current = stack.back();
+    stack.pop_back();
+    if (!visited.insert(current).second) continue;
+    if (visited.size() > kMaxVisitedNodes) return false;
+    if (current->opcode() == IrOpcode::kPhi &&
+        NodeProperties::GetControlInput(current) == loop) {
+      return false;
+    }
+    for (int i = 0; i < current->op()->ValueInputCount(); ++i) {
+      stack.push_back(NodeProperties::GetValueInput(current, i));
+    }
+  }
+  return true;
+}
+
 Type* Typer::Visitor::TypeEffectPhi(Node* node) {
   UNREACHABLE();
   return nullptr;
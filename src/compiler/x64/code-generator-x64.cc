@@ -1602,6 +1602,60 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
       __ Xorpd(kScratchDoubleReg, kScratchDoubleReg);
       __ Subsd(i.InputDoubleRegister(0), kScratchDoubleReg);
       break;
+    case kSSEFloat32x4Splat:
+      __ shufps(i.OutputDoubleRegister(), i.OutputDoubleRegister(), 0);
+      break;
+    case kSSEFloat32x4Add:
+      ASSEMBLE_SSE_BINOP(addps);
+      break;
+    case kSSEFloat32x4Sub:
+      ASSEMBLE_SSE_BINOP(subps);
+      break;
+    case kSSEFloat32x4Mul:
+      ASSEMBLE_SSE_BINOP(mulps);
+      break;
+    case kSSEFloat32x4Div:
+      ASSEMBLE_SSE_BINOP(divps);
+      break;
+    case kSSEFloat64x2Splat:
+      __ shufpd(i.OutputDoubleRegister(), i.OutputDoubleRegister(), 0);
+      break;
+    case kSSEFloat64x2Add:
+      ASSEMBLE_SSE_BINOP(addpd);
+      break;
+    case kSSEFloat64x2Sub:
+      ASSEMBLE_SSE_BINOP(subpd);
+      break;
+    case kSSEFloat64x2Mul:
+      ASSEMBLE_SSE_BINOP(mulpd);
+      break;
+    case kSSEFloat64x2Div:
+      ASSEMBLE_SSE_BINOP(divpd);
+      break;
+    case kAVXFloat32x4Add:
+      ASSEMBLE_AVX_BINOP(vaddps);
+      break;
+    case kAVXFloat32x4Sub:
+      ASSEMBLE_AVX_BINOP(vsubps);
+      break;
+    case kAVXFloat32x4Mul:
+      ASSEMBLE_AVX_BINOP(vmulps);
+      break;
+    case kAVXFloat32x4Div:
+      ASSEMBLE_AVX_BINOP(vdivps);
+      break;
+    case kAVXFloat64x2Add:
+      ASSEMBLE_AVX_BINOP(vaddpd);
+      break;
+    case kAVXFloat64x2Sub:
+      ASSEMBLE_AVX_BINOP(vsubpd);
+      break;
+    case kAVXFloat64x2Mul:
+      ASSEMBLE_AVX_BINOP(vmulpd);
+      break;
+    case kAVXFloat64x2Div:
+      ASSEMBLE_AVX_BINOP(vdivpd);
+      break;
     case kX64Movsxbl:
       ASSEMBLE_MOVX(movsxbl);
       __ AssertZeroExtended(i.OutputRegister());
@@ -1694,6 +1748,15 @@ CodeGenerator::CodeGenResult CodeGenerator::AssembleArchInstruction(
         __ Movsd(operand, i.InputDoubleRegister(index));
       }
       break;
+    case kX64Movups:
+      if (instr->HasOutput()) {
+        __ movups(i.OutputDoubleRegister(), i.MemoryOperand());
+      } else {
+        size_t index = 0;
+        Operand operand = i.MemoryOperand(&index);
+        __ movups(operand, i.InputDoubleRegister(index));
+      }
+      break;
     case kX64BitcastFI:
       if (instr->InputAt(0)->IsFPStackSlot()) {
         __ movl(i.OutputRegister(), i.InputOperand(0));
@@ -2291,18 +2354,31 @@ void CodeGenerator::AssembleMove(InstructionOperand* source,
     } else {
       DCHECK(destination->IsFPStackSlot());
       Operand dst = g.ToOperand(destination);
-      __ Movsd(dst, src);
+      if (source->IsSimd128Register()) {
+        __ movups(dst, src);
+      } else {
+        __ Movsd(dst, src);
+      }
     }
   } else if (source->IsFPStackSlot()) {
     DCHECK(destination->IsFPRegister() || destination->IsFPStackSlot());
     Operand src = g.ToOperand(source);
     if (destination->IsFPRegister()) {
       XMMRegister dst = g.ToDoubleRegister(destination);
-      __ Movsd(dst, src);
+      if (source->IsSimd128StackSlot()) {
+        __ movups(dst, src);
+      } else {
+        __ Movsd(dst, src);
+      }
     } else {
       Operand dst = g.ToOperand(destination);
-      __ Movsd(kScratchDoubleReg, src);
-      __ Movsd(dst, kScratchDoubleReg);
+      if (source->IsSimd128StackSlot()) {
+        __ movups(kScratchDoubleReg, src);
+        __ movups(dst, kScratchDoubleReg);
+      } else {
+        __ Movsd(kScratchDoubleReg, src);
+        __ Movsd(dst, kScratchDoubleReg);
+      }
     }
   } else {
     UNREACHABLE();
@@ -2331,6 +2407,17 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     frame_access_state()->IncreaseSPDelta(-1);
     dst = g.ToOperand(destination);
     __ popq(dst);
+  } else if (source->IsSimd128StackSlot() &&
+             destination->IsSimd128StackSlot()) {
+    // 128-bit memory-memory, one quadword at a time.
+    for (int extra = 0; extra < kSimd128Size; extra += kDoubleSize) {
+      Operand src = g.ToOperand(source, extra);
+      Operand dst = g.ToOperand(destination, extra);
+      __ Movsd(kScratchDoubleReg, src);
+      __ movq(kScratchRegister, dst);
+      __ Movsd(dst, kScratchDoubleReg);
+      __ movq(src, kScratchRegister);
+    }
   } else if ((source->IsStackSlot() && destination->IsStackSlot()) ||
              (source->IsFPStackSlot() && destination->IsFPStackSlot())) {
     // Memory-memory.
@@ -2356,9 +2443,15 @@ void CodeGenerator::AssembleSwap(InstructionOperand* source,
     // XMM register-memory swap.
     XMMRegister src = g.ToDoubleRegister(source);
     Operand dst = g.ToOperand(destination);
-    __ Movsd(kScratchDoubleReg, src);
-    __ Movsd(src, dst);
-    __ Movsd(dst, kScratchDoubleReg);
+    if (destination->IsSimd128StackSlot()) {
+      __ Movapd(kScratchDoubleReg, src);
+      __ movups(src, dst);
+      __ movups(dst, kScratchDoubleReg);
+    } else {
+      __ Movsd(kScratchDoubleReg, src);
+      __ Movsd(src, dst);
+      __ Movsd(dst, kScratchDoubleReg);
+    }
   } else {
     // No other combinations are possible.
     UNREACHABLE();
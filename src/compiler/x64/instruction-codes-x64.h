@@ -121,6 +121,24 @@ namespace compiler {
   V(AVXFloat64Neg)                 \
   V(AVXFloat32Abs)                 \
   V(AVXFloat32Neg)                 \
+  V(SSEFloat32x4Splat)             \
+  V(SSEFloat32x4Add)               \
+  V(SSEFloat32x4Sub)               \
+  V(SSEFloat32x4Mul)               \
+  V(SSEFloat32x4Div)               \
+  V(SSEFloat64x2Splat)             \
+  V(SSEFloat64x2Add)               \
+  V(SSEFloat64x2Sub)               \
+  V(SSEFloat64x2Mul)               \
+  V(SSEFloat64x2Div)               \
+  V(AVXFloat32x4Add)               \
+  V(AVXFloat32x4Sub)               \
+  V(AVXFloat32x4Mul)               \
+  V(AVXFloat32x4Div)               \
+  V(AVXFloat64x2Add)               \
+  V(AVXFloat64x2Sub)               \
+  V(AVXFloat64x2Mul)               \
+  V(AVXFloat64x2Div)               \
   V(X64Movsxbl)                    \
   V(X64Movzxbl)                    \
   V(X64Movb)                       \
@@ -132,6 +150,7 @@ namespace compiler {
   V(X64Movq)                       \
   V(X64Movsd)                      \
   V(X64Movss)                      \
+  V(X64Movups)                     \
   V(X64BitcastFI)                  \
   V(X64BitcastDL)                  \
   V(X64BitcastIF)                  \
@@ -123,6 +123,24 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kAVXFloat64Neg:
     case kAVXFloat32Abs:
     case kAVXFloat32Neg:
+    case kSSEFloat32x4Splat:
+    case kSSEFloat32x4Add:
+    case kSSEFloat32x4Sub:
+    case kSSEFloat32x4Mul:
+    case kSSEFloat32x4Div:
+    case kSSEFloat64x2Splat:
+    case kSSEFloat64x2Add:
+    case kSSEFloat64x2Sub:
+    case kSSEFloat64x2Mul:
+    case kSSEFloat64x2Div:
+    case kAVXFloat32x4Add:
+    case kAVXFloat32x4Sub:
+    case kAVXFloat32x4Mul:
+    case kAVXFloat32x4Div:
+    case kAVXFloat64x2Add:
+    case kAVXFloat64x2Sub:
+    case kAVXFloat64x2Mul:
+    case kAVXFloat64x2Div:
     case kX64BitcastFI:
     case kX64BitcastDL:
     case kX64BitcastIF:
@@ -160,6 +178,7 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kX64Movq:
     case kX64Movsd:
     case kX64Movss:
+    case kX64Movups:
       return instr->HasOutput() ? kIsLoadOperation : kHasSideEffect;
 
     case kX64StackCheck:
@@ -165,7 +165,9 @@ void InstructionSelector::VisitLoad(Node* node) {
     case MachineRepresentation::kWord64:
       opcode = kX64Movq;
       break;
-    case MachineRepresentation::kSimd128:  // Fall through.
+    case MachineRepresentation::kSimd128:
+      opcode = kX64Movups;
+      break;
     case MachineRepresentation::kNone:
       UNREACHABLE();
       return;
@@ -250,7 +252,9 @@ void InstructionSelector::VisitStore(Node* node) {
       case MachineRepresentation::kWord64:
         opcode = kX64Movq;
         break;
-      case MachineRepresentation::kSimd128:  // Fall through.
+      case MachineRepresentation::kSimd128:
+        opcode = kX64Movups;
+        break;
       case MachineRepresentation::kNone:
         UNREACHABLE();
         return;
@@ -1128,6 +1132,22 @@ void VisitFloatBinop(InstructionSelector* selector, Node* node,
 }
 
 
+// Packed SSE instructions require memory operands to be 16 byte aligned,
+// which spill slots are not, so only the AVX versions take memory operands.
+void VisitSimd128FloatBinop(InstructionSelector* selector, Node* node,
+                            ArchOpcode avx_opcode, ArchOpcode sse_opcode) {
+  X64OperandGenerator g(selector);
+  InstructionOperand operand0 = g.UseRegister(node->InputAt(0));
+  if (selector->IsSupported(AVX)) {
+    selector->Emit(avx_opcode, g.DefineAsRegister(node), operand0,
+                   g.Use(node->InputAt(1)));
+  } else {
+    selector->Emit(sse_opcode, g.DefineSameAsFirst(node), operand0,
+                   g.UseRegister(node->InputAt(1)));
+  }
+}
+
+
 void VisitFloatUnop(InstructionSelector* selector, Node* node, Node* input,
                     ArchOpcode avx_opcode, ArchOpcode sse_opcode) {
   X64OperandGenerator g(selector);
@@ -2059,6 +2079,50 @@ void InstructionSelector::VisitFloat64SilenceNaN(Node* node) {
        g.UseRegister(node->InputAt(0)));
 }
 
+void InstructionSelector::VisitFloat32x4Splat(Node* node) {
+  X64OperandGenerator g(this);
+  Emit(kSSEFloat32x4Splat, g.DefineSameAsFirst(node),
+       g.UseRegister(node->InputAt(0)));
+}
+
+void InstructionSelector::VisitFloat32x4Add(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat32x4Add, kSSEFloat32x4Add);
+}
+
+void InstructionSelector::VisitFloat32x4Sub(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat32x4Sub, kSSEFloat32x4Sub);
+}
+
+void InstructionSelector::VisitFloat32x4Mul(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat32x4Mul, kSSEFloat32x4Mul);
+}
+
+void InstructionSelector::VisitFloat32x4Div(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat32x4Div, kSSEFloat32x4Div);
+}
+
+void InstructionSelector::VisitFloat64x2Splat(Node* node) {
+  X64OperandGenerator g(this);
+  Emit(kSSEFloat64x2Splat, g.DefineSameAsFirst(node),
+       g.UseRegister(node->InputAt(0)));
+}
+
+void InstructionSelector::VisitFloat64x2Add(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat64x2Add, kSSEFloat64x2Add);
+}
+
+void InstructionSelector::VisitFloat64x2Sub(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat64x2Sub, kSSEFloat64x2Sub);
+}
+
+void InstructionSelector::VisitFloat64x2Mul(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat64x2Mul, kSSEFloat64x2Mul);
+}
+
+void InstructionSelector::VisitFloat64x2Div(Node* node) {
+  VisitSimd128FloatBinop(this, node, kAVXFloat64x2Div, kSSEFloat64x2Div);
+}
+
 void InstructionSelector::VisitAtomicLoad(Node* node) {
   LoadRepresentation load_rep = LoadRepresentationOf(node->op());
   DCHECK(load_rep.representation() == MachineRepresentation::kWord8 ||
@@ -2115,7 +2179,8 @@ InstructionSelector::SupportedMachineOperatorFlags() {
       MachineOperatorBuilder::kFloat64Max |
       MachineOperatorBuilder::kFloat64Min |
       MachineOperatorBuilder::kWord32ShiftIsSafe |
-      MachineOperatorBuilder::kWord32Ctz | MachineOperatorBuilder::kWord64Ctz;
+      MachineOperatorBuilder::kWord32Ctz | MachineOperatorBuilder::kWord64Ctz |
+      MachineOperatorBuilder::kSimd128FloatArithmetic;
   if (CpuFeatures::IsSupported(POPCNT)) {
     flags |= MachineOperatorBuilder::kWord32Popcnt |
              MachineOperatorBuilder::kWord64Popcnt;
@@ -527,6 +527,12 @@ void Context::AddOptimizedCode(Code* code) {
   DCHECK(code->next_code_link()->IsUndefined(GetIsolate()));
   code->set_next_code_link(get(OPTIMIZED_CODE_LIST));
   set(OPTIMIZED_CODE_LIST, code, UPDATE_WEAK_WRITE_BARRIER);
+
+  // Optimized code keeps the bytecode of inlined functions alive, which the
+  // marker misses for code that was allocated black.
+  if (FLAG_flush_bytecode) {
+    GetHeap()->incremental_marking()->IterateBlackObject(code);
+  }
 }
 
 
@@ -833,6 +833,9 @@ class RuntimeCallTimerScope {
   HR(code_cache_reject_reason, V8.CodeCacheRejectReason, 1, 6, 6)             \
   HR(errors_thrown_per_context, V8.ErrorsThrownPerContext, 0, 200, 20)        \
   HR(debug_feature_usage, V8.DebugFeatureUsage, 1, 7, 7)                      \
+  /* Time jobs wait in the concurrent recompilation queue, in ms. */          \
+  HR(concurrent_recompilation_queue_latency,                                  \
+     V8.ConcurrentRecompilationQueueLatency, 0, 10000, 101)                   \
   /* Asm/Wasm. */                                                             \
   HR(wasm_functions_per_module, V8.WasmFunctionsPerModule, 1, 10000, 51)
 
@@ -1029,6 +1032,11 @@ class RuntimeCallTimerScope {
   SC(soft_deopts_requested, V8.SoftDeoptsRequested)                            \
   SC(soft_deopts_inserted, V8.SoftDeoptsInserted)                              \
   SC(soft_deopts_executed, V8.SoftDeoptsExecuted)                              \
+  /* Concurrent recompilation queue. */                                        \
+  SC(concurrent_recompilation_jobs_evicted,                                    \
+     V8.ConcurrentRecompilationJobsEvicted)                                    \
+  SC(concurrent_recompilation_jobs_reprioritized,                              \
+     V8.ConcurrentRecompilationJobsReprioritized)                              \
   /* Number of write barriers in generated code. */                            \
   SC(write_barriers_dynamic, V8.WriteBarriersDynamic)                          \
   SC(write_barriers_static, V8.WriteBarriersStatic)                            \
@@ -1054,7 +1062,14 @@ class RuntimeCallTimerScope {
   /* Total code size (including metadata) of baseline code or bytecode. */     \
   SC(total_baseline_code_size, V8.TotalBaselineCodeSize)                       \
   /* Total count of functions compiled using the baseline compiler. */         \
-  SC(total_baseline_compile_count, V8.TotalBaselineCompileCount)
+  SC(total_baseline_compile_count, V8.TotalBaselineCompileCount)               \
+  /* Total size of the source position tables of bytecode. */                  \
+  SC(bytecode_source_position_table_size,                                      \
+     V8.BytecodeSourcePositionTableSize)                                       \
+  /* Number of bytecode arrays compiled without source position table. */      \
+  SC(bytecode_source_positions_omitted, V8.BytecodeSourcePositionsOmitted)     \
+  /* Number of omitted source position tables collected later on. */           \
+  SC(bytecode_source_positions_collected, V8.BytecodeSourcePositionsCollected)
 
 // This file contains all the v8 counters that are in use.
 class Counters {
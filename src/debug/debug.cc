@@ -184,7 +184,7 @@ BreakLocation::BytecodeArrayIterator::BytecodeArrayIterator(
     : Iterator(debug_info),
       source_position_iterator_(debug_info->abstract_code()
                                     ->GetBytecodeArray()
-                                    ->source_position_table()),
+                                    ->SourcePositionTable()),
       break_locator_type_(type),
       start_position_(debug_info->shared()->start_position()) {
   // There is at least one break location.
@@ -1540,6 +1540,12 @@ bool Debug::EnsureDebugInfo(Handle<SharedFunctionInfo> shared,
   }
 
   if (shared->HasBytecodeArray()) {
+    // Break locations are looked up by source position, collect them if they
+    // were omitted when the bytecode was generated.
+    bool has_source_positions = function.is_null()
+                                    ? Compiler::EnsureSourcePositions(shared)
+                                    : Compiler::EnsureSourcePositions(function);
+    if (!has_source_positions) return false;
     // To prepare bytecode for debugging, we already need to have the debug
     // info (containing the debug copy) upfront, but since we do not recompile,
     // preparing for break points cannot fail.
@@ -1558,6 +1564,12 @@ void Debug::CreateDebugInfo(Handle<SharedFunctionInfo> shared) {
   DCHECK(shared->HasDebugCode());
   Handle<DebugInfo> debug_info = isolate_->factory()->NewDebugInfo(shared);
 
+  // The bytecode of functions with debug info must not be flushed, make sure
+  // a decision taken during incremental marking is revisited.
+  if (FLAG_flush_bytecode) {
+    isolate_->heap()->incremental_marking()->IterateBlackObject(*shared);
+  }
+
   // Add debug info to the list.
   DebugInfoListNode* node = new DebugInfoListNode(*debug_info);
   node->set_next(debug_info_list_);
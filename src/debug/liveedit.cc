@@ -1237,12 +1237,15 @@ Handle<Code> PatchPositionsInCode(Handle<Code> code,
 
 void PatchPositionsInBytecodeArray(Handle<BytecodeArray> bytecode,
                                    Handle<JSArray> position_change_array) {
+  // Omitted source positions are collected from the patched script later on.
+  if (!bytecode->HasSourcePositionTable()) return;
+
   Isolate* isolate = bytecode->GetIsolate();
   Zone zone(isolate->allocator());
   interpreter::SourcePositionTableBuilder builder(isolate, &zone);
 
   for (interpreter::SourcePositionTableIterator iterator(
-           bytecode->source_position_table());
+           bytecode->SourcePositionTable());
        !iterator.done(); iterator.Advance()) {
     int position = iterator.source_position();
     int new_position = TranslatePosition(position, position_change_array);
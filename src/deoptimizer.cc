@@ -4,6 +4,8 @@
 
 #include "src/deoptimizer.h"
 
+#include <algorithm>
+
 #include "src/accessors.h"
 #include "src/ast/prettyprinter.h"
 #include "src/codegen.h"
@@ -52,6 +54,42 @@ DeoptimizerData::~DeoptimizerData() {
 }
 
 
+void DeoptimizationTracker::Record(SharedFunctionInfo* shared,
+                                   Deoptimizer::DeoptReason reason) {
+  int script_id = shared->script()->IsScript()
+                      ? Script::cast(shared->script())->id()
+                      : -1;
+  std::pair<int, int> key(script_id, shared->start_position());
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    if (entries_.size() >= kMaxEntries) return;
+    Entry entry;
+    entry.name = shared->DebugName()->ToCString().get();
+    entry.script_id = script_id;
+    entry.start_position = shared->start_position();
+    entry.count = 0;
+    std::fill(entry.reason_counts,
+              entry.reason_counts + Deoptimizer::kLastDeoptReason, 0);
+    it = entries_.insert(std::make_pair(key, entry)).first;
+  }
+  it->second.count++;
+  it->second.reason_counts[reason]++;
+}
+
+
+std::vector<const DeoptimizationTracker::Entry*>
+DeoptimizationTracker::TopEntries(size_t max_entries) const {
+  std::vector<const Entry*> result;
+  for (auto& pair : entries_) result.push_back(&pair.second);
+  std::stable_sort(result.begin(), result.end(),
+                   [](const Entry* a, const Entry* b) {
+                     return a->count > b->count;
+                   });
+  if (result.size() > max_entries) result.resize(max_entries);
+  return result;
+}
+
+
 Code* Deoptimizer::FindDeoptimizingCode(Address addr) {
   if (function_->IsHeapObject()) {
     // Search all deoptimizing code in the native context of the function.
@@ -520,6 +558,12 @@ Deoptimizer::Deoptimizer(Isolate* isolate, JSFunction* function,
     }
   }
   compiled_code_ = FindOptimizedCode(function, optimized_code);
+  if (FLAG_track_deopt_reasons && function != nullptr &&
+      compiled_code_->kind() == Code::OPTIMIZED_FUNCTION) {
+    DeoptInfo info = GetDeoptInfo(compiled_code_, from_);
+    isolate->deoptimizer_data()->tracker()->Record(function->shared(),
+                                                   info.deopt_reason);
+  }
 #if DEBUG
   DCHECK(compiled_code_ != NULL);
   if (type == EAGER || type == SOFT || type == LAZY) {
@@ -5,6 +5,10 @@
 #ifndef V8_DEOPTIMIZER_H_
 #define V8_DEOPTIMIZER_H_
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "src/allocation.h"
 #include "src/macro-assembler.h"
 
@@ -961,17 +965,52 @@ class FrameDescription {
 };
 
 
+// Counts the deoptimizations of each function, broken down by reason, so
+// that the functions caught in optimize/deoptimize cycles can be reported.
+// Functions are identified by script and source position, which survive
+// recompilation and garbage collection.
+class DeoptimizationTracker {
+ public:
+  struct Entry {
+    std::string name;
+    int script_id;
+    int start_position;
+    int count;
+    int reason_counts[Deoptimizer::kLastDeoptReason];
+  };
+
+  DeoptimizationTracker() {}
+
+  void Record(SharedFunctionInfo* shared, Deoptimizer::DeoptReason reason);
+
+  // Returns at most {max_entries} entries, most deoptimized functions first.
+  std::vector<const Entry*> TopEntries(size_t max_entries) const;
+
+ private:
+  // Upper bound on the number of tracked functions, deoptimizations of any
+  // further functions are not recorded.
+  static const size_t kMaxEntries = 1024;
+
+  std::map<std::pair<int, int>, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(DeoptimizationTracker);
+};
+
+
 class DeoptimizerData {
  public:
   explicit DeoptimizerData(MemoryAllocator* allocator);
   ~DeoptimizerData();
 
+  DeoptimizationTracker* tracker() { return &tracker_; }
+
  private:
   MemoryAllocator* allocator_;
   int deopt_entry_code_entries_[Deoptimizer::kLastBailoutType + 1];
   MemoryChunk* deopt_entry_code_[Deoptimizer::kLastBailoutType + 1];
 
   Deoptimizer* current_;
+  DeoptimizationTracker tracker_;
 
   friend class Deoptimizer;
 
@@ -47,6 +47,11 @@ namespace internal {
       __allocation__ = FUNCTION_CALL;                                         \
     }                                                                         \
     RETURN_OBJECT_UNLESS_RETRY(ISOLATE, TYPE)                                 \
+    /* Let the embedder raise the heap limit before giving up. */             \
+    if ((ISOLATE)->heap()->InvokeNearHeapLimitCallback()) {                   \
+      __allocation__ = FUNCTION_CALL;                                         \
+      RETURN_OBJECT_UNLESS_RETRY(ISOLATE, TYPE)                               \
+    }                                                                         \
     /* TODO(1181417): Fix this. */                                            \
     v8::internal::Heap::FatalProcessOutOfMemory("CALL_AND_RETRY_LAST", true); \
     return Handle<TYPE>();                                                    \
@@ -74,6 +74,15 @@ class FieldIndex final {
         (IsInObjectBits::kMask | IsDoubleBits::kMask | IndexBits::kMask);
   }
 
+  static const int kIndexBitsSize = kDescriptorIndexBitCount + 1;
+
+  // The layout of the field access stub key is also decoded by generated
+  // code that inlines field access handlers.
+  // Index from beginning of object.
+  class IndexBits: public BitField<int, 0, kIndexBitsSize> {};
+  class IsInObjectBits: public BitField<bool, IndexBits::kNext, 1> {};
+  class IsDoubleBits: public BitField<bool, IsInObjectBits::kNext, 1> {};
+
  private:
   FieldIndex(bool is_inobject, int local_index, bool is_double,
              int inobject_properties, int first_inobject_property_offset,
@@ -94,12 +103,6 @@ class FieldIndex final {
     return FirstInobjectPropertyOffsetBits::decode(bit_field_);
   }
 
-  static const int kIndexBitsSize = kDescriptorIndexBitCount + 1;
-
-  // Index from beginning of object.
-  class IndexBits: public BitField<int, 0, kIndexBitsSize> {};
-  class IsInObjectBits: public BitField<bool, IndexBits::kNext, 1> {};
-  class IsDoubleBits: public BitField<bool, IsInObjectBits::kNext, 1> {};
   // Number of inobject properties.
   class InObjectPropertyBits
       : public BitField<int, IsDoubleBits::kNext, kDescriptorIndexBitCount> {};
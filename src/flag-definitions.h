@@ -269,6 +269,12 @@ DEFINE_BOOL(trace_pretenuring, false,
             "trace pretenuring decisions of HAllocate instructions")
 DEFINE_BOOL(trace_pretenuring_statistics, false,
             "trace allocation site pretenuring statistics")
+DEFINE_BOOL(pretenuring_histograms, false,
+            "pretenure allocation sites based on the number of scavenges "
+            "their objects survive")
+DEFINE_BOOL(trace_pretenuring_histograms, false,
+            "trace allocation site lifetime histograms")
+DEFINE_IMPLICATION(trace_pretenuring_histograms, pretenuring_histograms)
 DEFINE_BOOL(track_fields, true, "track fields with only smi values")
 DEFINE_BOOL(track_double_fields, true, "track fields with double values")
 DEFINE_BOOL(track_heap_object_fields, true, "track fields with heap values")
@@ -302,8 +308,23 @@ DEFINE_BOOL(ignition_deadcode, true,
             "use ignition dead code elimination optimizer")
 DEFINE_BOOL(ignition_peephole, true, "use ignition peephole optimizer")
 DEFINE_BOOL(ignition_reo, true, "use ignition register equivalence optimizer")
+DEFINE_BOOL(ignition_superinstructions, false,
+            "fuse frequent bytecode pairs into superinstructions")
+DEFINE_BOOL(ignition_star_lookahead, true,
+            "perform a following Star in the dispatch of bytecode handlers "
+            "that write the accumulator")
+DEFINE_BOOL(ignition_inline_field_access, true,
+            "inline monomorphic and polymorphic field load and store "
+            "handlers into named property bytecode handlers")
 DEFINE_BOOL(ignition_filter_expression_positions, true,
             "filter expression positions before the bytecode pipeline")
+DEFINE_BOOL(lazy_source_positions, false,
+            "omit the source position tables of bytecode until they are "
+            "needed and collect them by reparsing")
+DEFINE_BOOL(trace_lazy_source_positions, false,
+            "trace the lazy collection of bytecode source positions")
+DEFINE_BOOL(ignition_osr, false,
+            "enable on-stack replacement from ignition into turbofan")
 DEFINE_BOOL(print_bytecode, false,
             "print bytecode generated by ignition interpreter")
 DEFINE_BOOL(trace_ignition, false,
@@ -409,6 +430,9 @@ DEFINE_BOOL(trace_concurrent_recompilation, false,
             "track concurrent recompilation")
 DEFINE_INT(concurrent_recompilation_queue_length, 8,
            "the length of the concurrent compilation queue")
+DEFINE_INT(concurrent_recompilation_max_queue_time, 0,
+           "evict jobs that waited longer than this in the concurrent "
+           "compilation queue (in ms, 0 to disable)")
 DEFINE_INT(concurrent_recompilation_delay, 0,
            "artificial compilation delay in ms")
 DEFINE_BOOL(block_concurrent_recompilation, false,
@@ -428,6 +452,19 @@ DEFINE_BOOL(turbo_sp_frame_access, false,
             "use stack pointer-relative access to frame wherever possible")
 DEFINE_BOOL(turbo_preprocess_ranges, true,
             "run pre-register allocation heuristics")
+DEFINE_BOOL(turbo_parallel_register_allocation, true,
+            "allocate general and floating point registers in parallel")
+DEFINE_INT(turbo_parallel_register_allocation_min_ranges, 2000,
+           "minimum number of virtual registers of each kind for parallel "
+           "register allocation")
+DEFINE_BOOL(turbo_greedy_regalloc, false,
+            "use the greedy register allocator for hot functions")
+DEFINE_INT(turbo_greedy_regalloc_min_ticks, 4,
+           "minimum number of profiler ticks of a function to be allocated "
+           "by the greedy register allocator")
+DEFINE_INT(turbo_greedy_regalloc_max_instructions, 10000,
+           "maximum number of instructions of a function to be allocated by "
+           "the greedy register allocator")
 DEFINE_BOOL(turbo_loop_stackcheck, true, "enable stack checks in loops")
 DEFINE_STRING(turbo_filter, "~~", "optimization filter for TurboFan compiler")
 DEFINE_BOOL(trace_turbo, false, "trace generated TurboFan IR")
@@ -459,6 +496,8 @@ DEFINE_BOOL(native_context_specialization, true,
             "enable native context specialization in TurboFan")
 DEFINE_BOOL(turbo_inlining, true, "enable inlining in TurboFan")
 DEFINE_BOOL(trace_turbo_inlining, false, "trace TurboFan inlining")
+DEFINE_BOOL(turbo_polymorphic_inlining, true,
+            "inline the targets of polymorphic calls in TurboFan")
 DEFINE_BOOL(loop_assignment_analysis, true, "perform loop assignment analysis")
 DEFINE_BOOL(turbo_profiling, false, "enable profiling in TurboFan")
 DEFINE_BOOL(turbo_verify_allocation, DEBUG_BOOL,
@@ -471,7 +510,12 @@ DEFINE_BOOL(turbo_cf_optimization, true, "optimize control flow in TurboFan")
 DEFINE_BOOL(turbo_frame_elision, true, "elide frames in TurboFan")
 DEFINE_BOOL(turbo_cache_shared_code, true, "cache context-independent code")
 DEFINE_BOOL(turbo_preserve_shared_code, false, "keep context-independent code")
-DEFINE_BOOL(turbo_escape, false, "enable escape analysis")
+DEFINE_BOOL(turbo_escape, true, "enable escape analysis")
+DEFINE_BOOL(turbo_loop_variable, true,
+            "enable induction variable analysis and bounds check elimination")
+DEFINE_BOOL(turbo_licm, false, "enable loop invariant code motion in TurboFan")
+DEFINE_BOOL(turbo_loop_vectorization, true,
+            "vectorize loops over typed arrays in TurboFan")
 DEFINE_BOOL(turbo_instruction_scheduling, false,
             "enable instruction scheduling in TurboFan")
 DEFINE_BOOL(turbo_stress_instruction_scheduling, false,
@@ -605,12 +649,23 @@ DEFINE_BOOL(always_opt, false, "always try to optimize functions")
 DEFINE_BOOL(always_osr, false, "always try to OSR functions")
 DEFINE_BOOL(prepare_always_opt, false, "prepare for turning on always opt")
 DEFINE_BOOL(trace_deopt, false, "trace optimize function deoptimization")
+DEFINE_BOOL(track_deopt_reasons, false,
+            "count deoptimizations per function and reason")
+DEFINE_BOOL(deopt_backoff, true,
+            "back off exponentially from re-optimizing functions that "
+            "deoptimized")
+DEFINE_INT(deopt_storm_threshold, 3,
+           "number of deoptimizations after which TurboFan stops speculating "
+           "on type feedback for a function")
 DEFINE_BOOL(trace_stub_failures, false,
             "trace deoptimization of generated code stubs")
 
 DEFINE_BOOL(serialize_toplevel, true, "enable caching of toplevel scripts")
 DEFINE_BOOL(serialize_eager, false, "compile eagerly when caching scripts")
 DEFINE_BOOL(serialize_age_code, false, "pre age code in the code cache")
+DEFINE_BOOL(serialize_optimization_hints, false,
+            "record functions optimized before producing the code cache and "
+            "optimize them early after deserialization")
 DEFINE_BOOL(trace_serializer, false, "print code serializer trace")
 
 // compiler.cc
@@ -711,6 +766,9 @@ DEFINE_BOOL(trace_code_flushing, false, "trace code flushing progress")
 DEFINE_BOOL(age_code, true,
             "track un-executed functions to age code and flush only "
             "old code (required for code flushing)")
+DEFINE_BOOL(flush_bytecode, false,
+            "flush the bytecode of interpreted functions that have not "
+            "been executed for a while (requires code flushing)")
 DEFINE_BOOL(incremental_marking, true, "use incremental marking")
 DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
            "keep finalizing incremental marking as long as we discover at "
@@ -718,10 +776,15 @@ DEFINE_INT(min_progress_during_incremental_marking_finalization, 32,
 DEFINE_INT(max_incremental_marking_finalization_rounds, 3,
            "at most try this many times to finalize incremental marking")
 DEFINE_BOOL(black_allocation, false, "use black allocation")
+DEFINE_BOOL(concurrent_marking, false,
+            "use background tasks for marking during the atomic pause")
 DEFINE_BOOL(concurrent_sweeping, true, "use concurrent sweeping")
 DEFINE_BOOL(parallel_compaction, true, "use parallel compaction")
+DEFINE_BOOL(parallel_scavenge, false, "use background tasks for scavenging")
 DEFINE_BOOL(parallel_pointer_update, true,
             "use parallel pointer update during compaction")
+DEFINE_BOOL(parallel_weak_clearing, false,
+            "use background tasks for clearing dead weak references")
 DEFINE_BOOL(trace_incremental_marking, false,
             "trace progress of the incremental marking")
 DEFINE_BOOL(track_gc_object_stats, false,
@@ -739,10 +802,19 @@ DEFINE_BOOL(verify_heap, false, "verify heap pointers before and after GC")
 #endif
 DEFINE_BOOL(move_object_start, true, "enable moving of object starts")
 DEFINE_BOOL(memory_reducer, true, "use memory reducer")
+DEFINE_BOOL(discard_pooled_pages, false,
+            "pool released old and map space pages and discard their contents "
+            "instead of uncommitting them")
+DEFINE_INT(page_pool_size, 0,
+           "number of committed pages that are allocated ahead of time by a "
+           "background task (requires concurrent sweeping)")
 DEFINE_BOOL(scavenge_reclaim_unmodified_objects, true,
             "remove unmodified and unreferenced objects")
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
+DEFINE_INT(heap_soft_limit_percent, 0,
+           "percentage of the maximum old generation size above which the "
+           "heap grows slowly and compacts eagerly (0 disables the soft limit)")
 
 // counters.cc
 DEFINE_INT(histogram_interval, 600000,
@@ -886,6 +958,9 @@ DEFINE_BOOL(predictable, false, "enable predictable mode")
 DEFINE_NEG_IMPLICATION(predictable, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(predictable, concurrent_sweeping)
 DEFINE_NEG_IMPLICATION(predictable, parallel_compaction)
+DEFINE_NEG_IMPLICATION(predictable, parallel_scavenge)
+DEFINE_NEG_IMPLICATION(predictable, concurrent_marking)
+DEFINE_NEG_IMPLICATION(predictable, parallel_weak_clearing)
 DEFINE_NEG_IMPLICATION(predictable, memory_reducer)
 
 // mark-compact.cc
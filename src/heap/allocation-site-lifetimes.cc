@@ -0,0 +1,85 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/allocation-site-lifetimes.h"
+
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+void AllocationSiteLifetimes::RecordSurvivor(Address from, HeapObject* target,
+                                             AllocationSite* site) {
+  if (site != nullptr) {
+    Track(target, site, 1);
+    return;
+  }
+  if (survivors_.empty()) return;
+  auto it = survivors_.find(from);
+  if (it == survivors_.end()) return;
+  Survivor survivor = it->second;
+  survivors_.erase(it);
+  Track(target, survivor.site, survivor.age + 1);
+}
+
+void AllocationSiteLifetimes::Track(HeapObject* target, AllocationSite* site,
+                                    int age) {
+  Histogram& histogram = histograms_[site];
+  histogram.survived[Bucket(age)]++;
+  histogram.copied_bytes += target->Size();
+  // Promoted objects are not scavenged anymore.
+  if (heap_->InNewSpace(target)) {
+    Survivor survivor = {site, age};
+    next_survivors_[target->address()] = survivor;
+  }
+}
+
+void AllocationSiteLifetimes::FinishScavenge() {
+  for (auto& entry : survivors_) {
+    const Survivor& survivor = entry.second;
+    histograms_[survivor.site].died[Bucket(survivor.age)]++;
+  }
+  survivors_.swap(next_survivors_);
+  next_survivors_.clear();
+}
+
+void AllocationSiteLifetimes::Reset() {
+  survivors_.clear();
+  next_survivors_.clear();
+  histograms_.clear();
+}
+
+double AllocationSiteLifetimes::LongLivedRatio(AllocationSite* site) const {
+  auto it = histograms_.find(site);
+  if (it == histograms_.end()) return -1.0;
+  const Histogram& histogram = it->second;
+  // Objects promoted on their first scavenge have no known fate and are
+  // left out.
+  const int long_lived = histogram.survived[2];
+  const int resolved = long_lived + histogram.died[1];
+  if (resolved < kMinimumSamples) return -1.0;
+  return static_cast<double>(long_lived) / resolved;
+}
+
+void AllocationSiteLifetimes::Print() const {
+  STATIC_ASSERT(kMaxAge == 4);
+  for (auto& entry : histograms_) {
+    AllocationSite* site = entry.first;
+    const Histogram& h = entry.second;
+    PrintIsolate(heap_->isolate(),
+                 "pretenuring: AllocationSite(%p): (survived, died) by age "
+                 "1: (%d, %d) 2: (%d, %d) 3: (%d, %d) 4+: (%d, %d) "
+                 "copied: %" V8PRIdPTR " bytes, %s\n",
+                 static_cast<void*>(site), h.survived[1], h.died[1],
+                 h.survived[2], h.died[2], h.survived[3], h.died[3],
+                 h.survived[4], h.died[4], h.copied_bytes,
+                 site->PretenureDecisionName(site->pretenure_decision()));
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,105 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_ALLOCATION_SITE_LIFETIMES_H_
+#define V8_HEAP_ALLOCATION_SITE_LIFETIMES_H_
+
+#include <unordered_map>
+
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class AllocationSite;
+class Heap;
+class HeapObject;
+
+// Gathers per-allocation-site age histograms during scavenges.
+//
+// An allocation memento only trails an object until its first scavenge, so
+// objects that survived a scavenge with a memento are remembered by their
+// new-space address together with their site and age. Subsequent scavenges
+// look up the objects they copy and either age them or, if a tracked object
+// was not copied, count it as dead. Promoted objects leave the young
+// generation and are no longer tracked.
+//
+// Histograms are keyed by allocation site address and are dropped on every
+// mark-compact since both allocation sites and tracked objects may move.
+class AllocationSiteLifetimes {
+ public:
+  // Ages at or above kMaxAge share the last histogram bucket.
+  static const int kMaxAge = 4;
+
+  // Minimum number of objects with a known fate after their first scavenge
+  // before the histogram of a site is used for pretenuring decisions.
+  static const int kMinimumSamples = 50;
+
+  struct Histogram {
+    Histogram() : copied_bytes(0) {
+      for (int i = 0; i <= kMaxAge; i++) {
+        survived[i] = 0;
+        died[i] = 0;
+      }
+    }
+    // Number of objects that survived their {age}-th scavenge.
+    int survived[kMaxAge + 1];
+    // Number of objects that survived {age} scavenges but not the next one.
+    int died[kMaxAge + 1];
+    // Bytes copied by the scavenger for tracked objects.
+    intptr_t copied_bytes;
+  };
+
+  explicit AllocationSiteLifetimes(Heap* heap) : heap_(heap) {}
+
+  // Returns true if the object at the given from-space address is tracked.
+  // Only reads state and may be called concurrently during a scavenge.
+  bool IsTracked(Address address) const {
+    return !survivors_.empty() && survivors_.count(address) > 0;
+  }
+
+  // Records that the object formerly at {from} was copied to {target}.
+  // {site} is the allocation site of a memento found behind the object
+  // before it was copied, or nullptr.
+  void RecordSurvivor(Address from, HeapObject* target, AllocationSite* site);
+
+  // Counts tracked objects that were not copied during the scavenge as dead
+  // and starts tracking the copies recorded since.
+  void FinishScavenge();
+
+  // Drops all survivors and histograms.
+  void Reset();
+
+  // Returns the fraction of a site's objects that survived a second
+  // scavenge among those whose fate after the first one is known, or a
+  // negative value if there are not enough samples.
+  double LongLivedRatio(AllocationSite* site) const;
+
+  // Prints the histograms of all sites for --trace-pretenuring-histograms.
+  void Print() const;
+
+ private:
+  struct Survivor {
+    AllocationSite* site;
+    int age;
+  };
+
+  static int Bucket(int age) { return age < kMaxAge ? age : kMaxAge; }
+
+  void Track(HeapObject* target, AllocationSite* site, int age);
+
+  Heap* heap_;
+  // Tracked objects keyed by their address in from-space.
+  std::unordered_map<Address, Survivor> survivors_;
+  // Copies of tracked objects keyed by their address in to-space.
+  std::unordered_map<Address, Survivor> next_survivors_;
+  std::unordered_map<AllocationSite*, Histogram> histograms_;
+
+  DISALLOW_COPY_AND_ASSIGN(AllocationSiteLifetimes);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_ALLOCATION_SITE_LIFETIMES_H_
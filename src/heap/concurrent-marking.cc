@@ -0,0 +1,302 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/concurrent-marking.h"
+
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/mark-compact-inl.h"
+#include "src/heap/mark-compact.h"
+#include "src/heap/objects-visiting.h"
+#include "src/heap/remembered-set.h"
+#include "src/heap/spaces-inl.h"
+#include "src/objects-body-descriptors-inl.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+class ConcurrentMarking::Visitor final : public ObjectVisitor {
+ public:
+  explicit Visitor(TaskState* state) : state_(state), host_(nullptr) {}
+
+  // Visits the body of the given object if it only consists of plain tagged
+  // fields and returns true. Returns false for all other objects.
+  bool VisitBody(Map* map, HeapObject* object) {
+    const int size = object->SizeFromMap(map);
+    host_ = object;
+    switch (static_cast<StaticVisitorBase::VisitorId>(map->visitor_id())) {
+      case StaticVisitorBase::kVisitSeqOneByteString:
+      case StaticVisitorBase::kVisitSeqTwoByteString:
+      case StaticVisitorBase::kVisitByteArray:
+      case StaticVisitorBase::kVisitFreeSpace:
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+        break;
+      case StaticVisitorBase::kVisitFixedArray:
+        FixedArray::BodyDescriptor::IterateBody(object, size, this);
+        break;
+      case StaticVisitorBase::kVisitFixedTypedArray:
+      case StaticVisitorBase::kVisitFixedFloat64Array:
+        FixedTypedArrayBase::BodyDescriptor::IterateBody(object, size, this);
+        break;
+      case StaticVisitorBase::kVisitShortcutCandidate:
+      case StaticVisitorBase::kVisitConsString:
+        ConsString::BodyDescriptor::IterateBody(object, size, this);
+        break;
+      case StaticVisitorBase::kVisitSlicedString:
+        SlicedString::BodyDescriptor::IterateBody(object, size, this);
+        break;
+      case StaticVisitorBase::kVisitSymbol:
+        Symbol::BodyDescriptor::IterateBody(object, size, this);
+        break;
+      case StaticVisitorBase::kVisitOddball:
+        Oddball::BodyDescriptor::IterateBody(object, size, this);
+        break;
+      case StaticVisitorBase::kVisitCell:
+        Cell::BodyDescriptor::IterateBody(object, size, this);
+        break;
+      default: {
+        const int id = map->visitor_id();
+        if (id >= StaticVisitorBase::kVisitDataObject &&
+            id <= StaticVisitorBase::kVisitDataObjectGeneric) {
+          break;
+        }
+        if (id >= StaticVisitorBase::kVisitJSObject &&
+            id <= StaticVisitorBase::kVisitJSObjectGeneric) {
+          JSObject::BodyDescriptor::IterateBody(object, size, this);
+          break;
+        }
+        if (id >= StaticVisitorBase::kVisitStruct &&
+            id <= StaticVisitorBase::kVisitStructGeneric) {
+          StructBodyDescriptor::IterateBody(object, size, this);
+          break;
+        }
+        return false;
+      }
+    }
+    MarkObject(map);
+    return true;
+  }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* object = *p;
+      if (!object->IsHeapObject()) continue;
+      HeapObject* target = HeapObject::cast(object);
+      RecordSlot(p, target);
+      MarkObject(target);
+    }
+  }
+
+ private:
+  // Mirrors MarkCompactCollector::RecordSlot but buffers the slot because
+  // remembered sets cannot be updated concurrently.
+  void RecordSlot(Object** slot, HeapObject* target) {
+    Page* target_page = Page::FromAddress(target->address());
+    if (target_page->IsEvacuationCandidate() &&
+        !MarkCompactCollector::ShouldSkipEvacuationSlotRecording(host_)) {
+      state_->slots.push_back(std::make_pair(
+          Page::FromAddress(host_->address()), reinterpret_cast<Address>(slot)));
+    }
+  }
+
+  void MarkObject(HeapObject* object) {
+    MarkBit mark_bit = Marking::MarkBitFrom(object);
+    if (Marking::WhiteToBlackAtomic(mark_bit)) {
+      const int size = object->Size();
+      state_->live_bytes[MemoryChunk::FromAddress(object->address())] += size;
+      state_->marked_bytes += size;
+      state_->marking_stack.push_back(object);
+    }
+  }
+
+  TaskState* state_;
+  HeapObject* host_;
+};
+
+class ConcurrentMarking::Task : public CancelableTask {
+ public:
+  Task(Heap* heap, ConcurrentMarking* concurrent_marking,
+       base::Semaphore* on_finish)
+      : CancelableTask(heap->isolate()),
+        heap_(heap),
+        concurrent_marking_(concurrent_marking),
+        on_finish_(on_finish) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    TaskState state(true);
+    const double start = heap_->MonotonicallyIncreasingTimeInMs();
+    concurrent_marking_->MarkObjects(&state);
+    state.duration = heap_->MonotonicallyIncreasingTimeInMs() - start;
+    concurrent_marking_->FlushTaskState(&state);
+    on_finish_->Signal();
+  }
+
+  Heap* heap_;
+  ConcurrentMarking* concurrent_marking_;
+  base::Semaphore* on_finish_;
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+ConcurrentMarking::ConcurrentMarking(Heap* heap)
+    : heap_(heap),
+      started_tasks_(0),
+      idle_tasks_(0),
+      background_marked_bytes_(0),
+      background_duration_(0.0),
+      pending_tasks_semaphore_(0) {}
+
+int ConcurrentMarking::NumberOfTasks() {
+  return Min(kMaxTasks,
+             static_cast<int>(
+                 V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
+}
+
+bool ConcurrentMarking::ShouldProcess(MarkingDeque* marking_deque) {
+  // Object statistics are gathered by the main-thread marking visitor.
+  if (!FLAG_concurrent_marking || FLAG_track_gc_object_stats) return false;
+  if (NumberOfTasks() == 0) return false;
+  const int length = (marking_deque->top() - marking_deque->bottom()) &
+                     marking_deque->mask();
+  return length >= kMinObjectsToStartTasks;
+}
+
+void ConcurrentMarking::ProcessMarkingDeque(MarkingDeque* marking_deque) {
+  DCHECK(shared_.empty());
+  DCHECK(bailout_.empty());
+  while (!marking_deque->IsEmpty()) {
+    shared_.push_back(marking_deque->Pop());
+  }
+  started_tasks_ = 0;
+  idle_tasks_ = 0;
+  idle_tasks_hint_.SetValue(0);
+
+  const int num_tasks = NumberOfTasks();
+  uint32_t task_ids[kMaxTasks];
+  for (int i = 0; i < num_tasks; i++) {
+    Task* task = new Task(heap_, this, &pending_tasks_semaphore_);
+    task_ids[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+
+  // Contribute on main thread.
+  TaskState state(false);
+  MarkObjects(&state);
+  FlushTaskState(&state);
+
+  // Wait for background tasks.
+  for (int i = 0; i < num_tasks; i++) {
+    if (!heap_->isolate()->cancelable_task_manager()->TryAbort(task_ids[i])) {
+      pending_tasks_semaphore_.Wait();
+    }
+  }
+  DCHECK(shared_.empty());
+
+  for (auto& entry : live_bytes_) {
+    entry.first->IncrementLiveBytes(static_cast<int>(entry.second));
+  }
+  live_bytes_.clear();
+
+  for (auto& slot : slots_) {
+    RememberedSet<OLD_TO_OLD>::Insert(slot.first, slot.second);
+  }
+  slots_.clear();
+
+  // Bailout objects are black and accounted for in live bytes. Hand them over
+  // to the main-thread visitor like MarkCompactCollector::UnshiftBlack does.
+  for (HeapObject* object : bailout_) {
+    if (!marking_deque->Push(object)) {
+      MemoryChunk::IncrementLiveBytesFromGC(object, -object->Size());
+      Marking::BlackToGrey(object);
+    }
+  }
+  bailout_.clear();
+
+  heap_->tracer()->AddConcurrentMarkingStep(background_duration_,
+                                            background_marked_bytes_);
+  background_duration_ = 0.0;
+  background_marked_bytes_ = 0;
+}
+
+void ConcurrentMarking::MarkObjects(TaskState* state) {
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    started_tasks_++;
+  }
+  Map* filler_map = heap_->one_pointer_filler_map();
+  Visitor visitor(state);
+  do {
+    while (!state->marking_stack.empty()) {
+      HeapObject* object = state->marking_stack.back();
+      state->marking_stack.pop_back();
+      // Explicitly skip one word fillers, see
+      // MarkCompactCollector::EmptyMarkingDeque.
+      Map* map = object->map();
+      if (map == filler_map) continue;
+      if (!visitor.VisitBody(map, object)) {
+        state->bailout.push_back(object);
+        continue;
+      }
+      if (state->marking_stack.size() > static_cast<size_t>(kChunkSize) &&
+          idle_tasks_hint_.Value() > 0) {
+        ShareWork(state);
+      }
+    }
+  } while (TakeWork(state));
+}
+
+bool ConcurrentMarking::TakeWork(TaskState* state) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  idle_tasks_++;
+  idle_tasks_hint_.SetValue(idle_tasks_);
+  while (shared_.empty()) {
+    // Tasks that have not started yet cannot hold any work. Marking is
+    // complete once all started tasks are idle.
+    if (idle_tasks_ == started_tasks_) {
+      work_available_.NotifyAll();
+      return false;
+    }
+    work_available_.Wait(&mutex_);
+  }
+  idle_tasks_--;
+  idle_tasks_hint_.SetValue(idle_tasks_);
+  const size_t count = Min(shared_.size(), static_cast<size_t>(kChunkSize));
+  state->marking_stack.insert(state->marking_stack.end(),
+                              shared_.end() - count, shared_.end());
+  shared_.resize(shared_.size() - count);
+  return true;
+}
+
+void ConcurrentMarking::ShareWork(TaskState* state) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  // Share the bottom of the local stack which tends to hold objects closer to
+  // the roots with larger subgraphs.
+  std::vector<HeapObject*>& stack = state->marking_stack;
+  shared_.insert(shared_.end(), stack.begin(), stack.begin() + kChunkSize);
+  stack.erase(stack.begin(), stack.begin() + kChunkSize);
+  work_available_.NotifyAll();
+}
+
+void ConcurrentMarking::FlushTaskState(TaskState* state) {
+  DCHECK(state->marking_stack.empty());
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  bailout_.insert(bailout_.end(), state->bailout.begin(), state->bailout.end());
+  slots_.insert(slots_.end(), state->slots.begin(), state->slots.end());
+  for (auto& entry : state->live_bytes) {
+    live_bytes_[entry.first] += entry.second;
+  }
+  if (state->background) {
+    background_marked_bytes_ += state->marked_bytes;
+    background_duration_ += state->duration;
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
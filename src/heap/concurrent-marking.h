@@ -0,0 +1,122 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CONCURRENT_MARKING_H_
+#define V8_HEAP_CONCURRENT_MARKING_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "src/allocation.h"
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/cancelable-task.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+class Map;
+class MarkingDeque;
+class MemoryChunk;
+class Page;
+
+// Drains the marking deque of the mark-compact collector with the help of
+// background tasks posted through v8::Platform::CallOnBackgroundThread.
+//
+// Objects are marked using atomic mark bit transitions. Each task keeps a
+// local marking stack and shares work through a global pool that idle tasks
+// steal from. Only objects whose body consists of plain tagged fields are
+// visited off the main thread. Everything else (maps, code, functions,
+// weak objects, ...) needs the side effects of the main-thread marking
+// visitor and is handed back to the main thread as a bailout object.
+//
+// Live bytes and recorded slots are buffered per task and applied by the main
+// thread once all tasks have finished.
+class ConcurrentMarking {
+ public:
+  explicit ConcurrentMarking(Heap* heap);
+
+  // Returns true if it is worth draining the given deque with the help of
+  // background tasks.
+  bool ShouldProcess(MarkingDeque* marking_deque);
+
+  // Transitively marks everything reachable from the objects on the deque.
+  // Blocks until all tasks have finished. Upon return the deque only contains
+  // bailout objects that have to be visited by the main-thread visitor.
+  void ProcessMarkingDeque(MarkingDeque* marking_deque);
+
+ private:
+  class Task;
+  class Visitor;
+
+  // Number of objects moved between a task-local marking stack and the
+  // shared pool at once.
+  static const int kChunkSize = 128;
+
+  // Minimum number of objects on the marking deque to start background tasks.
+  static const int kMinObjectsToStartTasks = 2 * kChunkSize;
+
+  static const int kMaxTasks = 4;
+
+  struct TaskState {
+    explicit TaskState(bool background)
+        : background(background), marked_bytes(0), duration(0.0) {}
+    bool background;
+    std::vector<HeapObject*> marking_stack;
+    std::vector<HeapObject*> bailout;
+    std::vector<std::pair<Page*, Address>> slots;
+    std::unordered_map<MemoryChunk*, intptr_t> live_bytes;
+    intptr_t marked_bytes;
+    double duration;
+  };
+
+  int NumberOfTasks();
+
+  // Runs the marking loop of a single task. Called on the main thread as well
+  // as on background threads.
+  void MarkObjects(TaskState* state);
+
+  // Moves a chunk of objects from the shared pool to the task-local stack.
+  // Returns false once all started tasks ran out of work.
+  bool TakeWork(TaskState* state);
+
+  // Moves a chunk of objects from the task-local stack to the shared pool if
+  // other tasks are waiting for work.
+  void ShareWork(TaskState* state);
+
+  // Hands buffered results of a task over to the main thread.
+  void FlushTaskState(TaskState* state);
+
+  Heap* heap_;
+
+  // Guards the shared state below.
+  base::Mutex mutex_;
+  base::ConditionVariable work_available_;
+  std::vector<HeapObject*> shared_;
+  int started_tasks_;
+  int idle_tasks_;
+  base::AtomicNumber<int> idle_tasks_hint_;
+
+  std::vector<HeapObject*> bailout_;
+  std::vector<std::pair<Page*, Address>> slots_;
+  std::unordered_map<MemoryChunk*, intptr_t> live_bytes_;
+  intptr_t background_marked_bytes_;
+  double background_duration_;
+
+  // Signaled by every finished background task. Has the same lifetime as the
+  // isolate, see PageParallelJob for the reason.
+  base::Semaphore pending_tasks_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConcurrentMarking);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CONCURRENT_MARKING_H_
@@ -15,6 +15,7 @@ const double GCIdleTimeHandler::kConservativeTimeRatio = 0.9;
 const size_t GCIdleTimeHandler::kMaxFinalIncrementalMarkCompactTimeInMs = 1000;
 const double GCIdleTimeHandler::kHighContextDisposalRate = 100;
 const size_t GCIdleTimeHandler::kMinTimeForOverApproximatingWeakClosureInMs = 1;
+const double GCIdleTimeHandler::kIdleScavengeFillRatio = 0.5;
 
 
 void GCIdleTimeAction::Print() {
@@ -34,6 +35,12 @@ void GCIdleTimeAction::Print() {
     case DO_FULL_GC:
       PrintF("full GC");
       break;
+    case DO_SCAVENGE:
+      PrintF("scavenge");
+      break;
+    case DO_START_INCREMENTAL_MARKING:
+      PrintF("start incremental marking");
+      break;
   }
 }
 
@@ -43,6 +50,12 @@ void GCIdleTimeHeapState::Print() {
   PrintF("contexts_disposal_rate=%f ", contexts_disposal_rate);
   PrintF("size_of_objects=%" PRIuS " ", size_of_objects);
   PrintF("incremental_marking_stopped=%d ", incremental_marking_stopped);
+  PrintF("used_new_space_size=%" PRIuS " ", used_new_space_size);
+  PrintF("new_space_capacity=%" PRIuS " ", new_space_capacity);
+  PrintF("scavenge_speed=%f ", scavenge_speed_in_bytes_per_ms);
+  PrintF("mark_compact_speed=%f ", mark_compact_speed_in_bytes_per_ms);
+  PrintF("can_start_incremental_marking=%d ", can_start_incremental_marking);
+  PrintF("high_fragmentation=%d ", high_fragmentation);
 }
 
 size_t GCIdleTimeHandler::EstimateMarkingStepSize(
@@ -93,6 +106,33 @@ bool GCIdleTimeHandler::ShouldDoOverApproximateWeakClosure(
   return idle_time_in_ms >= kMinTimeForOverApproximatingWeakClosureInMs;
 }
 
+double GCIdleTimeHandler::EstimateScavengeTime(
+    size_t used_new_space_size, double scavenge_speed_in_bytes_per_ms) {
+  if (scavenge_speed_in_bytes_per_ms == 0) {
+    scavenge_speed_in_bytes_per_ms = kInitialConservativeScavengeSpeed;
+  }
+  return used_new_space_size / scavenge_speed_in_bytes_per_ms;
+}
+
+bool GCIdleTimeHandler::ShouldDoScavenge(
+    double idle_time_in_ms, size_t new_space_capacity,
+    size_t used_new_space_size, double scavenge_speed_in_bytes_per_ms) {
+  if (used_new_space_size < new_space_capacity * kIdleScavengeFillRatio) {
+    return false;
+  }
+  return idle_time_in_ms * kConservativeTimeRatio >=
+         EstimateScavengeTime(used_new_space_size,
+                              scavenge_speed_in_bytes_per_ms);
+}
+
+double GCIdleTimeHandler::EstimateMarkCompactTime(
+    size_t size_of_objects, double mark_compact_speed_in_bytes_per_ms) {
+  if (mark_compact_speed_in_bytes_per_ms == 0) {
+    mark_compact_speed_in_bytes_per_ms = kInitialConservativeMarkCompactSpeed;
+  }
+  return size_of_objects / mark_compact_speed_in_bytes_per_ms;
+}
+
 
 GCIdleTimeAction GCIdleTimeHandler::NothingOrDone(double idle_time_in_ms) {
   if (idle_time_in_ms >= kMinBackgroundIdleTime) {
@@ -147,5 +187,50 @@ GCIdleTimeAction GCIdleTimeHandler::Compute(double idle_time_in_ms,
 }
 
 
+// The following logic is implemented for embedders that report idle time
+// together with a latency budget:
+// (1) If new space is filled far enough and a scavenge fits into the budget,
+// a scavenge is performed.
+// (2) If incremental marking is in progress, we perform a marking step of at
+// most the budget. The step finalizes marking if the estimated finalization
+// time fits.
+// (3) If contexts were disposed or the old generation is fragmented, and a
+// full GC fits into the budget, a memory reducing full GC is performed.
+// (4) If the old generation is large enough to start incremental marking, it
+// is started.
+GCIdleTimeAction GCIdleTimeHandler::ComputeWithLatencyBudget(
+    double idle_time_in_ms, double latency_budget_in_ms,
+    GCIdleTimeHeapState heap_state) {
+  const double pause_in_ms = Min(idle_time_in_ms, latency_budget_in_ms);
+  if (pause_in_ms <= 0) return GCIdleTimeAction::Nothing();
+
+  if (ShouldDoScavenge(pause_in_ms, heap_state.new_space_capacity,
+                       heap_state.used_new_space_size,
+                       heap_state.scavenge_speed_in_bytes_per_ms)) {
+    return GCIdleTimeAction::Scavenge();
+  }
+
+  if (!heap_state.incremental_marking_stopped) {
+    return GCIdleTimeAction::IncrementalStep();
+  }
+
+  if ((ShouldDoContextDisposalMarkCompact(heap_state.contexts_disposed,
+                                          heap_state.contexts_disposal_rate) ||
+       heap_state.high_fragmentation) &&
+      pause_in_ms * kConservativeTimeRatio >=
+          EstimateMarkCompactTime(
+              heap_state.size_of_objects,
+              heap_state.mark_compact_speed_in_bytes_per_ms)) {
+    return GCIdleTimeAction::FullGC();
+  }
+
+  if (FLAG_incremental_marking && heap_state.can_start_incremental_marking) {
+    return GCIdleTimeAction::StartIncrementalMarking();
+  }
+
+  return GCIdleTimeAction::Done();
+}
+
+
 }  // namespace internal
 }  // namespace v8
@@ -15,6 +15,8 @@ enum GCIdleTimeActionType {
   DO_NOTHING,
   DO_INCREMENTAL_STEP,
   DO_FULL_GC,
+  DO_SCAVENGE,
+  DO_START_INCREMENTAL_MARKING,
 };
 
 
@@ -48,6 +50,20 @@ class GCIdleTimeAction {
     return result;
   }
 
+  static GCIdleTimeAction Scavenge() {
+    GCIdleTimeAction result;
+    result.type = DO_SCAVENGE;
+    result.additional_work = false;
+    return result;
+  }
+
+  static GCIdleTimeAction StartIncrementalMarking() {
+    GCIdleTimeAction result;
+    result.type = DO_START_INCREMENTAL_MARKING;
+    result.additional_work = false;
+    return result;
+  }
+
   void Print();
 
   GCIdleTimeActionType type;
@@ -63,6 +79,32 @@ class GCIdleTimeHeapState {
   double contexts_disposal_rate;
   size_t size_of_objects;
   bool incremental_marking_stopped;
+
+  // Only used by GCIdleTimeHandler::ComputeWithLatencyBudget.
+  size_t used_new_space_size;
+  size_t new_space_capacity;
+  double scavenge_speed_in_bytes_per_ms;
+  double mark_compact_speed_in_bytes_per_ms;
+  bool can_start_incremental_marking;
+  bool high_fragmentation;
+};
+
+
+// Garbage collection work done by Heap::IdleTimeGarbageCollection.
+class GCIdleTimeReport {
+ public:
+  GCIdleTimeReport()
+      : used_time_in_ms(0),
+        scavenges(0),
+        incremental_marking_steps(0),
+        mark_compacts(0),
+        done(false) {}
+
+  double used_time_in_ms;
+  int scavenges;
+  int incremental_marking_steps;
+  int mark_compacts;
+  bool done;
 };
 
 
@@ -120,11 +162,26 @@ class GCIdleTimeHandler {
   // ensure we don't keep scheduling idle tasks and making no progress.
   static const int kMaxNoProgressIdleTimes = 10;
 
+  // If we haven't recorded any scavenge events yet, we use a conservative
+  // lower bound for the scavenge speed.
+  static const size_t kInitialConservativeScavengeSpeed = 100 * KB;
+
+  // Idle time scavenges are only done once new space is filled to this
+  // fraction, as the cost of a scavenge does not depend much on the amount
+  // of garbage.
+  static const double kIdleScavengeFillRatio;
+
   GCIdleTimeHandler() : idle_times_which_made_no_progress_(0) {}
 
   GCIdleTimeAction Compute(double idle_time_in_ms,
                            GCIdleTimeHeapState heap_state);
 
+  // Computes the next action for an idle period of {idle_time_in_ms} in which
+  // no single action may take longer than {latency_budget_in_ms}.
+  GCIdleTimeAction ComputeWithLatencyBudget(double idle_time_in_ms,
+                                            double latency_budget_in_ms,
+                                            GCIdleTimeHeapState heap_state);
+
   void ResetNoProgressCounter() { idle_times_which_made_no_progress_ = 0; }
 
   static size_t EstimateMarkingStepSize(double idle_time_in_ms,
@@ -142,6 +199,17 @@ class GCIdleTimeHandler {
 
   static bool ShouldDoOverApproximateWeakClosure(double idle_time_in_ms);
 
+  static double EstimateScavengeTime(size_t used_new_space_size,
+                                     double scavenge_speed_in_bytes_per_ms);
+
+  static bool ShouldDoScavenge(double idle_time_in_ms,
+                               size_t new_space_capacity,
+                               size_t used_new_space_size,
+                               double scavenge_speed_in_bytes_per_ms);
+
+  static double EstimateMarkCompactTime(
+      size_t size_of_objects, double mark_compact_speed_in_bytes_per_ms);
+
  private:
   GCIdleTimeAction NothingOrDone(double idle_time_in_ms);
 
@@ -77,10 +77,17 @@ GCTracer::Event::Event(Type type, const char* gc_reason,
       incremental_marking_duration(0.0),
       cumulative_pure_incremental_marking_duration(0.0),
       pure_incremental_marking_duration(0.0),
-      longest_incremental_marking_step(0.0) {
+      longest_incremental_marking_step(0.0),
+      concurrent_marking_duration(0.0),
+      concurrent_marking_bytes(0),
+      parallel_scavenge_duration(0.0),
+      parallel_scavenge_bytes(0) {
   for (int i = 0; i < Scope::NUMBER_OF_SCOPES; i++) {
     scopes[i] = 0;
   }
+  for (int i = 0; i <= LAST_PAGED_SPACE; i++) {
+    background_sweeping_duration[i] = 0;
+  }
 }
 
 
@@ -122,6 +129,7 @@ GCTracer::GCTracer(Heap* heap)
       longest_incremental_marking_finalization_step_(0.0),
       cumulative_marking_duration_(0.0),
       cumulative_sweeping_duration_(0.0),
+      cumulative_background_sweeping_duration_(0.0),
       allocation_time_ms_(0.0),
       new_space_allocation_counter_bytes_(0),
       old_generation_allocation_counter_bytes_(0),
@@ -130,6 +138,9 @@ GCTracer::GCTracer(Heap* heap)
       old_generation_allocation_in_bytes_since_gc_(0),
       combined_mark_compact_speed_cache_(0.0),
       start_counter_(0) {
+  for (int i = 0; i <= LAST_PAGED_SPACE; i++) {
+    background_sweeping_duration_[i] = 0.0;
+  }
   current_ = Event(Event::START, NULL, NULL);
   current_.end_time = heap_->MonotonicallyIncreasingTimeInMs();
   previous_ = previous_incremental_mark_compactor_event_ = current_;
@@ -146,6 +157,10 @@ void GCTracer::ResetForTesting() {
   longest_incremental_marking_finalization_step_ = 0.0;
   cumulative_marking_duration_ = 0.0;
   cumulative_sweeping_duration_ = 0.0;
+  cumulative_background_sweeping_duration_ = 0.0;
+  for (int i = 0; i <= LAST_PAGED_SPACE; i++) {
+    background_sweeping_duration_[i] = 0.0;
+  }
   allocation_time_ms_ = 0.0;
   new_space_allocation_counter_bytes_ = 0.0;
   old_generation_allocation_counter_bytes_ = 0.0;
@@ -294,6 +309,14 @@ void GCTracer::Stop(GarbageCollector collector) {
     combined_mark_compact_speed_cache_ = 0.0;
   }
 
+  if (current_.type != Event::SCAVENGER) {
+    for (int i = 0; i <= LAST_PAGED_SPACE; i++) {
+      current_.background_sweeping_duration[i] =
+          background_sweeping_duration_[i];
+      background_sweeping_duration_[i] = 0.0;
+    }
+  }
+
   // TODO(ernstm): move the code below out of GCTracer.
 
   double spent_in_mutator = Max(current_.start_time - previous_.end_time, 0.0);
@@ -403,6 +426,23 @@ void GCTracer::AddIncrementalMarkingFinalizationStep(double duration) {
       Max(longest_incremental_marking_finalization_step_, duration);
 }
 
+void GCTracer::AddConcurrentMarkingStep(double duration, intptr_t bytes) {
+  current_.concurrent_marking_duration += duration;
+  current_.concurrent_marking_bytes += bytes;
+}
+
+void GCTracer::AddParallelScavengeStep(double duration, intptr_t bytes) {
+  current_.parallel_scavenge_duration += duration;
+  current_.parallel_scavenge_bytes += bytes;
+}
+
+void GCTracer::AddBackgroundSweepingTime(AllocationSpace space,
+                                         double duration) {
+  DCHECK_LE(space, LAST_PAGED_SPACE);
+  background_sweeping_duration_[space] += duration;
+  cumulative_background_sweeping_duration_ += duration;
+}
+
 
 void GCTracer::Output(const char* format, ...) const {
   if (FLAG_trace_gc) {
@@ -484,6 +524,7 @@ void GCTracer::PrintNVP() const {
                    "reduce_memory=%d "
                    "scavenge=%.2f "
                    "old_new=%.2f "
+                   "parallel=%.2f "
                    "weak=%.2f "
                    "roots=%.2f "
                    "code=%.2f "
@@ -495,6 +536,9 @@ void GCTracer::PrintNVP() const {
                    "steps_count=%d "
                    "steps_took=%.1f "
                    "scavenge_throughput=%.f "
+                   "parallel_scavenge_took=%.1f "
+                   "parallel_scavenge_bytes=%" V8PRIdPTR
+                   " "
                    "total_size_before=%" V8PRIdPTR
                    " "
                    "total_size_after=%" V8PRIdPTR
@@ -523,6 +567,7 @@ void GCTracer::PrintNVP() const {
                    current_.reduce_memory,
                    current_.scopes[Scope::SCAVENGER_SCAVENGE],
                    current_.scopes[Scope::SCAVENGER_OLD_TO_NEW_POINTERS],
+                   current_.scopes[Scope::SCAVENGER_PARALLEL],
                    current_.scopes[Scope::SCAVENGER_WEAK],
                    current_.scopes[Scope::SCAVENGER_ROOTS],
                    current_.scopes[Scope::SCAVENGER_CODE_FLUSH_CANDIDATES],
@@ -534,9 +579,11 @@ void GCTracer::PrintNVP() const {
                    current_.incremental_marking_steps,
                    current_.incremental_marking_duration,
                    ScavengeSpeedInBytesPerMillisecond(),
-                   current_.start_object_size, current_.end_object_size,
-                   current_.start_holes_size, current_.end_holes_size,
-                   allocated_since_last_gc, heap_->promoted_objects_size(),
+                   current_.parallel_scavenge_duration,
+                   current_.parallel_scavenge_bytes, current_.start_object_size,
+                   current_.end_object_size, current_.start_holes_size,
+                   current_.end_holes_size, allocated_since_last_gc,
+                   heap_->promoted_objects_size(),
                    heap_->semi_space_copied_object_size(),
                    heap_->nodes_died_in_new_space_,
                    heap_->nodes_copied_in_new_space_, heap_->nodes_promoted_,
@@ -557,6 +604,7 @@ void GCTracer::PrintNVP() const {
           "clear=%1.f "
           "clear.code_flush=%.1f "
           "clear.dependent_code=%.1f "
+          "clear.external_string_table=%.1f "
           "clear.global_handles=%.1f "
           "clear.maps=%.1f "
           "clear.slots_buffer=%.1f "
@@ -580,6 +628,7 @@ void GCTracer::PrintNVP() const {
           "external.weak_global_handles=%.1f "
           "finish=%.1f "
           "mark=%.1f "
+          "mark.concurrent=%.1f "
           "mark.finish_incremental=%.1f "
           "mark.prepare_code_flush=%.1f "
           "mark.roots=%.1f "
@@ -600,6 +649,12 @@ void GCTracer::PrintNVP() const {
           "finalization_steps_took=%.1f "
           "finalization_longest_step=%.1f "
           "incremental_marking_throughput=%.f "
+          "concurrent_marking_took=%.1f "
+          "concurrent_marking_bytes=%" V8PRIdPTR
+          " "
+          "background_sweeping.code=%.1f "
+          "background_sweeping.map=%.1f "
+          "background_sweeping.old=%.1f "
           "total_size_before=%" V8PRIdPTR
           " "
           "total_size_after=%" V8PRIdPTR
@@ -629,6 +684,7 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::MC_CLEAR],
           current_.scopes[Scope::MC_CLEAR_CODE_FLUSH],
           current_.scopes[Scope::MC_CLEAR_DEPENDENT_CODE],
+          current_.scopes[Scope::MC_CLEAR_EXTERNAL_STRING_TABLE],
           current_.scopes[Scope::MC_CLEAR_GLOBAL_HANDLES],
           current_.scopes[Scope::MC_CLEAR_MAPS],
           current_.scopes[Scope::MC_CLEAR_SLOTS_BUFFER],
@@ -651,6 +707,7 @@ void GCTracer::PrintNVP() const {
           current_.scopes[Scope::MC_INCREMENTAL_EXTERNAL_EPILOGUE],
           current_.scopes[Scope::EXTERNAL_WEAK_GLOBAL_HANDLES],
           current_.scopes[Scope::MC_FINISH], current_.scopes[Scope::MC_MARK],
+          current_.scopes[Scope::MC_MARK_CONCURRENT],
           current_.scopes[Scope::MC_MARK_FINISH_INCREMENTAL],
           current_.scopes[Scope::MC_MARK_PREPARE_CODE_FLUSH],
           current_.scopes[Scope::MC_MARK_ROOTS],
@@ -671,9 +728,15 @@ void GCTracer::PrintNVP() const {
           cumulative_incremental_marking_finalization_duration_,
           longest_incremental_marking_finalization_step_,
           IncrementalMarkingSpeedInBytesPerMillisecond(),
-          current_.start_object_size, current_.end_object_size,
-          current_.start_holes_size, current_.end_holes_size,
-          allocated_since_last_gc, heap_->promoted_objects_size(),
+          current_.concurrent_marking_duration,
+          current_.concurrent_marking_bytes,
+          current_.background_sweeping_duration[CODE_SPACE],
+          current_.background_sweeping_duration[MAP_SPACE],
+          current_.background_sweeping_duration[OLD_SPACE],
+          current_.start_object_size,
+          current_.end_object_size, current_.start_holes_size,
+          current_.end_holes_size, allocated_since_last_gc,
+          heap_->promoted_objects_size(),
           heap_->semi_space_copied_object_size(),
           heap_->nodes_died_in_new_space_, heap_->nodes_copied_in_new_space_,
           heap_->nodes_promoted_, heap_->promotion_ratio_,
@@ -64,6 +64,7 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   F(MC_CLEAR)                                      \
   F(MC_CLEAR_CODE_FLUSH)                           \
   F(MC_CLEAR_DEPENDENT_CODE)                       \
+  F(MC_CLEAR_EXTERNAL_STRING_TABLE)                \
   F(MC_CLEAR_GLOBAL_HANDLES)                       \
   F(MC_CLEAR_MAPS)                                 \
   F(MC_CLEAR_SLOTS_BUFFER)                         \
@@ -87,6 +88,7 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   F(MC_INCREMENTAL_EXTERNAL_EPILOGUE)              \
   F(MC_INCREMENTAL_EXTERNAL_PROLOGUE)              \
   F(MC_MARK)                                       \
+  F(MC_MARK_CONCURRENT)                            \
   F(MC_MARK_FINISH_INCREMENTAL)                    \
   F(MC_MARK_PREPARE_CODE_FLUSH)                    \
   F(MC_MARK_ROOTS)                                 \
@@ -104,6 +106,7 @@ enum ScavengeSpeedMode { kForAllObjects, kForSurvivedObjects };
   F(SCAVENGER_EXTERNAL_PROLOGUE)                   \
   F(SCAVENGER_OBJECT_GROUPS)                       \
   F(SCAVENGER_OLD_TO_NEW_POINTERS)                 \
+  F(SCAVENGER_PARALLEL)                            \
   F(SCAVENGER_ROOTS)                               \
   F(SCAVENGER_SCAVENGE)                            \
   F(SCAVENGER_SEMISPACE)                           \
@@ -243,6 +246,19 @@ class GCTracer {
     // (value at start of event)
     double longest_incremental_marking_step;
 
+    // Time spent and bytes marked by background marking tasks.
+    double concurrent_marking_duration;
+    intptr_t concurrent_marking_bytes;
+
+    // Time spent and bytes copied by background scavenging tasks.
+    double parallel_scavenge_duration;
+    intptr_t parallel_scavenge_bytes;
+
+    // Time spent by sweeper tasks per paged space since the last
+    // mark-compact. Sweeping done on sweeper tasks no longer adds to the
+    // pause, so this is the main-thread time saved.
+    double background_sweeping_duration[LAST_PAGED_SPACE + 1];
+
     // Amounts of time spent in different scopes during GC.
     double scopes[Scope::NUMBER_OF_SCOPES];
   };
@@ -276,6 +292,12 @@ class GCTracer {
 
   void AddIncrementalMarkingFinalizationStep(double duration);
 
+  // Log marking work done by background tasks.
+  void AddConcurrentMarkingStep(double duration, intptr_t bytes);
+
+  // Log scavenging work done by background tasks.
+  void AddParallelScavengeStep(double duration, intptr_t bytes);
+
   // Log time spent in marking.
   void AddMarkingTime(double duration) {
     cumulative_marking_duration_ += duration;
@@ -296,6 +318,22 @@ class GCTracer {
     return cumulative_sweeping_duration_;
   }
 
+  // Log time spent by sweeper tasks on the given paged space. Reported with
+  // the next mark-compact event.
+  void AddBackgroundSweepingTime(AllocationSpace space, double duration);
+
+  // Time spent in sweeping on sweeper tasks.
+  double cumulative_background_sweeping_duration() const {
+    return cumulative_background_sweeping_duration_;
+  }
+
+  // Time spent in sweeping on sweeper tasks for the given paged space, as
+  // reported with the last mark-compact event.
+  double background_sweeping_duration(AllocationSpace space) const {
+    DCHECK_LE(space, LAST_PAGED_SPACE);
+    return current_.background_sweeping_duration[space];
+  }
+
   // Compute the average incremental marking speed in bytes/millisecond.
   // Returns 0 if no events have been recorded.
   double IncrementalMarkingSpeedInBytesPerMillisecond() const;
@@ -398,6 +436,7 @@ class GCTracer {
     longest_incremental_marking_finalization_step_ = 0;
     cumulative_marking_duration_ = 0;
     cumulative_sweeping_duration_ = 0;
+    cumulative_background_sweeping_duration_ = 0;
   }
 
   double TotalExternalTime() const {
@@ -457,13 +496,17 @@ class GCTracer {
 
   // Total sweeping time on the main thread.
   // This timer is precise when run with --print-cumulative-gc-stat
-  // TODO(hpayer): Account for sweeping time on sweeper threads. Add a
-  // different field for that.
   // TODO(hpayer): This timer right now just holds the sweeping time
   // of the initial atomic sweeping pause. Make sure that it accumulates
   // all sweeping operations performed on the main thread.
   double cumulative_sweeping_duration_;
 
+  // Total sweeping time on sweeper tasks.
+  double cumulative_background_sweeping_duration_;
+
+  // Sweeper task time per paged space not yet reported with an event.
+  double background_sweeping_duration_[LAST_PAGED_SPACE + 1];
+
   // Timestamp and allocation counter at the last sampled allocation event.
   double allocation_time_ms_;
   size_t new_space_allocation_counter_bytes_;
@@ -550,20 +550,20 @@ AllocationMemento* Heap::FindAllocationMemento(HeapObject* object) {
 }
 
 template <Heap::UpdateAllocationSiteMode mode>
-void Heap::UpdateAllocationSite(HeapObject* object,
-                                base::HashMap* pretenuring_feedback) {
+Address Heap::UpdateAllocationSite(HeapObject* object,
+                                   base::HashMap* pretenuring_feedback) {
   DCHECK(InFromSpace(object));
   if (!FLAG_allocation_site_pretenuring ||
       !AllocationSite::CanTrack(object->map()->instance_type()))
-    return;
+    return nullptr;
   AllocationMemento* memento_candidate = FindAllocationMemento<kForGC>(object);
-  if (memento_candidate == nullptr) return;
+  if (memento_candidate == nullptr) return nullptr;
 
   if (mode == kGlobal) {
     DCHECK_EQ(pretenuring_feedback, global_pretenuring_feedback_);
     // Entering global pretenuring feedback is only used in the scavenger, where
     // we are allowed to actually touch the allocation site.
-    if (!memento_candidate->IsValid()) return;
+    if (!memento_candidate->IsValid()) return nullptr;
     AllocationSite* site = memento_candidate->GetAllocationSite();
     DCHECK(!site->IsZombie());
     // For inserting in the global pretenuring storage we need to first
@@ -572,6 +572,7 @@ void Heap::UpdateAllocationSite(HeapObject* object,
       global_pretenuring_feedback_->LookupOrInsert(site,
                                                    ObjectHash(site->address()));
     }
+    return reinterpret_cast<Address>(site);
   } else {
     DCHECK_EQ(mode, kCached);
     DCHECK_NE(pretenuring_feedback, global_pretenuring_feedback_);
@@ -583,6 +584,7 @@ void Heap::UpdateAllocationSite(HeapObject* object,
         pretenuring_feedback->LookupOrInsert(key, ObjectHash(key));
     DCHECK(e != nullptr);
     (*bit_cast<intptr_t*>(&e->value))++;
+    return key;
   }
 }
 
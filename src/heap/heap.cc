@@ -17,6 +17,7 @@
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
 #include "src/global-handles.h"
+#include "src/heap/allocation-site-lifetimes.h"
 #include "src/heap/array-buffer-tracker-inl.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "src/heap/gc-tracer.h"
@@ -27,6 +28,7 @@
 #include "src/heap/object-stats.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
+#include "src/heap/parallel-scavenger.h"
 #include "src/heap/remembered-set.h"
 #include "src/heap/scavenge-job.h"
 #include "src/heap/scavenger-inl.h"
@@ -78,6 +80,7 @@ Heap::Heap()
       max_semi_space_size_(8 * (kPointerSize / 4) * MB),
       initial_semispace_size_(Page::kPageSize),
       max_old_generation_size_(700ul * (kPointerSize / 4) * MB),
+      initial_max_old_generation_size_(max_old_generation_size_),
       initial_old_generation_size_(max_old_generation_size_ /
                                    kInitalOldGenerationLimitFactor),
       old_generation_size_configured_(false),
@@ -112,6 +115,7 @@ Heap::Heap()
       old_generation_allocation_limit_(initial_old_generation_size_),
       old_gen_exhausted_(false),
       optimize_for_memory_usage_(false),
+      above_soft_heap_limit_(false),
       inline_allocation_disabled_(false),
       total_regexp_code_generated_(0),
       tracer_(nullptr),
@@ -134,6 +138,8 @@ Heap::Heap()
       last_idle_notification_time_(0.0),
       last_gc_time_(0.0),
       scavenge_collector_(nullptr),
+      parallel_scavenger_(nullptr),
+      allocation_site_lifetimes_(nullptr),
       mark_compact_collector_(nullptr),
       memory_allocator_(nullptr),
       store_buffer_(this),
@@ -571,7 +577,12 @@ void Heap::ProcessPretenuringFeedback() {
         DCHECK(site->IsAllocationSite());
         active_allocation_sites++;
         allocation_mementos_found += found_count;
-        if (site->DigestPretenuringFeedback(maximum_size_scavenge)) {
+        double long_lived_ratio =
+            FLAG_pretenuring_histograms
+                ? allocation_site_lifetimes_->LongLivedRatio(site)
+                : -1.0;
+        if (site->DigestPretenuringFeedback(maximum_size_scavenge,
+                                            long_lived_ratio)) {
           trigger_deoptimization = true;
         }
         if (site->GetPretenureMode() == TENURED) {
@@ -613,6 +624,10 @@ void Heap::ProcessPretenuringFeedback() {
                    active_allocation_sites, allocation_mementos_found,
                    tenure_decisions, dont_tenure_decisions);
     }
+
+    if (FLAG_trace_pretenuring_histograms) {
+      allocation_site_lifetimes_->Print();
+    }
   }
 }
 
@@ -1028,6 +1043,7 @@ bool Heap::CollectGarbage(GarbageCollector collector, const char* gc_reason,
           (detached_contexts()->length() > 0);
       if (deserialization_complete_) {
         memory_reducer_->NotifyMarkCompact(event);
+        CheckHeapLimits(used_memory_after);
       }
       memory_pressure_level_.SetValue(MemoryPressureLevel::kNone);
     }
@@ -1419,6 +1435,9 @@ void Heap::MarkCompact() {
 
   ms_count_++;
 
+  // Allocation sites and tracked young objects may move.
+  if (FLAG_pretenuring_histograms) allocation_site_lifetimes_->Reset();
+
   MarkCompactPrologue();
 
   mark_compact_collector()->CollectGarbage();
@@ -1667,53 +1686,62 @@ void Heap::Scavenge() {
         &IsUnmodifiedHeapObject);
   }
 
-  {
-    // Copy roots.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
-    IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
-  }
+  if (parallel_scavenger_->ShouldScavengeInParallel()) {
+    parallel_scavenger_->Scavenge();
+    // All objects copied so far have been visited. Weak roots below are
+    // processed sequentially starting from the current top.
+    new_space_front = new_space_.top();
+    promotion_queue_.SetNewLimit(new_space_front);
+  } else {
+    {
+      // Copy roots.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+      IterateRoots(&scavenge_visitor, VISIT_ALL_IN_SCAVENGE);
+    }
 
-  {
-    // Copy objects reachable from the old generation.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
-    RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
-      return Scavenger::CheckAndScavengeObject(this, addr);
-    });
-
-    RememberedSet<OLD_TO_NEW>::IterateTyped(
-        this, [this](SlotType type, Address host_addr, Address addr) {
-          return UpdateTypedSlotHelper::UpdateTypedSlot(
-              isolate(), type, addr, [this](Object** addr) {
-                // We expect that objects referenced by code are long living.
-                // If we do not force promotion, then we need to clear
-                // old_to_new slots in dead code objects after mark-compact.
-                return Scavenger::CheckAndScavengeObject(
-                    this, reinterpret_cast<Address>(addr));
-              });
-        });
-  }
+    {
+      // Copy objects reachable from the old generation.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
+      RememberedSet<OLD_TO_NEW>::Iterate(this, [this](Address addr) {
+        return Scavenger::CheckAndScavengeObject(this, addr);
+      });
+
+      RememberedSet<OLD_TO_NEW>::IterateTyped(
+          this, [this](SlotType type, Address host_addr, Address addr) {
+            return UpdateTypedSlotHelper::UpdateTypedSlot(
+                isolate(), type, addr, [this](Object** addr) {
+                  // We expect that objects referenced by code are long living.
+                  // If we do not force promotion, then we need to clear
+                  // old_to_new slots in dead code objects after mark-compact.
+                  return Scavenger::CheckAndScavengeObject(
+                      this, reinterpret_cast<Address>(addr));
+                });
+          });
+    }
 
-  {
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
-    // Copy objects reachable from the encountered weak collections list.
-    scavenge_visitor.VisitPointer(&encountered_weak_collections_);
-    // Copy objects reachable from the encountered weak cells.
-    scavenge_visitor.VisitPointer(&encountered_weak_cells_);
-  }
+    {
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_WEAK);
+      // Copy objects reachable from the encountered weak collections list.
+      scavenge_visitor.VisitPointer(&encountered_weak_collections_);
+      // Copy objects reachable from the encountered weak cells.
+      scavenge_visitor.VisitPointer(&encountered_weak_cells_);
+    }
 
-  {
-    // Copy objects reachable from the code flushing candidates list.
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
-    MarkCompactCollector* collector = mark_compact_collector();
-    if (collector->is_code_flushing_enabled()) {
-      collector->code_flusher()->IteratePointersToFromSpace(&scavenge_visitor);
+    {
+      // Copy objects reachable from the code flushing candidates list.
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
+      MarkCompactCollector* collector = mark_compact_collector();
+      if (collector->is_code_flushing_enabled()) {
+        collector->code_flusher()->IteratePointersToFromSpace(
+            &scavenge_visitor);
+      }
     }
-  }
 
-  {
-    TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
-    new_space_front =
-        DoScavenge(&scavenge_visitor, new_space_front, promotion_mode);
+    {
+      TRACE_GC(tracer(), GCTracer::Scope::SCAVENGER_SEMISPACE);
+      new_space_front =
+          DoScavenge(&scavenge_visitor, new_space_front, promotion_mode);
+    }
   }
 
   if (FLAG_scavenge_reclaim_unmodified_objects) {
@@ -1760,6 +1788,8 @@ void Heap::Scavenge() {
 
   ArrayBufferTracker::FreeDeadInNewSpace(this);
 
+  if (FLAG_pretenuring_histograms) allocation_site_lifetimes_->FinishScavenge();
+
   // Update how much has survived scavenge.
   IncrementYoungSurvivorsCounter(static_cast<int>(
       (PromotedSpaceSizeOfObjects() - survived_watermark) + new_space_.Size()));
@@ -3079,6 +3109,8 @@ AllocationResult Heap::AllocateBytecodeArray(int length,
   instance->set_frame_size(frame_size);
   instance->set_parameter_count(parameter_count);
   instance->set_interrupt_budget(interpreter::Interpreter::InterruptBudget());
+  instance->set_osr_loop_nesting_level(0);
+  instance->set_bytecode_age(BytecodeArray::kNoAgeBytecodeAge);
   instance->set_constant_pool(constant_pool);
   instance->set_handler_table(empty_fixed_array());
   instance->set_source_position_table(empty_byte_array());
@@ -3421,6 +3453,8 @@ AllocationResult Heap::CopyBytecodeArray(BytecodeArray* bytecode_array) {
   copy->set_handler_table(bytecode_array->handler_table());
   copy->set_source_position_table(bytecode_array->source_position_table());
   copy->set_interrupt_budget(bytecode_array->interrupt_budget());
+  copy->set_osr_loop_nesting_level(bytecode_array->osr_loop_nesting_level());
+  copy->set_bytecode_age(bytecode_array->bytecode_age());
   bytecode_array->CopyBytecodesTo(copy);
   return copy;
 }
@@ -4243,6 +4277,16 @@ GCIdleTimeHeapState Heap::ComputeHeapState() {
       tracer()->ContextDisposalRateInMilliseconds();
   heap_state.size_of_objects = static_cast<size_t>(SizeOfObjects());
   heap_state.incremental_marking_stopped = incremental_marking()->IsStopped();
+  heap_state.used_new_space_size = static_cast<size_t>(new_space_.Size());
+  heap_state.new_space_capacity = static_cast<size_t>(new_space_.Capacity());
+  heap_state.scavenge_speed_in_bytes_per_ms =
+      tracer()->ScavengeSpeedInBytesPerMillisecond();
+  heap_state.mark_compact_speed_in_bytes_per_ms =
+      tracer()->MarkCompactSpeedInBytesPerMillisecond();
+  heap_state.can_start_incremental_marking =
+      heap_state.incremental_marking_stopped &&
+      incremental_marking()->ShouldActivateEvenWithoutIdleNotification();
+  heap_state.high_fragmentation = HasHighFragmentation();
   return heap_state;
 }
 
@@ -4274,6 +4318,11 @@ bool Heap::PerformIdleTimeAction(GCIdleTimeAction action,
       CollectAllGarbage(kNoGCFlags, "idle notification: contexts disposed");
       break;
     }
+    case DO_SCAVENGE:
+    case DO_START_INCREMENTAL_MARKING:
+      // Only computed for idle time with a latency budget.
+      UNREACHABLE();
+      break;
     case DO_NOTHING:
       break;
   }
@@ -4375,6 +4424,78 @@ bool Heap::IdleNotification(double deadline_in_seconds) {
 }
 
 
+void Heap::IdleTimeGarbageCollection(double idle_time_in_ms,
+                                     double latency_budget_in_ms,
+                                     GCIdleTimeReport* report) {
+  CHECK(HasBeenSetUp());
+  HistogramTimerScope idle_notification_scope(
+      isolate_->counters()->gc_idle_notification());
+  TRACE_EVENT0("v8", "V8.GCIdleTimeGarbageCollection");
+  const double start_ms = MonotonicallyIncreasingTimeInMs();
+  const double deadline_in_ms = start_ms + idle_time_in_ms;
+  const unsigned int gc_count_before = gc_count_;
+  const unsigned int ms_count_before = ms_count_;
+
+  tracer()->SampleAllocation(start_ms, NewSpaceAllocationCounter(),
+                             OldGenerationAllocationCounter());
+
+  // Each action makes progress or ends the loop, except for marking steps
+  // that are cut short, e.g. by sweeping. Bound the number of actions anyway.
+  static const int kMaxActions = 100;
+  double current_ms = start_ms;
+  GCIdleTimeAction action = GCIdleTimeAction::Nothing();
+  for (int i = 0; i < kMaxActions; i++) {
+    GCIdleTimeHeapState heap_state = ComputeHeapState();
+    action = gc_idle_time_handler_->ComputeWithLatencyBudget(
+        deadline_in_ms - current_ms, latency_budget_in_ms, heap_state);
+    if (action.type == DONE || action.type == DO_NOTHING) break;
+    const double action_deadline_in_ms =
+        Min(deadline_in_ms, current_ms + latency_budget_in_ms);
+    bool full_gc = false;
+    switch (action.type) {
+      case DO_SCAVENGE:
+        CollectGarbage(NEW_SPACE, "idle time: scavenge");
+        break;
+      case DO_INCREMENTAL_STEP:
+        IncrementalMarkingJob::IdleTask::Step(this, action_deadline_in_ms);
+        report->incremental_marking_steps++;
+        break;
+      case DO_FULL_GC:
+        CollectAllGarbage(kReduceMemoryFootprintMask,
+                          "idle time: memory reducing GC");
+        full_gc = true;
+        break;
+      case DO_START_INCREMENTAL_MARKING:
+        StartIdleIncrementalMarking();
+        break;
+      default:
+        UNREACHABLE();
+    }
+    current_ms = MonotonicallyIncreasingTimeInMs();
+    // A full GC leaves nothing to do for the rest of the idle time.
+    if (full_gc || current_ms >= deadline_in_ms) break;
+  }
+
+  contexts_disposed_ = 0;
+  last_idle_notification_time_ = current_ms;
+  report->used_time_in_ms = current_ms - start_ms;
+  report->mark_compacts = static_cast<int>(ms_count_ - ms_count_before);
+  report->scavenges =
+      static_cast<int>(gc_count_ - gc_count_before) - report->mark_compacts;
+  report->done = action.type == DONE;
+
+  if (FLAG_trace_idle_notification) {
+    PrintIsolate(isolate_,
+                 "Idle time GC: idle time %.2f ms, latency budget %.2f ms, "
+                 "used %.2f ms, scavenges=%d marking_steps=%d "
+                 "mark_compacts=%d done=%d\n",
+                 idle_time_in_ms, latency_budget_in_ms, report->used_time_in_ms,
+                 report->scavenges, report->incremental_marking_steps,
+                 report->mark_compacts, report->done);
+  }
+}
+
+
 bool Heap::RecentIdleNotificationHappened() {
   return (last_idle_notification_time_ +
           GCIdleTimeHandler::kMaxScheduledIdleTime) >
@@ -4410,6 +4531,37 @@ void Heap::CheckMemoryPressure() {
   memory_reducer_->NotifyPossibleGarbage(event);
 }
 
+intptr_t Heap::OldGenerationSoftLimit() {
+  if (FLAG_heap_soft_limit_percent <= 0) return max_old_generation_size_;
+  return max_old_generation_size_ / 100 * FLAG_heap_soft_limit_percent;
+}
+
+void Heap::CheckHeapLimits(intptr_t old_gen_size) {
+  // Beyond this fraction of the maximum old generation size the next
+  // allocations are likely to fail.
+  const double kNearHeapLimitRatio = 0.9;
+
+  const bool above_soft_limit = FLAG_heap_soft_limit_percent > 0 &&
+                                old_gen_size >= OldGenerationSoftLimit();
+  if (above_soft_limit && !above_soft_heap_limit_) {
+    if (FLAG_trace_gc_verbose) {
+      PrintIsolate(isolate_,
+                   "Old generation above the soft limit of %" V8PRIdPTR " MB\n",
+                   OldGenerationSoftLimit() / MB);
+    }
+    // Start a memory reducer cycle to compact the old generation.
+    MemoryReducer::Event event;
+    event.type = MemoryReducer::kPossibleGarbage;
+    event.time_ms = MonotonicallyIncreasingTimeInMs();
+    memory_reducer_->NotifyPossibleGarbage(event);
+  }
+  above_soft_heap_limit_ = above_soft_limit;
+
+  if (old_gen_size >= max_old_generation_size_ * kNearHeapLimitRatio) {
+    InvokeNearHeapLimitCallback();
+  }
+}
+
 void Heap::CollectGarbageOnMemoryPressure(const char* source) {
   const int kGarbageThresholdInBytes = 8 * MB;
   const double kGarbageThresholdAsFractionOfTotalMemory = 0.1;
@@ -4945,6 +5097,7 @@ bool Heap::ConfigureHeap(int max_semi_space_size, int max_old_space_size,
   if (max_executable_size_ > max_old_generation_size_) {
     max_executable_size_ = max_old_generation_size_;
   }
+  initial_max_old_generation_size_ = max_old_generation_size_;
 
   if (FLAG_initial_old_space_size > 0) {
     initial_old_generation_size_ = FLAG_initial_old_space_size * MB;
@@ -5146,7 +5299,9 @@ void Heap::SetOldGenerationAllocationLimit(intptr_t old_gen_size,
     factor = Min(factor, kMaxHeapGrowingFactorMemoryConstrained);
   }
 
-  if (memory_reducer_->ShouldGrowHeapSlowly() || optimize_for_memory_usage_) {
+  if (memory_reducer_->ShouldGrowHeapSlowly() || optimize_for_memory_usage_ ||
+      (FLAG_heap_soft_limit_percent > 0 &&
+       old_gen_size >= OldGenerationSoftLimit())) {
     factor = Min(factor, kConservativeHeapGrowingFactor);
   }
 
@@ -5249,6 +5404,12 @@ bool Heap::SetUp() {
                                 code_range_size_))
     return false;
 
+  // Start filling the page pool early, so that setting up and growing the
+  // spaces does not have to map fresh memory.
+  if (FLAG_page_pool_size > 0 && FLAG_concurrent_sweeping) {
+    memory_allocator_->unmapper()->FreeQueuedChunks();
+  }
+
   // Initialize incremental marking.
   incremental_marking_ = new IncrementalMarking(this);
 
@@ -5301,6 +5462,10 @@ bool Heap::SetUp() {
 
   scavenge_collector_ = new Scavenger(this);
 
+  parallel_scavenger_ = new ParallelScavenger(this);
+
+  allocation_site_lifetimes_ = new AllocationSiteLifetimes(this);
+
   mark_compact_collector_ = new MarkCompactCollector(this);
 
   gc_idle_time_handler_ = new GCIdleTimeHandler();
@@ -5417,6 +5582,8 @@ void Heap::TearDown() {
     PrintF("total_marking_time=%.1f ", tracer()->cumulative_marking_duration());
     PrintF("total_sweeping_time=%.1f ",
            tracer()->cumulative_sweeping_duration());
+    PrintF("total_background_sweeping_time=%.1f ",
+           tracer()->cumulative_background_sweeping_duration());
     PrintF("\n\n");
   }
 
@@ -5448,6 +5615,12 @@ void Heap::TearDown() {
   delete scavenge_collector_;
   scavenge_collector_ = nullptr;
 
+  delete parallel_scavenger_;
+  parallel_scavenger_ = nullptr;
+
+  delete allocation_site_lifetimes_;
+  allocation_site_lifetimes_ = nullptr;
+
   if (mark_compact_collector_ != nullptr) {
     mark_compact_collector_->TearDown();
     delete mark_compact_collector_;
@@ -5527,6 +5700,55 @@ void Heap::AddGCPrologueCallback(v8::Isolate::GCCallback callback,
 }
 
 
+void Heap::AddNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                    void* data) {
+  DCHECK(callback != NULL);
+  near_heap_limit_callbacks_.Add(std::make_pair(callback, data));
+}
+
+
+void Heap::RemoveNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                       size_t heap_limit) {
+  DCHECK(callback != NULL);
+  for (int i = 0; i < near_heap_limit_callbacks_.length(); ++i) {
+    if (near_heap_limit_callbacks_[i].first == callback) {
+      near_heap_limit_callbacks_.Remove(i);
+      if (heap_limit > 0) {
+        // Leave some headroom above the live objects when lowering the limit.
+        intptr_t old_gen_size = PromotedSpaceSizeOfObjects();
+        intptr_t min_limit = old_gen_size + old_gen_size / 4;
+        max_old_generation_size_ =
+            Min(max_old_generation_size_,
+                Max(static_cast<intptr_t>(heap_limit), min_limit));
+      }
+      return;
+    }
+  }
+  // Removing a callback that was never added is harmless, ignore it.
+}
+
+
+bool Heap::InvokeNearHeapLimitCallback() {
+  if (near_heap_limit_callbacks_.is_empty()) return false;
+  v8::NearHeapLimitCallback callback = near_heap_limit_callbacks_.last().first;
+  void* data = near_heap_limit_callbacks_.last().second;
+  size_t heap_limit =
+      callback(data, static_cast<size_t>(max_old_generation_size_),
+               static_cast<size_t>(initial_max_old_generation_size_));
+  if (heap_limit <= static_cast<size_t>(max_old_generation_size_)) {
+    return false;
+  }
+  if (FLAG_trace_gc) {
+    PrintIsolate(isolate_, "Heap limit raised from %" V8PRIdPTR
+                           " MB to %" V8PRIdPTR " MB\n",
+                 max_old_generation_size_ / MB,
+                 static_cast<intptr_t>(heap_limit) / MB);
+  }
+  max_old_generation_size_ = static_cast<intptr_t>(heap_limit);
+  return true;
+}
+
+
 void Heap::RemoveGCPrologueCallback(v8::Isolate::GCCallback callback) {
   DCHECK(callback != NULL);
   for (int i = 0; i < gc_prologue_callbacks_.length(); ++i) {
@@ -308,10 +308,12 @@ using v8::MemoryPressureLevel;
 
 // Forward declarations.
 class AllocationObserver;
+class AllocationSiteLifetimes;
 class ArrayBufferTracker;
 class GCIdleTimeAction;
 class GCIdleTimeHandler;
 class GCIdleTimeHeapState;
+class GCIdleTimeReport;
 class GCTracer;
 class HeapObjectsFilter;
 class HeapStats;
@@ -319,6 +321,7 @@ class HistogramTimer;
 class Isolate;
 class MemoryReducer;
 class ObjectStats;
+class ParallelScavenger;
 class Scavenger;
 class ScavengeJob;
 class WeakObjectRetainer;
@@ -776,11 +779,18 @@ class Heap {
   // Implements the corresponding V8 API function.
   bool IdleNotification(double deadline_in_seconds);
   bool IdleNotification(int idle_time_in_ms);
+  void IdleTimeGarbageCollection(double idle_time_in_ms,
+                                 double latency_budget_in_ms,
+                                 GCIdleTimeReport* report);
 
   void MemoryPressureNotification(MemoryPressureLevel level,
                                   bool is_isolate_locked);
   void CheckMemoryPressure();
 
+  // Updates the soft heap limit state and invokes the near-heap-limit
+  // callback based on the old generation size after a mark-compact.
+  void CheckHeapLimits(intptr_t old_gen_size);
+
   double MonotonicallyIncreasingTimeInMs();
 
   void RecordStats(HeapStats* stats, bool take_snapshot = false);
@@ -889,7 +899,8 @@ class Heap {
   void SetOptimizeForLatency() { optimize_for_memory_usage_ = false; }
   void SetOptimizeForMemoryUsage();
   bool ShouldOptimizeForMemoryUsage() {
-    return optimize_for_memory_usage_ || HighMemoryPressure();
+    return optimize_for_memory_usage_ || HighMemoryPressure() ||
+           above_soft_heap_limit_;
   }
   bool HighMemoryPressure() {
     return memory_pressure_level_.Value() != MemoryPressureLevel::kNone;
@@ -1229,6 +1240,10 @@ class Heap {
   intptr_t MaxOldGenerationSize() { return max_old_generation_size_; }
   intptr_t MaxExecutableSize() { return max_executable_size_; }
 
+  // Returns the old generation size above which the heap grows slowly and
+  // the memory reducer compacts eagerly, see --heap-soft-limit-percent.
+  intptr_t OldGenerationSoftLimit();
+
   // Returns the capacity of the heap in bytes w/o growing. Heap grows when
   // more spaces are needed until it reaches the limit.
   intptr_t Capacity();
@@ -1368,6 +1383,15 @@ class Heap {
   void CallGCPrologueCallbacks(GCType gc_type, GCCallbackFlags flags);
   void CallGCEpilogueCallbacks(GCType gc_type, GCCallbackFlags flags);
 
+  void AddNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                void* data);
+  void RemoveNearHeapLimitCallback(v8::NearHeapLimitCallback callback,
+                                   size_t heap_limit);
+
+  // Asks the most recently added near-heap-limit callback for a new maximum
+  // old generation size. Returns true if the limit was raised.
+  bool InvokeNearHeapLimitCallback();
+
   // ===========================================================================
   // Allocation methods. =======================================================
   // ===========================================================================
@@ -1399,10 +1423,13 @@ class Heap {
   // storage is passed as {pretenuring_feedback} the memento found count on
   // the corresponding allocation site is immediately updated and an entry
   // in the hash map is created. Otherwise the entry (including a the count
-  // value) is cached on the local pretenuring feedback.
+  // value) is cached on the local pretenuring feedback. Returns the
+  // allocation site of a found memento (see
+  // AllocationMemento::GetAllocationSiteUnchecked), or nullptr. The site is
+  // only validated in kGlobal mode.
   template <UpdateAllocationSiteMode mode>
-  inline void UpdateAllocationSite(HeapObject* object,
-                                   base::HashMap* pretenuring_feedback);
+  inline Address UpdateAllocationSite(HeapObject* object,
+                                      base::HashMap* pretenuring_feedback);
 
   // Removes an entry from the global pretenuring storage.
   inline void RemoveAllocationSitePretenuringFeedback(AllocationSite* site);
@@ -1413,6 +1440,10 @@ class Heap {
   void MergeAllocationSitePretenuringFeedback(
       const base::HashMap& local_pretenuring_feedback);
 
+  AllocationSiteLifetimes* allocation_site_lifetimes() {
+    return allocation_site_lifetimes_;
+  }
+
 // =============================================================================
 
 #ifdef VERIFY_HEAP
@@ -2035,6 +2066,9 @@ class Heap {
   int max_semi_space_size_;
   int initial_semispace_size_;
   intptr_t max_old_generation_size_;
+  // The maximum old generation size before any near-heap-limit callback
+  // raised it.
+  intptr_t initial_max_old_generation_size_;
   intptr_t initial_old_generation_size_;
   bool old_generation_size_configured_;
   intptr_t max_executable_size_;
@@ -2114,6 +2148,10 @@ class Heap {
   // TODO(ulan): Merge it with memory reducer once chromium:490559 is fixed.
   bool optimize_for_memory_usage_;
 
+  // Indicates that the old generation was above the soft heap limit after
+  // the last mark-compact.
+  bool above_soft_heap_limit_;
+
   // Indicates that inline bump-pointer allocation has been globally disabled
   // for all spaces. This is used to disable allocations in generated code.
   bool inline_allocation_disabled_;
@@ -2135,6 +2173,8 @@ class Heap {
   List<GCCallbackPair> gc_epilogue_callbacks_;
   List<GCCallbackPair> gc_prologue_callbacks_;
 
+  List<std::pair<v8::NearHeapLimitCallback, void*> > near_heap_limit_callbacks_;
+
   // Total RegExp code ever generated
   double total_regexp_code_generated_;
 
@@ -2185,6 +2225,11 @@ class Heap {
 
   Scavenger* scavenge_collector_;
 
+  ParallelScavenger* parallel_scavenger_;
+
+  // Per-site age histograms, only used with --pretenuring-histograms.
+  AllocationSiteLifetimes* allocation_site_lifetimes_;
+
   MarkCompactCollector* mark_compact_collector_;
 
   MemoryAllocator* memory_allocator_;
@@ -2281,10 +2326,13 @@ class Heap {
   friend class MarkCompactMarkingVisitor;
   friend class NewSpace;
   friend class ObjectStatsCollector;
+  friend class ParallelScavenger;
   friend class Page;
   friend class Scavenger;
   friend class StoreBuffer;
   friend class TestMemoryAllocatorScope;
+  template <typename StaticVisitor>
+  friend class StaticMarkingVisitor;
 
   // The allocator interface.
   friend class Factory;
@@ -86,6 +86,23 @@ void CodeFlusher::AddCandidate(JSFunction* function) {
 }
 
 
+void CodeFlusher::AddBytecodeCandidate(SharedFunctionInfo* shared_info) {
+  DCHECK(!isolate_->heap()->InNewSpace(shared_info));
+  bytecode_candidates_.Add(shared_info);
+}
+
+
+bool CodeFlusher::IsOldBytecode(BytecodeArray* bytecode, bool reduce_memory) {
+  // Memory reducing GCs already flush bytecode that has not been executed
+  // since the previous full GC.
+  if (reduce_memory) {
+    return bytecode->bytecode_age() >=
+           BytecodeArray::kQuadragenarianBytecodeAge;
+  }
+  return bytecode->IsOld();
+}
+
+
 JSFunction** CodeFlusher::GetNextCandidateSlot(JSFunction* candidate) {
   return reinterpret_cast<JSFunction**>(
       HeapObject::RawField(candidate, JSFunction::kNextFunctionLinkOffset));
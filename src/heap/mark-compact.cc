@@ -15,6 +15,7 @@
 #include "src/gdb-jit.h"
 #include "src/global-handles.h"
 #include "src/heap/array-buffer-tracker.h"
+#include "src/heap/concurrent-marking.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/incremental-marking.h"
 #include "src/heap/mark-compact-inl.h"
@@ -62,6 +63,7 @@ MarkCompactCollector::MarkCompactCollector(Heap* heap)
       marking_deque_memory_(NULL),
       marking_deque_memory_committed_(0),
       code_flusher_(nullptr),
+      concurrent_marking_(nullptr),
       embedder_heap_tracer_(nullptr),
       sweeper_(heap) {
 }
@@ -250,6 +252,8 @@ void MarkCompactCollector::SetUp() {
   EnsureMarkingDequeIsReserved();
   EnsureMarkingDequeIsCommitted(kMinMarkingDequeSize);
 
+  concurrent_marking_ = new ConcurrentMarking(heap());
+
   if (FLAG_flush_code) {
     code_flusher_ = new CodeFlusher(isolate());
     if (FLAG_trace_code_flushing) {
@@ -263,6 +267,7 @@ void MarkCompactCollector::TearDown() {
   AbortCompaction();
   delete marking_deque_memory_;
   delete code_flusher_;
+  delete concurrent_marking_;
 }
 
 
@@ -308,10 +313,40 @@ bool MarkCompactCollector::StartCompaction(CompactionMode mode) {
   return compacting_;
 }
 
+static int NumberOfWeakClearingTasks(int items, int items_per_task) {
+  if (!FLAG_parallel_weak_clearing) return 1;
+  const int kMaxTasks = 4;
+  return Min(kMaxTasks, (items + items_per_task - 1) / items_per_task);
+}
+
+class ClearInvalidSlotsJobTraits {
+ public:
+  typedef int PerPageData;  // Per page data is not used in this job.
+  typedef int PerTaskData;  // Per task data is not used in this job.
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData, MemoryChunk* chunk,
+                                    PerPageData) {
+    RememberedSet<OLD_TO_NEW>::ClearInvalidSlots(heap, chunk);
+    return true;
+  }
+
+  static const bool NeedSequentialFinalization = false;
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool, PerPageData) {
+  }
+};
+
 void MarkCompactCollector::ClearInvalidRememberedSetSlots() {
   {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR_STORE_BUFFER);
-    RememberedSet<OLD_TO_NEW>::ClearInvalidSlots(heap());
+    PageParallelJob<ClearInvalidSlotsJobTraits> job(
+        heap(), heap()->isolate()->cancelable_task_manager(),
+        &page_parallel_job_semaphore_);
+    for (Page* page : *heap()->old_space()) {
+      if (page->old_to_new_slots() != nullptr) job.AddPage(page, 0);
+    }
+    const int kPagesPerTask = 4;
+    job.Run(NumberOfWeakClearingTasks(job.NumberOfPages(), kPagesPerTask),
+            [](int i) { return 0; });
   }
 // There is not need to filter the old to old set because
 // it is completely cleared after the mark-compact GC.
@@ -462,7 +497,11 @@ class MarkCompactCollector::Sweeper::SweeperTask : public v8::Task {
       const int space_id = FIRST_SPACE + ((i + offset) % num_spaces);
       DCHECK_GE(space_id, FIRST_SPACE);
       DCHECK_LE(space_id, LAST_PAGED_SPACE);
-      sweeper_->ParallelSweepSpace(static_cast<AllocationSpace>(space_id), 0);
+      const AllocationSpace space = static_cast<AllocationSpace>(space_id);
+      const double start = sweeper_->heap_->MonotonicallyIncreasingTimeInMs();
+      sweeper_->ParallelSweepSpace(space, 0);
+      sweeper_->AddBackgroundSweepingTime(
+          space, sweeper_->heap_->MonotonicallyIncreasingTimeInMs() - start);
     }
     pending_sweeper_tasks_->Signal();
   }
@@ -516,6 +555,15 @@ void MarkCompactCollector::SweepAndRefill(CompactionSpace* space) {
   }
 }
 
+void MarkCompactCollector::Sweeper::AddBackgroundSweepingTime(
+    AllocationSpace space, double duration) {
+  // Sweeper tasks also sweep new space pages, but the tracer only reports
+  // background sweeping time for paged spaces.
+  if (space < FIRST_PAGED_SPACE) return;
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  background_sweeping_duration_[space] += duration;
+}
+
 Page* MarkCompactCollector::Sweeper::GetSweptPageSafe(PagedSpace* space) {
   base::LockGuard<base::Mutex> guard(&mutex_);
   SweptList& list = swept_list_[space->identity()];
@@ -547,6 +595,10 @@ void MarkCompactCollector::Sweeper::EnsureCompleted() {
       swept_list_[NEW_SPACE].Clear();
     }
     DCHECK(sweeping_list_[space].empty());
+    // All sweeper tasks have finished, so the durations are stable.
+    heap_->tracer()->AddBackgroundSweepingTime(
+        space, background_sweeping_duration_[space]);
+    background_sweeping_duration_[space] = 0.0;
   });
   late_pages_ = false;
   sweeping_in_progress_ = false;
@@ -1045,6 +1097,74 @@ void CodeFlusher::ProcessSharedFunctionInfoCandidates() {
 }
 
 
+void CodeFlusher::ProcessBytecodeCandidates() {
+  Code* lazy_compile = isolate_->builtins()->builtin(Builtins::kCompileLazy);
+  MarkCompactCollector* collector = isolate_->heap()->mark_compact_collector();
+
+  for (int i = 0; i < bytecode_candidates_.length(); i++) {
+    SharedFunctionInfo* candidate = bytecode_candidates_[i];
+
+    // Candidates left over from an aborted incremental marking might have
+    // died in the meantime.
+    if (Marking::IsWhite(Marking::MarkBitFrom(candidate))) continue;
+
+    // Candidates can be enqueued more than once, or might have switched to
+    // baseline code in the meantime.
+    if (!candidate->HasBytecodeArray()) continue;
+
+    BytecodeArray* bytecode = candidate->bytecode_array();
+    MarkBit bytecode_mark = Marking::MarkBitFrom(bytecode);
+    if (Marking::IsWhite(bytecode_mark)) {
+      // Bytecode that ran since the candidate was judged has been kept alive
+      // by RetainExecutedBytecode, and white bytecode does not age. It is
+      // thus at least as old as memory reducing GCs require.
+      DCHECK(IsOldBytecode(bytecode, true));
+      DCHECK(candidate->code()->is_interpreter_trampoline_builtin());
+      DCHECK(!candidate->HasDebugInfo());
+      if (FLAG_trace_code_flushing) {
+        PrintF("[code-flushing clears bytecode: ");
+        candidate->ShortPrint();
+        PrintF(" - age: %d]\n", bytecode->bytecode_age());
+      }
+      // Always flush the optimized code map if there is one.
+      if (!candidate->OptimizedCodeMapIsCleared()) {
+        candidate->ClearOptimizedCodeMap();
+      }
+      candidate->ClearBytecodeArray();
+      candidate->set_code(lazy_compile);
+    } else {
+      // The bytecode survives, record the slot we skipped during marking.
+      Object** data_slot = HeapObject::RawField(
+          candidate, SharedFunctionInfo::kFunctionDataOffset);
+      collector->RecordSlot(candidate, data_slot, *data_slot);
+    }
+
+    Object** code_slot =
+        HeapObject::RawField(candidate, SharedFunctionInfo::kCodeOffset);
+    collector->RecordSlot(candidate, code_slot, *code_slot);
+  }
+
+  bytecode_candidates_.Clear();
+}
+
+
+void CodeFlusher::RetainExecutedBytecode(ObjectVisitor* visitor,
+                                         bool reduce_memory) {
+  for (int i = 0; i < bytecode_candidates_.length(); i++) {
+    SharedFunctionInfo* candidate = bytecode_candidates_[i];
+
+    // Unmarked candidates are judged again if they are reached later on.
+    if (Marking::IsWhite(Marking::MarkBitFrom(candidate))) continue;
+    if (!candidate->HasBytecodeArray()) continue;
+    if (IsOldBytecode(candidate->bytecode_array(), reduce_memory)) continue;
+
+    Object** data_slot = HeapObject::RawField(
+        candidate, SharedFunctionInfo::kFunctionDataOffset);
+    visitor->VisitPointer(data_slot);
+  }
+}
+
+
 void CodeFlusher::EvictCandidate(SharedFunctionInfo* shared_info) {
   // Make sure previous flushing decisions are revisited.
   isolate_->heap()->incremental_marking()->IterateBlackObject(shared_info);
@@ -1428,8 +1548,9 @@ class RootMarkingVisitor : public ObjectVisitor {
     MarkCompactMarkingVisitor::IterateBody(map, object);
 
     // Mark all the objects reachable from the map and body.  May leave
-    // overflowed objects in the heap.
-    collector_->EmptyMarkingDeque();
+    // overflowed objects in the heap. With concurrent marking the work is
+    // left on the marking stack and processed in bulk by the caller.
+    if (!FLAG_concurrent_marking) collector_->EmptyMarkingDeque();
   }
 
   MarkCompactCollector* collector_;
@@ -1483,6 +1604,47 @@ class StringTableCleaner : public ObjectVisitor {
 typedef StringTableCleaner<false, true> InternalizedStringTableCleaner;
 typedef StringTableCleaner<true, false> ExternalStringTableCleaner;
 
+// Same as InternalizedStringTableCleaner but processes a range of the string
+// table. Slots that need to be recorded are buffered per task because
+// remembered sets cannot be updated concurrently.
+class StringTableCleaningJobTraits {
+ public:
+  struct TaskData {
+    TaskData() : pointers_removed(0) {}
+    int pointers_removed;
+    std::vector<Object**> slots;
+  };
+
+  // Range of element indices.
+  typedef std::pair<int, int> PerPageData;
+  typedef TaskData* PerTaskData;
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData data,
+                                    MemoryChunk* chunk, PerPageData range) {
+    StringTable* string_table = heap->string_table();
+    DCHECK_EQ(chunk, MemoryChunk::FromAddress(string_table->address()));
+    Object* the_hole = heap->the_hole_value();
+    for (int i = range.first; i < range.second; i++) {
+      Object** p = string_table->RawFieldOfElementAt(i);
+      Object* o = *p;
+      if (!o->IsHeapObject()) continue;
+      if (Marking::IsWhite(Marking::MarkBitFrom(HeapObject::cast(o)))) {
+        data->pointers_removed++;
+        // Set the entry to the_hole_value (as deleted).
+        *p = the_hole;
+      } else if (Page::FromAddress(reinterpret_cast<Address>(o))
+                     ->IsEvacuationCandidate()) {
+        data->slots.push_back(p);
+      }
+    }
+    return true;
+  }
+
+  static const bool NeedSequentialFinalization = false;
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool, PerPageData) {
+  }
+};
+
 // Implementation of WeakObjectRetainer for mark compact GCs. All marked objects
 // are retained.
 class MarkCompactWeakObjectRetainer : public WeakObjectRetainer {
@@ -2014,10 +2176,7 @@ void MarkCompactCollector::MarkRoots(RootMarkingVisitor* visitor) {
   MarkStringTable(visitor);
 
   // There may be overflowed objects in the heap.  Visit them now.
-  while (marking_deque_.overflowed()) {
-    RefillMarkingDeque();
-    EmptyMarkingDeque();
-  }
+  ProcessMarkingDeque();
 }
 
 
@@ -2077,6 +2236,16 @@ void MarkCompactCollector::EmptyMarkingDeque() {
 }
 
 
+// Mark objects reachable from the marking stack with the help of background
+// tasks if the stack holds enough work. Objects that need the main-thread
+// visitor are left on the marking stack.
+void MarkCompactCollector::EmptyMarkingDequeConcurrently() {
+  if (!concurrent_marking_->ShouldProcess(&marking_deque_)) return;
+  TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_CONCURRENT);
+  concurrent_marking_->ProcessMarkingDeque(&marking_deque_);
+}
+
+
 // Sweep the heap for overflowed objects, clear their overflow bits, and
 // push them on the marking stack.  Stop early if the marking stack fills
 // before sweeping completes.  If sweeping completes, there are no remaining
@@ -2111,9 +2280,11 @@ void MarkCompactCollector::RefillMarkingDeque() {
 // pointers.  After: the marking stack is empty and there are no overflowed
 // objects in the heap.
 void MarkCompactCollector::ProcessMarkingDeque() {
+  EmptyMarkingDequeConcurrently();
   EmptyMarkingDeque();
   while (marking_deque_.overflowed()) {
     RefillMarkingDeque();
+    EmptyMarkingDequeConcurrently();
     EmptyMarkingDeque();
   }
 }
@@ -2324,6 +2495,11 @@ void MarkCompactCollector::MarkLiveObjects() {
     TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_MARK_ROOTS);
     MarkRoots(&root_visitor);
     ProcessTopOptimizedFrame(&root_visitor);
+    if (is_code_flushing_enabled()) {
+      code_flusher_->RetainExecutedBytecode(&root_visitor,
+                                            heap()->ShouldReduceMemory());
+      ProcessMarkingDeque();
+    }
   }
 
   {
@@ -2398,10 +2574,34 @@ void MarkCompactCollector::ClearNonLiveReferences() {
     // string table.  Cannot use string_table() here because the string
     // table is marked.
     StringTable* string_table = heap()->string_table();
-    InternalizedStringTableCleaner internalized_visitor(heap(), string_table);
-    string_table->IterateElements(&internalized_visitor);
-    string_table->ElementsRemoved(internalized_visitor.PointersRemoved());
+    PageParallelJob<StringTableCleaningJobTraits> job(
+        heap(), heap()->isolate()->cancelable_task_manager(),
+        &page_parallel_job_semaphore_);
+    MemoryChunk* chunk = MemoryChunk::FromAddress(string_table->address());
+    const int kRangeSize = 4 * KB;
+    for (int start = StringTable::kElementsStartIndex;
+         start < string_table->length(); start += kRangeSize) {
+      job.AddPage(chunk, std::make_pair(start, Min(start + kRangeSize,
+                                                   string_table->length())));
+    }
+    const int kRangesPerTask = 4;
+    const int num_tasks =
+        NumberOfWeakClearingTasks(job.NumberOfPages(), kRangesPerTask);
+    std::vector<StringTableCleaningJobTraits::TaskData> task_data(num_tasks);
+    job.Run(num_tasks, [&task_data](int i) { return &task_data[i]; });
+    int pointers_removed = 0;
+    for (auto& data : task_data) {
+      pointers_removed += data.pointers_removed;
+      for (Object** slot : data.slots) {
+        RecordSlot(string_table, slot, *slot);
+      }
+    }
+    string_table->ElementsRemoved(pointers_removed);
+  }
 
+  {
+    TRACE_GC(heap()->tracer(),
+             GCTracer::Scope::MC_CLEAR_EXTERNAL_STRING_TABLE);
     ExternalStringTableCleaner external_visitor(heap(), nullptr);
     heap()->external_string_table_.Iterate(&external_visitor);
     heap()->external_string_table_.CleanUp();
@@ -2669,8 +2869,35 @@ void MarkCompactCollector::ProcessWeakCollections() {
 }
 
 
+// Removes the entries with unreachable keys from a single weak collection
+// table. Tables are independent of each other and can be processed in
+// parallel.
+class ClearWeakCollectionsJobTraits {
+ public:
+  typedef ObjectHashTable* PerPageData;
+  typedef int PerTaskData;  // Per task data is not used in this job.
+
+  static bool ProcessPageInParallel(Heap* heap, PerTaskData, MemoryChunk*,
+                                    PerPageData table) {
+    for (int i = 0; i < table->Capacity(); i++) {
+      HeapObject* key = HeapObject::cast(table->KeyAt(i));
+      if (!MarkCompactCollector::IsMarked(key)) {
+        table->RemoveEntry(i);
+      }
+    }
+    return true;
+  }
+
+  static const bool NeedSequentialFinalization = false;
+  static void FinalizePageSequentially(Heap*, MemoryChunk*, bool, PerPageData) {
+  }
+};
+
 void MarkCompactCollector::ClearWeakCollections() {
   TRACE_GC(heap()->tracer(), GCTracer::Scope::MC_CLEAR_WEAK_COLLECTIONS);
+  PageParallelJob<ClearWeakCollectionsJobTraits> job(
+      heap(), heap()->isolate()->cancelable_task_manager(),
+      &page_parallel_job_semaphore_);
   Object* weak_collection_obj = heap()->encountered_weak_collections();
   while (weak_collection_obj != Smi::FromInt(0)) {
     JSWeakCollection* weak_collection =
@@ -2678,17 +2905,15 @@ void MarkCompactCollector::ClearWeakCollections() {
     DCHECK(MarkCompactCollector::IsMarked(weak_collection));
     if (weak_collection->table()->IsHashTable()) {
       ObjectHashTable* table = ObjectHashTable::cast(weak_collection->table());
-      for (int i = 0; i < table->Capacity(); i++) {
-        HeapObject* key = HeapObject::cast(table->KeyAt(i));
-        if (!MarkCompactCollector::IsMarked(key)) {
-          table->RemoveEntry(i);
-        }
-      }
+      job.AddPage(MemoryChunk::FromAddress(table->address()), table);
     }
     weak_collection_obj = weak_collection->next();
     weak_collection->set_next(heap()->undefined_value());
   }
   heap()->set_encountered_weak_collections(Smi::FromInt(0));
+  const int kTablesPerTask = 8;
+  job.Run(NumberOfWeakClearingTasks(job.NumberOfPages(), kTablesPerTask),
+          [](int i) { return 0; });
 }
 
 
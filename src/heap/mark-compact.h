@@ -24,6 +24,7 @@ typedef void (*MarkObjectFunction)(Heap* heap, HeapObject* object);
 
 // Forward declarations.
 class CodeFlusher;
+class ConcurrentMarking;
 class MarkCompactCollector;
 class MarkingVisitor;
 class RootMarkingVisitor;
@@ -106,6 +107,14 @@ class Marking : public AllStatic {
     markbit.Next().Set();
   }
 
+  // Marks a white object black. Safe to use from several marking threads
+  // concurrently. Returns false if the object was already grey or black.
+  INLINE(static bool WhiteToBlackAtomic(MarkBit markbit)) {
+    if (!markbit.AtomicSet()) return false;
+    markbit.Next().AtomicSet();
+    return true;
+  }
+
   INLINE(static void GreyToBlack(MarkBit markbit)) {
     DCHECK(IsGrey(markbit));
     markbit.Next().Set();
@@ -271,6 +280,9 @@ class MarkingDeque {
 // We are not allowed to flush unoptimized code for functions that got
 // optimized or inlined into optimized code, because we might bailout
 // into the unoptimized code again during deoptimization.
+// The same holds for bytecode arrays referenced by a SharedFunctionInfo of
+// an interpreted function, which are flushed once they are no longer
+// reachable from anything but their SharedFunctionInfo.
 class CodeFlusher {
  public:
   explicit CodeFlusher(Isolate* isolate)
@@ -280,12 +292,24 @@ class CodeFlusher {
 
   inline void AddCandidate(SharedFunctionInfo* shared_info);
   inline void AddCandidate(JSFunction* function);
+  inline void AddBytecodeCandidate(SharedFunctionInfo* shared_info);
 
   void EvictCandidate(SharedFunctionInfo* shared_info);
   void EvictCandidate(JSFunction* function);
 
+  // Returns true if {bytecode} has not been executed for long enough to be
+  // flushed by the current GC, which is memory reducing if {reduce_memory}.
+  static inline bool IsOldBytecode(BytecodeArray* bytecode, bool reduce_memory);
+
+  // Bytecode candidates are judged when their function info is visited. If
+  // the function ran during incremental marking after that, the age of its
+  // bytecode was reset. Visits the bytecode of such candidates with {visitor}
+  // to keep it alive.
+  void RetainExecutedBytecode(ObjectVisitor* visitor, bool reduce_memory);
+
   void ProcessCandidates() {
     ProcessSharedFunctionInfoCandidates();
+    ProcessBytecodeCandidates();
     ProcessJSFunctionCandidates();
   }
 
@@ -294,6 +318,7 @@ class CodeFlusher {
  private:
   void ProcessJSFunctionCandidates();
   void ProcessSharedFunctionInfoCandidates();
+  void ProcessBytecodeCandidates();
 
   static inline JSFunction** GetNextCandidateSlot(JSFunction* candidate);
   static inline JSFunction* GetNextCandidate(JSFunction* candidate);
@@ -311,6 +336,11 @@ class CodeFlusher {
   Isolate* isolate_;
   JSFunction* jsfunction_candidates_head_;
   SharedFunctionInfo* shared_function_info_candidates_head_;
+  // The code field of interpreted functions holds the shared interpreter
+  // entry trampoline, so bytecode candidates cannot be linked through the
+  // GC metadata of their code. Function infos live in old space and do not
+  // move before the candidates are processed.
+  List<SharedFunctionInfo*> bytecode_candidates_;
 
   DISALLOW_COPY_AND_ASSIGN(CodeFlusher);
 };
@@ -426,7 +456,11 @@ class MarkCompactCollector {
           pending_sweeper_tasks_semaphore_(0),
           sweeping_in_progress_(false),
           late_pages_(false),
-          num_sweeping_tasks_(0) {}
+          num_sweeping_tasks_(0) {
+      ForAllSweepingSpaces([this](AllocationSpace space) {
+        background_sweeping_duration_[space] = 0.0;
+      });
+    }
 
     bool sweeping_in_progress() { return sweeping_in_progress_; }
     bool contains_late_pages() { return late_pages_; }
@@ -463,6 +497,8 @@ class MarkCompactCollector {
 
     void PrepareToBeSweptPage(AllocationSpace space, Page* page);
 
+    void AddBackgroundSweepingTime(AllocationSpace space, double duration);
+
     Heap* heap_;
     base::Semaphore pending_sweeper_tasks_semaphore_;
     base::Mutex mutex_;
@@ -471,6 +507,9 @@ class MarkCompactCollector {
     bool sweeping_in_progress_;
     bool late_pages_;
     base::AtomicNumber<intptr_t> num_sweeping_tasks_;
+    // Time spent by sweeper tasks per space. Guarded by {mutex_} and handed
+    // to the GC tracer once all tasks have finished.
+    double background_sweeping_duration_[kAllocationSpaces];
   };
 
   enum IterationMode {
@@ -724,6 +763,10 @@ class MarkCompactCollector {
   // overflow flag will be set.
   void EmptyMarkingDeque();
 
+  // Like EmptyMarkingDeque but uses background tasks for objects that can be
+  // visited off the main thread. Bailout objects remain on the marking stack.
+  void EmptyMarkingDequeConcurrently();
+
   // Refill the marking stack with overflowed objects from the heap.  This
   // function either leaves the marking stack full or clears the overflow
   // flag on the marking stack.
@@ -868,6 +911,8 @@ class MarkCompactCollector {
 
   CodeFlusher* code_flusher_;
 
+  ConcurrentMarking* concurrent_marking_;
+
   EmbedderHeapTracer* embedder_heap_tracer_;
 
   List<Page*> evacuation_candidates_;
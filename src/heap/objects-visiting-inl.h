@@ -438,6 +438,10 @@ void StaticMarkingVisitor<StaticVisitor>::VisitCode(Map* map,
   if (FLAG_age_code && !heap->isolate()->serializer_enabled()) {
     code->MakeOlder(heap->mark_compact_collector()->marking_parity());
   }
+  if (FLAG_flush_bytecode && code->kind() == Code::OPTIMIZED_FUNCTION &&
+      heap->mark_compact_collector()->is_code_flushing_enabled()) {
+    MarkInlinedFunctionsBytecode(heap, code);
+  }
   CodeBodyVisitor::Visit(map, object);
 }
 
@@ -470,6 +474,15 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfo(
       VisitSharedFunctionInfoWeakCode(heap, object);
       return;
     }
+    if (IsFlushableBytecode(heap, shared)) {
+      // The bytecode looks flushable. It is only flushed if nothing else,
+      // like an interpreter frame or optimized code inlining the function,
+      // keeps it alive until the end of marking.
+      collector->code_flusher()->AddBytecodeCandidate(shared);
+      // Treat the reference to the bytecode array weakly.
+      VisitSharedFunctionInfoWeakBytecode(heap, object);
+      return;
+    }
   }
   VisitSharedFunctionInfoStrongCode(heap, object);
 }
@@ -496,6 +509,12 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSFunction(Map* map,
       // Treat the reference to the code object weakly.
       VisitJSFunctionWeakCode(map, object);
       return;
+    } else if (IsFlushableBytecode(heap, function)) {
+      // Closures entering the interpreter are reset to lazy compilation
+      // together with their function in case its bytecode gets flushed.
+      collector->code_flusher()->AddCandidate(function);
+      VisitJSFunctionWeakCode(map, object);
+      return;
     } else {
       // Visit all unoptimized code objects to prevent flushing them.
       StaticVisitor::MarkObject(heap, function->shared()->code());
@@ -514,8 +533,12 @@ void StaticMarkingVisitor<StaticVisitor>::VisitJSRegExp(Map* map,
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitBytecodeArray(
     Map* map, HeapObject* object) {
+  Heap* heap = map->GetHeap();
+  if (FLAG_flush_bytecode && !heap->isolate()->serializer_enabled()) {
+    BytecodeArray::cast(object)->MakeOlder();
+  }
   StaticVisitor::VisitPointers(
-      map->GetHeap(), object,
+      heap, object,
       HeapObject::RawField(object, BytecodeArray::kConstantPoolOffset),
       HeapObject::RawField(object, BytecodeArray::kFrameSizeOffset));
 }
@@ -657,6 +680,71 @@ bool StaticMarkingVisitor<StaticVisitor>::IsFlushable(
 }
 
 
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsFlushableBytecode(
+    Heap* heap, JSFunction* function) {
+  // Only closures that still enter the interpreter need to be reset, all
+  // others are taken care of by deoptimization or by normal code flushing.
+  Code* code = function->code();
+  if (code != function->shared()->code()) return false;
+  if (!code->is_interpreter_trampoline_builtin()) return false;
+  return IsFlushableBytecode(heap, function->shared());
+}
+
+
+template <typename StaticVisitor>
+bool StaticMarkingVisitor<StaticVisitor>::IsFlushableBytecode(
+    Heap* heap, SharedFunctionInfo* shared_info) {
+  if (!FLAG_flush_bytecode) return false;
+
+  // The function must be interpreted, functions that tiered up to baseline
+  // code have already dropped their bytecode.
+  if (!shared_info->HasBytecodeArray()) return false;
+  if (!shared_info->code()->is_interpreter_trampoline_builtin()) return false;
+
+  // Bytecode is either on stack, in a compilation job or referenced by
+  // optimized code inlining the function.
+  BytecodeArray* bytecode = shared_info->bytecode_array();
+  if (Marking::IsBlackOrGrey(Marking::MarkBitFrom(bytecode))) return false;
+
+  // The source code must be available to regenerate the bytecode lazily.
+  if (!HasSourceCode(heap, shared_info)) return false;
+
+  // The same restrictions as for flushing unoptimized code apply.
+  if (shared_info->IsApiFunction()) return false;
+  if (!shared_info->allows_lazy_compilation()) return false;
+  if (shared_info->is_resumable()) return false;
+  if (shared_info->is_toplevel()) return false;
+  if (shared_info->IsBuiltin()) return false;
+  if (shared_info->HasDebugInfo()) return false;
+  if (shared_info->dont_flush()) return false;
+
+  return CodeFlusher::IsOldBytecode(bytecode, heap->ShouldReduceMemory());
+}
+
+
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::MarkInlinedFunctionsBytecode(
+    Heap* heap, Code* code) {
+  // Deoptimizing the code materializes interpreter frames for the function
+  // itself and for all functions inlined into it, their bytecode has to be
+  // kept alive as long as the code is.
+  DeoptimizationInputData* const data =
+      DeoptimizationInputData::cast(code->deoptimization_data());
+  if (data->length() == 0) return;
+  FixedArray* const literals = data->LiteralArray();
+  int const inlined_count = data->InlinedFunctionCount()->value();
+  for (int i = -1; i < inlined_count; ++i) {
+    Object* object = i < 0 ? data->SharedFunctionInfo() : literals->get(i);
+    if (!object->IsSharedFunctionInfo()) continue;
+    SharedFunctionInfo* shared = SharedFunctionInfo::cast(object);
+    if (shared->HasBytecodeArray()) {
+      StaticVisitor::MarkObject(heap, shared->bytecode_array());
+    }
+  }
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoStrongCode(
     Heap* heap, HeapObject* object) {
@@ -689,6 +777,22 @@ void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakCode(
 }
 
 
+template <typename StaticVisitor>
+void StaticMarkingVisitor<StaticVisitor>::VisitSharedFunctionInfoWeakBytecode(
+    Heap* heap, HeapObject* object) {
+  Object** start_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kStartOffset);
+  Object** data_slot =
+      HeapObject::RawField(object, SharedFunctionInfo::kFunctionDataOffset);
+  StaticVisitor::VisitPointers(heap, object, start_slot, data_slot);
+
+  // Skip visiting kFunctionDataOffset as it is treated weakly here.
+  Object** end_slot = HeapObject::RawField(
+      object, SharedFunctionInfo::BodyDescriptor::kEndOffset);
+  StaticVisitor::VisitPointers(heap, object, data_slot + 1, end_slot);
+}
+
+
 template <typename StaticVisitor>
 void StaticMarkingVisitor<StaticVisitor>::VisitJSFunctionStrongCode(
     Map* map, HeapObject* object) {
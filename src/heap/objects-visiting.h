@@ -388,10 +388,18 @@ class StaticMarkingVisitor : public StaticVisitorBase {
   INLINE(static bool IsFlushable(Heap* heap, JSFunction* function));
   INLINE(static bool IsFlushable(Heap* heap, SharedFunctionInfo* shared_info));
 
+  // Bytecode flushing support.
+  INLINE(static bool IsFlushableBytecode(Heap* heap, JSFunction* function));
+  INLINE(static bool IsFlushableBytecode(Heap* heap,
+                                         SharedFunctionInfo* shared_info));
+  static void MarkInlinedFunctionsBytecode(Heap* heap, Code* code);
+
   // Helpers used by code flushing support that visit pointer fields and treat
   // references to code objects either strongly or weakly.
   static void VisitSharedFunctionInfoStrongCode(Heap* heap, HeapObject* object);
   static void VisitSharedFunctionInfoWeakCode(Heap* heap, HeapObject* object);
+  static void VisitSharedFunctionInfoWeakBytecode(Heap* heap,
+                                                  HeapObject* object);
   static void VisitJSFunctionStrongCode(Map* map, HeapObject* object);
   static void VisitJSFunctionWeakCode(Map* map, HeapObject* object);
 
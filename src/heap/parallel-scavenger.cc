@@ -0,0 +1,529 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/parallel-scavenger.h"
+
+#include "src/base/atomicops.h"
+#include "src/heap/allocation-site-lifetimes.h"
+#include "src/heap/gc-tracer.h"
+#include "src/heap/heap-inl.h"
+#include "src/heap/heap.h"
+#include "src/heap/mark-compact.h"
+#include "src/heap/objects-visiting-inl.h"
+#include "src/heap/remembered-set.h"
+#include "src/heap/scavenger.h"
+#include "src/heap/spaces-inl.h"
+#include "src/objects-body-descriptors-inl.h"
+#include "src/tracing/trace-event.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+// Per-task scavenging state. Visits the bodies of copied objects.
+class ParallelScavenger::Worker final : public ObjectVisitor {
+ public:
+  static const int kLabSize = 4 * KB;
+  static const int kMaxLabObjectSize = 256;
+  static const int kInitialLocalPretenuringFeedbackCapacity = 256;
+
+  explicit Worker(Heap* heap)
+      : heap_(heap),
+        buffer_(LocalAllocationBuffer::InvalidBuffer()),
+        compaction_spaces_(heap),
+        local_pretenuring_feedback_(base::HashMap::PointersMatch,
+                                    kInitialLocalPretenuringFeedbackCapacity),
+        visiting_promoted_object_(false),
+        promoted_size_(0),
+        semispace_copied_size_(0),
+        duration_(0.0) {}
+
+  // Scavenges the object referenced from the given remembered set slot.
+  // Returns KEEP_SLOT if the slot still points to the young generation.
+  SlotCallbackResult CheckAndScavengeObject(Address slot_address) {
+    Object** slot = reinterpret_cast<Object**>(slot_address);
+    Object* object = *slot;
+    if (heap_->InFromSpace(object)) {
+      ScavengeObject(reinterpret_cast<HeapObject**>(slot),
+                     reinterpret_cast<HeapObject*>(object));
+      if (heap_->InToSpace(*slot)) {
+        return KEEP_SLOT;
+      }
+    } else {
+      DCHECK(!heap_->InNewSpace(object));
+    }
+    return REMOVE_SLOT;
+  }
+
+  // Copies the given from-space object unless another task already did so and
+  // updates the slot to point to the copy.
+  void ScavengeObject(HeapObject** slot, HeapObject* object) {
+    DCHECK(heap_->InFromSpace(object));
+    MapWord map_word = object->map_word();
+    if (map_word.IsForwardingAddress()) {
+      *slot = map_word.ToForwardingAddress();
+      return;
+    }
+    Map* map = map_word.ToMap();
+    DCHECK(map != heap_->allocation_memento_map());
+    const int size = object->SizeFromMap(map);
+    const AllocationAlignment alignment = RequiredAlignment(map, object);
+
+    HeapObject* target = nullptr;
+    bool promote =
+        heap_->ShouldBePromoted<DEFAULT_PROMOTION>(object->address(), size);
+    // A semi-space copy may fail due to fragmentation. In that case, we try
+    // to promote the object.
+    if (!promote && !AllocateInNewSpace(size, alignment, &target)) {
+      promote = true;
+    }
+    if (promote && !AllocateInOldSpace(size, alignment, &target)) {
+      // If promotion failed, we try to copy the object to the other
+      // semi-space.
+      promote = false;
+      if (!AllocateInNewSpace(size, alignment, &target)) {
+        Heap::FatalProcessOutOfMemory("Scavenger: semi-space copy\n");
+      }
+    }
+
+    heap_->CopyBlock(target->address(), object->address(), size);
+    target->set_map_word(map_word);
+    if (!TryForward(object, map_word, target)) {
+      // Another task copied the object in the meantime. Turn our copy into a
+      // filler to keep the spaces iterable.
+      heap_->CreateFillerObjectAt(target->address(), size,
+                                  ClearRecordedSlots::kNo);
+      *slot = object->map_word().ToForwardingAddress();
+      return;
+    }
+    *slot = target;
+
+    Address site = RecordAllocationSite(object, map, size);
+    if (FLAG_pretenuring_histograms &&
+        (site != nullptr ||
+         heap_->allocation_site_lifetimes()->IsTracked(object->address()))) {
+      Survivor survivor = {object->address(), target, site};
+      survivors_.push_back(survivor);
+    }
+    if (promote) {
+      promoted_size_ += size;
+    } else {
+      semispace_copied_size_ += size;
+    }
+    if (ContainsPointers(map)) {
+      stack_.push_back(target);
+    }
+  }
+
+  // Visits the body of a copied object.
+  void Visit(HeapObject* object) {
+    Map* map = object->map();
+    visiting_promoted_object_ = !heap_->InNewSpace(object);
+    object->IterateBody(map->instance_type(), object->SizeFromMap(map), this);
+  }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) {
+      Object* object = *p;
+      if (!heap_->InFromSpace(object)) continue;
+      ScavengeObject(reinterpret_cast<HeapObject**>(p),
+                     reinterpret_cast<HeapObject*>(object));
+      // Remembered sets cannot be updated concurrently. Buffer the slot, see
+      // Heap::IteratePromotedObjectPointers.
+      if (visiting_promoted_object_ && heap_->InNewSpace(*p)) {
+        old_to_new_slots_.push_back(reinterpret_cast<Address>(p));
+      }
+    }
+  }
+
+  // Merges the buffered state back into the heap. Needs to be called on the
+  // main thread after all tasks have finished.
+  void Finalize() {
+    buffer_ = LocalAllocationBuffer::InvalidBuffer();
+    heap_->old_space()->MergeCompactionSpace(
+        compaction_spaces_.Get(OLD_SPACE));
+    for (Address slot : old_to_new_slots_) {
+      RememberedSet<OLD_TO_NEW>::Insert(Page::FromAddress(slot), slot);
+    }
+    heap_->IncrementPromotedObjectsSize(promoted_size_);
+    heap_->IncrementSemiSpaceCopiedObjectSize(semispace_copied_size_);
+    heap_->MergeAllocationSitePretenuringFeedback(local_pretenuring_feedback_);
+    for (const Survivor& survivor : survivors_) {
+      // Validate the site like MergeAllocationSitePretenuringFeedback does.
+      AllocationSite* site =
+          reinterpret_cast<AllocationSite*>(survivor.site);
+      if (site != nullptr && (!site->IsAllocationSite() || site->IsZombie())) {
+        site = nullptr;
+      }
+      heap_->allocation_site_lifetimes()->RecordSurvivor(survivor.from,
+                                                         survivor.target, site);
+    }
+  }
+
+  std::vector<HeapObject*>& stack() { return stack_; }
+  intptr_t copied_size() { return promoted_size_ + semispace_copied_size_; }
+  double duration() { return duration_; }
+  void set_duration(double duration) { duration_ = duration; }
+
+ private:
+  // Mirrors HeapObject::RequiredAlignment without reading the map word, which
+  // may be replaced by a forwarding address concurrently.
+  static AllocationAlignment RequiredAlignment(Map* map, HeapObject* object) {
+#ifdef V8_HOST_ARCH_32_BIT
+    InstanceType type = map->instance_type();
+    if ((type == FIXED_FLOAT64_ARRAY_TYPE || type == FIXED_DOUBLE_ARRAY_TYPE) &&
+        reinterpret_cast<FixedArrayBase*>(object)->length() != 0) {
+      return kDoubleAligned;
+    }
+    if (type == HEAP_NUMBER_TYPE) return kDoubleUnaligned;
+    if (type == SIMD128_VALUE_TYPE) return kSimd128Unaligned;
+#endif  // V8_HOST_ARCH_32_BIT
+    return kWordAligned;
+  }
+
+  // Returns false for objects that can be skipped when scanning for pointers
+  // into from-space.
+  static bool ContainsPointers(Map* map) {
+    switch (static_cast<StaticVisitorBase::VisitorId>(map->visitor_id())) {
+      case StaticVisitorBase::kVisitSeqOneByteString:
+      case StaticVisitorBase::kVisitSeqTwoByteString:
+      case StaticVisitorBase::kVisitByteArray:
+      case StaticVisitorBase::kVisitFixedDoubleArray:
+        return false;
+      default: {
+        const int id = map->visitor_id();
+        return id < StaticVisitorBase::kVisitDataObject ||
+               id > StaticVisitorBase::kVisitDataObjectGeneric;
+      }
+    }
+  }
+
+  // Installs the forwarding address unless another task already did so.
+  static bool TryForward(HeapObject* object, MapWord map_word,
+                         HeapObject* target) {
+    const base::AtomicWord old_value =
+        static_cast<base::AtomicWord>(map_word.ToRawValue());
+    const base::AtomicWord new_value = static_cast<base::AtomicWord>(
+        MapWord::FromForwardingAddress(target).ToRawValue());
+    return base::Release_CompareAndSwap(
+               reinterpret_cast<base::AtomicWord*>(object->address()),
+               old_value, new_value) == old_value;
+  }
+
+  // Same as Heap::UpdateAllocationSite<Heap::kCached> but uses the map that
+  // was read before the object got forwarded.
+  Address RecordAllocationSite(HeapObject* object, Map* map, int size) {
+    if (!FLAG_allocation_site_pretenuring ||
+        !AllocationSite::CanTrack(map->instance_type())) {
+      return nullptr;
+    }
+    Address memento_address = object->address() + size;
+    if (!Page::OnSamePage(object->address(), memento_address + kPointerSize)) {
+      return nullptr;
+    }
+    HeapObject* candidate = HeapObject::FromAddress(memento_address);
+    MapWord candidate_map_word = candidate->map_word();
+    if (candidate_map_word.IsForwardingAddress() ||
+        candidate_map_word.ToMap() != heap_->allocation_memento_map()) {
+      return nullptr;
+    }
+    Address key =
+        AllocationMemento::cast(candidate)->GetAllocationSiteUnchecked();
+    base::HashMap::Entry* e =
+        local_pretenuring_feedback_.LookupOrInsert(key, ObjectHash(key));
+    DCHECK(e != nullptr);
+    (*bit_cast<intptr_t*>(&e->value))++;
+    return key;
+  }
+
+  bool AllocateInNewSpace(int size, AllocationAlignment alignment,
+                          HeapObject** target) {
+    AllocationResult allocation;
+    if (size > kMaxLabObjectSize) {
+      allocation = heap_->new_space()->AllocateRawSynchronized(size, alignment);
+      return allocation.To(target);
+    }
+    if (buffer_.IsValid()) {
+      allocation = buffer_.AllocateRawAligned(size, alignment);
+      if (allocation.To(target)) return true;
+    }
+    LocalAllocationBuffer saved_old_buffer = buffer_;
+    buffer_ = LocalAllocationBuffer::FromResult(
+        heap_, heap_->new_space()->AllocateRawSynchronized(kLabSize,
+                                                           kWordAligned),
+        kLabSize);
+    if (!buffer_.IsValid()) return false;
+    buffer_.TryMerge(&saved_old_buffer);
+    allocation = buffer_.AllocateRawAligned(size, alignment);
+    return allocation.To(target);
+  }
+
+  bool AllocateInOldSpace(int size, AllocationAlignment alignment,
+                          HeapObject** target) {
+    AllocationResult allocation =
+        compaction_spaces_.Get(OLD_SPACE)->AllocateRaw(size, alignment);
+    return allocation.To(target);
+  }
+
+  Heap* heap_;
+  LocalAllocationBuffer buffer_;
+  CompactionSpaceCollection compaction_spaces_;
+  base::HashMap local_pretenuring_feedback_;
+
+  // Copies of objects with an allocation memento or a tracked lifetime, see
+  // AllocationSiteLifetimes. The site is not validated yet.
+  struct Survivor {
+    Address from;
+    HeapObject* target;
+    Address site;
+  };
+  std::vector<Survivor> survivors_;
+
+  // Copied objects that still need to be visited.
+  std::vector<HeapObject*> stack_;
+  std::vector<Address> old_to_new_slots_;
+  bool visiting_promoted_object_;
+
+  intptr_t promoted_size_;
+  intptr_t semispace_copied_size_;
+  double duration_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+// Scavenges objects referenced from roots on the main thread. Mirrors
+// ScavengeVisitor.
+class ParallelScavenger::RootVisitor final : public ObjectVisitor {
+ public:
+  RootVisitor(Heap* heap, Worker* worker) : heap_(heap), worker_(worker) {}
+
+  void VisitPointer(Object** p) override { ScavengePointer(p); }
+
+  void VisitPointers(Object** start, Object** end) override {
+    for (Object** p = start; p < end; p++) ScavengePointer(p);
+  }
+
+ private:
+  void ScavengePointer(Object** p) {
+    Object* object = *p;
+    if (!heap_->InNewSpace(object)) return;
+
+    if (heap_->PurgeLeftTrimmedObject(p)) return;
+
+    worker_->ScavengeObject(reinterpret_cast<HeapObject**>(p),
+                            reinterpret_cast<HeapObject*>(object));
+  }
+
+  Heap* heap_;
+  Worker* worker_;
+};
+
+class ParallelScavenger::Task : public CancelableTask {
+ public:
+  Task(Heap* heap, ParallelScavenger* scavenger, Worker* worker,
+       base::Semaphore* on_finish)
+      : CancelableTask(heap->isolate()),
+        heap_(heap),
+        scavenger_(scavenger),
+        worker_(worker),
+        on_finish_(on_finish) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    const double start = heap_->MonotonicallyIncreasingTimeInMs();
+    scavenger_->ScavengeObjects(worker_);
+    worker_->set_duration(heap_->MonotonicallyIncreasingTimeInMs() - start);
+    on_finish_->Signal();
+  }
+
+  Heap* heap_;
+  ParallelScavenger* scavenger_;
+  Worker* worker_;
+  base::Semaphore* on_finish_;
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+ParallelScavenger::ParallelScavenger(Heap* heap)
+    : heap_(heap),
+      started_tasks_(0),
+      idle_tasks_(0),
+      pending_tasks_semaphore_(0) {}
+
+int ParallelScavenger::NumberOfTasks() {
+  return Min(kMaxTasks,
+             static_cast<int>(
+                 V8::GetCurrentPlatform()->NumberOfAvailableBackgroundThreads()));
+}
+
+bool ParallelScavenger::ShouldScavengeInParallel() {
+  if (!FLAG_parallel_scavenge || NumberOfTasks() == 0) return false;
+  // Transferring marks, recording copied objects and emitting move events
+  // are only implemented by the sequential scavenging visitors.
+  return !heap_->incremental_marking()->IsMarking() && !FLAG_log_gc &&
+         !heap_->scavenge_collector_->IsLoggingAndProfiling();
+}
+
+void ParallelScavenger::Scavenge() {
+  Worker main_worker(heap_);
+  RootVisitor root_visitor(heap_, &main_worker);
+
+  {
+    // Copy roots.
+    TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_ROOTS);
+    heap_->IterateRoots(&root_visitor, VISIT_ALL_IN_SCAVENGE);
+  }
+
+  {
+    TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_WEAK);
+    // Copy objects reachable from the encountered weak collections list.
+    root_visitor.VisitPointer(&heap_->encountered_weak_collections_);
+    // Copy objects reachable from the encountered weak cells.
+    root_visitor.VisitPointer(&heap_->encountered_weak_cells_);
+  }
+
+  {
+    // Copy objects reachable from the code flushing candidates list.
+    TRACE_GC(heap_->tracer(),
+             GCTracer::Scope::SCAVENGER_CODE_FLUSH_CANDIDATES);
+    MarkCompactCollector* collector = heap_->mark_compact_collector();
+    if (collector->is_code_flushing_enabled()) {
+      collector->code_flusher()->IteratePointersToFromSpace(&root_visitor);
+    }
+  }
+
+  {
+    TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_OLD_TO_NEW_POINTERS);
+    // Typed slots are embedded in code objects and are updated on the main
+    // thread.
+    RememberedSet<OLD_TO_NEW>::IterateTyped(
+        heap_, [this, &main_worker](SlotType type, Address host_addr,
+                                    Address addr) {
+          return UpdateTypedSlotHelper::UpdateTypedSlot(
+              heap_->isolate(), type, addr, [&main_worker](Object** addr) {
+                return main_worker.CheckAndScavengeObject(
+                    reinterpret_cast<Address>(addr));
+              });
+        });
+    RememberedSet<OLD_TO_NEW>::IterateMemoryChunks(
+        heap_, [this](MemoryChunk* chunk) {
+          if (chunk->old_to_new_slots() != nullptr) chunks_.push_back(chunk);
+        });
+  }
+
+  {
+    TRACE_GC(heap_->tracer(), GCTracer::Scope::SCAVENGER_PARALLEL);
+    DCHECK(shared_.empty());
+    next_chunk_.SetValue(0);
+    started_tasks_ = 0;
+    idle_tasks_ = 0;
+    idle_tasks_hint_.SetValue(0);
+
+    const int num_tasks = NumberOfTasks();
+    Worker** workers = new Worker*[num_tasks];
+    uint32_t task_ids[kMaxTasks];
+    for (int i = 0; i < num_tasks; i++) {
+      workers[i] = new Worker(heap_);
+      Task* task =
+          new Task(heap_, this, workers[i], &pending_tasks_semaphore_);
+      task_ids[i] = task->id();
+      V8::GetCurrentPlatform()->CallOnBackgroundThread(
+          task, v8::Platform::kShortRunningTask);
+    }
+
+    // Contribute on main thread.
+    ScavengeObjects(&main_worker);
+
+    // Wait for background tasks.
+    for (int i = 0; i < num_tasks; i++) {
+      if (!heap_->isolate()->cancelable_task_manager()->TryAbort(task_ids[i])) {
+        pending_tasks_semaphore_.Wait();
+      }
+    }
+    DCHECK(shared_.empty());
+    chunks_.clear();
+
+    double background_duration = 0.0;
+    intptr_t background_copied_bytes = 0;
+    main_worker.Finalize();
+    for (int i = 0; i < num_tasks; i++) {
+      background_duration += workers[i]->duration();
+      background_copied_bytes += workers[i]->copied_size();
+      workers[i]->Finalize();
+      delete workers[i];
+    }
+    delete[] workers;
+    heap_->tracer()->AddParallelScavengeStep(background_duration,
+                                             background_copied_bytes);
+  }
+}
+
+void ParallelScavenger::ScavengeObjects(Worker* worker) {
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    started_tasks_++;
+  }
+  ProcessLocalStack(worker);
+  const int num_chunks = static_cast<int>(chunks_.size());
+  int index;
+  while ((index = next_chunk_.Increment(1) - 1) < num_chunks) {
+    RememberedSet<OLD_TO_NEW>::Iterate(
+        chunks_[index], [worker](Address addr) {
+          return worker->CheckAndScavengeObject(addr);
+        });
+    ProcessLocalStack(worker);
+  }
+  while (TakeWork(worker)) {
+    ProcessLocalStack(worker);
+  }
+}
+
+void ParallelScavenger::ProcessLocalStack(Worker* worker) {
+  std::vector<HeapObject*>& stack = worker->stack();
+  while (!stack.empty()) {
+    HeapObject* object = stack.back();
+    stack.pop_back();
+    worker->Visit(object);
+    if (stack.size() > static_cast<size_t>(kChunkSize) &&
+        idle_tasks_hint_.Value() > 0) {
+      ShareWork(worker);
+    }
+  }
+}
+
+bool ParallelScavenger::TakeWork(Worker* worker) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  idle_tasks_++;
+  idle_tasks_hint_.SetValue(idle_tasks_);
+  while (shared_.empty()) {
+    // Tasks that have not started yet cannot hold any work. Idle tasks have
+    // run out of remembered set chunks, so scavenging is complete once all
+    // started tasks are idle.
+    if (idle_tasks_ == started_tasks_) {
+      work_available_.NotifyAll();
+      return false;
+    }
+    work_available_.Wait(&mutex_);
+  }
+  idle_tasks_--;
+  idle_tasks_hint_.SetValue(idle_tasks_);
+  const size_t count = Min(shared_.size(), static_cast<size_t>(kChunkSize));
+  std::vector<HeapObject*>& stack = worker->stack();
+  stack.insert(stack.end(), shared_.end() - count, shared_.end());
+  shared_.resize(shared_.size() - count);
+  return true;
+}
+
+void ParallelScavenger::ShareWork(Worker* worker) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  std::vector<HeapObject*>& stack = worker->stack();
+  shared_.insert(shared_.end(), stack.begin(), stack.begin() + kChunkSize);
+  stack.erase(stack.begin(), stack.begin() + kChunkSize);
+  work_available_.NotifyAll();
+}
+
+}  // namespace internal
+}  // namespace v8
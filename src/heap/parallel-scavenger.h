@@ -0,0 +1,106 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_PARALLEL_SCAVENGER_H_
+#define V8_HEAP_PARALLEL_SCAVENGER_H_
+
+#include <vector>
+
+#include "src/base/atomic-utils.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/cancelable-task.h"
+#include "src/utils.h"
+
+namespace v8 {
+namespace internal {
+
+class Heap;
+class HeapObject;
+class MemoryChunk;
+
+// Scavenges the young generation with the help of background tasks posted
+// through v8::Platform::CallOnBackgroundThread.
+//
+// The main thread copies objects referenced from roots and typed slots. The
+// untyped old-to-new remembered set is then split up by memory chunk, and all
+// tasks, including the main thread, process chunks and the transitive closure
+// of the objects they copied. Each task owns a local allocation buffer in
+// to-space and a compaction space for promotion. Forwarding addresses are
+// installed with a compare-and-swap on the map word, so racing tasks agree on
+// a single copy. Idle tasks steal copied-but-unvisited objects from a shared
+// pool.
+//
+// Old-to-new slots of promoted objects and pretenuring feedback are buffered
+// per task and applied by the main thread once all tasks have finished.
+// Weak roots, object groups and the external string table are processed
+// sequentially afterwards.
+class ParallelScavenger {
+ public:
+  explicit ParallelScavenger(Heap* heap);
+
+  // Returns true if the current scavenge can be performed in parallel. The
+  // parallel scavenger neither transfers marks nor emits move events, so it
+  // is only used outside of incremental marking and without logging.
+  bool ShouldScavengeInParallel();
+
+  // Copies everything reachable from roots, the old-to-new remembered set,
+  // encountered weak lists and code flushing candidates. Blocks until all
+  // tasks have finished.
+  void Scavenge();
+
+ private:
+  class RootVisitor;
+  class Task;
+  class Worker;
+
+  // Number of objects moved between a task-local stack and the shared pool
+  // at once.
+  static const int kChunkSize = 128;
+
+  static const int kMaxTasks = 4;
+
+  int NumberOfTasks();
+
+  // Runs the scavenging loop of a single task. Called on the main thread as
+  // well as on background threads.
+  void ScavengeObjects(Worker* worker);
+
+  // Visits objects on the task-local stack until it is empty.
+  void ProcessLocalStack(Worker* worker);
+
+  // Moves a chunk of objects from the shared pool to the task-local stack.
+  // Returns false once all started tasks ran out of work.
+  bool TakeWork(Worker* worker);
+
+  // Moves a chunk of objects from the task-local stack to the shared pool.
+  void ShareWork(Worker* worker);
+
+  Heap* heap_;
+
+  // Memory chunks with untyped old-to-new slots. Claimed by tasks through
+  // {next_chunk_}.
+  std::vector<MemoryChunk*> chunks_;
+  base::AtomicNumber<int> next_chunk_;
+
+  // Guards the shared state below.
+  base::Mutex mutex_;
+  base::ConditionVariable work_available_;
+  std::vector<HeapObject*> shared_;
+  int started_tasks_;
+  int idle_tasks_;
+  base::AtomicNumber<int> idle_tasks_hint_;
+
+  // Signaled by every finished background task. Has the same lifetime as the
+  // isolate, see PageParallelJob for the reason.
+  base::Semaphore pending_tasks_semaphore_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelScavenger);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_PARALLEL_SCAVENGER_H_
@@ -14,16 +14,16 @@ namespace v8 {
 namespace internal {
 
 template <PointerDirection direction>
-void RememberedSet<direction>::ClearInvalidSlots(Heap* heap) {
+void RememberedSet<direction>::ClearInvalidSlots(Heap* heap,
+                                                 MemoryChunk* chunk) {
   STATIC_ASSERT(direction == OLD_TO_NEW);
-  for (MemoryChunk* chunk : *heap->old_space()) {
-    SlotSet* slots = GetSlotSet(chunk);
-    if (slots != nullptr) {
-      slots->Iterate([heap, chunk](Address addr) {
-        Object** slot = reinterpret_cast<Object**>(addr);
-        return IsValidSlot(heap, chunk, slot) ? KEEP_SLOT : REMOVE_SLOT;
-      });
-    }
+  DCHECK(chunk->owner() == heap->old_space());
+  SlotSet* slots = GetSlotSet(chunk);
+  if (slots != nullptr) {
+    slots->Iterate([heap, chunk](Address addr) {
+      Object** slot = reinterpret_cast<Object**>(addr);
+      return IsValidSlot(heap, chunk, slot) ? KEEP_SLOT : REMOVE_SLOT;
+    });
   }
 }
 
@@ -66,7 +66,8 @@ bool RememberedSet<direction>::IsValidSlot(Heap* heap, MemoryChunk* chunk,
              chunk, reinterpret_cast<Address>(slot));
 }
 
-template void RememberedSet<OLD_TO_NEW>::ClearInvalidSlots(Heap* heap);
+template void RememberedSet<OLD_TO_NEW>::ClearInvalidSlots(Heap* heap,
+                                                           MemoryChunk* chunk);
 template void RememberedSet<OLD_TO_NEW>::VerifyValidSlots(Heap* heap);
 template void RememberedSet<OLD_TO_OLD>::VerifyValidSlots(Heap* heap);
 
@@ -165,11 +165,12 @@ class RememberedSet {
     }
   }
 
-  // Eliminates all stale slots from the remembered set, i.e.
-  // slots that are not part of live objects anymore. This method must be
-  // called after marking, when the whole transitive closure is known and
-  // must be called before sweeping when mark bits are still intact.
-  static void ClearInvalidSlots(Heap* heap);
+  // Eliminates all stale slots of the given old space chunk from the
+  // remembered set, i.e. slots that are not part of live objects anymore.
+  // This method must be called after marking, when the whole transitive
+  // closure is known and must be called before sweeping when mark bits are
+  // still intact. Chunks can be processed in parallel.
+  static void ClearInvalidSlots(Heap* heap, MemoryChunk* chunk);
 
   static void VerifyValidSlots(Heap* heap);
 
@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_SCAVENGER_INL_H_
 #define V8_HEAP_SCAVENGER_INL_H_
 
+#include "src/heap/allocation-site-lifetimes.h"
 #include "src/heap/scavenger.h"
 
 namespace v8 {
@@ -28,13 +29,17 @@ void Scavenger::ScavengeObject(HeapObject** p, HeapObject* object) {
     return;
   }
 
-  object->GetHeap()->UpdateAllocationSite<Heap::kGlobal>(
-      object, object->GetHeap()->global_pretenuring_feedback_);
+  Heap* heap = object->GetHeap();
+  Address site = heap->UpdateAllocationSite<Heap::kGlobal>(
+      object, heap->global_pretenuring_feedback_);
 
   // AllocationMementos are unrooted and shouldn't survive a scavenge
-  DCHECK(object->map() != object->GetHeap()->allocation_memento_map());
+  DCHECK(object->map() != heap->allocation_memento_map());
   // Call the slow part of scavenge object.
-  return ScavengeObjectSlow(p, object);
+  if (!FLAG_pretenuring_histograms) return ScavengeObjectSlow(p, object);
+  ScavengeObjectSlow(p, object);
+  heap->allocation_site_lifetimes()->RecordSurvivor(
+      object->address(), *p, reinterpret_cast<AllocationSite*>(site));
 }
 
 SlotCallbackResult Scavenger::CheckAndScavengeObject(Heap* heap,
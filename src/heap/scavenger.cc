@@ -387,12 +387,16 @@ void Scavenger::ScavengeObjectSlow(HeapObject** p, HeapObject* object) {
 }
 
 
+bool Scavenger::IsLoggingAndProfiling() {
+  return FLAG_verify_predictable || isolate()->logger()->is_logging() ||
+         isolate()->is_profiling() ||
+         (isolate()->heap_profiler() != NULL &&
+          isolate()->heap_profiler()->is_tracking_object_moves());
+}
+
+
 void Scavenger::SelectScavengingVisitorsTable() {
-  bool logging_and_profiling =
-      FLAG_verify_predictable || isolate()->logger()->is_logging() ||
-      isolate()->is_profiling() ||
-      (isolate()->heap_profiler() != NULL &&
-       isolate()->heap_profiler()->is_tracking_object_moves());
+  bool logging_and_profiling = IsLoggingAndProfiling();
 
   if (!heap()->incremental_marking()->IsMarking()) {
     if (!logging_and_profiling) {
@@ -36,6 +36,10 @@ class Scavenger {
   // of the heap (i.e. incremental marking, logging and profiling).
   void SelectScavengingVisitorsTable();
 
+  // Returns true if copied objects have to be reported to the logger or
+  // profilers.
+  bool IsLoggingAndProfiling();
+
   Isolate* isolate();
   Heap* heap() { return heap_; }
 
@@ -19,12 +19,20 @@ enum SlotCallbackResult { KEEP_SLOT, REMOVE_SLOT };
 // operation.
 // The data structure assumes that the slots are pointer size aligned and
 // splits the valid slot offset range into kBuckets buckets.
-// Each bucket is a bitmap with a bit corresponding to a single slot offset.
+// Each bucket adapts its representation to the number of slots it contains:
+// - sparse: a sorted array of up to kSparseCapacity slot indices,
+// - dense: a bitmap with a bit corresponding to a single slot offset,
+// - full: no storage, all slots of the bucket are in the set.
+// Buckets start out sparse, become dense when the sorted array overflows and
+// become full when all bits are set. Iteration moves buckets back to the
+// sparse representation when only a few slots survive.
 class SlotSet : public Malloced {
  public:
   SlotSet() {
     for (int i = 0; i < kBuckets; i++) {
-      bucket[i] = nullptr;
+      bucket_[i] = nullptr;
+      mode_[i] = kEmpty;
+      sparse_count_[i] = 0;
     }
   }
 
@@ -38,25 +46,41 @@ class SlotSet : public Malloced {
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   void Insert(int slot_offset) {
-    int bucket_index, cell_index, bit_index;
-    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    if (bucket[bucket_index] == nullptr) {
-      bucket[bucket_index] = AllocateBucket();
+    int bucket_index, index;
+    SlotToIndices(slot_offset, &bucket_index, &index);
+    switch (mode_[bucket_index]) {
+      case kEmpty:
+        AllocateSparseBucket(bucket_index);
+        InsertSparse(bucket_index, index);
+        break;
+      case kSparse:
+        InsertSparse(bucket_index, index);
+        break;
+      case kDense:
+        InsertDense(bucket_index, index);
+        break;
+      case kFull:
+        break;
     }
-    bucket[bucket_index][cell_index] |= 1u << bit_index;
   }
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   void Remove(int slot_offset) {
-    int bucket_index, cell_index, bit_index;
-    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    if (bucket[bucket_index] != nullptr) {
-      uint32_t cell = bucket[bucket_index][cell_index];
-      if (cell) {
-        uint32_t bit_mask = 1u << bit_index;
-        if (cell & bit_mask) {
-          bucket[bucket_index][cell_index] ^= bit_mask;
-        }
+    int bucket_index, index;
+    SlotToIndices(slot_offset, &bucket_index, &index);
+    switch (mode_[bucket_index]) {
+      case kEmpty:
+        break;
+      case kSparse:
+        RemoveRangeInSparseBucket(bucket_index, index, index + 1);
+        break;
+      case kFull:
+        ConvertFullToDense(bucket_index);
+      // Fall through.
+      case kDense: {
+        uint32_t* cells = DenseCells(bucket_index);
+        cells[index >> kBitsPerCellLog2] &= ~(1u << (index & kBitIndexMask));
+        break;
       }
     }
   }
@@ -65,60 +89,59 @@ class SlotSet : public Malloced {
   // [page_start_ + start_offset ... page_start_ + end_offset).
   void RemoveRange(int start_offset, int end_offset) {
     DCHECK_LE(start_offset, end_offset);
-    int start_bucket, start_cell, start_bit;
-    SlotToIndices(start_offset, &start_bucket, &start_cell, &start_bit);
-    int end_bucket, end_cell, end_bit;
-    SlotToIndices(end_offset, &end_bucket, &end_cell, &end_bit);
-    uint32_t start_mask = (1u << start_bit) - 1;
-    uint32_t end_mask = ~((1u << end_bit) - 1);
-    if (start_bucket == end_bucket && start_cell == end_cell) {
-      MaskCell(start_bucket, start_cell, start_mask | end_mask);
-      return;
-    }
-    int current_bucket = start_bucket;
-    int current_cell = start_cell;
-    MaskCell(current_bucket, current_cell, start_mask);
-    current_cell++;
-    if (current_bucket < end_bucket) {
-      if (bucket[current_bucket] != nullptr) {
-        while (current_cell < kCellsPerBucket) {
-          bucket[current_bucket][current_cell] = 0;
-          current_cell++;
-        }
+    DCHECK_EQ(start_offset % kPointerSize, 0);
+    DCHECK_EQ(end_offset % kPointerSize, 0);
+    const int start_slot = start_offset >> kPointerSizeLog2;
+    const int end_slot = end_offset >> kPointerSizeLog2;
+    DCHECK(start_slot >= 0 && end_slot <= kMaxSlots);
+    for (int bucket_index = start_slot >> kSlotsPerBucketLog2;
+         bucket_index < kBuckets; bucket_index++) {
+      const int bucket_start = bucket_index << kSlotsPerBucketLog2;
+      if (bucket_start >= end_slot) break;
+      const int start = Max(start_slot, bucket_start) - bucket_start;
+      const int end = Min(end_slot, bucket_start + kSlotsPerBucket) -
+                      bucket_start;
+      if (start == 0 && end == kSlotsPerBucket) {
+        ReleaseBucket(bucket_index);
+        continue;
+      }
+      switch (mode_[bucket_index]) {
+        case kEmpty:
+          break;
+        case kSparse:
+          RemoveRangeInSparseBucket(bucket_index, start, end);
+          break;
+        case kFull:
+          ConvertFullToDense(bucket_index);
+        // Fall through.
+        case kDense:
+          RemoveRangeInDenseBucket(bucket_index, start, end);
+          break;
       }
-      // The rest of the current bucket is cleared.
-      // Move on to the next bucket.
-      current_bucket++;
-      current_cell = 0;
-    }
-    DCHECK(current_bucket == end_bucket ||
-           (current_bucket < end_bucket && current_cell == 0));
-    while (current_bucket < end_bucket) {
-      ReleaseBucket(current_bucket);
-      current_bucket++;
-    }
-    // All buckets between start_bucket and end_bucket are cleared.
-    DCHECK(current_bucket == end_bucket && current_cell <= end_cell);
-    if (current_bucket == kBuckets || bucket[current_bucket] == nullptr) {
-      return;
-    }
-    while (current_cell < end_cell) {
-      bucket[current_bucket][current_cell] = 0;
-      current_cell++;
     }
-    // All cells between start_cell and end_cell are cleared.
-    DCHECK(current_bucket == end_bucket && current_cell == end_cell);
-    MaskCell(end_bucket, end_cell, end_mask);
   }
 
   // The slot offset specifies a slot at address page_start_ + slot_offset.
   bool Lookup(int slot_offset) {
-    int bucket_index, cell_index, bit_index;
-    SlotToIndices(slot_offset, &bucket_index, &cell_index, &bit_index);
-    if (bucket[bucket_index] != nullptr) {
-      uint32_t cell = bucket[bucket_index][cell_index];
-      return (cell & (1u << bit_index)) != 0;
+    int bucket_index, index;
+    SlotToIndices(slot_offset, &bucket_index, &index);
+    switch (mode_[bucket_index]) {
+      case kEmpty:
+        return false;
+      case kSparse: {
+        uint16_t* indices = SparseIndices(bucket_index);
+        const int count = sparse_count_[bucket_index];
+        const int position = LowerBound(indices, count, index);
+        return position < count && indices[position] == index;
+      }
+      case kDense: {
+        uint32_t cell = DenseCells(bucket_index)[index >> kBitsPerCellLog2];
+        return (cell & (1u << (index & kBitIndexMask))) != 0;
+      }
+      case kFull:
+        return true;
     }
+    UNREACHABLE();
     return false;
   }
 
@@ -135,82 +158,309 @@ class SlotSet : public Malloced {
   int Iterate(Callback callback) {
     int new_count = 0;
     for (int bucket_index = 0; bucket_index < kBuckets; bucket_index++) {
-      if (bucket[bucket_index] != nullptr) {
-        int in_bucket_count = 0;
-        uint32_t* current_bucket = bucket[bucket_index];
-        int cell_offset = bucket_index * kBitsPerBucket;
-        for (int i = 0; i < kCellsPerBucket; i++, cell_offset += kBitsPerCell) {
-          if (current_bucket[i]) {
-            uint32_t cell = current_bucket[i];
-            uint32_t old_cell = cell;
-            uint32_t new_cell = cell;
-            while (cell) {
-              int bit_offset = base::bits::CountTrailingZeros32(cell);
-              uint32_t bit_mask = 1u << bit_offset;
-              uint32_t slot = (cell_offset + bit_offset) << kPointerSizeLog2;
-              if (callback(page_start_ + slot) == KEEP_SLOT) {
-                ++in_bucket_count;
-              } else {
-                new_cell ^= bit_mask;
-              }
-              cell ^= bit_mask;
-            }
-            if (old_cell != new_cell) {
-              current_bucket[i] = new_cell;
-            }
-          }
-        }
-        if (in_bucket_count == 0) {
-          ReleaseBucket(bucket_index);
-        }
-        new_count += in_bucket_count;
+      switch (mode_[bucket_index]) {
+        case kEmpty:
+          break;
+        case kSparse:
+          new_count += IterateSparseBucket(bucket_index, callback);
+          break;
+        case kDense:
+          new_count += IterateDenseBucket(bucket_index, callback);
+          break;
+        case kFull:
+          new_count += IterateFullBucket(bucket_index, callback);
+          break;
       }
     }
     return new_count;
   }
 
+  // Returns the number of bytes allocated for buckets, excluding the
+  // SlotSet itself.
+  size_t AllocatedBucketMemory() {
+    size_t bytes = 0;
+    for (int i = 0; i < kBuckets; i++) {
+      if (mode_[i] == kSparse) {
+        bytes += kSparseCapacity * sizeof(uint16_t);
+      } else if (mode_[i] == kDense) {
+        bytes += kCellsPerBucket * sizeof(uint32_t);
+      }
+    }
+    return bytes;
+  }
+
  private:
+  enum BucketMode : uint8_t { kEmpty, kSparse, kDense, kFull };
+
   static const int kMaxSlots = (1 << kPageSizeBits) / kPointerSize;
   static const int kCellsPerBucket = 32;
   static const int kCellsPerBucketLog2 = 5;
   static const int kBitsPerCell = 32;
   static const int kBitsPerCellLog2 = 5;
-  static const int kBitsPerBucket = kCellsPerBucket * kBitsPerCell;
-  static const int kBitsPerBucketLog2 = kCellsPerBucketLog2 + kBitsPerCellLog2;
+  static const int kBitIndexMask = kBitsPerCell - 1;
+  static const int kSlotsPerBucket = kCellsPerBucket * kBitsPerCell;
+  static const int kSlotsPerBucketLog2 = kCellsPerBucketLog2 + kBitsPerCellLog2;
   static const int kBuckets = kMaxSlots / kCellsPerBucket / kBitsPerCell;
+  // A sparse bucket takes an eighth of the memory of a dense bucket.
+  static const int kSparseCapacity = 8;
+  // Dense buckets with at most that many slots left after iteration become
+  // sparse again. Smaller than kSparseCapacity to avoid flip-flopping.
+  static const int kSparseThreshold = kSparseCapacity / 2;
+
+  STATIC_ASSERT(kSlotsPerBucket <= (1 << 16));
+
+  uint16_t* SparseIndices(int bucket_index) {
+    DCHECK_EQ(kSparse, mode_[bucket_index]);
+    return static_cast<uint16_t*>(bucket_[bucket_index]);
+  }
 
-  uint32_t* AllocateBucket() {
-    uint32_t* result = NewArray<uint32_t>(kCellsPerBucket);
+  uint32_t* DenseCells(int bucket_index) {
+    DCHECK_EQ(kDense, mode_[bucket_index]);
+    return static_cast<uint32_t*>(bucket_[bucket_index]);
+  }
+
+  void AllocateSparseBucket(int bucket_index) {
+    DCHECK_EQ(kEmpty, mode_[bucket_index]);
+    bucket_[bucket_index] = NewArray<uint16_t>(kSparseCapacity);
+    mode_[bucket_index] = kSparse;
+    sparse_count_[bucket_index] = 0;
+  }
+
+  uint32_t* AllocateDenseBucket(int bucket_index, uint32_t initial_value) {
+    DCHECK_NULL(bucket_[bucket_index]);
+    uint32_t* cells = NewArray<uint32_t>(kCellsPerBucket);
     for (int i = 0; i < kCellsPerBucket; i++) {
-      result[i] = 0;
+      cells[i] = initial_value;
     }
-    return result;
+    bucket_[bucket_index] = cells;
+    mode_[bucket_index] = kDense;
+    return cells;
   }
 
   void ReleaseBucket(int bucket_index) {
-    DeleteArray<uint32_t>(bucket[bucket_index]);
-    bucket[bucket_index] = nullptr;
+    if (mode_[bucket_index] == kSparse) {
+      DeleteArray<uint16_t>(SparseIndices(bucket_index));
+    } else if (mode_[bucket_index] == kDense) {
+      DeleteArray<uint32_t>(DenseCells(bucket_index));
+    }
+    bucket_[bucket_index] = nullptr;
+    mode_[bucket_index] = kEmpty;
+    sparse_count_[bucket_index] = 0;
+  }
+
+  void ConvertSparseToDense(int bucket_index) {
+    uint16_t* indices = SparseIndices(bucket_index);
+    const int count = sparse_count_[bucket_index];
+    bucket_[bucket_index] = nullptr;
+    uint32_t* cells = AllocateDenseBucket(bucket_index, 0);
+    for (int i = 0; i < count; i++) {
+      const int index = indices[i];
+      cells[index >> kBitsPerCellLog2] |= 1u << (index & kBitIndexMask);
+    }
+    DeleteArray<uint16_t>(indices);
+    sparse_count_[bucket_index] = 0;
+  }
+
+  void ConvertDenseToSparse(int bucket_index) {
+    uint32_t* cells = DenseCells(bucket_index);
+    bucket_[bucket_index] = nullptr;
+    mode_[bucket_index] = kEmpty;
+    AllocateSparseBucket(bucket_index);
+    uint16_t* indices = SparseIndices(bucket_index);
+    int count = 0;
+    for (int i = 0; i < kCellsPerBucket; i++) {
+      uint32_t cell = cells[i];
+      while (cell) {
+        int bit_offset = base::bits::CountTrailingZeros32(cell);
+        DCHECK_LT(count, kSparseCapacity);
+        indices[count++] =
+            static_cast<uint16_t>((i << kBitsPerCellLog2) + bit_offset);
+        cell ^= 1u << bit_offset;
+      }
+    }
+    sparse_count_[bucket_index] = static_cast<uint8_t>(count);
+    DeleteArray<uint32_t>(cells);
+  }
+
+  uint32_t* ConvertFullToDense(int bucket_index) {
+    DCHECK_EQ(kFull, mode_[bucket_index]);
+    return AllocateDenseBucket(bucket_index, ~0u);
+  }
+
+  void ConvertDenseToFull(int bucket_index) {
+    DeleteArray<uint32_t>(DenseCells(bucket_index));
+    bucket_[bucket_index] = nullptr;
+    mode_[bucket_index] = kFull;
+  }
+
+  // Returns the position of the first index that is not smaller than the
+  // given one.
+  static int LowerBound(uint16_t* indices, int count, int index) {
+    int position = 0;
+    while (position < count && indices[position] < index) position++;
+    return position;
+  }
+
+  void InsertSparse(int bucket_index, int index) {
+    uint16_t* indices = SparseIndices(bucket_index);
+    const int count = sparse_count_[bucket_index];
+    const int position = LowerBound(indices, count, index);
+    if (position < count && indices[position] == index) return;
+    if (count == kSparseCapacity) {
+      ConvertSparseToDense(bucket_index);
+      InsertDense(bucket_index, index);
+      return;
+    }
+    for (int i = count; i > position; i--) {
+      indices[i] = indices[i - 1];
+    }
+    indices[position] = static_cast<uint16_t>(index);
+    sparse_count_[bucket_index]++;
+  }
+
+  void InsertDense(int bucket_index, int index) {
+    uint32_t* cells = DenseCells(bucket_index);
+    const int cell_index = index >> kBitsPerCellLog2;
+    cells[cell_index] |= 1u << (index & kBitIndexMask);
+    if (cells[cell_index] != ~0u) return;
+    for (int i = 0; i < kCellsPerBucket; i++) {
+      if (cells[i] != ~0u) return;
+    }
+    ConvertDenseToFull(bucket_index);
+  }
+
+  // Removes the indices in [start, end) from a sparse bucket.
+  void RemoveRangeInSparseBucket(int bucket_index, int start, int end) {
+    uint16_t* indices = SparseIndices(bucket_index);
+    const int count = sparse_count_[bucket_index];
+    int new_count = 0;
+    for (int i = 0; i < count; i++) {
+      if (indices[i] < start || indices[i] >= end) {
+        indices[new_count++] = indices[i];
+      }
+    }
+    if (new_count == 0) {
+      ReleaseBucket(bucket_index);
+    } else {
+      sparse_count_[bucket_index] = static_cast<uint8_t>(new_count);
+    }
+  }
+
+  // Removes the indices in [start, end) from a dense bucket.
+  void RemoveRangeInDenseBucket(int bucket_index, int start, int end) {
+    if (start >= end) return;
+    uint32_t* cells = DenseCells(bucket_index);
+    const int start_cell = start >> kBitsPerCellLog2;
+    const int end_cell = end >> kBitsPerCellLog2;
+    const uint32_t start_mask = (1u << (start & kBitIndexMask)) - 1;
+    const uint32_t end_mask = ~((1u << (end & kBitIndexMask)) - 1);
+    if (start_cell == end_cell) {
+      cells[start_cell] &= start_mask | end_mask;
+      return;
+    }
+    cells[start_cell] &= start_mask;
+    for (int i = start_cell + 1; i < end_cell; i++) {
+      cells[i] = 0;
+    }
+    if (end_cell < kCellsPerBucket) {
+      cells[end_cell] &= end_mask;
+    }
+  }
+
+  Address SlotAddress(int bucket_index, int index) {
+    const int slot = (bucket_index << kSlotsPerBucketLog2) + index;
+    return page_start_ + (slot << kPointerSizeLog2);
   }
 
-  void MaskCell(int bucket_index, int cell_index, uint32_t mask) {
-    uint32_t* cells = bucket[bucket_index];
-    if (cells != nullptr && cells[cell_index] != 0) {
-      cells[cell_index] &= mask;
+  template <typename Callback>
+  int IterateSparseBucket(int bucket_index, Callback callback) {
+    uint16_t* indices = SparseIndices(bucket_index);
+    const int count = sparse_count_[bucket_index];
+    int new_count = 0;
+    for (int i = 0; i < count; i++) {
+      if (callback(SlotAddress(bucket_index, indices[i])) == KEEP_SLOT) {
+        indices[new_count++] = indices[i];
+      }
+    }
+    if (new_count == 0) {
+      ReleaseBucket(bucket_index);
+    } else {
+      sparse_count_[bucket_index] = static_cast<uint8_t>(new_count);
+    }
+    return new_count;
+  }
+
+  template <typename Callback>
+  int IterateDenseBucket(int bucket_index, Callback callback) {
+    int in_bucket_count = 0;
+    uint32_t* current_bucket = DenseCells(bucket_index);
+    int cell_offset = 0;
+    for (int i = 0; i < kCellsPerBucket; i++, cell_offset += kBitsPerCell) {
+      if (current_bucket[i]) {
+        uint32_t cell = current_bucket[i];
+        uint32_t old_cell = cell;
+        uint32_t new_cell = cell;
+        while (cell) {
+          int bit_offset = base::bits::CountTrailingZeros32(cell);
+          uint32_t bit_mask = 1u << bit_offset;
+          if (callback(SlotAddress(bucket_index, cell_offset + bit_offset)) ==
+              KEEP_SLOT) {
+            ++in_bucket_count;
+          } else {
+            new_cell ^= bit_mask;
+          }
+          cell ^= bit_mask;
+        }
+        if (old_cell != new_cell) {
+          current_bucket[i] = new_cell;
+        }
+      }
+    }
+    if (in_bucket_count == 0) {
+      ReleaseBucket(bucket_index);
+    } else if (in_bucket_count <= kSparseThreshold) {
+      ConvertDenseToSparse(bucket_index);
+    } else if (in_bucket_count == kSlotsPerBucket) {
+      ConvertDenseToFull(bucket_index);
+    }
+    return in_bucket_count;
+  }
+
+  template <typename Callback>
+  int IterateFullBucket(int bucket_index, Callback callback) {
+    int in_bucket_count = 0;
+    // Only materialized once the first slot is removed.
+    uint32_t* cells = nullptr;
+    for (int i = 0; i < kSlotsPerBucket; i++) {
+      if (callback(SlotAddress(bucket_index, i)) == KEEP_SLOT) {
+        ++in_bucket_count;
+      } else {
+        if (cells == nullptr) cells = ConvertFullToDense(bucket_index);
+        cells[i >> kBitsPerCellLog2] ^= 1u << (i & kBitIndexMask);
+      }
+    }
+    if (in_bucket_count == 0) {
+      ReleaseBucket(bucket_index);
+    } else if (cells != nullptr && in_bucket_count <= kSparseThreshold) {
+      ConvertDenseToSparse(bucket_index);
     }
+    return in_bucket_count;
   }
 
-  // Converts the slot offset into bucket/cell/bit index.
-  void SlotToIndices(int slot_offset, int* bucket_index, int* cell_index,
-                     int* bit_index) {
+  // Converts the slot offset into bucket index and the index of the slot
+  // within the bucket.
+  void SlotToIndices(int slot_offset, int* bucket_index, int* index) {
     DCHECK_EQ(slot_offset % kPointerSize, 0);
     int slot = slot_offset >> kPointerSizeLog2;
-    DCHECK(slot >= 0 && slot <= kMaxSlots);
-    *bucket_index = slot >> kBitsPerBucketLog2;
-    *cell_index = (slot >> kBitsPerCellLog2) & (kCellsPerBucket - 1);
-    *bit_index = slot & (kBitsPerCell - 1);
+    DCHECK(slot >= 0 && slot < kMaxSlots);
+    *bucket_index = slot >> kSlotsPerBucketLog2;
+    *index = slot & (kSlotsPerBucket - 1);
   }
 
-  uint32_t* bucket[kBuckets];
+  void* bucket_[kBuckets];
+  BucketMode mode_[kBuckets];
+  // Number of used entries of sparse buckets.
+  uint8_t sparse_count_[kBuckets];
   Address page_start_;
 };
 
@@ -314,6 +314,11 @@ void MemoryAllocator::TearDown() {
   unmapper()->WaitUntilCompleted();
 
   MemoryChunk* chunk = nullptr;
+  while ((chunk = unmapper()->TryGetPreAllocatedMemoryChunkSafe()) != nullptr) {
+    size_.Increment(-static_cast<intptr_t>(MemoryChunk::kPageSize));
+    FreeMemory(reinterpret_cast<Address>(chunk), MemoryChunk::kPageSize,
+               NOT_EXECUTABLE);
+  }
   while ((chunk = unmapper()->TryGetPooledMemoryChunkSafe()) != nullptr) {
     FreeMemory(reinterpret_cast<Address>(chunk), MemoryChunk::kPageSize,
                NOT_EXECUTABLE);
@@ -342,6 +347,7 @@ class MemoryAllocator::Unmapper::UnmapFreeMemoryTask : public v8::Task {
   // v8::Task overrides.
   void Run() override {
     unmapper_->PerformFreeMemoryOnQueuedChunks();
+    unmapper_->RefillPreAllocatedChunks();
     unmapper_->pending_unmapping_tasks_semaphore_.Signal();
   }
 
@@ -375,6 +381,14 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks() {
   // Regular chunks.
   while ((chunk = GetMemoryChunkSafe<kRegular>()) != nullptr) {
     bool pooled = chunk->IsFlagSet(MemoryChunk::POOLED);
+    if (pooled && FLAG_discard_pooled_pages) {
+      if (allocator_->DiscardPooledMemory(chunk)) {
+        AddMemoryChunkSafe<kPooledDiscarded>(chunk);
+      } else {
+        AddMemoryChunkSafe<kPooled>(chunk);
+      }
+      continue;
+    }
     allocator_->PerformFreeMemory(chunk);
     if (pooled) AddMemoryChunkSafe<kPooled>(chunk);
   }
@@ -384,6 +398,21 @@ void MemoryAllocator::Unmapper::PerformFreeMemoryOnQueuedChunks() {
   }
 }
 
+void MemoryAllocator::Unmapper::RefillPreAllocatedChunks() {
+  while (true) {
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      if (static_cast<int>(chunks_[kPreAllocated].size()) >=
+          FLAG_page_pool_size) {
+        return;
+      }
+    }
+    MemoryChunk* chunk = allocator_->PreAllocateChunk();
+    if (chunk == nullptr) return;
+    AddMemoryChunkSafe<kPreAllocated>(chunk);
+  }
+}
+
 void MemoryAllocator::Unmapper::ReconsiderDelayedChunks() {
   std::list<MemoryChunk*> delayed_chunks(std::move(delayed_regular_chunks_));
   // Move constructed, so the permanent list should be empty.
@@ -791,7 +820,7 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
 
   base::VirtualMemory* reservation = chunk->reserved_memory();
   if (chunk->IsFlagSet(MemoryChunk::POOLED)) {
-    UncommitBlock(reinterpret_cast<Address>(chunk), MemoryChunk::kPageSize);
+    UncommitPooledMemory(chunk);
   } else {
     if (reservation->IsReserved()) {
       FreeMemory(reservation, chunk->executable());
@@ -801,6 +830,55 @@ void MemoryAllocator::PerformFreeMemory(MemoryChunk* chunk) {
   }
 }
 
+MemoryChunk* MemoryAllocator::PreAllocateChunk() {
+  const size_t size = MemoryChunk::kPageSize;
+  const intptr_t delta = static_cast<intptr_t>(size);
+  // Claim the memory before mapping it, so that the pool never grows beyond
+  // the remaining capacity, even if the main thread allocates concurrently.
+  if (size_.Increment(delta) > capacity_) {
+    size_.Increment(-delta);
+    return nullptr;
+  }
+  base::VirtualMemory reservation(size, MemoryChunk::kAlignment);
+  if (!reservation.IsReserved()) {
+    size_.Increment(-delta);
+    return nullptr;
+  }
+  Address base = RoundUp(static_cast<Address>(reservation.address()),
+                         MemoryChunk::kAlignment);
+  // The last chunk in the address space cannot be used, see AllocateChunk.
+  if ((reinterpret_cast<uintptr_t>(base) + size) == 0u ||
+      !reservation.Commit(base, size, false)) {
+    reservation.Release();
+    size_.Increment(-delta);
+    return nullptr;
+  }
+  UpdateAllocatedSpaceLimits(base, base + size);
+  // Pooled chunks are tracked by their address only, see AllocatePagePooled.
+  reservation.Reset();
+  return MemoryChunk::FromAddress(base);
+}
+
+bool MemoryAllocator::DiscardPooledMemory(MemoryChunk* chunk) {
+  DCHECK(chunk->IsFlagSet(MemoryChunk::PRE_FREED));
+  DCHECK(chunk->IsFlagSet(MemoryChunk::POOLED));
+  // The header still references memory that is allocated outside of the
+  // chunk, so it needs to be released before the contents are discarded.
+  chunk->ReleaseAllocatedMemory();
+  if (base::OS::DiscardSystemPages(chunk, MemoryChunk::kPageSize)) {
+    return true;
+  }
+  UncommitPooledMemory(chunk);
+  return false;
+}
+
+void MemoryAllocator::UncommitPooledMemory(MemoryChunk* chunk) {
+  // PreFreeMemory already removed the chunk from the allocated memory, it is
+  // accounted for again once AllocatePagePooled hands it out.
+  base::VirtualMemory::UncommitRegion(reinterpret_cast<Address>(chunk),
+                                      MemoryChunk::kPageSize);
+}
+
 template <MemoryAllocator::FreeMode mode>
 void MemoryAllocator::Free(MemoryChunk* chunk) {
   switch (mode) {
@@ -854,6 +932,9 @@ template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kRegular, SemiSpace>(
     intptr_t size, SemiSpace* owner, Executability executable);
 template Page*
+MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+    intptr_t size, PagedSpace* owner, Executability executable);
+template Page*
 MemoryAllocator::AllocatePage<MemoryAllocator::kPooled, SemiSpace>(
     intptr_t size, SemiSpace* owner, Executability executable);
 
@@ -867,19 +948,34 @@ LargePage* MemoryAllocator::AllocateLargePage(intptr_t size,
 
 template <typename SpaceType>
 MemoryChunk* MemoryAllocator::AllocatePagePooled(SpaceType* owner) {
-  MemoryChunk* chunk = unmapper()->TryGetPooledMemoryChunkSafe();
+  bool committed = false;
+  bool pre_allocated = false;
+  MemoryChunk* chunk =
+      unmapper()->TryGetPooledMemoryChunkSafe(&committed, &pre_allocated);
   if (chunk == nullptr) return nullptr;
   const int size = MemoryChunk::kPageSize;
   const Address start = reinterpret_cast<Address>(chunk);
   const Address area_start = start + MemoryChunk::kObjectStartOffset;
   const Address area_end = start + size;
-  if (!CommitBlock(reinterpret_cast<Address>(chunk), size, NOT_EXECUTABLE)) {
-    return nullptr;
+  // Pooled chunks are not accounted for while they are in the pool, so each
+  // reused chunk is added to the allocated memory exactly once here.
+  // Pre-allocated chunks are the exception, they are part of Size() already.
+  if (committed) {
+    // Discarded, pre-allocated and stolen chunks are still committed. Only
+    // redo the bookkeeping of CommitBlock.
+    if (Heap::ShouldZapGarbage()) {
+      ZapBlock(start, size);
+    }
+    isolate_->counters()->memory_allocated()->Increment(size);
+  } else {
+    if (!CommitBlock(start, size, NOT_EXECUTABLE)) {
+      return nullptr;
+    }
   }
   base::VirtualMemory reservation(start, size);
   MemoryChunk::Initialize(isolate_->heap(), start, size, area_start, area_end,
                           NOT_EXECUTABLE, owner, &reservation);
-  size_.Increment(size);
+  if (!pre_allocated) size_.Increment(size);
   return chunk;
 }
 
@@ -1211,7 +1307,14 @@ bool PagedSpace::Expand() {
 
   if (!heap()->CanExpandOldGeneration(size)) return false;
 
-  Page* p = heap()->memory_allocator()->AllocatePage(size, this, executable());
+  Page* p = nullptr;
+  if ((FLAG_discard_pooled_pages || FLAG_page_pool_size > 0) &&
+      executable() == NOT_EXECUTABLE && size == Page::kAllocatableMemory) {
+    p = heap()->memory_allocator()->AllocatePage<MemoryAllocator::kPooled>(
+        size, this, executable());
+  } else {
+    p = heap()->memory_allocator()->AllocatePage(size, this, executable());
+  }
   if (p == nullptr) return false;
 
   AccountCommitted(static_cast<intptr_t>(p->size()));
@@ -1279,7 +1382,12 @@ void PagedSpace::ReleasePage(Page* page) {
   }
 
   AccountUncommitted(static_cast<intptr_t>(page->size()));
-  heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+  if ((FLAG_discard_pooled_pages || FLAG_page_pool_size > 0) &&
+      executable() == NOT_EXECUTABLE && page->size() == Page::kPageSize) {
+    heap()->memory_allocator()->Free<MemoryAllocator::kPooledAndQueue>(page);
+  } else {
+    heap()->memory_allocator()->Free<MemoryAllocator::kPreFreeAndQueue>(page);
+  }
 
   DCHECK(Capacity() > 0);
   accounting_stats_.ShrinkSpace(AreaSize());
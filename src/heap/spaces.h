@@ -139,6 +139,21 @@ class MarkBit {
   inline bool Get() { return (*cell_ & mask_) != 0; }
   inline void Clear() { *cell_ &= ~mask_; }
 
+  // Sets the bit with a compare-and-swap on the cell so that concurrent
+  // updates of other bits in the same cell are not lost. Returns false if
+  // the bit was already set.
+  inline bool AtomicSet() {
+    base::Atomic32* cell = reinterpret_cast<base::Atomic32*>(cell_);
+    const base::Atomic32 mask = static_cast<base::Atomic32>(mask_);
+    base::Atomic32 old_value;
+    do {
+      old_value = base::NoBarrier_Load(cell);
+      if ((old_value & mask) != 0) return false;
+    } while (base::Release_CompareAndSwap(cell, old_value, old_value | mask) !=
+             old_value);
+    return true;
+  }
+
   CellType* cell_;
   CellType mask_;
 
@@ -1315,32 +1330,62 @@ class MemoryAllocator {
       }
     }
 
-    MemoryChunk* TryGetPooledMemoryChunkSafe() {
+    // Returns a chunk of kPageSize for reuse or nullptr if none is available.
+    // If given, {committed} is set to true if the memory of the chunk is
+    // still committed and {pre_allocated} is set to true if the chunk was
+    // allocated ahead of time and thus is already accounted for.
+    MemoryChunk* TryGetPooledMemoryChunkSafe(bool* committed = nullptr,
+                                             bool* pre_allocated = nullptr) {
       // Procedure:
-      // (1) Try to get a chunk that was declared as pooled and already has
+      // (1) Try to get a chunk that was declared as pooled and whose contents
+      // have been discarded.
+      // (2) Try to get a chunk that was allocated ahead of time.
+      // (3) Try to get a chunk that was declared as pooled and already has
       // been uncommitted.
-      // (2) Try to steal any memory chunk of kPageSize that would've been
+      // (4) Try to steal any memory chunk of kPageSize that would've been
       // unmapped.
-      MemoryChunk* chunk = GetMemoryChunkSafe<kPooled>();
-      if (chunk == nullptr) {
-        chunk = GetMemoryChunkSafe<kRegular>();
-        if (chunk != nullptr) {
-          // For stolen chunks we need to manually free any allocated memory.
-          chunk->ReleaseAllocatedMemory();
-        }
+      if (committed != nullptr) *committed = true;
+      if (pre_allocated != nullptr) *pre_allocated = false;
+      MemoryChunk* chunk = GetMemoryChunkSafe<kPooledDiscarded>();
+      if (chunk != nullptr) return chunk;
+      chunk = TryGetPreAllocatedMemoryChunkSafe();
+      if (chunk != nullptr) {
+        if (pre_allocated != nullptr) *pre_allocated = true;
+        return chunk;
+      }
+      chunk = GetMemoryChunkSafe<kPooled>();
+      if (chunk != nullptr) {
+        if (committed != nullptr) *committed = false;
+        return chunk;
+      }
+      chunk = GetMemoryChunkSafe<kRegular>();
+      if (chunk != nullptr) {
+        // For stolen chunks we need to manually free any allocated memory.
+        chunk->ReleaseAllocatedMemory();
       }
       return chunk;
     }
 
+    // Returns a chunk that was allocated ahead of time or nullptr if none is
+    // available.
+    MemoryChunk* TryGetPreAllocatedMemoryChunkSafe() {
+      return GetMemoryChunkSafe<kPreAllocated>();
+    }
+
     void FreeQueuedChunks();
     bool WaitUntilCompleted();
 
    private:
     enum ChunkQueueType {
-      kRegular,     // Pages of kPageSize that do not live in a CodeRange and
-                    // can thus be used for stealing.
-      kNonRegular,  // Large chunks and executable chunks.
-      kPooled,      // Pooled chunks, already uncommited and ready for reuse.
+      kRegular,          // Pages of kPageSize that do not live in a
+                         // CodeRange and can thus be used for stealing.
+      kNonRegular,       // Large chunks and executable chunks.
+      kPooled,           // Pooled chunks, already uncommited and ready for
+                         // reuse.
+      kPooledDiscarded,  // Pooled chunks that are still committed but whose
+                         // contents have been discarded.
+      kPreAllocated,     // Freshly committed and thus zeroed chunks, see
+                         // FLAG_page_pool_size.
       kNumberOfChunkQueues,
     };
 
@@ -1367,6 +1412,11 @@ class MemoryAllocator {
     void ReconsiderDelayedChunks();
     void PerformFreeMemoryOnQueuedChunks();
 
+    // Allocates chunks ahead of time until FLAG_page_pool_size chunks are
+    // available or the allocator runs out of capacity. Only called from the
+    // background task.
+    void RefillPreAllocatedChunks();
+
     base::Mutex mutex_;
     MemoryAllocator* allocator_;
     std::list<MemoryChunk*> chunks_[kNumberOfChunkQueues];
@@ -1517,6 +1567,21 @@ class MemoryAllocator {
   // FreeMemory can be called concurrently when PreFree was executed before.
   void PerformFreeMemory(MemoryChunk* chunk);
 
+  // Releases the physical memory of a pooled chunk while keeping it
+  // committed. Can be called concurrently when PreFree was executed before.
+  // Falls back to uncommitting the chunk and returns false if the OS does not
+  // support discarding pages.
+  bool DiscardPooledMemory(MemoryChunk* chunk);
+
+  // Uncommits a pooled chunk without accounting for it, as PreFreeMemory
+  // already did.
+  void UncommitPooledMemory(MemoryChunk* chunk);
+
+  // Reserves and commits a non-executable chunk of kPageSize and accounts for
+  // it in Size(). Returns nullptr if that would exceed the capacity. Can be
+  // called concurrently.
+  MemoryChunk* PreAllocateChunk();
+
   // See AllocatePage for public interface. Note that currently we only support
   // pools for NOT_EXECUTABLE pages of size MemoryChunk::kPageSize.
   template <typename SpaceType>
@@ -2198,8 +2198,30 @@ void CallIC::HandleMiss(Handle<Object> function) {
   // Hand-coded MISS handling is easier if CallIC slots don't contain smis.
   DCHECK(!feedback->IsSmi());
 
-  if (feedback->IsWeakCell() || !function->IsJSFunction() ||
-      feedback->IsAllocationSite()) {
+  // Only functions from this native context other than the Array function
+  // are recorded as call targets.
+  bool is_call_target = false;
+  if (function->IsJSFunction()) {
+    Handle<JSFunction> js_function = Handle<JSFunction>::cast(function);
+    is_call_target =
+        js_function->context()->native_context() ==
+            *isolate()->native_context() &&
+        *js_function != isolate()->native_context()->array_function();
+  }
+
+  if (feedback->IsFixedArray()) {
+    // We are sampling the targets of a polymorphic call site.
+    if (!is_call_target || !nexus->RecordPolymorphicCall(
+                               Handle<JSFunction>::cast(function))) {
+      nexus->ConfigureMegamorphic();
+    }
+  } else if (feedback->IsWeakCell() && is_call_target &&
+             !WeakCell::cast(feedback)->cleared() &&
+             WeakCell::cast(feedback)->value() != *function) {
+    // We are going polymorphic.
+    nexus->ConfigurePolymorphic(Handle<JSFunction>::cast(function));
+  } else if (feedback->IsWeakCell() || !function->IsJSFunction() ||
+             feedback->IsAllocationSite()) {
     // We are going generic.
     nexus->ConfigureMegamorphic();
   } else {
@@ -14,12 +14,13 @@ namespace internal {
 namespace interpreter {
 
 BytecodeArrayWriter::BytecodeArrayWriter(
-    Isolate* isolate, Zone* zone, ConstantArrayBuilder* constant_array_builder)
+    Isolate* isolate, Zone* zone, ConstantArrayBuilder* constant_array_builder,
+    SourcePositionTableBuilder::RecordingMode source_position_mode)
     : isolate_(isolate),
       bytecodes_(zone),
       max_register_count_(0),
       unbound_jumps_(0),
-      source_position_table_builder_(isolate, zone),
+      source_position_table_builder_(isolate, zone, source_position_mode),
       constant_array_builder_(constant_array_builder) {
   LOG_CODE_EVENT(isolate_, CodeStartLinePosInfoRecordEvent(
                                source_position_table_builder()));
@@ -42,13 +43,19 @@ Handle<BytecodeArray> BytecodeArrayWriter::ToBytecodeArray(
   int frame_size_used = max_register_count() * kPointerSize;
   int frame_size = std::max(frame_size_for_locals, frame_size_used);
   Handle<FixedArray> constant_pool = constant_array_builder()->ToFixedArray();
-  Handle<ByteArray> source_position_table =
-      source_position_table_builder()->ToSourcePositionTable();
   Handle<BytecodeArray> bytecode_array = isolate_->factory()->NewBytecodeArray(
       bytecode_size, &bytecodes()->front(), frame_size, parameter_count,
       constant_pool);
   bytecode_array->set_handler_table(*handler_table);
-  bytecode_array->set_source_position_table(*source_position_table);
+  if (source_position_table_builder()->Omit()) {
+    bytecode_array->set_source_position_table(
+        isolate_->heap()->undefined_value());
+    isolate_->counters()->bytecode_source_positions_omitted()->Increment();
+  } else {
+    Handle<ByteArray> source_position_table =
+        source_position_table_builder()->ToSourcePositionTable();
+    bytecode_array->set_source_position_table(*source_position_table);
+  }
 
   void* line_info = source_position_table_builder()->DetachJITHandlerData();
   LOG_CODE_EVENT(isolate_, CodeEndLinePosInfoRecordEvent(
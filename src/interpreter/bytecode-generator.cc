@@ -541,13 +541,16 @@ class BytecodeGenerator::RegisterResultScope final
   Register result_register_;
 };
 
-BytecodeGenerator::BytecodeGenerator(CompilationInfo* info)
+BytecodeGenerator::BytecodeGenerator(
+    CompilationInfo* info,
+    SourcePositionTableBuilder::RecordingMode source_position_mode)
     : isolate_(info->isolate()),
       zone_(info->zone()),
       builder_(new (zone()) BytecodeArrayBuilder(
           info->isolate(), info->zone(), info->num_parameters_including_this(),
           info->scope()->MaxNestedContextChainLength(),
-          info->scope()->num_stack_slots(), info->literal())),
+          info->scope()->num_stack_slots(), info->literal(),
+          source_position_mode)),
       info_(info),
       scope_(info->scope()),
       globals_(0, info->zone()),
@@ -21,7 +21,10 @@ class LoopBuilder;
 
 class BytecodeGenerator final : public AstVisitor {
  public:
-  explicit BytecodeGenerator(CompilationInfo* info);
+  explicit BytecodeGenerator(
+      CompilationInfo* info,
+      SourcePositionTableBuilder::RecordingMode source_position_mode =
+          SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS);
 
   Handle<BytecodeArray> MakeBytecode();
 
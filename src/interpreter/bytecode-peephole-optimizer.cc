@@ -220,6 +220,41 @@ bool BytecodePeepholeOptimizer::TransformLastAndCurrentBytecodes(
   return false;
 }
 
+bool BytecodePeepholeOptimizer::FuseLastAndCurrentBytecodes(
+    BytecodeNode* const current) {
+  if (!FLAG_ignition_superinstructions) return false;
+  Bytecode superinstruction =
+      Bytecodes::GetSuperinstruction(last_.bytecode(), current->bytecode());
+  if (superinstruction == Bytecode::kIllegal) return false;
+
+  // The superinstruction has a single source position, so only fuse if at
+  // most one of the bytecodes has one.
+  if (last_.source_info().is_valid() && current->source_info().is_valid()) {
+    return false;
+  }
+
+  //
+  // An example transformation here would be:
+  //
+  //   Ldar R1  ____\  LdarAdd R1, R2
+  //   Add R2   ====/
+  //
+  // which saves a dispatch. The superinstruction replaces the current
+  // bytecode, so it can take part in further optimizations as the last
+  // bytecode.
+  //
+  DCHECK_EQ(Bytecodes::NumberOfOperands(superinstruction),
+            last_.operand_count() + current->operand_count());
+  DCHECK_EQ(current->operand_count(), 1);
+  last_.Transform(superinstruction, current->operand(0));
+  if (current->source_info().is_valid()) {
+    last_.source_info().Clone(current->source_info());
+  }
+  current->Clone(&last_);
+  InvalidateLast();
+  return true;
+}
+
 bool BytecodePeepholeOptimizer::RemoveToBooleanFromJump(
     BytecodeNode* const current) {
   bool can_remove = Bytecodes::IsJumpIfToBoolean(current->bytecode()) &&
@@ -281,7 +316,8 @@ BytecodeNode* BytecodePeepholeOptimizer::Optimize(BytecodeNode* current) {
   TryToRemoveLastExpressionPosition(current);
 
   if (TransformCurrentBytecode(current) ||
-      TransformLastAndCurrentBytecodes(current)) {
+      TransformLastAndCurrentBytecodes(current) ||
+      FuseLastAndCurrentBytecodes(current)) {
     return current;
   }
 
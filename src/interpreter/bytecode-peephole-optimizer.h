@@ -39,6 +39,7 @@ class BytecodePeepholeOptimizer final : public BytecodePipelineStage,
   void TryToRemoveLastExpressionPosition(const BytecodeNode* const current);
   bool TransformCurrentBytecode(BytecodeNode* const current);
   bool TransformLastAndCurrentBytecodes(BytecodeNode* const current);
+  bool FuseLastAndCurrentBytecodes(BytecodeNode* const current);
   bool CanElideCurrent(const BytecodeNode* const current) const;
   bool CanElideLast(const BytecodeNode* const current) const;
   bool CanElideLastBasedOnSourcePosition(
@@ -250,6 +250,7 @@ bool Bytecodes::WritesBooleanToAccumulator(Bytecode bytecode) {
     case Bytecode::kTestInstanceOf:
     case Bytecode::kTestIn:
     case Bytecode::kForInDone:
+    case Bytecode::kLdarTestLessThan:
       return true;
     default:
       return false;
@@ -469,6 +470,50 @@ Bytecode Bytecodes::GetJumpWithoutToBoolean(Bytecode bytecode) {
   return Bytecode::kIllegal;
 }
 
+// static
+Bytecode Bytecodes::GetSuperinstruction(Bytecode first, Bytecode second) {
+#define CASE(Name, First, Second)                                     \
+  if (first == Bytecode::k##First && second == Bytecode::k##Second) { \
+    return Bytecode::k##Name;                                         \
+  }
+  SUPERINSTRUCTION_LIST(CASE)
+#undef CASE
+  return Bytecode::kIllegal;
+}
+
+// static
+bool Bytecodes::IsStarLookahead(Bytecode bytecode,
+                                OperandScale operand_scale) {
+  // Loads that are followed by a Star are mostly turned into Ldr bytecodes by
+  // the peephole optimizer, so these are the remaining bytecodes whose result
+  // is frequently stored to a register.
+  if (operand_scale != OperandScale::kSingle) return false;
+  switch (bytecode) {
+    case Bytecode::kLdaZero:
+    case Bytecode::kLdaSmi:
+    case Bytecode::kLdaNull:
+    case Bytecode::kLdaTheHole:
+    case Bytecode::kLdaTrue:
+    case Bytecode::kLdaFalse:
+    case Bytecode::kLdaConstant:
+    case Bytecode::kAdd:
+    case Bytecode::kSub:
+    case Bytecode::kMul:
+    case Bytecode::kInc:
+    case Bytecode::kDec:
+    case Bytecode::kTypeOf:
+    case Bytecode::kCall:
+    case Bytecode::kNew:
+    case Bytecode::kCallRuntime:
+    case Bytecode::kCreateClosure:
+    case Bytecode::kCreateArrayLiteral:
+    case Bytecode::kCreateObjectLiteral:
+      return true;
+    default:
+      return false;
+  }
+}
+
 // static
 bool Bytecodes::IsCallOrNew(Bytecode bytecode) {
   return bytecode == Bytecode::kCall || bytecode == Bytecode::kTailCall ||
@@ -73,6 +73,16 @@ namespace interpreter {
   DEBUG_BREAK_PLAIN_BYTECODE_LIST(V) \
   DEBUG_BREAK_PREFIX_BYTECODE_LIST(V)
 
+// Pairs of bytecodes that the peephole optimizer fuses into a single
+// superinstruction with --ignition-superinstructions, in the form
+// V(Superinstruction, First, Second). The operands of the superinstruction
+// are the operands of First followed by those of Second. Candidates are the
+// hottest pairs reported by tools/ignition/bytecode_dispatches_report.py.
+#define SUPERINSTRUCTION_LIST(V)          \
+  V(LdarAdd, Ldar, Add)                   \
+  V(LdarSub, Ldar, Sub)                   \
+  V(LdarTestLessThan, Ldar, TestLessThan)
+
 // The list of bytecodes which are interpreted by the interpreter.
 #define BYTECODE_LIST(V)                                                       \
   /* Extended width operands */                                                \
@@ -256,6 +266,12 @@ namespace interpreter {
   V(SuspendGenerator, AccumulatorUse::kRead, OperandType::kReg)                \
   V(ResumeGenerator, AccumulatorUse::kWrite, OperandType::kReg)                \
                                                                                \
+  /* Superinstructions */                                                      \
+  V(LdarAdd, AccumulatorUse::kWrite, OperandType::kReg, OperandType::kReg)     \
+  V(LdarSub, AccumulatorUse::kWrite, OperandType::kReg, OperandType::kReg)     \
+  V(LdarTestLessThan, AccumulatorUse::kWrite, OperandType::kReg,               \
+    OperandType::kReg)                                                         \
+                                                                               \
   /* Debugger */                                                               \
   V(Debugger, AccumulatorUse::kNone)                                           \
   DEBUG_BREAK_BYTECODE_LIST(V)                                                 \
@@ -582,6 +598,14 @@ class Bytecodes {
   // Returns the equivalent jump bytecode without the accumulator coercion.
   static Bytecode GetJumpWithoutToBoolean(Bytecode bytecode);
 
+  // Returns true if the handler for |bytecode| with |operand_scale| performs
+  // an immediately following Star itself instead of dispatching to it.
+  static bool IsStarLookahead(Bytecode bytecode, OperandScale operand_scale);
+
+  // Returns the superinstruction that replaces |first| immediately followed
+  // by |second|, or Bytecode::kIllegal if there is none.
+  static Bytecode GetSuperinstruction(Bytecode first, Bytecode second);
+
   // Returns true if the bytecode is a conditional jump, a jump, or a return.
   static bool IsJumpOrReturn(Bytecode bytecode);
 
@@ -477,7 +477,136 @@ Node* InterpreterAssembler::CallRuntimeN(Node* function_id, Node* context,
                   first_arg, function_entry, result_size);
 }
 
-void InterpreterAssembler::UpdateInterruptBudget(Node* weight) {
+void InterpreterAssembler::TryFieldAccessHandler(const LoadICParameters* p,
+                                                 CodeStub::Major major_key,
+                                                 Variable* var_key,
+                                                 Label* if_handler,
+                                                 Label* if_slow) {
+  Variable var_handler(this, MachineRepresentation::kTagged);
+  Label if_found(this, &var_handler), try_polymorphic(this);
+
+  // Field access handlers are never installed for Smi receivers.
+  GotoIf(WordIsSmi(p->receiver), if_slow);
+  Node* receiver_map = LoadMap(p->receiver);
+
+  Node* feedback = TryMonomorphicCase(p, receiver_map, &if_found, &var_handler,
+                                      &try_polymorphic);
+  Bind(&try_polymorphic);
+  {
+    // Megamorphic and uninitialized feedback is left to the IC.
+    GotoUnless(
+        WordEqual(LoadMap(feedback), LoadRoot(Heap::kFixedArrayMapRootIndex)),
+        if_slow);
+    HandlePolymorphicCase(p, receiver_map, feedback, &if_found, &var_handler,
+                          if_slow, 2);
+  }
+
+  Bind(&if_found);
+  {
+    // Handlers are Code objects that carry the key of the stub they were
+    // generated from, compiled handlers use CodeStub::NoCacheKey().
+    Node* key = SmiToWord32(LoadObjectField(var_handler.value(),
+                                            Code::kTypeFeedbackInfoOffset));
+    Node* major = Word32And(key, Int32Constant((1 << kStubMajorKeyBits) - 1));
+    GotoUnless(Word32Equal(major, Int32Constant(major_key)), if_slow);
+    var_key->Bind(key);
+    Goto(if_handler);
+  }
+}
+
+Node* InterpreterAssembler::FieldAccessHolder(Node* receiver, Node* field_key,
+                                              Label* if_slow) {
+  Variable var_holder(this, MachineRepresentation::kTagged);
+  Label if_inobject(this), if_backing_store(this), done(this, &var_holder);
+
+  // Double fields need boxing or unboxing, leave them to the handler.
+  Node* is_double = BitFieldDecode<FieldIndex::IsDoubleBits>(field_key);
+  GotoIf(Word32NotEqual(is_double, Int32Constant(0)), if_slow);
+
+  Node* is_inobject = BitFieldDecode<FieldIndex::IsInObjectBits>(field_key);
+  Branch(Word32NotEqual(is_inobject, Int32Constant(0)), &if_inobject,
+         &if_backing_store);
+  Bind(&if_inobject);
+  {
+    var_holder.Bind(receiver);
+    Goto(&done);
+  }
+  Bind(&if_backing_store);
+  {
+    var_holder.Bind(LoadProperties(receiver));
+    Goto(&done);
+  }
+  Bind(&done);
+  return var_holder.value();
+}
+
+Node* InterpreterAssembler::FieldAccessOffset(Node* field_key) {
+  // The field index counts words from the start of the holder, including the
+  // FixedArray header for out-of-object fields.
+  Node* index = BitFieldDecode<FieldIndex::IndexBits>(field_key);
+  return IntPtrSub(WordShl(ChangeUint32ToWord(index), kPointerSizeLog2),
+                   IntPtrConstant(kHeapObjectTag));
+}
+
+void InterpreterAssembler::TryInlinedLoadField(const LoadICParameters* p,
+                                               Variable* var_result,
+                                               Label* if_done, Label* if_slow) {
+  Variable var_key(this, MachineRepresentation::kWord32);
+  Label if_field(this, &var_key);
+
+  TryFieldAccessHandler(p, CodeStub::LoadField, &var_key, &if_field, if_slow);
+  Bind(&if_field);
+  {
+    Node* field_key =
+        BitFieldDecode<LoadFieldStub::CodeKeyFieldIndexBits>(var_key.value());
+    Node* holder = FieldAccessHolder(p->receiver, field_key, if_slow);
+    Node* offset = FieldAccessOffset(field_key);
+    var_result->Bind(Load(MachineType::AnyTagged(), holder, offset));
+    Goto(if_done);
+  }
+}
+
+void InterpreterAssembler::TryInlinedStoreField(const LoadICParameters* p,
+                                                Node* value, Label* if_done,
+                                                Label* if_slow) {
+  Variable var_key(this, MachineRepresentation::kWord32);
+  Label if_field(this, &var_key), if_store(this);
+
+  TryFieldAccessHandler(p, CodeStub::StoreField, &var_key, &if_field, if_slow);
+  Bind(&if_field);
+  {
+    // Only Smi, HeapObject and Tagged fields are handled here. The field type
+    // of HeapObject fields is known to be unconstrained, since the StoreIC
+    // only uses the StoreFieldStub if no field type needs to be checked.
+    Node* representation =
+        BitFieldDecode<StoreFieldStub::CodeKeyRepresentationBits>(
+            var_key.value());
+    Label if_smi(this), if_heap_object(this);
+    GotoIf(Word32Equal(representation, Int32Constant(Representation::kTagged)),
+           &if_store);
+    GotoIf(Word32Equal(representation, Int32Constant(Representation::kSmi)),
+           &if_smi);
+    Branch(Word32Equal(representation,
+                       Int32Constant(Representation::kHeapObject)),
+           &if_heap_object, if_slow);
+    Bind(&if_smi);
+    Branch(WordIsSmi(value), &if_store, if_slow);
+    Bind(&if_heap_object);
+    Branch(WordIsSmi(value), if_slow, &if_store);
+  }
+
+  Bind(&if_store);
+  {
+    Node* field_key =
+        BitFieldDecode<StoreFieldStub::CodeKeyFieldIndexBits>(var_key.value());
+    Node* holder = FieldAccessHolder(p->receiver, field_key, if_slow);
+    Node* offset = FieldAccessOffset(field_key);
+    Store(MachineRepresentation::kTagged, holder, offset, value);
+    Goto(if_done);
+  }
+}
+
+void InterpreterAssembler::UpdateInterruptBudget(Node* weight, bool is_jump) {
   Label ok(this), interrupt_check(this, Label::kDeferred), end(this);
   Node* budget_offset =
       IntPtrConstant(BytecodeArray::kInterruptBudgetOffset - kHeapObjectTag);
@@ -495,6 +624,8 @@ void InterpreterAssembler::UpdateInterruptBudget(Node* weight) {
   Bind(&interrupt_check);
   {
     CallRuntime(Runtime::kInterrupt, GetContext());
+    // Only backward jumps exhaust the budget, so this is a loop back edge.
+    if (is_jump) OnStackReplacementCheck();
     new_budget.Bind(Int32Constant(Interpreter::InterruptBudget()));
     Goto(&ok);
   }
@@ -506,6 +637,28 @@ void InterpreterAssembler::UpdateInterruptBudget(Node* weight) {
                       new_budget.value());
 }
 
+void InterpreterAssembler::OnStackReplacementCheck() {
+  Label osr_armed(this, Label::kDeferred), end(this);
+  Node* osr_level = Load(
+      MachineType::Int32(), BytecodeArrayTaggedPointer(),
+      IntPtrConstant(BytecodeArray::kOSRNestingLevelOffset - kHeapObjectTag));
+  Branch(Word32Equal(osr_level, Int32Constant(0)), &end, &osr_armed);
+
+  // The runtime profiler armed this function, try to enter optimized code
+  // for the loop at hand. The builtin only returns here if that fails.
+  Bind(&osr_armed);
+  {
+    Callable callable = CodeFactory::InterpreterOnStackReplacement(isolate());
+    Node* target = HeapConstant(callable.code());
+    Node** args = zone()->NewArray<Node*>(1);
+    args[0] = GetContext();
+    CallStubN(callable.descriptor(), target, args);
+    Goto(&end);
+  }
+
+  Bind(&end);
+}
+
 Node* InterpreterAssembler::Advance(int delta) {
   return IntPtrAdd(BytecodeOffset(), IntPtrConstant(delta));
 }
@@ -515,7 +668,7 @@ Node* InterpreterAssembler::Advance(Node* delta) {
 }
 
 Node* InterpreterAssembler::Jump(Node* delta) {
-  UpdateInterruptBudget(delta);
+  UpdateInterruptBudget(delta, true);
   return DispatchTo(Advance(delta));
 }
 
@@ -539,7 +692,54 @@ void InterpreterAssembler::JumpIfWordNotEqual(Node* lhs, Node* rhs,
 }
 
 Node* InterpreterAssembler::Dispatch() {
-  return DispatchTo(Advance(Bytecodes::Size(bytecode_, operand_scale_)));
+  Node* new_bytecode_offset =
+      Advance(Bytecodes::Size(bytecode_, operand_scale_));
+  if (FLAG_ignition_star_lookahead && !FLAG_trace_ignition &&
+      Bytecodes::IsStarLookahead(bytecode_, operand_scale_)) {
+    return DispatchToWithStarLookahead(new_bytecode_offset);
+  }
+  return DispatchTo(new_bytecode_offset);
+}
+
+Node* InterpreterAssembler::DispatchToWithStarLookahead(
+    Node* new_bytecode_offset) {
+  Label do_star(this), dispatch(this);
+  Node* target_bytecode = Load(
+      MachineType::Uint8(), BytecodeArrayTaggedPointer(), new_bytecode_offset);
+  Node* is_star = Word32Equal(
+      target_bytecode, Int32Constant(Bytecodes::ToByte(Bytecode::kStar)));
+  Branch(is_star, &do_star, &dispatch);
+
+  Bind(&do_star);
+  {
+    // Star has a single register operand and no prefix, since the byte at
+    // |new_bytecode_offset| would otherwise be a scaling prefix.
+    DCHECK_EQ(OperandType::kRegOut,
+              Bytecodes::GetOperandType(Bytecode::kStar, 0));
+    if (FLAG_trace_ignition_dispatches) {
+      TraceBytecodeDispatch(IntPtrConstant(Bytecodes::ToByte(Bytecode::kStar)));
+    }
+    Node* reg_index =
+        Load(MachineType::Int8(), BytecodeArrayTaggedPointer(),
+             IntPtrAdd(new_bytecode_offset,
+                       IntPtrConstant(Bytecodes::GetOperandOffset(
+                           Bytecode::kStar, 0, OperandScale::kSingle))));
+    if (kPointerSize == 8) {
+      reg_index = ChangeInt32ToInt64(reg_index);
+    }
+    StoreRegister(GetAccumulatorUnchecked(), reg_index);
+
+    // Account the following dispatch to the Star.
+    Bytecode bytecode = bytecode_;
+    bytecode_ = Bytecode::kStar;
+    DispatchTo(IntPtrAdd(new_bytecode_offset,
+                         IntPtrConstant(Bytecodes::Size(
+                             Bytecode::kStar, OperandScale::kSingle))));
+    bytecode_ = bytecode;
+  }
+
+  Bind(&dispatch);
+  return DispatchTo(new_bytecode_offset);
 }
 
 Node* InterpreterAssembler::DispatchTo(Node* new_bytecode_offset) {
@@ -627,7 +827,7 @@ void InterpreterAssembler::UpdateInterruptBudgetOnReturn() {
   Node* profiling_weight =
       Int32Sub(Int32Constant(kHeapObjectTag + BytecodeArray::kHeaderSize),
                BytecodeOffset());
-  UpdateInterruptBudget(profiling_weight);
+  UpdateInterruptBudget(profiling_weight, false);
 }
 
 Node* InterpreterAssembler::StackCheckTriggeredInterrupt() {
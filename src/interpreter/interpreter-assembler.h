@@ -9,6 +9,7 @@
 #include "src/base/smart-pointers.h"
 #include "src/builtins.h"
 #include "src/code-stub-assembler.h"
+#include "src/code-stubs.h"
 #include "src/frames.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/runtime/runtime.h"
@@ -114,6 +115,23 @@ class InterpreterAssembler : public CodeStubAssembler {
                                compiler::Node* first_arg,
                                compiler::Node* arg_count, int return_size = 1);
 
+  // Tries to perform the named property load described by |p| without
+  // calling the LoadIC, if the feedback for the receiver map is a
+  // LoadFieldStub handler for a non-double field. Binds the loaded value to
+  // |var_result| and jumps to |if_done| on success, otherwise jumps to
+  // |if_slow|.
+  void TryInlinedLoadField(const LoadICParameters* p, Variable* var_result,
+                           Label* if_done, Label* if_slow);
+
+  // Tries to perform the named property store of |value| described by |p|
+  // without calling the StoreIC, if the feedback for the receiver map is a
+  // StoreFieldStub handler for a non-double field whose representation
+  // accepts |value|. Jumps to |if_done| on success, otherwise jumps to
+  // |if_slow|. The StoreIC feedback is looked up like the LoadIC feedback,
+  // so |p| reuses LoadICParameters, which the lookup helpers expect.
+  void TryInlinedStoreField(const LoadICParameters* p, compiler::Node* value,
+                            Label* if_done, Label* if_slow);
+
   // Jump relative to the current bytecode by |jump_offset|.
   compiler::Node* Jump(compiler::Node* jump_offset);
 
@@ -184,8 +202,31 @@ class InterpreterAssembler : public CodeStubAssembler {
   void TraceBytecode(Runtime::FunctionId function_id);
 
   // Updates the bytecode array's interrupt budget by |weight| and calls
-  // Runtime::kInterrupt if counter reaches zero.
-  void UpdateInterruptBudget(compiler::Node* weight);
+  // Runtime::kInterrupt if counter reaches zero. If |is_jump| is true the
+  // update is for a jump and on-stack replacement may be attempted.
+  void UpdateInterruptBudget(compiler::Node* weight, bool is_jump);
+
+  // Calls the InterpreterOnStackReplacement builtin if the runtime profiler
+  // armed on-stack replacement for the current bytecode array.
+  void OnStackReplacementCheck();
+
+  // Looks up the handler for the receiver map in the monomorphic or
+  // polymorphic feedback of |p| and jumps to |if_handler| with the stub key
+  // of the handler bound to |var_key|, if the handler was generated from a
+  // code stub with major key |major_key|. Otherwise jumps to |if_slow|.
+  void TryFieldAccessHandler(const LoadICParameters* p,
+                             CodeStub::Major major_key, Variable* var_key,
+                             Label* if_handler, Label* if_slow);
+
+  // Computes the object holding the field described by the field access stub
+  // key |field_key| of |receiver|, i.e. the receiver itself or its properties
+  // backing store. Jumps to |if_slow| for double fields.
+  compiler::Node* FieldAccessHolder(compiler::Node* receiver,
+                                    compiler::Node* field_key, Label* if_slow);
+
+  // Returns the untagged offset of the field described by the field access
+  // stub key |field_key| within the object returned by FieldAccessHolder().
+  compiler::Node* FieldAccessOffset(compiler::Node* field_key);
 
   // Returns the offset of register |index| relative to RegisterFilePointer().
   compiler::Node* RegisterFrameOffset(compiler::Node* index);
@@ -226,6 +267,12 @@ class InterpreterAssembler : public CodeStubAssembler {
   // Starts next instruction dispatch at |new_bytecode_offset|.
   compiler::Node* DispatchTo(compiler::Node* new_bytecode_offset);
 
+  // Starts next instruction dispatch at |new_bytecode_offset|, performing the
+  // bytecode there directly if it is a Star. This keeps the accumulator in
+  // its machine register and saves the dispatch to the Star handler.
+  compiler::Node* DispatchToWithStarLookahead(
+      compiler::Node* new_bytecode_offset);
+
   // Dispatch to the bytecode handler with code offset |handler|.
   compiler::Node* DispatchToBytecodeHandler(compiler::Node* handler,
                                             compiler::Node* bytecode_offset);
@@ -4,11 +4,13 @@
 
 #include "src/interpreter/interpreter.h"
 
+#include <cstring>
 #include <fstream>
 
 #include "src/ast/prettyprinter.h"
 #include "src/code-factory.h"
 #include "src/compiler.h"
+#include "src/debug/debug.h"
 #include "src/factory.h"
 #include "src/interpreter/bytecode-generator.h"
 #include "src/interpreter/bytecodes.h"
@@ -126,11 +128,34 @@ void Interpreter::IterateDispatchTable(ObjectVisitor* v) {
 
 // static
 int Interpreter::InterruptBudget() {
-  // TODO(ignition): Tune code size multiplier.
-  const int kCodeSizeMultiplier = 32;
   return FLAG_interrupt_budget * kCodeSizeMultiplier;
 }
 
+namespace {
+
+// Source positions are only needed for stack traces, the debugger and the
+// profiler. With --lazy-source-positions they are omitted for functions
+// unless something is known to need them right away.
+SourcePositionTableBuilder::RecordingMode SourcePositionRecordingMode(
+    CompilationInfo* info) {
+  Isolate* isolate = info->isolate();
+  if (!FLAG_lazy_source_positions || FLAG_print_bytecode ||
+      !info->has_shared_info() || info->is_debug() ||
+      isolate->serializer_enabled() || isolate->debug()->is_active() ||
+      isolate->is_profiling() || isolate->logger()->is_logging_code_events()) {
+    return SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS;
+  }
+  // Collecting source positions later on reparses the function lazily, which
+  // is not supported for top-level code.
+  Handle<SharedFunctionInfo> shared = info->shared_info();
+  if (shared->is_toplevel() || !shared->IsSubjectToDebugging()) {
+    return SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS;
+  }
+  return SourcePositionTableBuilder::OMIT_SOURCE_POSITIONS;
+}
+
+}  // namespace
+
 bool Interpreter::MakeBytecode(CompilationInfo* info) {
   RuntimeCallTimerScope runtimeTimer(info->isolate(),
                                      &RuntimeCallStats::CompileIgnition);
@@ -162,7 +187,7 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
   }
 #endif  // DEBUG
 
-  BytecodeGenerator generator(info);
+  BytecodeGenerator generator(info, SourcePositionRecordingMode(info));
   Handle<BytecodeArray> bytecodes = generator.MakeBytecode();
 
   if (generator.HasStackOverflow()) return false;
@@ -178,6 +203,47 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
   return true;
 }
 
+bool Interpreter::CollectSourcePositions(CompilationInfo* info) {
+  Isolate* isolate = info->isolate();
+  Handle<SharedFunctionInfo> shared = info->shared_info();
+  Handle<BytecodeArray> bytecode_array(shared->bytecode_array());
+  DCHECK(!bytecode_array->HasSourcePositionTable());
+
+  BytecodeGenerator generator(
+      info, SourcePositionTableBuilder::RECORD_SOURCE_POSITIONS);
+  Handle<BytecodeArray> bytecodes = generator.MakeBytecode();
+  if (generator.HasStackOverflow()) return false;
+
+  // Only the source position table of the regenerated bytecode is kept. It
+  // describes the existing bytecode only if both are identical, so bail out
+  // if regenerating produced different bytecode.
+  if (bytecodes->length() != bytecode_array->length() ||
+      memcmp(bytecodes->GetFirstBytecodeAddress(),
+             bytecode_array->GetFirstBytecodeAddress(),
+             bytecode_array->length()) != 0) {
+    return false;
+  }
+  ByteArray* source_position_table = bytecodes->SourcePositionTable();
+  bytecode_array->set_source_position_table(source_position_table);
+  if (shared->HasDebugInfo()) {
+    // The debug copy of the bytecode is executed while debugging.
+    AbstractCode* debug_code = shared->GetDebugInfo()->abstract_code();
+    if (debug_code->IsBytecodeArray()) {
+      debug_code->GetBytecodeArray()->set_source_position_table(
+          source_position_table);
+    }
+  }
+  isolate->counters()->bytecode_source_positions_collected()->Increment();
+
+  if (FLAG_trace_lazy_source_positions) {
+    OFStream os(stdout);
+    os << "[collected source positions for function: "
+       << info->GetDebugName().get() << ", " << source_position_table->length()
+       << " bytes]" << std::endl;
+  }
+  return true;
+}
+
 bool Interpreter::IsDispatchTableInitialized() {
   if (FLAG_trace_ignition || FLAG_trace_ignition_codegen ||
       FLAG_trace_ignition_dispatches) {
@@ -582,8 +648,26 @@ Node* Interpreter::BuildLoadNamedProperty(Callable ic,
   Node* smi_slot = __ SmiTag(raw_slot);
   Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* context = __ GetContext();
-  return __ CallStub(ic.descriptor(), code_target, context, object, name,
-                     smi_slot, type_feedback_vector);
+  if (!FLAG_ignition_inline_field_access) {
+    return __ CallStub(ic.descriptor(), code_target, context, object, name,
+                       smi_slot, type_feedback_vector);
+  }
+
+  // Perform field loads inline and only call the LoadIC for other handlers
+  // and for misses.
+  InterpreterAssembler::LoadICParameters params(context, object, name,
+                                                smi_slot, type_feedback_vector);
+  Variable var_result(assembler, MachineRepresentation::kTagged);
+  Label if_slow(assembler), end(assembler, &var_result);
+  __ TryInlinedLoadField(&params, &var_result, &end, &if_slow);
+  __ Bind(&if_slow);
+  {
+    var_result.Bind(__ CallStub(ic.descriptor(), code_target, context, object,
+                                name, smi_slot, type_feedback_vector));
+    __ Goto(&end);
+  }
+  __ Bind(&end);
+  return var_result.value();
 }
 
 // LdaNamedProperty <object> <name_index> <slot>
@@ -657,8 +741,26 @@ void Interpreter::DoStoreIC(Callable ic, InterpreterAssembler* assembler) {
   Node* smi_slot = __ SmiTag(raw_slot);
   Node* type_feedback_vector = __ LoadTypeFeedbackVector();
   Node* context = __ GetContext();
-  __ CallStub(ic.descriptor(), code_target, context, object, name, value,
-              smi_slot, type_feedback_vector);
+  if (!FLAG_ignition_inline_field_access) {
+    __ CallStub(ic.descriptor(), code_target, context, object, name, value,
+                smi_slot, type_feedback_vector);
+    __ Dispatch();
+    return;
+  }
+
+  // Perform field stores inline and only call the StoreIC for other handlers
+  // and for misses.
+  InterpreterAssembler::LoadICParameters params(context, object, name,
+                                                smi_slot, type_feedback_vector);
+  Label if_slow(assembler), end(assembler);
+  __ TryInlinedStoreField(&params, value, &end, &if_slow);
+  __ Bind(&if_slow);
+  {
+    __ CallStub(ic.descriptor(), code_target, context, object, name, value,
+                smi_slot, type_feedback_vector);
+    __ Goto(&end);
+  }
+  __ Bind(&end);
   __ Dispatch();
 }
 
@@ -750,6 +852,18 @@ void Interpreter::DoBinaryOp(InterpreterAssembler* assembler) {
   __ Dispatch();
 }
 
+template <class Generator>
+void Interpreter::DoLdarAndBinaryOp(InterpreterAssembler* assembler) {
+  Node* rhs_index = __ BytecodeOperandReg(0);
+  Node* rhs = __ LoadRegister(rhs_index);
+  Node* lhs_index = __ BytecodeOperandReg(1);
+  Node* lhs = __ LoadRegister(lhs_index);
+  Node* context = __ GetContext();
+  Node* result = Generator::Generate(assembler, lhs, rhs, context);
+  __ SetAccumulator(result);
+  __ Dispatch();
+}
+
 // Add <src>
 //
 // Add register <src> to accumulator.
@@ -1163,6 +1277,30 @@ void Interpreter::DoTestLessThan(InterpreterAssembler* assembler) {
   DoBinaryOp<LessThanStub>(assembler);
 }
 
+// LdarAdd <src0> <src1>
+//
+// Superinstruction for Ldar <src0>, Add <src1>. Add register <src1> to
+// register <src0> and store the result in the accumulator.
+void Interpreter::DoLdarAdd(InterpreterAssembler* assembler) {
+  DoLdarAndBinaryOp<AddStub>(assembler);
+}
+
+// LdarSub <src0> <src1>
+//
+// Superinstruction for Ldar <src0>, Sub <src1>. Subtract register <src0> from
+// register <src1> and store the result in the accumulator.
+void Interpreter::DoLdarSub(InterpreterAssembler* assembler) {
+  DoLdarAndBinaryOp<SubtractStub>(assembler);
+}
+
+// LdarTestLessThan <src0> <src1>
+//
+// Superinstruction for Ldar <src0>, TestLessThan <src1>. Test if the value in
+// the <src1> register is less than the value in the <src0> register.
+void Interpreter::DoLdarTestLessThan(InterpreterAssembler* assembler) {
+  DoLdarAndBinaryOp<LessThanStub>(assembler);
+}
+
 // TestGreaterThan <src>
 //
 // Test if the value in the <src> register is greater than the accumulator.
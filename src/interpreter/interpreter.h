@@ -40,9 +40,19 @@ class Interpreter {
   // Returns the interrupt budget which should be used for the profiler counter.
   static int InterruptBudget();
 
+  // Factor by which the size of bytecode is scaled to compare it with the
+  // size of machine code, e.g. for the interrupt budget.
+  // TODO(ignition): Tune code size multiplier.
+  static const int kCodeSizeMultiplier = 32;
+
   // Generate bytecode for |info|.
   static bool MakeBytecode(CompilationInfo* info);
 
+  // Collect the source positions that were omitted when generating the
+  // bytecode of the function of |info|, by generating its bytecode again.
+  // Requires a parsed and analyzed |info|.
+  static bool CollectSourcePositions(CompilationInfo* info);
+
   // Return bytecode handler for |bytecode|.
   Code* GetBytecodeHandler(Bytecode bytecode, OperandScale operand_scale);
 
@@ -74,6 +84,11 @@ class Interpreter {
   template <class Generator>
   void DoBinaryOp(InterpreterAssembler* assembler);
 
+  // Generates code to load the accumulator from a register and perform the
+  // binary operation via |Generator|, in a single superinstruction.
+  template <class Generator>
+  void DoLdarAndBinaryOp(InterpreterAssembler* assembler);
+
   // Generates code to perform the unary operation via |callable|.
   void DoUnaryOp(Callable callable, InterpreterAssembler* assembler);
 
@@ -24,6 +24,12 @@ namespace interpreter {
 // - we just stuff one bit for the type into the bytecode offset,
 // - we write least-significant bits first,
 // - we use zig-zag encoding to encode both positive and negative numbers.
+//
+// Most entries are expression positions that are close to the previous
+// entry, both in the bytecode and in the source. Such an entry is written as
+// a single 'short' byte holding both differences. The top bit of the first
+// byte of an entry tells short entries from long ones, the first byte of a
+// long entry thus only contains 6 bits of payload data and the 'more' bit.
 
 namespace {
 
@@ -31,6 +37,19 @@ namespace {
 class MoreBit : public BitField8<bool, 7, 1> {};
 class ValueBits : public BitField8<unsigned, 0, 7> {};
 
+// The first byte of an entry is encoded as IsShortEntryBit | ..., where a
+// short entry continues with ShortBytecodeDeltaBits | ShortSourceDeltaBits
+// and a long entry continues with FirstMoreBit | FirstValueBits.
+class IsShortEntryBit : public BitField8<bool, 7, 1> {};
+class ShortBytecodeDeltaBits : public BitField8<unsigned, 4, 3> {};
+class ShortSourceDeltaBits : public BitField8<unsigned, 0, 4> {};
+class FirstMoreBit : public BitField8<bool, 6, 1> {};
+class FirstValueBits : public BitField8<unsigned, 0, 6> {};
+
+// Source position differences in [-kShortSourceDeltaBias, kMax - bias] fit
+// into a short entry.
+static const int kShortSourceDeltaBias = 1 << (ShortSourceDeltaBits::kSize - 1);
+
 // Helper: Add the offsets from 'other' to 'value'. Also set is_statement.
 void AddAndSetEntry(PositionTableEntry& value,
                     const PositionTableEntry& other) {
@@ -46,52 +65,85 @@ void SubtractFromEntry(PositionTableEntry& value,
   value.source_position -= other.source_position;
 }
 
-// Helper: Encode an integer.
-void EncodeInt(ZoneVector<byte>& bytes, int value) {
+// Helper: Encode an integer, with |first_size| bits of payload data in the
+// first byte, followed by its 'more' bit.
+void EncodeInt(ZoneVector<byte>& bytes, int value,
+               int first_size = ValueBits::kSize) {
   // Zig-zag encoding.
   static const int kShift = kIntSize * kBitsPerByte - 1;
   value = ((value << 1) ^ (value >> kShift));
   DCHECK_GE(value, 0);
   unsigned int encoded = static_cast<unsigned int>(value);
-  bool more;
-  do {
+  unsigned int first_max = (1u << first_size) - 1;
+  bool more = encoded > first_max;
+  bytes.push_back(static_cast<byte>((more ? (1u << first_size) : 0) |
+                                    (encoded & first_max)));
+  encoded >>= first_size;
+  while (more) {
     more = encoded > ValueBits::kMax;
     bytes.push_back(MoreBit::encode(more) |
                     ValueBits::encode(encoded & ValueBits::kMask));
     encoded >>= ValueBits::kSize;
-  } while (more);
+  }
 }
 
 // Encode a PositionTableEntry.
 void EncodeEntry(ZoneVector<byte>& bytes, const PositionTableEntry& entry) {
   // We only accept ascending bytecode offsets.
   DCHECK(entry.bytecode_offset >= 0);
+  int biased_source_delta = entry.source_position + kShortSourceDeltaBias;
+  if (!entry.is_statement &&
+      entry.bytecode_offset <=
+          static_cast<int>(ShortBytecodeDeltaBits::kMax) &&
+      biased_source_delta >= 0 &&
+      biased_source_delta <= static_cast<int>(ShortSourceDeltaBits::kMax)) {
+    bytes.push_back(IsShortEntryBit::encode(true) |
+                    ShortBytecodeDeltaBits::encode(entry.bytecode_offset) |
+                    ShortSourceDeltaBits::encode(biased_source_delta));
+    return;
+  }
   // Since bytecode_offset is not negative, we use sign to encode is_statement.
-  EncodeInt(bytes, entry.is_statement ? entry.bytecode_offset
-                                      : -entry.bytecode_offset - 1);
+  // The IsShortEntryBit stays clear, since the payload of the first byte
+  // and its 'more' bit are below it.
+  STATIC_ASSERT(FirstMoreBit::kNext == IsShortEntryBit::kShift);
+  EncodeInt(bytes,
+            entry.is_statement ? entry.bytecode_offset
+                               : -entry.bytecode_offset - 1,
+            FirstValueBits::kSize);
   EncodeInt(bytes, entry.source_position);
 }
 
-// Helper: Decode an integer.
-void DecodeInt(ByteArray* bytes, int* index, int* v) {
-  byte current;
-  int shift = 0;
-  int decoded = 0;
-  bool more;
-  do {
+// Helper: Decode an integer, see EncodeInt().
+void DecodeInt(ByteArray* bytes, int* index, int* v,
+               int first_size = ValueBits::kSize) {
+  byte current = bytes->get((*index)++);
+  int decoded = current & ((1 << first_size) - 1);
+  bool more = (current >> first_size) & 1;
+  int shift = first_size;
+  while (more) {
     current = bytes->get((*index)++);
     decoded |= ValueBits::decode(current) << shift;
     more = MoreBit::decode(current);
     shift += ValueBits::kSize;
-  } while (more);
+  }
   DCHECK_GE(decoded, 0);
   decoded = (decoded >> 1) ^ (-(decoded & 1));
   *v = decoded;
 }
 
 void DecodeEntry(ByteArray* bytes, int* index, PositionTableEntry* entry) {
+  byte first = bytes->get(*index);
+  if (IsShortEntryBit::decode(first)) {
+    (*index)++;
+    entry->is_statement = false;
+    entry->bytecode_offset = ShortBytecodeDeltaBits::decode(first);
+    entry->source_position =
+        static_cast<int>(ShortSourceDeltaBits::decode(first)) -
+        kShortSourceDeltaBias;
+    return;
+  }
   int tmp;
-  DecodeInt(bytes, index, &tmp);
+  DecodeInt(bytes, index, &tmp, FirstValueBits::kSize);
   if (tmp >= 0) {
     entry->is_statement = true;
     entry->bytecode_offset = tmp;
@@ -107,6 +159,7 @@ void DecodeEntry(ByteArray* bytes, int* index, PositionTableEntry* entry) {
 void SourcePositionTableBuilder::AddPosition(size_t bytecode_offset,
                                              int source_position,
                                              bool is_statement) {
+  if (Omit()) return;
   int offset = static_cast<int>(bytecode_offset);
   AddEntry({offset, source_position, is_statement});
 }
@@ -132,7 +185,10 @@ void SourcePositionTableBuilder::AddEntry(const PositionTableEntry& entry) {
 }
 
 Handle<ByteArray> SourcePositionTableBuilder::ToSourcePositionTable() {
+  DCHECK(!Omit());
   if (bytes_.empty()) return isolate_->factory()->empty_byte_array();
+  isolate_->counters()->bytecode_source_position_table_size()->Increment(
+      static_cast<int>(bytes_.size()));
 
   Handle<ByteArray> table = isolate_->factory()->NewByteArray(
       static_cast<int>(bytes_.size()), TENURED);
@@ -36,8 +36,15 @@ struct PositionTableEntry {
 
 class SourcePositionTableBuilder final : public PositionsRecorder {
  public:
-  SourcePositionTableBuilder(Isolate* isolate, Zone* zone)
+  // Source positions can be omitted if nothing needs them right away. They
+  // are collected later on by regenerating the bytecode, see
+  // Compiler::EnsureSourcePositions().
+  enum RecordingMode { RECORD_SOURCE_POSITIONS, OMIT_SOURCE_POSITIONS };
+
+  SourcePositionTableBuilder(Isolate* isolate, Zone* zone,
+                             RecordingMode mode = RECORD_SOURCE_POSITIONS)
       : isolate_(isolate),
+        mode_(mode),
         bytes_(zone),
 #ifdef ENABLE_SLOW_DCHECKS
         raw_entries_(zone),
@@ -49,11 +56,14 @@ class SourcePositionTableBuilder final : public PositionsRecorder {
                    bool is_statement);
   Handle<ByteArray> ToSourcePositionTable();
 
+  bool Omit() const { return mode_ == OMIT_SOURCE_POSITIONS; }
+
  private:
   void AddEntry(const PositionTableEntry& entry);
   void CommitEntry();
 
   Isolate* isolate_;
+  RecordingMode mode_;
   ZoneVector<byte> bytes_;
 #ifdef ENABLE_SLOW_DCHECKS
   ZoneVector<PositionTableEntry> raw_entries_;
@@ -19,6 +19,7 @@
 #include "src/codegen.h"
 #include "src/compilation-cache.h"
 #include "src/compilation-statistics.h"
+#include "src/compiler.h"
 #include "src/crankshaft/hydrogen.h"
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
@@ -402,6 +403,9 @@ Handle<Object> Isolate::CaptureSimpleStackTrace(Handle<JSReceiver> error_object,
           if (!this->context()->HasSameSecurityTokenAs(fun->context())) {
             continue;
           }
+          // The code offset is only mapped to a position when the stack
+          // trace is formatted, make sure it can be.
+          Compiler::EnsureSourcePositions(fun);
           elements = MaybeGrow(this, elements, cursor, cursor + 4);
 
           Handle<AbstractCode> abstract_code = frames[i].abstract_code();
@@ -724,6 +728,7 @@ Handle<JSArray> Isolate::CaptureCurrentStackTrace(
         if (!(options & StackTrace::kExposeFramesAcrossSecurityOrigins) &&
             !this->context()->HasSameSecurityTokenAs(fun->context()))
           continue;
+        Compiler::EnsureSourcePositions(fun);
         Handle<JSObject> new_frame_obj = helper.NewStackFrameObject(frames[i]);
         stack_trace_elems->set(frames_seen, *new_frame_obj);
         frames_seen++;
@@ -1320,6 +1325,7 @@ void Isolate::PrintCurrentStackTrace(FILE* out) {
     int pos;
     if (frame->is_interpreted()) {
       InterpretedFrame* iframe = reinterpret_cast<InterpretedFrame*>(frame);
+      Compiler::EnsureSourcePositions(handle(iframe->function(), this));
       pos = iframe->GetBytecodeArray()->SourcePosition(
           iframe->GetBytecodeOffset());
     } else if (frame->is_java_script()) {
@@ -1369,8 +1375,10 @@ bool Isolate::ComputeLocation(MessageLocation* target) {
   List<FrameSummary> frames(FLAG_max_inlining_levels + 1);
   JavaScriptFrame::cast(frame)->Summarize(&frames);
   FrameSummary& summary = frames.last();
+  Handle<JSFunction> function(fun, this);
+  Compiler::EnsureSourcePositions(summary.function());
   int pos = summary.abstract_code()->SourcePosition(summary.code_offset());
-  *target = MessageLocation(casted_script, pos, pos + 1, handle(fun));
+  *target = MessageLocation(casted_script, pos, pos + 1, function);
   return true;
 }
 
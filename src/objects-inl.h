@@ -1710,11 +1710,12 @@ inline void AllocationSite::IncrementMementoCreateCount() {
 inline bool AllocationSite::MakePretenureDecision(
     PretenureDecision current_decision,
     double ratio,
+    double threshold,
     bool maximum_size_scavenge) {
   // Here we just allow state transitions from undecided or maybe tenure
   // to don't tenure, maybe tenure, or tenure.
   if ((current_decision == kUndecided || current_decision == kMaybeTenure)) {
-    if (ratio >= kPretenureRatio) {
+    if (ratio >= threshold) {
       // We just transition into tenure state when the semi-space was at
       // maximum capacity.
       if (maximum_size_scavenge) {
@@ -1734,7 +1735,7 @@ inline bool AllocationSite::MakePretenureDecision(
 
 
 inline bool AllocationSite::DigestPretenuringFeedback(
-    bool maximum_size_scavenge) {
+    bool maximum_size_scavenge, double long_lived_ratio) {
   bool deopt = false;
   int create_count = memento_create_count();
   int found_count = memento_found_count();
@@ -1745,8 +1746,18 @@ inline bool AllocationSite::DigestPretenuringFeedback(
   PretenureDecision current_decision = pretenure_decision();
 
   if (minimum_mementos_created) {
-    deopt = MakePretenureDecision(
-        current_decision, ratio, maximum_size_scavenge);
+    if (long_lived_ratio >= 0) {
+      // Objects surviving their second scavenge are copied twice, while
+      // objects dying right after their first one are only copied once and
+      // would needlessly fill up old space when pretenured. Decide on the
+      // expected number of copies per allocated object instead.
+      deopt = MakePretenureDecision(current_decision,
+                                    ratio * (1.0 + long_lived_ratio),
+                                    kPretenureCopyRatio, maximum_size_scavenge);
+    } else {
+      deopt = MakePretenureDecision(current_decision, ratio, kPretenureRatio,
+                                    maximum_size_scavenge);
+    }
   }
 
   if (FLAG_trace_pretenuring_statistics) {
@@ -4054,6 +4065,26 @@ void BytecodeArray::set_interrupt_budget(int interrupt_budget) {
   WRITE_INT_FIELD(this, kInterruptBudgetOffset, interrupt_budget);
 }
 
+int BytecodeArray::osr_loop_nesting_level() const {
+  return READ_INT_FIELD(this, kOSRNestingLevelOffset);
+}
+
+void BytecodeArray::set_osr_loop_nesting_level(int depth) {
+  DCHECK_GE(depth, 0);
+  WRITE_INT_FIELD(this, kOSRNestingLevelOffset, depth);
+}
+
+BytecodeArray::Age BytecodeArray::bytecode_age() const {
+  return static_cast<Age>(READ_INT8_FIELD(this, kBytecodeAgeOffset));
+}
+
+void BytecodeArray::set_bytecode_age(BytecodeArray::Age age) {
+  DCHECK_GE(age, kFirstBytecodeAge);
+  DCHECK_LE(age, kLastBytecodeAge);
+  STATIC_ASSERT(kLastBytecodeAge <= kMaxInt8);
+  WRITE_INT8_FIELD(this, kBytecodeAgeOffset, static_cast<int8_t>(age));
+}
+
 int BytecodeArray::parameter_count() const {
   // Parameter count is stored as the size on stack of the parameters to allow
   // it to be used directly by generated code.
@@ -4063,9 +4094,18 @@ int BytecodeArray::parameter_count() const {
 
 ACCESSORS(BytecodeArray, constant_pool, FixedArray, kConstantPoolOffset)
 ACCESSORS(BytecodeArray, handler_table, FixedArray, kHandlerTableOffset)
-ACCESSORS(BytecodeArray, source_position_table, ByteArray,
+ACCESSORS(BytecodeArray, source_position_table, Object,
           kSourcePositionTableOffset)
 
+bool BytecodeArray::HasSourcePositionTable() {
+  return source_position_table()->IsByteArray();
+}
+
+ByteArray* BytecodeArray::SourcePositionTable() {
+  if (!HasSourcePositionTable()) return GetHeap()->empty_byte_array();
+  return ByteArray::cast(source_position_table());
+}
+
 Address BytecodeArray::GetFirstBytecodeAddress() {
   return reinterpret_cast<Address>(this) - kHeapObjectTag + kHeaderSize;
 }
@@ -4077,7 +4117,7 @@ int BytecodeArray::SizeIncludingMetadata() {
   int size = BytecodeArraySize();
   size += constant_pool()->Size();
   size += handler_table()->Size();
-  size += source_position_table()->Size();
+  size += SourcePositionTable()->Size();
   return size;
 }
 
@@ -5718,6 +5758,8 @@ BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, never_compiled,
                kNeverCompiled)
 BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, is_declaration,
                kIsDeclaration)
+BOOL_ACCESSORS(SharedFunctionInfo, compiler_hints, optimization_hint,
+               kOptimizationHint)
 
 #if V8_HOST_ARCH_32_BIT
 SMI_ACCESSORS(SharedFunctionInfo, length, kLengthOffset)
@@ -12726,6 +12726,7 @@ void Script::SetEvalOrigin(Handle<Script> script,
     StackTraceFrameIterator it(script->GetIsolate());
     if (!it.done() && it.is_javascript()) {
       FrameSummary summary = FrameSummary::GetFirst(it.javascript_frame());
+      Compiler::EnsureSourcePositions(summary.function());
       script->set_eval_from_shared(summary.function()->shared());
       script->set_eval_from_position(-summary.code_offset());
       return;
@@ -14493,7 +14494,7 @@ void Code::Disassemble(const char* name, std::ostream& os) {  // NOLINT
 int BytecodeArray::SourcePosition(int offset) {
   int last_position = 0;
   for (interpreter::SourcePositionTableIterator iterator(
-           source_position_table());
+           SourcePositionTable());
        !iterator.done() && iterator.bytecode_offset() <= offset;
        iterator.Advance()) {
     last_position = iterator.source_position();
@@ -14506,7 +14507,7 @@ int BytecodeArray::SourceStatementPosition(int offset) {
   int position = SourcePosition(offset);
   // Now find the closest statement position before the position.
   int statement_position = 0;
-  for (interpreter::SourcePositionTableIterator it(source_position_table());
+  for (interpreter::SourcePositionTableIterator it(SourcePositionTable());
        !it.done(); it.Advance()) {
     if (it.is_statement()) {
       int p = it.source_position();
@@ -14524,7 +14525,7 @@ void BytecodeArray::Disassemble(std::ostream& os) {
 
   const uint8_t* base_address = GetFirstBytecodeAddress();
   interpreter::SourcePositionTableIterator source_positions(
-      source_position_table());
+      SourcePositionTable());
 
   interpreter::BytecodeArrayIterator iterator(handle(this));
   while (!iterator.done()) {
@@ -14569,6 +14570,19 @@ void BytecodeArray::CopyBytecodesTo(BytecodeArray* to) {
             from->length());
 }
 
+void BytecodeArray::MakeOlder() {
+  Age age = bytecode_age();
+  if (age < kLastBytecodeAge) {
+    set_bytecode_age(static_cast<Age>(age + 1));
+  }
+  DCHECK_GE(bytecode_age(), kFirstBytecodeAge);
+  DCHECK_LE(bytecode_age(), kLastBytecodeAge);
+}
+
+bool BytecodeArray::IsOld() const {
+  return bytecode_age() >= kIsOldBytecodeAge;
+}
+
 // static
 void JSArray::Initialize(Handle<JSArray> array, int capacity, int length) {
   DCHECK(capacity >= 0);
@@ -15282,6 +15296,7 @@ bool JSArray::SetLengthWouldNormalize(uint32_t new_length) {
 
 
 const double AllocationSite::kPretenureRatio = 0.85;
+const double AllocationSite::kPretenureCopyRatio = 1.2;
 
 
 void AllocationSite::ResetPretenureDecision() {
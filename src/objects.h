@@ -3818,6 +3818,7 @@ class ObjectHashTable: public HashTable<ObjectHashTable,
                                         int32_t hash);
 
  protected:
+  friend class ClearWeakCollectionsJobTraits;
   friend class MarkCompactCollector;
 
   void AddEntry(int entry, Object* key, Object* value);
@@ -4456,6 +4457,19 @@ class ByteArray: public FixedArrayBase {
 // BytecodeArray represents a sequence of interpreter bytecodes.
 class BytecodeArray : public FixedArrayBase {
  public:
+  enum Age {
+    kNoAgeBytecodeAge = 0,
+    kQuadragenarianBytecodeAge,
+    kQuinquagenarianBytecodeAge,
+    kSexagenarianBytecodeAge,
+    kSeptuagenarianBytecodeAge,
+    kOctogenarianBytecodeAge,
+    kAfterLastBytecodeAge,
+    kFirstBytecodeAge = kNoAgeBytecodeAge,
+    kLastBytecodeAge = kAfterLastBytecodeAge - 1,
+    kIsOldBytecodeAge = kSexagenarianBytecodeAge
+  };
+
   static int SizeFor(int length) {
     return OBJECT_POINTER_ALIGN(kHeaderSize + length);
   }
@@ -4482,6 +4496,17 @@ class BytecodeArray : public FixedArrayBase {
   inline int interrupt_budget() const;
   inline void set_interrupt_budget(int interrupt_budget);
 
+  // Accessors for the OSR loop nesting level. A non-zero level arms on-stack
+  // replacement at the next backward jump that exhausts the interrupt budget.
+  inline int osr_loop_nesting_level() const;
+  inline void set_osr_loop_nesting_level(int depth);
+
+  // Accessors for bytecode's code age. The age is reset by the interpreter
+  // entry trampoline and bumped by every full marking, so that bytecode of
+  // functions that have not run for a while can be flushed.
+  inline Age bytecode_age() const;
+  inline void set_bytecode_age(Age age);
+
   // Accessors for the constant pool.
   DECL_ACCESSORS(constant_pool, FixedArray)
 
@@ -4489,8 +4514,14 @@ class BytecodeArray : public FixedArrayBase {
   DECL_ACCESSORS(handler_table, FixedArray)
 
   // Accessors for source position table containing mappings between byte code
-  // offset and source position.
-  DECL_ACCESSORS(source_position_table, ByteArray)
+  // offset and source position. The table is undefined if the source positions
+  // were omitted when compiling and have not been collected yet.
+  DECL_ACCESSORS(source_position_table, Object)
+  inline bool HasSourcePositionTable();
+
+  // Returns the source position table, or the empty table if the source
+  // positions were omitted, see Compiler::EnsureSourcePositions().
+  inline ByteArray* SourcePositionTable();
 
   DECLARE_CAST(BytecodeArray)
 
@@ -4513,6 +4544,10 @@ class BytecodeArray : public FixedArrayBase {
 
   void CopyBytecodesTo(BytecodeArray* to);
 
+  // Bytecode aging
+  void MakeOlder();
+  bool IsOld() const;
+
   // Layout description.
   static const int kConstantPoolOffset = FixedArrayBase::kHeaderSize;
   static const int kHandlerTableOffset = kConstantPoolOffset + kPointerSize;
@@ -4521,7 +4556,9 @@ class BytecodeArray : public FixedArrayBase {
   static const int kFrameSizeOffset = kSourcePositionTableOffset + kPointerSize;
   static const int kParameterSizeOffset = kFrameSizeOffset + kIntSize;
   static const int kInterruptBudgetOffset = kParameterSizeOffset + kIntSize;
-  static const int kHeaderSize = kInterruptBudgetOffset + kIntSize;
+  static const int kOSRNestingLevelOffset = kInterruptBudgetOffset + kIntSize;
+  static const int kBytecodeAgeOffset = kOSRNestingLevelOffset + kIntSize;
+  static const int kHeaderSize = kBytecodeAgeOffset + kCharSize;
 
   // Maximal memory consumption for a single BytecodeArray.
   static const int kMaxSize = 512 * MB;
@@ -7295,6 +7332,10 @@ class SharedFunctionInfo: public HeapObject {
   // Whether this function was created from a FunctionDeclaration.
   DECL_BOOLEAN_ACCESSORS(is_declaration)
 
+  // Indicates that the function was optimized in the process that produced
+  // the code cache it was deserialized from.
+  DECL_BOOLEAN_ACCESSORS(optimization_hint)
+
   inline FunctionKind kind();
   inline void set_kind(FunctionKind kind);
 
@@ -7567,6 +7608,7 @@ class SharedFunctionInfo: public HeapObject {
     kIsAsyncFunction,
     kDeserialized,
     kIsDeclaration,
+    kOptimizationHint,
     kCompilerHintsCount,  // Pseudo entry
   };
   // Add hints for other modes when they're added.
@@ -8568,6 +8610,9 @@ class AllocationSite: public Struct {
  public:
   static const uint32_t kMaximumArrayBytesToPretransition = 8 * 1024;
   static const double kPretenureRatio;
+  // Threshold on the expected number of scavenger copies per allocated
+  // object, used instead of kPretenureRatio when lifetimes are known.
+  static const double kPretenureCopyRatio;
   static const int kPretenureMinimumCreated = 100;
 
   // Values for pretenure decision field.
@@ -8641,10 +8686,13 @@ class AllocationSite: public Struct {
   inline void MarkZombie();
 
   inline bool MakePretenureDecision(PretenureDecision current_decision,
-                                    double ratio,
+                                    double ratio, double threshold,
                                     bool maximum_size_scavenge);
 
-  inline bool DigestPretenuringFeedback(bool maximum_size_scavenge);
+  // {long_lived_ratio} is the fraction of surviving objects that also
+  // survived their second scavenge, or negative if unknown.
+  inline bool DigestPretenuringFeedback(bool maximum_size_scavenge,
+                                        double long_lived_ratio = -1.0);
 
   inline ElementsKind GetElementsKind();
   inline void SetElementsKind(ElementsKind kind);
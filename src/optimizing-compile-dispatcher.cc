@@ -5,6 +5,7 @@
 #include "src/optimizing-compile-dispatcher.h"
 
 #include "src/base/atomicops.h"
+#include "src/cancelable-task.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/isolate.h"
 #include "src/tracing/trace-event.h"
@@ -75,6 +76,39 @@ class OptimizingCompileDispatcher::CompileTask : public v8::Task {
 };
 
 
+class OptimizingCompileDispatcher::SubJobTask : public CancelableTask {
+ public:
+  SubJobTask(Isolate* isolate, OptimizingCompileDispatcher* dispatcher,
+             CompilationSubJob* sub_job, int* pending_sub_jobs)
+      : CancelableTask(isolate),
+        dispatcher_(dispatcher),
+        sub_job_(sub_job),
+        pending_sub_jobs_(pending_sub_jobs) {}
+
+  virtual ~SubJobTask() {}
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    DisallowHandleDereference no_deref;
+
+    sub_job_->Run();
+
+    base::LockGuard<base::Mutex> lock_guard(&dispatcher_->sub_jobs_mutex_);
+    --*pending_sub_jobs_;
+    dispatcher_->sub_job_done_.NotifyAll();
+  }
+
+  OptimizingCompileDispatcher* dispatcher_;
+  CompilationSubJob* sub_job_;
+  int* pending_sub_jobs_;
+
+  DISALLOW_COPY_AND_ASSIGN(SubJobTask);
+};
+
+
 OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
 #ifdef DEBUG
   {
@@ -89,10 +123,21 @@ OptimizingCompileDispatcher::~OptimizingCompileDispatcher() {
 CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
   base::LockGuard<base::Mutex> access_input_queue_(&input_queue_mutex_);
   if (input_queue_length_ == 0) return NULL;
-  CompilationJob* job = input_queue_[InputQueueIndex(0)];
+  // Take out the job with the highest priority, the oldest one on ties.
+  int index = 0;
+  for (int i = 1; i < input_queue_length_; i++) {
+    InputQueueEntry const& entry = input_queue_[i];
+    InputQueueEntry const& best = input_queue_[index];
+    if (entry.priority > best.priority ||
+        (entry.priority == best.priority && entry.queued_at < best.queued_at)) {
+      index = i;
+    }
+  }
+  CompilationJob* job = input_queue_[index].job;
   DCHECK_NOT_NULL(job);
-  input_queue_shift_ = InputQueueIndex(1);
-  input_queue_length_--;
+  base::TimeDelta latency =
+      base::TimeTicks::HighResolutionNow() - input_queue_[index].queued_at;
+  input_queue_[index] = input_queue_[--input_queue_length_];
   if (check_if_flushing) {
     if (static_cast<ModeFlag>(base::Acquire_Load(&mode_)) == FLUSH) {
       AllowHandleDereference allow_handle_dereference;
@@ -100,9 +145,88 @@ CompilationJob* OptimizingCompileDispatcher::NextInput(bool check_if_flushing) {
       return NULL;
     }
   }
+  queue_latencies_.push_back(static_cast<int>(latency.InMilliseconds()));
+  return job;
+}
+
+int OptimizingCompileDispatcher::LowestPriorityIndex() {
+  DCHECK_LT(0, input_queue_length_);
+  int index = 0;
+  for (int i = 1; i < input_queue_length_; i++) {
+    InputQueueEntry const& entry = input_queue_[i];
+    InputQueueEntry const& worst = input_queue_[index];
+    if (entry.priority < worst.priority ||
+        (entry.priority == worst.priority &&
+         entry.queued_at > worst.queued_at)) {
+      index = i;
+    }
+  }
+  return index;
+}
+
+CompilationJob* OptimizingCompileDispatcher::RemoveInput(int index) {
+  DCHECK_LE(0, index);
+  DCHECK_LT(index, input_queue_length_);
+  CompilationJob* job = input_queue_[index].job;
+  input_queue_[index] = input_queue_[--input_queue_length_];
   return job;
 }
 
+void OptimizingCompileDispatcher::DisposeEvictedJob(CompilationJob* job) {
+  Handle<JSFunction> function = job->info()->closure();
+  if (FLAG_trace_concurrent_recompilation) {
+    PrintF("  ** Evicting ");
+    function->ShortPrint();
+    PrintF(" from the compilation queue.\n");
+  }
+  isolate_->counters()->concurrent_recompilation_jobs_evicted()->Increment();
+  // Leave optimized code in place, otherwise allow the function to be marked
+  // for optimization again.
+  DisposeCompilationJob(job, !function->IsOptimized());
+}
+
+void OptimizingCompileDispatcher::EvictStaleJobs() {
+  if (blocked_jobs_ > 0) return;
+  base::TimeTicks now = base::TimeTicks::HighResolutionNow();
+  base::TimeDelta max_queue_time = base::TimeDelta::FromMilliseconds(
+      FLAG_concurrent_recompilation_max_queue_time);
+  std::vector<CompilationJob*> evicted;
+  {
+    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    for (int i = input_queue_length_ - 1; i >= 0; i--) {
+      InputQueueEntry const& entry = input_queue_[i];
+      // Jobs for functions that were optimized in the meantime (e.g. via OSR)
+      // are not needed anymore, and jobs that waited for too long are likely
+      // based on outdated type feedback.
+      if (entry.job->info()->closure()->IsOptimized() ||
+          (FLAG_concurrent_recompilation_max_queue_time > 0 &&
+           now - entry.queued_at > max_queue_time)) {
+        evicted.push_back(RemoveInput(i));
+      }
+    }
+  }
+  for (CompilationJob* job : evicted) DisposeEvictedJob(job);
+}
+
+void OptimizingCompileDispatcher::AgeQueuedJobsForTesting(
+    base::TimeDelta delta) {
+  base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+  for (int i = 0; i < input_queue_length_; i++) {
+    input_queue_[i].queued_at -= delta;
+  }
+}
+
+void OptimizingCompileDispatcher::RecordQueueLatencies() {
+  std::vector<int> latencies;
+  {
+    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    latencies.swap(queue_latencies_);
+  }
+  Histogram* histogram =
+      isolate_->counters()->concurrent_recompilation_queue_latency();
+  for (int latency : latencies) histogram->AddSample(latency);
+}
+
 void OptimizingCompileDispatcher::CompileNext(CompilationJob* job) {
   if (!job) return;
 
@@ -171,6 +295,8 @@ void OptimizingCompileDispatcher::Stop() {
 
 void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
   HandleScope handle_scope(isolate_);
+  RecordQueueLatencies();
+  EvictStaleJobs();
 
   for (;;) {
     CompilationJob* job = NULL;
@@ -195,15 +321,30 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
   }
 }
 
-void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
-  DCHECK(IsQueueAvailable());
+bool OptimizingCompileDispatcher::IsQueueAvailable(int priority) {
+  EvictStaleJobs();
+  base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+  if (input_queue_length_ < input_queue_capacity_) return true;
+  return input_queue_[LowestPriorityIndex()].priority < priority;
+}
+
+void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job,
+                                                       int priority) {
+  CompilationJob* evicted = nullptr;
   {
-    // Add job to the back of the input queue.
     base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+    if (input_queue_length_ == input_queue_capacity_) {
+      // Make room by evicting the coldest job. Its compile task is kept, it
+      // will just pick up the next job in the queue.
+      evicted = RemoveInput(LowestPriorityIndex());
+    }
     DCHECK_LT(input_queue_length_, input_queue_capacity_);
-    input_queue_[InputQueueIndex(input_queue_length_)] = job;
-    input_queue_length_++;
+    InputQueueEntry& entry = input_queue_[input_queue_length_++];
+    entry.job = job;
+    entry.priority = priority;
+    entry.queued_at = base::TimeTicks::HighResolutionNow();
   }
+  if (evicted != nullptr) DisposeEvictedJob(evicted);
   if (FLAG_block_concurrent_recompilation) {
     blocked_jobs_++;
   } else {
@@ -212,6 +353,61 @@ void OptimizingCompileDispatcher::QueueForOptimization(CompilationJob* job) {
   }
 }
 
+void OptimizingCompileDispatcher::UpdatePriority(JSFunction* function,
+                                                 int priority) {
+  base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
+  for (int i = 0; i < input_queue_length_; i++) {
+    InputQueueEntry& entry = input_queue_[i];
+    if (*entry.job->info()->closure() != function) continue;
+    if (entry.priority != priority) {
+      entry.priority = priority;
+      isolate_->counters()
+          ->concurrent_recompilation_jobs_reprioritized()
+          ->Increment();
+    }
+    return;
+  }
+}
+
+// static
+int OptimizingCompileDispatcher::PriorityFor(JSFunction* function) {
+  // The profiler ticks count how often the function was found on the stack
+  // (including as an inlinee), which makes them a good estimate of the time
+  // spent in unoptimized code that optimizing the function would save.
+  return function->shared()->profiler_ticks();
+}
+
+
+void OptimizingCompileDispatcher::RunSubJobs(CompilationSubJob** sub_jobs,
+                                             int count) {
+  DCHECK_LE(1, count);
+  DCHECK_LE(count, kMaxSubJobs);
+  uint32_t task_ids[kMaxSubJobs];
+  // Guarded by sub_jobs_mutex_.
+  int pending_sub_jobs = count - 1;
+  for (int i = 1; i < count; i++) {
+    SubJobTask* task =
+        new SubJobTask(isolate_, this, sub_jobs[i], &pending_sub_jobs);
+    task_ids[i] = task->id();
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+
+  // Contribute on the calling thread.
+  sub_jobs[0]->Run();
+  for (int i = 1; i < count; i++) {
+    if (isolate_->cancelable_task_manager()->TryAbort(task_ids[i])) {
+      sub_jobs[i]->Run();
+      base::LockGuard<base::Mutex> lock_guard(&sub_jobs_mutex_);
+      --pending_sub_jobs;
+    }
+  }
+
+  // Wait for the sub-jobs that were started by background threads.
+  base::LockGuard<base::Mutex> lock_guard(&sub_jobs_mutex_);
+  while (pending_sub_jobs > 0) sub_job_done_.Wait(&sub_jobs_mutex_);
+}
+
 
 void OptimizingCompileDispatcher::Unblock() {
   while (blocked_jobs_ > 0) {
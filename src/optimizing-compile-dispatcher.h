@@ -6,11 +6,13 @@
 #define V8_OPTIMIZING_COMPILE_DISPATCHER_H_
 
 #include <queue>
+#include <vector>
 
 #include "src/base/atomicops.h"
 #include "src/base/platform/condition-variable.h"
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
+#include "src/base/platform/time.h"
 #include "src/flags.h"
 #include "src/list.h"
 
@@ -18,20 +20,32 @@ namespace v8 {
 namespace internal {
 
 class CompilationJob;
+class JSFunction;
 class SharedFunctionInfo;
 
+// An independent part of a single compilation job that can run in parallel
+// with other parts of the same job, see
+// OptimizingCompileDispatcher::RunSubJobs.
+class CompilationSubJob {
+ public:
+  virtual ~CompilationSubJob() {}
+
+  // Called on an arbitrary thread. Must not touch the heap or any state
+  // shared with the other sub-jobs without synchronization.
+  virtual void Run() = 0;
+};
+
 class OptimizingCompileDispatcher {
  public:
   explicit OptimizingCompileDispatcher(Isolate* isolate)
       : isolate_(isolate),
         input_queue_capacity_(FLAG_concurrent_recompilation_queue_length),
         input_queue_length_(0),
-        input_queue_shift_(0),
         blocked_jobs_(0),
         ref_count_(0),
         recompilation_delay_(FLAG_concurrent_recompilation_delay) {
     base::NoBarrier_Store(&mode_, static_cast<base::AtomicWord>(COMPILE));
-    input_queue_ = NewArray<CompilationJob*>(input_queue_capacity_);
+    input_queue_ = NewArray<InputQueueEntry>(input_queue_capacity_);
   }
 
   ~OptimizingCompileDispatcher();
@@ -39,41 +53,84 @@ class OptimizingCompileDispatcher {
   void Run();
   void Stop();
   void Flush();
-  void QueueForOptimization(CompilationJob* job);
+  // Queues {job} with the given {priority}, see PriorityFor. If the queue is
+  // full, the queued job with the lowest priority is evicted.
+  void QueueForOptimization(CompilationJob* job, int priority);
   void Unblock();
   void InstallOptimizedFunctions();
 
-  inline bool IsQueueAvailable() {
-    base::LockGuard<base::Mutex> access_input_queue(&input_queue_mutex_);
-    return input_queue_length_ < input_queue_capacity_;
-  }
+  // Updates the priority of the queued job for {function}, if any, so that
+  // functions that keep getting hotter while waiting are compiled earlier.
+  void UpdatePriority(JSFunction* function, int priority);
+
+  // Returns the priority of optimizing {function}. Jobs with higher
+  // priorities are compiled first.
+  static int PriorityFor(JSFunction* function);
+
+  // Runs the given sub-jobs of a compilation job in parallel and returns once
+  // all of them are done. The sub-jobs are scheduled on the same background
+  // threads as whole-function jobs. The calling thread runs the first one and
+  // every other sub-job that has not been started by a background thread in
+  // the meantime, so this never waits for a busy thread pool.
+  void RunSubJobs(CompilationSubJob** sub_jobs, int count);
+
+  // Returns true if a job with the given {priority} can be queued, either
+  // because there is space left or because a job with a lower priority can be
+  // evicted.
+  bool IsQueueAvailable(int priority);
+
+  // Pretends that all queued jobs were queued {delta} earlier, so that tests
+  // do not depend on the wall clock.
+  void AgeQueuedJobsForTesting(base::TimeDelta delta);
 
   static bool Enabled() { return FLAG_concurrent_recompilation; }
 
  private:
   class CompileTask;
+  class SubJobTask;
+
+  static const int kMaxSubJobs = 8;
 
   enum ModeFlag { COMPILE, FLUSH };
 
+  struct InputQueueEntry {
+    CompilationJob* job;
+    int priority;
+    // Jobs with the same priority are compiled in FIFO order.
+    base::TimeTicks queued_at;
+  };
+
   void FlushOutputQueue(bool restore_function_code);
   void CompileNext(CompilationJob* job);
   CompilationJob* NextInput(bool check_if_flushing = false);
 
-  inline int InputQueueIndex(int i) {
-    int result = (i + input_queue_shift_) % input_queue_capacity_;
-    DCHECK_LE(0, result);
-    DCHECK_LT(result, input_queue_capacity_);
-    return result;
-  }
+  // Removes jobs from the input queue that are not worth compiling anymore.
+  // Needs to be called on the main thread. Jobs held back by
+  // --block-concurrent-recompilation are never evicted.
+  void EvictStaleJobs();
+  // Removes the job at {index} from the input queue and returns it. Needs to
+  // be called with input_queue_mutex_ held.
+  CompilationJob* RemoveInput(int index);
+  // Disposes of a job removed by RemoveInput. Touches the heap, so it needs to
+  // be called on the main thread without holding input_queue_mutex_.
+  void DisposeEvictedJob(CompilationJob* job);
+  // Returns the index of the queued job with the lowest priority, the one
+  // that is evicted first.
+  int LowestPriorityIndex();
+  void RecordQueueLatencies();
 
   Isolate* isolate_;
 
-  // Circular queue of incoming recompilation tasks (including OSR).
-  CompilationJob** input_queue_;
+  // Unordered queue of incoming recompilation tasks (including OSR). Jobs
+  // are taken out in priority order by NextInput.
+  InputQueueEntry* input_queue_;
   int input_queue_capacity_;
   int input_queue_length_;
-  int input_queue_shift_;
   base::Mutex input_queue_mutex_;
+  // Time between queuing and starting to compile the jobs that were taken
+  // out since the last call to RecordQueueLatencies, in milliseconds.
+  // Guarded by input_queue_mutex_.
+  std::vector<int> queue_latencies_;
 
   // Queue of recompilation tasks ready to be installed (excluding OSR).
   std::queue<CompilationJob*> output_queue_;
@@ -89,6 +146,10 @@ class OptimizingCompileDispatcher {
   base::Mutex ref_count_mutex_;
   base::ConditionVariable ref_count_zero_;
 
+  // Signaled whenever a background thread finishes a sub-job.
+  base::Mutex sub_jobs_mutex_;
+  base::ConditionVariable sub_job_done_;
+
   // Copy of FLAG_concurrent_recompilation_delay that will be used from the
   // background thread.
   //
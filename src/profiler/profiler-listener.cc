@@ -111,7 +111,7 @@ void ProfilerListener::CodeCreateEvent(CodeEventListener::LogEventsAndTags tag,
       BytecodeArray* bytecode = abstract_code->GetBytecodeArray();
       line_table = new JITLineInfoTable();
       interpreter::SourcePositionTableIterator it(
-          bytecode->source_position_table());
+          bytecode->SourcePositionTable());
       for (; !it.done(); it.Advance()) {
         int line_number = script->GetLineNumber(it.source_position()) + 1;
         int pc_offset = it.bytecode_offset() + BytecodeArray::kHeaderSize;
@@ -14,6 +14,8 @@
 #include "src/frames-inl.h"
 #include "src/full-codegen/full-codegen.h"
 #include "src/global-handles.h"
+#include "src/interpreter/interpreter.h"
+#include "src/optimizing-compile-dispatcher.h"
 
 namespace v8 {
 namespace internal {
@@ -33,8 +35,14 @@ static const int kProfilerTicksBeforeReenablingOptimization = 250;
 // FLAG_type_info_threshold), but has seen a huge number of ticks,
 // optimize it as it is.
 static const int kTicksWhenNotEnoughTypeInfo = 100;
+// With --deopt-backoff, every deoptimization of a function doubles the number
+// of ticks it has to be seen on the stack before it is optimized again, up to
+// this many doublings.
+static const int kMaxDeoptBackoffShift = 6;
 // We only have one byte to store the number of ticks.
 STATIC_ASSERT(kProfilerTicksBeforeOptimization < 256);
+STATIC_ASSERT((kProfilerTicksBeforeOptimization << kMaxDeoptBackoffShift) <
+              256);
 STATIC_ASSERT(kProfilerTicksBeforeReenablingOptimization < 256);
 STATIC_ASSERT(kTicksWhenNotEnoughTypeInfo < 256);
 
@@ -45,6 +53,13 @@ static const int kOSRCodeSizeAllowanceBase =
 static const int kOSRCodeSizeAllowancePerTick =
     4 * FullCodeGenerator::kCodeSizeMultiplier;
 
+// Maximum size in bytes of bytecode for a function to allow OSR.
+static const int kOSRCodeSizeAllowanceBaseIgnition =
+    100 * interpreter::Interpreter::kCodeSizeMultiplier;
+
+static const int kOSRCodeSizeAllowancePerTickIgnition =
+    4 * interpreter::Interpreter::kCodeSizeMultiplier;
+
 // Maximum size in bytes of generated code for a function to be optimized
 // the very first time it is seen on the stack.
 static const int kMaxSizeEarlyOpt =
@@ -143,6 +158,28 @@ void RuntimeProfiler::AttemptOnStackReplacement(JSFunction* function,
   // arguments accesses, which is unsound.  Don't try OSR.
   if (shared->uses_arguments()) return;
 
+  // Functions that still run in the interpreter have no back edge table,
+  // instead the back edges of their bytecode are armed.
+  if (shared->code()->kind() != Code::FUNCTION) {
+    if (!FLAG_ignition_osr || !shared->HasBytecodeArray()) return;
+
+    // Resuming generators jump into the middle of loops, which the OSR entry
+    // at the loop header doesn't account for.
+    if (shared->is_resumable()) return;
+
+    if (FLAG_trace_osr) {
+      PrintF("[OSR - arming back edges in ");
+      function->PrintName();
+      PrintF("]\n");
+    }
+
+    BytecodeArray* bytecode = shared->bytecode_array();
+    int level = bytecode->osr_loop_nesting_level() + loop_nesting_levels;
+    bytecode->set_osr_loop_nesting_level(
+        Min(level, Code::kMaxLoopNestingMarker));
+    return;
+  }
+
   // We're using on-stack replacement: patch the unoptimized code so that
   // any back edge in any unoptimized frame will trigger on-stack
   // replacement for that frame.
@@ -215,7 +252,29 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
 
   int ticks = shared_code->profiler_ticks();
 
-  if (ticks >= kProfilerTicksBeforeOptimization) {
+  if (shared->optimization_hint()) {
+    // The function was optimized in the process that produced the code cache
+    // it was deserialized from, so skip the warm-up ticks once the type
+    // feedback is stable. The hint is only used once, later deoptimizations
+    // go through the usual heuristics.
+    int typeinfo, generic, total, type_percentage, generic_percentage;
+    GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
+                &generic_percentage);
+    if (type_percentage >= FLAG_type_info_threshold &&
+        generic_percentage <= FLAG_generic_ic_threshold) {
+      shared->set_optimization_hint(false);
+      Optimize(function, "optimized before code caching");
+      return;
+    }
+  }
+
+  int ticks_before_optimization = kProfilerTicksBeforeOptimization;
+  if (FLAG_deopt_backoff && shared->deopt_count() > 0) {
+    ticks_before_optimization <<=
+        Min(shared->deopt_count(), kMaxDeoptBackoffShift);
+  }
+
+  if (ticks >= ticks_before_optimization) {
     int typeinfo, generic, total, type_percentage, generic_percentage;
     GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
                 &generic_percentage);
@@ -236,9 +295,10 @@ void RuntimeProfiler::MaybeOptimizeFullCodegen(JSFunction* function,
       }
     }
   } else if (!any_ic_changed_ &&
+             (!FLAG_deopt_backoff || shared->deopt_count() == 0) &&
              shared_code->instruction_size() < kMaxSizeEarlyOpt) {
     // If no IC was patched since the last tick and this function is very
-    // small, optimistically optimize it now.
+    // small and has never deoptimized, optimistically optimize it now.
     int typeinfo, generic, total, type_percentage, generic_percentage;
     GetICCounts(function, &typeinfo, &generic, &total, &type_percentage,
                 &generic_percentage);
@@ -264,10 +324,21 @@ void RuntimeProfiler::MaybeOptimizeIgnition(JSFunction* function) {
   // TODO(rmcilroy): Consider whether we should optimize small functions when
   // they are first seen on the stack (e.g., kMaxSizeEarlyOpt).
 
-  if (function->IsMarkedForBaseline() || function->IsMarkedForOptimization() ||
-      function->IsMarkedForConcurrentOptimization() ||
-      function->IsOptimized()) {
-    // TODO(rmcilroy): Support OSR in these cases.
+  if (FLAG_always_osr) {
+    AttemptOnStackReplacement(function, Code::kMaxLoopNestingMarker);
+    // Fall through and do a normal baseline compile as well.
+  } else if (function->IsMarkedForBaseline() ||
+             function->IsMarkedForOptimization() ||
+             function->IsMarkedForConcurrentOptimization() ||
+             function->IsOptimized()) {
+    // Attempt OSR if we are still running interpreted code even though the
+    // the function has long been marked or even already been optimized.
+    int64_t allowance =
+        kOSRCodeSizeAllowanceBaseIgnition +
+        static_cast<int64_t>(ticks) * kOSRCodeSizeAllowancePerTickIgnition;
+    if (shared->bytecode_array()->Size() <= allowance) {
+      AttemptOnStackReplacement(function);
+    }
     return;
   }
 
@@ -311,6 +382,13 @@ void RuntimeProfiler::MarkCandidatesForOptimization() {
       }
     }
 
+    if (function->IsInOptimizationQueue()) {
+      // Let functions that keep getting hotter while they wait overtake
+      // colder ones in the concurrent recompilation queue.
+      isolate_->optimizing_compile_dispatcher()->UpdatePriority(
+          function, OptimizingCompileDispatcher::PriorityFor(function));
+    }
+
     if (frame->is_interpreted()) {
       DCHECK(!frame->is_optimized());
       MaybeOptimizeIgnition(function);
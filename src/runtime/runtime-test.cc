@@ -163,9 +163,8 @@ RUNTIME_FUNCTION(Runtime_OptimizeOsr) {
   RUNTIME_ASSERT(function->shared()->allows_lazy_compilation() ||
                  !function->shared()->optimization_disabled());
 
-  // If function is interpreted, just return. OSR is not supported.
-  // TODO(4764): Remove this check when OSR is enabled in the interpreter.
-  if (function->shared()->HasBytecodeArray()) {
+  // If function is interpreted but OSR hasn't been enabled, just return.
+  if (function->shared()->HasBytecodeArray() && !FLAG_ignition_osr) {
     return isolate->heap()->undefined_value();
   }
 
@@ -175,10 +174,12 @@ RUNTIME_FUNCTION(Runtime_OptimizeOsr) {
   Code* unoptimized = function->shared()->code();
   if (unoptimized->kind() == Code::FUNCTION) {
     DCHECK(BackEdgeTable::Verify(isolate, unoptimized));
-    isolate->runtime_profiler()->AttemptOnStackReplacement(
-        *function, Code::kMaxLoopNestingMarker);
   }
 
+  // Make the profiler arm all back edges in unoptimized code.
+  isolate->runtime_profiler()->AttemptOnStackReplacement(
+      *function, Code::kMaxLoopNestingMarker);
+
   return isolate->heap()->undefined_value();
 }
 
@@ -248,6 +249,48 @@ RUNTIME_FUNCTION(Runtime_GetOptimizationCount) {
 }
 
 
+// Returns the functions that deoptimized most often, as an array of objects
+// with the function's name, its number of deoptimizations and the number of
+// deoptimizations per reason. Reasons are only recorded with
+// --track-deopt-reasons.
+RUNTIME_FUNCTION(Runtime_GetDeoptimizationReport) {
+  HandleScope scope(isolate);
+  DCHECK(args.length() == 1);
+  CONVERT_SMI_ARG_CHECKED(max_entries, 0);
+  Factory* factory = isolate->factory();
+  std::vector<const DeoptimizationTracker::Entry*> entries =
+      isolate->deoptimizer_data()->tracker()->TopEntries(
+          static_cast<size_t>(Max(max_entries, 0)));
+  Handle<FixedArray> elements =
+      factory->NewFixedArray(static_cast<int>(entries.size()));
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const DeoptimizationTracker::Entry* entry = entries[i];
+    Handle<JSObject> reasons = factory->NewJSObject(isolate->object_function());
+    for (int r = 0; r < Deoptimizer::kLastDeoptReason; ++r) {
+      if (entry->reason_counts[r] == 0) continue;
+      const char* reason =
+          Deoptimizer::GetDeoptReason(static_cast<Deoptimizer::DeoptReason>(r));
+      JSObject::AddProperty(reasons, factory->InternalizeUtf8String(reason),
+                            handle(Smi::FromInt(entry->reason_counts[r]),
+                                   isolate),
+                            NONE);
+    }
+    Handle<JSObject> result = factory->NewJSObject(isolate->object_function());
+    JSObject::AddProperty(
+        result, factory->InternalizeUtf8String("name"),
+        factory->NewStringFromUtf8(CStrVector(entry->name.c_str()))
+            .ToHandleChecked(),
+        NONE);
+    JSObject::AddProperty(result, factory->InternalizeUtf8String("count"),
+                          handle(Smi::FromInt(entry->count), isolate), NONE);
+    JSObject::AddProperty(result, factory->InternalizeUtf8String("reasons"),
+                          reasons, NONE);
+    elements->set(static_cast<int>(i), *result);
+  }
+  return *factory->NewJSArrayWithElements(elements);
+}
+
+
 RUNTIME_FUNCTION(Runtime_GetUndetectable) {
   HandleScope scope(isolate);
   DCHECK(args.length() == 0);
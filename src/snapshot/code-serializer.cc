@@ -13,9 +13,25 @@
 namespace v8 {
 namespace internal {
 
-ScriptData* CodeSerializer::Serialize(Isolate* isolate,
-                                      Handle<SharedFunctionInfo> info,
-                                      Handle<String> source) {
+namespace {
+
+// Hashes the source text of {shared}. A recorded optimization hint is only
+// applied to a function with the same source text, which also guarantees the
+// same type feedback layout.
+uint32_t FunctionSourceHash(String* source, SharedFunctionInfo* shared) {
+  uint32_t hash = 0;
+  int end = Min(shared->end_position(), source->length());
+  for (int i = shared->start_position(); i < end; i++) {
+    hash = StringHasher::AddCharacterCore(hash, source->Get(i));
+  }
+  return StringHasher::GetHashCore(hash);
+}
+
+}  // namespace
+
+ScriptData* CodeSerializer::Serialize(
+    Isolate* isolate, Handle<SharedFunctionInfo> info, Handle<String> source,
+    MaybeHandle<SharedFunctionInfo> warm_info) {
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
   if (FLAG_trace_serializer) {
@@ -28,6 +44,10 @@ ScriptData* CodeSerializer::Serialize(Isolate* isolate,
   // Serialize code object.
   CodeSerializer cs(isolate, *source);
   DisallowHeapAllocation no_gc;
+  Handle<SharedFunctionInfo> warm;
+  if (FLAG_serialize_optimization_hints && warm_info.ToHandle(&warm)) {
+    cs.RecordOptimizationHints(*warm);
+  }
   Object** location = Handle<Object>::cast(info).location();
   cs.VisitPointer(location);
   cs.SerializeDeferredObjects();
@@ -147,6 +167,50 @@ void CodeSerializer::SerializeCodeStub(Code* code_stub, HowToCode how_to_code,
   PutAttachedReference(reference, how_to_code, where_to_point);
 }
 
+void CodeSerializer::RecordOptimizationHints(SharedFunctionInfo* warm_info) {
+  Object* script = warm_info->script();
+  if (!script->IsScript()) return;
+  WeakFixedArray::Iterator iterator(
+      Script::cast(script)->shared_function_infos());
+  while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+    // Functions that ended up with optimization disabled, for instance due to
+    // repeated deoptimization, are better left to the runtime profiler.
+    if (shared->is_toplevel() || shared->opt_count() == 0 ||
+        shared->optimization_disabled()) {
+      continue;
+    }
+    optimization_hints_.Add(shared->start_position());
+    optimization_hints_.Add(shared->end_position());
+    optimization_hints_.Add(FunctionSourceHash(source_, shared));
+  }
+  if (FLAG_trace_serializer) {
+    PrintF(" Recorded %d optimization hints\n",
+           optimization_hints_.length() / kOptimizationHintSize);
+  }
+}
+
+void CodeSerializer::ApplyOptimizationHints(SharedFunctionInfo* info,
+                                            String* source,
+                                            Vector<const uint32_t> hints) {
+  DisallowHeapAllocation no_gc;
+  Object* script = info->script();
+  if (hints.is_empty() || !script->IsScript()) return;
+  WeakFixedArray::Iterator iterator(
+      Script::cast(script)->shared_function_infos());
+  while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+    uint32_t start = static_cast<uint32_t>(shared->start_position());
+    uint32_t end = static_cast<uint32_t>(shared->end_position());
+    for (int i = 0; i + kOptimizationHintSize <= hints.length();
+         i += kOptimizationHintSize) {
+      if (hints[i] != start || hints[i + 1] != end) continue;
+      if (hints[i + 2] == FunctionSourceHash(source, shared)) {
+        shared->set_optimization_hint(true);
+      }
+      break;
+    }
+  }
+}
+
 MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     Isolate* isolate, ScriptData* cached_data, Handle<String> source) {
   base::ElapsedTimer timer;
@@ -184,6 +248,9 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     PrintF("[Deserializing from %d bytes took %0.3f ms]\n", length, ms);
   }
   result->set_deserialized(true);
+  if (FLAG_serialize_optimization_hints) {
+    ApplyOptimizationHints(*result, *source, scd->OptimizationHints());
+  }
 
   if (isolate->logger()->is_logging_code_events() || isolate->is_profiling()) {
     String* name = isolate->heap()->empty_string();
@@ -240,6 +307,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>* payload,
                                        const CodeSerializer* cs) {
   DisallowHeapAllocation no_gc;
   const List<uint32_t>* stub_keys = cs->stub_keys();
+  const List<uint32_t>* hints = cs->optimization_hints();
 
   List<Reservation> reservations;
   cs->EncodeReservations(&reservations);
@@ -248,7 +316,9 @@ SerializedCodeData::SerializedCodeData(const List<byte>* payload,
   int reservation_size = reservations.length() * kInt32Size;
   int num_stub_keys = stub_keys->length();
   int stub_keys_size = stub_keys->length() * kInt32Size;
-  int payload_offset = kHeaderSize + reservation_size + stub_keys_size;
+  int hints_size = hints->length() * kInt32Size;
+  int payload_offset =
+      kHeaderSize + reservation_size + stub_keys_size + hints_size;
   int padded_payload_offset = POINTER_SIZE_ALIGN(payload_offset);
   int size = padded_payload_offset + payload->length();
 
@@ -264,6 +334,7 @@ SerializedCodeData::SerializedCodeData(const List<byte>* payload,
   SetHeaderValue(kFlagHashOffset, FlagList::Hash());
   SetHeaderValue(kNumReservationsOffset, reservations.length());
   SetHeaderValue(kNumCodeStubKeysOffset, num_stub_keys);
+  SetHeaderValue(kNumOptimizationHintsOffset, hints->length());
   SetHeaderValue(kPayloadLengthOffset, payload->length());
 
   Checksum checksum(payload->ToConstVector());
@@ -278,6 +349,10 @@ SerializedCodeData::SerializedCodeData(const List<byte>* payload,
   CopyBytes(data_ + kHeaderSize + reservation_size,
             reinterpret_cast<byte*>(stub_keys->begin()), stub_keys_size);
 
+  // Copy optimization hints.
+  CopyBytes(data_ + kHeaderSize + reservation_size + stub_keys_size,
+            reinterpret_cast<byte*>(hints->begin()), hints_size);
+
   memset(data_ + payload_offset, 0, padded_payload_offset - payload_offset);
 
   // Copy serialized data.
@@ -329,7 +404,9 @@ Vector<const SerializedData::Reservation> SerializedCodeData::Reservations()
 Vector<const byte> SerializedCodeData::Payload() const {
   int reservations_size = GetHeaderValue(kNumReservationsOffset) * kInt32Size;
   int code_stubs_size = GetHeaderValue(kNumCodeStubKeysOffset) * kInt32Size;
-  int payload_offset = kHeaderSize + reservations_size + code_stubs_size;
+  int hints_size = GetHeaderValue(kNumOptimizationHintsOffset) * kInt32Size;
+  int payload_offset =
+      kHeaderSize + reservations_size + code_stubs_size + hints_size;
   int padded_payload_offset = POINTER_SIZE_ALIGN(payload_offset);
   const byte* payload = data_ + padded_payload_offset;
   DCHECK(IsAligned(reinterpret_cast<intptr_t>(payload), kPointerAlignment));
@@ -345,6 +422,14 @@ Vector<const uint32_t> SerializedCodeData::CodeStubKeys() const {
                                 GetHeaderValue(kNumCodeStubKeysOffset));
 }
 
+Vector<const uint32_t> SerializedCodeData::OptimizationHints() const {
+  int reservations_size = GetHeaderValue(kNumReservationsOffset) * kInt32Size;
+  int code_stubs_size = GetHeaderValue(kNumCodeStubKeysOffset) * kInt32Size;
+  const byte* start = data_ + kHeaderSize + reservations_size + code_stubs_size;
+  return Vector<const uint32_t>(reinterpret_cast<const uint32_t*>(start),
+                                GetHeaderValue(kNumOptimizationHintsOffset));
+}
+
 SerializedCodeData::SerializedCodeData(ScriptData* data)
     : SerializedData(const_cast<byte*>(data->data()), data->length()) {}
 
@@ -13,9 +13,13 @@ namespace internal {
 
 class CodeSerializer : public Serializer {
  public:
-  static ScriptData* Serialize(Isolate* isolate,
-                               Handle<SharedFunctionInfo> info,
-                               Handle<String> source);
+  // If {warm_info} is given, it is a previously compiled and executed copy of
+  // {info}. With --serialize-optimization-hints, its functions that have been
+  // optimized are recorded in the cached data.
+  static ScriptData* Serialize(
+      Isolate* isolate, Handle<SharedFunctionInfo> info, Handle<String> source,
+      MaybeHandle<SharedFunctionInfo> warm_info =
+          MaybeHandle<SharedFunctionInfo>());
 
   MUST_USE_RESULT static MaybeHandle<SharedFunctionInfo> Deserialize(
       Isolate* isolate, ScriptData* cached_data, Handle<String> source);
@@ -26,6 +30,13 @@ class CodeSerializer : public Serializer {
   }
 
   const List<uint32_t>* stub_keys() const { return &stub_keys_; }
+  const List<uint32_t>* optimization_hints() const {
+    return &optimization_hints_;
+  }
+
+  // Each optimization hint consists of the start and end position of the
+  // function and a hash of its source text.
+  static const int kOptimizationHintSize = 3;
 
  private:
   CodeSerializer(Isolate* isolate, String* source)
@@ -45,9 +56,14 @@ class CodeSerializer : public Serializer {
   void SerializeGeneric(HeapObject* heap_object, HowToCode how_to_code,
                         WhereToPoint where_to_point);
 
+  void RecordOptimizationHints(SharedFunctionInfo* warm_info);
+  static void ApplyOptimizationHints(SharedFunctionInfo* info, String* source,
+                                     Vector<const uint32_t> hints);
+
   DisallowHeapAllocation no_gc_;
   String* source_;
   List<uint32_t> stub_keys_;
+  List<uint32_t> optimization_hints_;
   DISALLOW_COPY_AND_ASSIGN(CodeSerializer);
 };
 
@@ -69,6 +85,7 @@ class SerializedCodeData : public SerializedData {
   Vector<const byte> Payload() const;
 
   Vector<const uint32_t> CodeStubKeys() const;
+  Vector<const uint32_t> OptimizationHints() const;
 
  private:
   explicit SerializedCodeData(ScriptData* data);
@@ -95,11 +112,13 @@ class SerializedCodeData : public SerializedData {
   // [4] flag hash
   // [5] number of code stub keys
   // [6] number of reservation size entries
-  // [7] payload length
-  // [8] payload checksum part 1
-  // [9] payload checksum part 2
+  // [7] number of optimization hint entries
+  // [8] payload length
+  // [9] payload checksum part 1
+  // [10] payload checksum part 2
   // ...  reservations
   // ...  code stub keys
+  // ...  optimization hints
   // ...  serialized payload
   static const int kVersionHashOffset = kMagicNumberOffset + kInt32Size;
   static const int kSourceHashOffset = kVersionHashOffset + kInt32Size;
@@ -107,7 +126,10 @@ class SerializedCodeData : public SerializedData {
   static const int kFlagHashOffset = kCpuFeaturesOffset + kInt32Size;
   static const int kNumReservationsOffset = kFlagHashOffset + kInt32Size;
   static const int kNumCodeStubKeysOffset = kNumReservationsOffset + kInt32Size;
-  static const int kPayloadLengthOffset = kNumCodeStubKeysOffset + kInt32Size;
+  static const int kNumOptimizationHintsOffset =
+      kNumCodeStubKeysOffset + kInt32Size;
+  static const int kPayloadLengthOffset =
+      kNumOptimizationHintsOffset + kInt32Size;
   static const int kChecksum1Offset = kPayloadLengthOffset + kInt32Size;
   static const int kChecksum2Offset = kChecksum1Offset + kInt32Size;
   static const int kHeaderSize = kChecksum2Offset + kInt32Size;
@@ -609,12 +609,14 @@ InlineCacheState CallICNexus::StateFromFeedback() const {
   Object* feedback = GetFeedback();
   DCHECK(GetFeedbackExtra() ==
              *TypeFeedbackVector::UninitializedSentinel(isolate) ||
-         GetFeedbackExtra()->IsSmi());
+         GetFeedbackExtra()->IsSmi() || GetFeedbackExtra()->IsFixedArray());
 
   if (feedback == *TypeFeedbackVector::MegamorphicSentinel(isolate)) {
     return GENERIC;
   } else if (feedback->IsAllocationSite() || feedback->IsWeakCell()) {
     return MONOMORPHIC;
+  } else if (feedback->IsFixedArray()) {
+    return POLYMORPHIC;
   }
 
   CHECK(feedback == *TypeFeedbackVector::UninitializedSentinel(isolate));
@@ -622,7 +624,24 @@ InlineCacheState CallICNexus::StateFromFeedback() const {
 }
 
 
+FixedArray* CallICNexus::GetCallTargets() const {
+  Object* feedback = GetFeedback();
+  if (feedback->IsFixedArray()) return FixedArray::cast(feedback);
+  Object* feedback_extra = GetFeedbackExtra();
+  if (feedback_extra->IsFixedArray()) return FixedArray::cast(feedback_extra);
+  return nullptr;
+}
+
+
 int CallICNexus::ExtractCallCount() {
+  FixedArray* targets = GetCallTargets();
+  if (targets != nullptr) {
+    int value = 0;
+    for (int i = 1; i < targets->length(); i += 2) {
+      value += Smi::cast(targets->get(i))->value();
+    }
+    return value;
+  }
   Object* call_count = GetFeedbackExtra();
   if (call_count->IsSmi()) {
     int value = Smi::cast(call_count)->value();
@@ -632,6 +651,23 @@ int CallICNexus::ExtractCallCount() {
 }
 
 
+int CallICNexus::ExtractCallTargets(Handle<JSFunction>* targets, int* counts,
+                                    int length) {
+  FixedArray* array = GetCallTargets();
+  if (array == nullptr) return 0;
+  Isolate* isolate = GetIsolate();
+  int found = 0;
+  for (int i = 0; i < array->length() && found < length; i += 2) {
+    WeakCell* cell = WeakCell::cast(array->get(i));
+    if (cell->cleared()) continue;
+    targets[found] = handle(JSFunction::cast(cell->value()), isolate);
+    counts[found] = Smi::cast(array->get(i + 1))->value();
+    found++;
+  }
+  return found;
+}
+
+
 void CallICNexus::Clear(Code* host) { CallIC::Clear(GetIsolate(), host, this); }
 
 
@@ -653,6 +689,54 @@ void CallICNexus::ConfigureMonomorphic(Handle<JSFunction> function) {
 }
 
 
+void CallICNexus::ConfigurePolymorphic(Handle<JSFunction> function) {
+  Isolate* isolate = GetIsolate();
+  Handle<WeakCell> cell(WeakCell::cast(GetFeedback()), isolate);
+  DCHECK(cell->value()->IsJSFunction());
+  int const call_count = Smi::cast(GetFeedbackExtra())->value();
+  Handle<WeakCell> new_cell = isolate->factory()->NewWeakCell(function);
+  Handle<FixedArray> array = isolate->factory()->NewFixedArray(4);
+  array->set(0, *cell);
+  array->set(1, Smi::FromInt(call_count));
+  array->set(2, *new_cell);
+  array->set(3, Smi::FromInt(1));
+  SetFeedback(*array);
+  SetFeedbackExtra(Smi::FromInt(1), SKIP_WRITE_BARRIER);
+}
+
+
+bool CallICNexus::RecordPolymorphicCall(Handle<JSFunction> function) {
+  Isolate* isolate = GetIsolate();
+  Handle<FixedArray> array(FixedArray::cast(GetFeedback()), isolate);
+  int const samples = Smi::cast(GetFeedbackExtra())->value() + 1;
+  int const length = array->length();
+  int index = 0;
+  while (index < length &&
+         WeakCell::cast(array->get(index))->value() != *function) {
+    index += 2;
+  }
+  if (index == length) {
+    if (length == 2 * kMaxCallTargets) return false;
+    Handle<WeakCell> cell = isolate->factory()->NewWeakCell(function);
+    array = isolate->factory()->CopyFixedArrayAndGrow(array, 2);
+    array->set(index, *cell);
+    array->set(index + 1, Smi::FromInt(0));
+  }
+  int const count = Smi::cast(array->get(index + 1))->value();
+  array->set(index + 1, Smi::FromInt(count + 1));
+
+  if (samples < kPolymorphicCallSamples) {
+    SetFeedback(*array);
+    SetFeedbackExtra(Smi::FromInt(samples), SKIP_WRITE_BARRIER);
+  } else {
+    SetFeedback(*TypeFeedbackVector::MegamorphicSentinel(isolate),
+                SKIP_WRITE_BARRIER);
+    SetFeedbackExtra(*array);
+  }
+  return true;
+}
+
+
 void CallICNexus::ConfigureMegamorphic() {
   FeedbackNexus::ConfigureMegamorphic();
 }
@@ -458,13 +458,27 @@ class CallICNexus final : public FeedbackNexus {
     DCHECK_EQ(FeedbackVectorSlotKind::CALL_IC, vector->GetKind(slot));
   }
 
+  // Polymorphic call sites record up to kMaxCallTargets targets together
+  // with how often each of them was called. The histogram is a FixedArray of
+  // (WeakCell, Smi) pairs. While it is collected, it is kept as the feedback
+  // and the extra slot counts the calls sampled so far. After
+  // kPolymorphicCallSamples calls, the call site goes megamorphic, so that the
+  // CallIC stubs no longer miss, and the histogram moves to the extra slot.
+  static const int kMaxCallTargets = 4;
+  static const int kPolymorphicCallSamples = 32;
+
   void Clear(Code* host);
 
   void ConfigureMonomorphicArray();
   void ConfigureMonomorphic(Handle<JSFunction> function);
+  void ConfigurePolymorphic(Handle<JSFunction> function);
   void ConfigureMegamorphic() final;
   void ConfigureMegamorphic(int call_count);
 
+  // Records a call to {function} in the histogram of a polymorphic call site.
+  // Returns false if the histogram is already full with other targets.
+  bool RecordPolymorphicCall(Handle<JSFunction> function);
+
   InlineCacheState StateFromFeedback() const final;
 
   int ExtractMaps(MapHandleList* maps) const final {
@@ -479,6 +493,15 @@ class CallICNexus final : public FeedbackNexus {
   }
 
   int ExtractCallCount();
+
+  // Fills in up to {length} live {targets} of a polymorphic call site and how
+  // often each of them was called, and returns their number.
+  int ExtractCallTargets(Handle<JSFunction>* targets, int* counts,
+                         int length);
+
+ private:
+  // Returns the histogram of a polymorphic call site, or nullptr.
+  FixedArray* GetCallTargets() const;
 };
 
 
@@ -601,8 +601,14 @@
         'compiler/load-elimination.h',
         'compiler/loop-analysis.cc',
         'compiler/loop-analysis.h',
+        'compiler/loop-invariant-code-motion.cc',
+        'compiler/loop-invariant-code-motion.h',
         'compiler/loop-peeling.cc',
         'compiler/loop-peeling.h',
+        'compiler/loop-variable-optimizer.cc',
+        'compiler/loop-variable-optimizer.h',
+        'compiler/loop-vectorizer.cc',
+        'compiler/loop-vectorizer.h',
         'compiler/machine-operator-reducer.cc',
         'compiler/machine-operator-reducer.h',
         'compiler/machine-operator.cc',
@@ -836,9 +842,13 @@
         'handles.cc',
         'handles.h',
         'heap-symbols.h',
+        'heap/allocation-site-lifetimes.cc',
+        'heap/allocation-site-lifetimes.h',
         'heap/array-buffer-tracker-inl.h',
         'heap/array-buffer-tracker.cc',
         'heap/array-buffer-tracker.h',
+        'heap/concurrent-marking.cc',
+        'heap/concurrent-marking.h',
         'heap/memory-reducer.cc',
         'heap/memory-reducer.h',
         'heap/gc-idle-time-handler.cc',
@@ -862,6 +872,8 @@
         'heap/objects-visiting.cc',
         'heap/objects-visiting.h',
         'heap/page-parallel-job.h',
+        'heap/parallel-scavenger.cc',
+        'heap/parallel-scavenger.h',
         'heap/remembered-set.cc',
         'heap/remembered-set.h',
         'heap/scavenge-job.h',
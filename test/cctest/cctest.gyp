@@ -115,6 +115,7 @@
         'heap/test-lab.cc',
         'heap/test-mark-compact.cc',
         'heap/test-page-promotion.cc',
+        'heap/test-slot-set.cc',
         'heap/test-spaces.cc',
         'libsampler/test-sampler.cc',
         'print-extension.cc',
@@ -36,6 +36,7 @@
 #include "src/factory.h"
 #include "src/field-type.h"
 #include "src/global-handles.h"
+#include "src/heap/allocation-site-lifetimes.h"
 #include "src/heap/gc-tracer.h"
 #include "src/heap/memory-reducer.h"
 #include "src/ic/ic.h"
@@ -750,6 +751,48 @@ TEST(PromoteGreyOrBlackObjectsOnScavenge) {
   CHECK(!heap->InNewSpace(*marked));
 }
 
+TEST(ParallelScavenge) {
+  FLAG_parallel_scavenge = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+
+  HandleScope scope(isolate);
+  const int kLength = 1024;
+  // Young objects are reachable both from a handle and, through the tenured
+  // array, from the old-to-new remembered set.
+  Handle<FixedArray> young = factory->NewFixedArray(kLength);
+  Handle<FixedArray> old = factory->NewFixedArray(kLength, TENURED);
+  for (int i = 0; i < kLength; i++) {
+    Handle<FixedArray> inner = factory->NewFixedArray(3);
+    inner->set(0, *factory->NewHeapNumber(i));
+    inner->set(1, *factory->NewJSObject(isolate->object_function()));
+    inner->set(2, Smi::FromInt(i));
+    if (i % 2 == 0) {
+      young->set(i, *inner);
+    } else {
+      old->set(i, *inner);
+    }
+  }
+  CHECK(heap->InNewSpace(*young));
+
+  // The first scavenge copies within the young generation, the second one
+  // promotes.
+  heap->CollectGarbage(NEW_SPACE);
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK(!heap->InNewSpace(*young));
+
+  for (int i = 0; i < kLength; i++) {
+    FixedArray* inner =
+        FixedArray::cast(i % 2 == 0 ? young->get(i) : old->get(i));
+    CHECK_EQ(i, static_cast<int>(HeapNumber::cast(inner->get(0))->value()));
+    CHECK(inner->get(1)->IsJSObject());
+    CHECK_EQ(Smi::FromInt(i), inner->get(2));
+  }
+  heap->CollectAllGarbage();
+}
+
 TEST(BytecodeArray) {
   static const uint8_t kRawBytes[] = {0xc3, 0x7e, 0xa5, 0x5a};
   static const int kRawBytesSize = sizeof(kRawBytes);
@@ -1351,6 +1394,147 @@ TEST(TestCodeFlushingPreAged) {
 }
 
 
+static Handle<JSFunction> CompileAndRunFoo(Isolate* isolate) {
+  Factory* factory = isolate->factory();
+  const char* source = "function foo() {"
+                       "  var x = 42;"
+                       "  var y = 42;"
+                       "  var z = x + y;"
+                       "};"
+                       "foo()";
+  Handle<String> foo_name = factory->InternalizeUtf8String("foo");
+
+  // Compile and run foo to get its bytecode generated.
+  { v8::HandleScope scope(CcTest::isolate());
+    CompileRun(source);
+  }
+
+  // Check function is interpreted.
+  Handle<Object> func_value =
+      Object::GetProperty(isolate->global_object(), foo_name).ToHandleChecked();
+  CHECK(func_value->IsJSFunction());
+  Handle<JSFunction> function = Handle<JSFunction>::cast(func_value);
+  CHECK(function->shared()->HasBytecodeArray());
+  return function;
+}
+
+
+TEST(TestBytecodeFlushing) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_ignition = true;
+  i::FLAG_flush_bytecode = true;
+  i::FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+  Handle<JSFunction> function = CompileAndRunFoo(isolate);
+
+  // The bytecode will survive at least two GCs.
+  CcTest::heap()->CollectAllGarbage();
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // Simulate several GCs that use full marking.
+  const int kAgingThreshold = 6;
+  for (int i = 0; i < kAgingThreshold; i++) {
+    CcTest::heap()->CollectAllGarbage();
+  }
+
+  // foo should have dropped its bytecode and the closure is reset.
+  CHECK(!function->shared()->HasBytecodeArray());
+  CHECK(!function->shared()->is_compiled());
+  CHECK(!function->is_compiled());
+
+  // Call foo to get it recompiled.
+  CompileRun("foo()");
+  CHECK(function->shared()->HasBytecodeArray());
+  CHECK(function->is_compiled());
+}
+
+
+TEST(TestBytecodeFlushingReduceMemory) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_ignition = true;
+  i::FLAG_flush_bytecode = true;
+  i::FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+  Handle<JSFunction> function = CompileAndRunFoo(isolate);
+
+  // The bytecode has been run since the last GC and survives a memory
+  // reducing GC.
+  CcTest::heap()->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // Executing the function resets the age of the bytecode.
+  CompileRun("foo()");
+  CcTest::heap()->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // A regular GC does not flush bytecode that was just run.
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // The bytecode was not run since the previous GC, so the next memory
+  // reducing GC flushes it.
+  CcTest::heap()->CollectAllGarbage(Heap::kReduceMemoryFootprintMask);
+  CHECK(!function->shared()->HasBytecodeArray());
+  CHECK(!function->is_compiled());
+
+  CompileRun("foo()");
+  CHECK(function->shared()->HasBytecodeArray());
+}
+
+
+TEST(TestBytecodeFlushingIncremental) {
+  // If we do not flush code this test is invalid.
+  if (!FLAG_flush_code) return;
+  i::FLAG_ignition = true;
+  i::FLAG_flush_bytecode = true;
+  i::FLAG_always_opt = false;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(CcTest::isolate());
+  Handle<JSFunction> function = CompileAndRunFoo(isolate);
+
+  // Age the bytecode until the next marking treats it as a candidate.
+  const int kAgingThreshold = 3;
+  for (int i = 0; i < kAgingThreshold; i++) {
+    CcTest::heap()->CollectAllGarbage();
+  }
+  CHECK(function->shared()->HasBytecodeArray());
+
+  // Calling the function in the middle of marking resets the age of its
+  // bytecode, which has to survive although it was judged old before.
+  heap::SimulateIncrementalMarking(CcTest::heap());
+  CompileRun("foo()");
+  CcTest::heap()->CollectAllGarbage();
+  CHECK(function->shared()->HasBytecodeArray());
+  CHECK(function->is_compiled());
+  CompileRun("foo()");
+
+  // Closures created during marking still enter the interpreter after the
+  // bytecode of their function has been flushed.
+  CompileRun(
+      "function outer() {"
+      "  return function inner() { var x = 42; return x; };"
+      "}"
+      "var bar = outer();"
+      "bar();");
+  for (int i = 0; i < kAgingThreshold; i++) {
+    CcTest::heap()->CollectAllGarbage();
+  }
+  heap::SimulateIncrementalMarking(CcTest::heap());
+  CompileRun("var baz = outer();");
+  CcTest::heap()->CollectAllGarbage();
+  ExpectInt32("baz()", 42);
+  ExpectInt32("bar()", 42);
+}
+
+
 TEST(TestCodeFlushingIncremental) {
   // If we do not flush code this test is invalid.
   if (!FLAG_flush_code) return;
@@ -3243,6 +3427,85 @@ TEST(OptimizedPretenuringNestedDoubleLiterals) {
 }
 
 
+static Handle<AllocationSite> AllocationSiteOfLastElement(const char* array) {
+  // Do not keep the element alive.
+  HandleScope scope(CcTest::i_isolate());
+  i::ScopedVector<char> source(64);
+  i::SNPrintF(source, "%s[%s.length - 1]", array, array);
+  Handle<JSObject> object = Handle<JSObject>::cast(v8::Utils::OpenHandle(
+      *v8::Local<v8::Object>::Cast(CompileRun(source.start()))));
+  AllocationMemento* memento =
+      CcTest::heap()->FindAllocationMemento<Heap::kForRuntime>(*object);
+  CHECK_NOT_NULL(memento);
+  return scope.CloseAndEscape(
+      handle(memento->GetAllocationSite(), CcTest::i_isolate()));
+}
+
+
+TEST(PretenuringLifetimeHistograms) {
+  // The test relies on scavenges happening exactly where it triggers them.
+  i::FLAG_pretenuring_histograms = true;
+  i::FLAG_allocation_site_pretenuring = true;
+  i::FLAG_gc_global = false;
+  i::FLAG_stress_compaction = false;
+  i::FLAG_gc_interval = -1;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  AllocationSiteLifetimes* lifetimes = heap->allocation_site_lifetimes();
+  heap->CollectAllGarbage();
+
+  i::ScopedVector<char> source(1024);
+  i::SNPrintF(source,
+              "var long_lived = [];"
+              "var short_lived = [];"
+              "function f() { return [1.1, 2.2]; }"
+              "function g() { return [3.3, 4.4]; }"
+              "for (var i = 0; i < %d; i++) {"
+              "  long_lived.push(f());"
+              "  short_lived.push(g());"
+              "}",
+              AllocationSite::kPretenureMinimumCreated);
+  CompileRun(source.start());
+  Handle<AllocationSite> long_lived_site =
+      AllocationSiteOfLastElement("long_lived");
+  Handle<AllocationSite> short_lived_site =
+      AllocationSiteOfLastElement("short_lived");
+  CHECK(!long_lived_site.is_identical_to(short_lived_site));
+  CHECK_LT(lifetimes->LongLivedRatio(*long_lived_site), 0);
+
+  // Both arrays survive their first scavenge, but only the elements of one
+  // of them survive the second one.
+  heap->CollectGarbage(NEW_SPACE);
+  CompileRun("short_lived = null;");
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(1.0, lifetimes->LongLivedRatio(*long_lived_site));
+  CHECK_EQ(0.0, lifetimes->LongLivedRatio(*short_lived_site));
+
+  // Objects dying after their first scavenge are not pretenured, even when
+  // all of them survive it.
+  short_lived_site->ResetPretenureDecision();
+  short_lived_site->set_memento_create_count(100);
+  short_lived_site->IncrementMementoFoundCount(100);
+  short_lived_site->DigestPretenuringFeedback(
+      true, lifetimes->LongLivedRatio(*short_lived_site));
+  CHECK_EQ(AllocationSite::kDontTenure, short_lived_site->pretenure_decision());
+
+  // Objects surviving two scavenges are pretenured at a lower survival rate.
+  long_lived_site->ResetPretenureDecision();
+  long_lived_site->set_memento_create_count(100);
+  long_lived_site->IncrementMementoFoundCount(70);
+  long_lived_site->DigestPretenuringFeedback(
+      true, lifetimes->LongLivedRatio(*long_lived_site));
+  CHECK_EQ(AllocationSite::kTenure, long_lived_site->pretenure_decision());
+  long_lived_site->set_deopt_dependent_code(false);
+
+  // Mark-compact drops all histograms.
+  heap->CollectAllGarbage();
+  CHECK_LT(lifetimes->LongLivedRatio(*long_lived_site), 0);
+}
+
+
 // Test regular array literals allocation.
 TEST(OptimizedAllocationArrayLiterals) {
   i::FLAG_allow_natives_syntax = true;
@@ -6309,6 +6572,32 @@ TEST(AllocationThroughput) {
 }
 
 
+TEST(BackgroundSweepingTime) {
+  // Without sweeper tasks only the time logged below is reported.
+  FLAG_concurrent_sweeping = false;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+  GCTracer* tracer = heap->tracer();
+  heap->CollectAllGarbage();
+  tracer->ResetForTesting();
+  tracer->AddBackgroundSweepingTime(OLD_SPACE, 10.0);
+  tracer->AddBackgroundSweepingTime(CODE_SPACE, 2.0);
+  // Scavenges do not report background sweeping time.
+  heap->CollectGarbage(NEW_SPACE);
+  CHECK_EQ(0.0, tracer->background_sweeping_duration(OLD_SPACE));
+  heap->CollectAllGarbage();
+  CHECK_EQ(10.0, tracer->background_sweeping_duration(OLD_SPACE));
+  CHECK_EQ(2.0, tracer->background_sweeping_duration(CODE_SPACE));
+  CHECK_EQ(0.0, tracer->background_sweeping_duration(MAP_SPACE));
+  CHECK_EQ(12.0, tracer->cumulative_background_sweeping_duration());
+  // The durations are only reported with one mark-compact event.
+  heap->CollectAllGarbage();
+  CHECK_EQ(0.0, tracer->background_sweeping_duration(OLD_SPACE));
+  CHECK_EQ(12.0, tracer->cumulative_background_sweeping_duration());
+}
+
+
 TEST(ContextMeasure) {
   CcTest::InitializeVM();
   v8::HandleScope scope(CcTest::isolate());
@@ -6730,5 +7019,54 @@ TEST(Regress618958) {
          !heap->incremental_marking()->IsStopped()));
 }
 
+struct NearHeapLimitState {
+  int invocations;
+  size_t initial_heap_limit;
+};
+
+static size_t DoubleHeapLimit(void* data, size_t current_heap_limit,
+                              size_t initial_heap_limit) {
+  NearHeapLimitState* state = reinterpret_cast<NearHeapLimitState*>(data);
+  state->invocations++;
+  state->initial_heap_limit = initial_heap_limit;
+  return 2 * current_heap_limit;
+}
+
+UNINITIALIZED_TEST(NearHeapLimitCallback) {
+  v8::Isolate::CreateParams create_params;
+  create_params.constraints.set_max_old_space_size(8 * Page::kPageSize / MB);
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+  NearHeapLimitState state = {0, 0};
+  isolate->AddNearHeapLimitCallback(DoubleHeapLimit, &state);
+  isolate->Enter();
+  {
+    i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+    Heap* heap = i_isolate->heap();
+    const intptr_t initial_limit = heap->MaxOldGenerationSize();
+    HandleScope handle_scope(i_isolate);
+    // Retain twice as much memory as the initial limit allows. Without the
+    // callback this would be a fatal out-of-memory error.
+    const int kFixedArrayLength = 4 * KB;
+    const int kArrays = static_cast<int>(
+        2 * initial_limit / FixedArray::SizeFor(kFixedArrayLength) + 1);
+    Handle<FixedArray> arrays =
+        i_isolate->factory()->NewFixedArray(kArrays, TENURED);
+    for (int i = 0; i < kArrays; i++) {
+      Handle<FixedArray> array =
+          i_isolate->factory()->NewFixedArray(kFixedArrayLength, TENURED);
+      arrays->set(i, *array);
+    }
+    CHECK_LT(0, state.invocations);
+    CHECK_EQ(static_cast<size_t>(initial_limit), state.initial_heap_limit);
+    CHECK_LT(initial_limit, heap->MaxOldGenerationSize());
+  }
+  isolate->RemoveNearHeapLimitCallback(DoubleHeapLimit, 0);
+  // Removing a callback that is not registered is ignored.
+  isolate->RemoveNearHeapLimitCallback(DoubleHeapLimit, 0);
+  isolate->Exit();
+  isolate->Dispose();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -190,6 +190,43 @@ HEAP_TEST(MarkCompactCollector) {
 }
 
 
+TEST(ConcurrentMarking) {
+  FLAG_concurrent_marking = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  v8::HandleScope sc(CcTest::isolate());
+
+  // Build a wide object graph so that the marking deque holds enough work for
+  // background marking tasks.
+  const int kOuterLength = 4096;
+  const int kInnerLength = 4;
+  Handle<FixedArray> outer = factory->NewFixedArray(kOuterLength, TENURED);
+  for (int i = 0; i < kOuterLength; i++) {
+    HandleScope scope(isolate);
+    Handle<FixedArray> inner = factory->NewFixedArray(kInnerLength);
+    inner->set(0, *factory->NewHeapNumber(i));
+    inner->set(1, *factory->NewJSObject(isolate->object_function()));
+    inner->set(2, *factory->NewStringFromAsciiChecked("concurrent"));
+    inner->set(3, Smi::FromInt(i));
+    outer->set(i, *inner);
+  }
+
+  heap->CollectAllGarbage();
+  heap->CollectAllGarbage();
+
+  for (int i = 0; i < kOuterLength; i++) {
+    FixedArray* inner = FixedArray::cast(outer->get(i));
+    CHECK_EQ(i, HeapNumber::cast(inner->get(0))->value());
+    CHECK(inner->get(1)->IsJSObject());
+    CHECK(String::cast(inner->get(2))->IsOneByteEqualTo(
+        STATIC_CHAR_VECTOR("concurrent")));
+    CHECK_EQ(Smi::FromInt(i), inner->get(3));
+  }
+}
+
+
 // TODO(1600): compaction of map space is temporary removed from GC.
 #if 0
 static Handle<Map> CreateMap(Isolate* isolate) {
@@ -0,0 +1,110 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Benchmarks for the memory use and iteration speed of SlotSet buckets. The
+// adaptive buckets are compared against the plain bitmap representation,
+// which allocates kBitmapBucketSize bytes for every bucket with a slot.
+
+#include "src/base/platform/elapsed-timer.h"
+#include "src/globals.h"
+#include "src/heap/slot-set.h"
+#include "src/heap/spaces.h"
+#include "test/cctest/cctest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+const int kSlotsPerBucket = 1024;
+const size_t kBitmapBucketSize = kSlotsPerBucket / kBitsPerByte;
+const int kIterations = 100;
+
+// Returns true if the slot at the given offset is part of the pattern.
+typedef bool (*SlotPattern)(int offset);
+
+// A few pointers per page, e.g. old objects holding on to a young one.
+bool SparsePattern(int offset) { return offset % (4 * KB) == 0; }
+
+// A large array of short-lived objects covering half of the page.
+bool ArrayPattern(int offset) { return offset < Page::kPageSize / 2; }
+
+// Every fourth slot, e.g. objects with a single young field.
+bool StridedPattern(int offset) { return offset % (4 * kPointerSize) == 0; }
+
+void BenchmarkPattern(const char* name, SlotPattern pattern,
+                      size_t max_expected_bytes) {
+  SlotSet set;
+  set.SetPageStart(0);
+  int slots = 0;
+  int last_bucket = -1;
+  size_t bitmap_bytes = 0;
+  for (int offset = 0; offset < Page::kPageSize; offset += kPointerSize) {
+    if (!pattern(offset)) continue;
+    set.Insert(offset);
+    slots++;
+    const int bucket = (offset / kPointerSize) / kSlotsPerBucket;
+    if (bucket != last_bucket) {
+      bitmap_bytes += kBitmapBucketSize;
+      last_bucket = bucket;
+    }
+  }
+  const size_t bytes = set.AllocatedBucketMemory();
+  CHECK_LE(bytes, bitmap_bytes);
+  CHECK_LE(bytes, max_expected_bytes);
+
+  base::ElapsedTimer timer;
+  timer.Start();
+  int iterated = 0;
+  for (int i = 0; i < kIterations; i++) {
+    iterated += set.Iterate([](Address slot) { return KEEP_SLOT; });
+  }
+  const double duration = timer.Elapsed().InMillisecondsF();
+  CHECK_EQ(slots * kIterations, iterated);
+  PrintF("%s: slots=%d bytes=%" PRIuS " bitmap_bytes=%" PRIuS
+         " iterate=%.3f ms\n",
+         name, slots, bytes, bitmap_bytes, duration / kIterations);
+}
+
+}  // namespace
+
+TEST(SlotSetBenchmarkSparse) {
+  // Two slots per bucket fit the smallest representation.
+  BenchmarkPattern("sparse", SparsePattern, Page::kPageSize / (4 * KB) * 16);
+}
+
+TEST(SlotSetBenchmarkArray) {
+  // Completely filled buckets do not need any storage.
+  BenchmarkPattern("array", ArrayPattern, 0);
+}
+
+TEST(SlotSetBenchmarkStrided) {
+  BenchmarkPattern("strided", StridedPattern,
+                   Page::kPageSize / kPointerSize / kSlotsPerBucket *
+                       kBitmapBucketSize);
+}
+
+TEST(SlotSetBenchmarkRemoveAndIterate) {
+  // Iteration that removes most slots moves buckets back to the sparse
+  // representation.
+  SlotSet set;
+  set.SetPageStart(0);
+  for (int offset = 0; offset < Page::kPageSize; offset += kPointerSize) {
+    set.Insert(offset);
+  }
+  CHECK_EQ(0u, set.AllocatedBucketMemory());
+  const int kKeepEvery = 512 * kPointerSize;
+  set.Iterate([kKeepEvery](Address slot) {
+    return reinterpret_cast<uintptr_t>(slot) % kKeepEvery == 0 ? KEEP_SLOT
+                                                               : REMOVE_SLOT;
+  });
+  const size_t bitmap_bytes =
+      Page::kPageSize / kPointerSize / kSlotsPerBucket * kBitmapBucketSize;
+  CHECK_LT(set.AllocatedBucketMemory(), bitmap_bytes);
+  PrintF("remove_and_iterate: bytes=%" PRIuS " bitmap_bytes=%" PRIuS "\n",
+         set.AllocatedBucketMemory(), bitmap_bytes);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -348,6 +348,104 @@ TEST(MemoryAllocator) {
 }
 
 
+TEST(MemoryAllocatorReusesDiscardedPages) {
+  FLAG_discard_pooled_pages = true;
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator != nullptr);
+  CHECK(memory_allocator->SetUp(heap->MaxReserved(), heap->MaxExecutableSize(),
+                                0));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+
+  {
+    OldSpace faked_space(heap, OLD_SPACE, NOT_EXECUTABLE);
+    Page* page =
+        memory_allocator->AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+            faked_space.AreaSize(), &faked_space, NOT_EXECUTABLE);
+    CHECK(Page::IsValid(page));
+    CHECK_EQ(Page::kPageSize, memory_allocator->Size());
+    Address address = page->address();
+    memory_allocator->Free<MemoryAllocator::kPooledAndQueue>(page);
+    memory_allocator->unmapper()->FreeQueuedChunks();
+    memory_allocator->unmapper()->WaitUntilCompleted();
+    CHECK_EQ(0, memory_allocator->Size());
+
+    // The pooled page is handed out again, independent of whether its
+    // contents were discarded or it got uncommitted.
+    page = memory_allocator->AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+        faked_space.AreaSize(), &faked_space, NOT_EXECUTABLE);
+    CHECK(Page::IsValid(page));
+    CHECK_EQ(address, page->address());
+    CHECK_EQ(0, page->LiveBytes());
+    // Reused pages are accounted for exactly once.
+    CHECK_EQ(Page::kPageSize, memory_allocator->Size());
+    memory_allocator->Free<MemoryAllocator::kPooledAndQueue>(page);
+    memory_allocator->unmapper()->FreeQueuedChunks();
+    memory_allocator->unmapper()->WaitUntilCompleted();
+    CHECK_EQ(0, memory_allocator->Size());
+  }
+  memory_allocator->TearDown();
+  delete memory_allocator;
+}
+
+
+TEST(MemoryAllocatorPreAllocatesPages) {
+  // The pool is only filled by the background task.
+  if (!FLAG_concurrent_sweeping) return;
+  FLAG_page_pool_size = 2;
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator != nullptr);
+  CHECK(memory_allocator->SetUp(heap->MaxReserved(), heap->MaxExecutableSize(),
+                                0));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+  memory_allocator->unmapper()->FreeQueuedChunks();
+  memory_allocator->unmapper()->WaitUntilCompleted();
+  // Pre-allocated pages count against the capacity while they are pooled.
+  CHECK_EQ(2 * Page::kPageSize, memory_allocator->Size());
+
+  {
+    OldSpace faked_space(heap, OLD_SPACE, NOT_EXECUTABLE);
+    Page* page =
+        memory_allocator->AllocatePage<MemoryAllocator::kPooled, PagedSpace>(
+            faked_space.AreaSize(), &faked_space, NOT_EXECUTABLE);
+    CHECK(Page::IsValid(page));
+    // Handing out a pre-allocated page does not account for it again.
+    CHECK_EQ(2 * Page::kPageSize, memory_allocator->Size());
+    memory_allocator->Free<MemoryAllocator::kPooledAndQueue>(page);
+    memory_allocator->unmapper()->FreeQueuedChunks();
+    memory_allocator->unmapper()->WaitUntilCompleted();
+    CHECK_EQ(2 * Page::kPageSize, memory_allocator->Size());
+  }
+  memory_allocator->TearDown();
+  delete memory_allocator;
+  FLAG_page_pool_size = 0;
+}
+
+TEST(MemoryAllocatorBoundsPreAllocatedPages) {
+  if (!FLAG_concurrent_sweeping) return;
+  FLAG_page_pool_size = 4;
+  Isolate* isolate = CcTest::i_isolate();
+
+  MemoryAllocator* memory_allocator = new MemoryAllocator(isolate);
+  CHECK(memory_allocator != nullptr);
+  CHECK(memory_allocator->SetUp(Page::kPageSize, 0, 0));
+  TestMemoryAllocatorScope test_scope(isolate, memory_allocator);
+  memory_allocator->unmapper()->FreeQueuedChunks();
+  memory_allocator->unmapper()->WaitUntilCompleted();
+  // The pool never grows beyond the remaining capacity.
+  CHECK_EQ(Page::kPageSize, memory_allocator->Size());
+  CHECK_EQ(0, memory_allocator->Available());
+  memory_allocator->TearDown();
+  delete memory_allocator;
+  FLAG_page_pool_size = 0;
+}
+
+
 TEST(NewSpace) {
   Isolate* isolate = CcTest::i_isolate();
   Heap* heap = isolate->heap();
@@ -358,6 +358,60 @@ TEST(InterpreterBinaryOpsHeapNumber) {
 }
 
 
+TEST(InterpreterSuperinstructions) {
+  bool old_flag = FLAG_ignition_superinstructions;
+  FLAG_ignition_superinstructions = true;
+
+  static const Token::Value kOperators[] = {
+      Token::Value::ADD, Token::Value::SUB, Token::Value::LT};
+  static const Bytecode kSuperinstructions[] = {
+      Bytecode::kLdarAdd, Bytecode::kLdarSub, Bytecode::kLdarTestLessThan};
+  double inputs[] = {3266, 1.5, 0, -17, -18000.25};
+  for (size_t o = 0; o < arraysize(kOperators); o++) {
+    HandleAndZoneScope handles;
+    i::Factory* factory = handles.main_isolate()->factory();
+    BytecodeArrayBuilder builder(handles.main_isolate(), handles.main_zone(), 2,
+                                 0, 0);
+    builder.LoadAccumulatorWithRegister(builder.Parameter(1));
+    if (Token::IsCompareOp(kOperators[o])) {
+      builder.CompareOperation(kOperators[o], builder.Parameter(0));
+    } else {
+      builder.BinaryOperation(kOperators[o], builder.Parameter(0));
+    }
+    builder.Return();
+    Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+
+    bool found_superinstruction = false;
+    for (BytecodeArrayIterator iterator(bytecode_array); !iterator.done();
+         iterator.Advance()) {
+      if (iterator.current_bytecode() == kSuperinstructions[o]) {
+        found_superinstruction = true;
+      }
+    }
+    CHECK(found_superinstruction);
+
+    InterpreterTester tester(handles.main_isolate(), bytecode_array);
+    auto callable = tester.GetCallable<Handle<Object>, Handle<Object>>();
+    for (size_t l = 0; l < arraysize(inputs); l++) {
+      for (size_t r = 0; r < arraysize(inputs); r++) {
+        double lhs = inputs[l];
+        double rhs = inputs[r];
+        Handle<Object> return_value =
+            callable(factory->NewNumber(lhs), factory->NewNumber(rhs))
+                .ToHandleChecked();
+        Handle<Object> expected_value =
+            Token::IsCompareOp(kOperators[o])
+                ? factory->ToBoolean(lhs < rhs)
+                : factory->NewNumber(BinaryOpC(kOperators[o], lhs, rhs));
+        CHECK(return_value->SameValue(*expected_value));
+      }
+    }
+  }
+
+  FLAG_ignition_superinstructions = old_flag;
+}
+
+
 TEST(InterpreterStringAdd) {
   HandleAndZoneScope handles;
   i::Factory* factory = handles.main_isolate()->factory();
@@ -2240,6 +2294,70 @@ TEST(InterpreterCompoundExpressions) {
 }
 
 
+TEST(InterpreterInlinedFieldAccess) {
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+
+  // Each snippet repeats its accesses so that the feedback is in place when
+  // the field access handlers are inlined into the bytecode handlers.
+  std::pair<const char*, Handle<Object>> field_accesses[] = {
+      // Monomorphic in-object fields.
+      std::make_pair("var s = 0;\n"
+                     "for (var i = 0; i < 10; i++) {\n"
+                     "  var o = { a: i, b: 2 };\n"
+                     "  o.a = o.a + o.b;\n"
+                     "  s += o.a;\n"
+                     "}\n"
+                     "return s;",
+                     Handle<Object>(Smi::FromInt(65), isolate)),
+      // Polymorphic fields at different offsets.
+      std::make_pair("var os = [{ x: 1 }, { y: 0, x: 2 },\n"
+                     "          { z: 0, y: 0, x: 3 }];\n"
+                     "var s = 0;\n"
+                     "for (var i = 0; i < 12; i++) {\n"
+                     "  var o = os[i % 3];\n"
+                     "  o.x = o.x + 1;\n"
+                     "  s += o.x;\n"
+                     "}\n"
+                     "return s;",
+                     Handle<Object>(Smi::FromInt(54), isolate)),
+      // Out-of-object fields.
+      std::make_pair("var o = {};\n"
+                     "o.a = 1; o.b = 2; o.c = 3; o.d = 4; o.e = 5; o.f = 6;\n"
+                     "for (var i = 0; i < 10; i++) o.f = o.f + o.e;\n"
+                     "return o.f;",
+                     Handle<Object>(Smi::FromInt(56), isolate)),
+      // Double fields are left to the handlers.
+      std::make_pair("var o = { d: 0.5 };\n"
+                     "for (var i = 0; i < 10; i++) o.d = o.d + 1;\n"
+                     "return o.d;",
+                     isolate->factory()->NewNumber(10.5)),
+      // A store that does not fit the field representation generalizes it.
+      std::make_pair("var o = { a: 1 };\n"
+                     "for (var i = 0; i < 10; i++) o.a = i;\n"
+                     "o.a = 'str';\n"
+                     "for (var i = 0; i < 10; i++) o.a = o.a;\n"
+                     "return o.a;",
+                     isolate->factory()->NewStringFromStaticChars("str")),
+      // String length is loaded through a field access handler as well.
+      std::make_pair("var s = 0;\n"
+                     "for (var i = 0; i < 10; i++) s += 'abc'.length;\n"
+                     "return s;",
+                     Handle<Object>(Smi::FromInt(30), isolate)),
+  };
+
+  for (size_t i = 0; i < arraysize(field_accesses); i++) {
+    std::string source(
+        InterpreterTester::SourceForBody(field_accesses[i].first));
+    InterpreterTester tester(isolate, source.c_str());
+    auto callable = tester.GetCallable<>();
+
+    Handle<i::Object> return_value = callable().ToHandleChecked();
+    CHECK(return_value->SameValue(*field_accesses[i].second));
+  }
+}
+
+
 TEST(InterpreterGlobalCompoundExpressions) {
   HandleAndZoneScope handles;
   i::Isolate* isolate = handles.main_isolate();
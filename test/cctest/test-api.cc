@@ -17922,6 +17922,36 @@ TEST(TestIdleNotification) {
 }
 
 
+// Test that idle time with a latency budget is used to collect garbage and
+// that the used time is reported.
+TEST(TestIdleTimeGarbageCollection) {
+  if (!i::FLAG_incremental_marking) return;
+  const int64_t kIdleTimeInMicroseconds = 1000000;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  intptr_t initial_size = CcTest::heap()->SizeOfObjects();
+  CreateGarbageInOldSpace();
+  CHECK_GT(CcTest::heap()->SizeOfObjects(), initial_size);
+  CcTest::heap()->StartIdleIncrementalMarking();
+  int mark_compacts = 0;
+  bool done = false;
+  for (int i = 0; i < 200 && !done; i++) {
+    v8::IdleTimeGCResult result;
+    env->GetIsolate()->IdleTimeGarbageCollection(
+        kIdleTimeInMicroseconds, kIdleTimeInMicroseconds, &result);
+    CHECK_LE(0, result.used_time_in_microseconds());
+    mark_compacts += result.mark_compacts();
+    done = result.done();
+    if (CcTest::heap()->mark_compact_collector()->sweeping_in_progress()) {
+      CcTest::heap()->mark_compact_collector()->EnsureSweepingCompleted();
+    }
+  }
+  CHECK(done);
+  CHECK_LT(0, mark_compacts);
+  CHECK_LT(CcTest::heap()->SizeOfObjects(), initial_size + 1);
+}
+
+
 TEST(Regress2333) {
   LocalContext env;
   for (int i = 0; i < 3; i++) {
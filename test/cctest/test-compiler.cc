@@ -28,11 +28,14 @@
 #include <stdlib.h>
 #include <wchar.h>
 
+#include <vector>
+
 #include "src/v8.h"
 
 #include "src/compiler.h"
 #include "src/disasm.h"
 #include "src/interpreter/interpreter.h"
+#include "src/optimizing-compile-dispatcher.h"
 #include "src/parsing/parser.h"
 #include "test/cctest/cctest.h"
 
@@ -800,3 +803,89 @@ TEST(IgnitionBaselineOnReturn) {
   CHECK_EQ(true, GetGlobalProperty("is_baseline_after_return")->BooleanValue());
   CHECK_EQ(1234.0, GetGlobalProperty("return_val")->Number());
 }
+
+
+// Marks a new function f<index> for concurrent optimization with the given
+// profiler {ticks} as its priority and calls it, which queues the job.
+static Handle<JSFunction> OptimizeConcurrently(int index, int ticks) {
+  EmbeddedVector<char, 256> buffer;
+  SNPrintF(buffer,
+           "function f%d(x) { return x + %d; }"
+           "f%d(1); f%d(2);"
+           "%%OptimizeFunctionOnNextCall(f%d, 'concurrent');",
+           index, index, index, index, index);
+  CompileRun(buffer.start());
+  SNPrintF(buffer, "f%d", index);
+  Handle<JSFunction> function =
+      Handle<JSFunction>::cast(GetGlobalProperty(buffer.start()));
+  function->shared()->set_profiler_ticks(ticks);
+  SNPrintF(buffer, "f%d(3);", index);
+  CompileRun(buffer.start());
+  return function;
+}
+
+TEST(ConcurrentRecompilationQueuePriorities) {
+  FLAG_allow_natives_syntax = true;
+  FLAG_always_opt = false;
+  FLAG_block_concurrent_recompilation = true;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  if (!isolate->concurrent_recompilation_enabled()) return;
+  v8::HandleScope scope(CcTest::isolate());
+  OptimizingCompileDispatcher* dispatcher =
+      isolate->optimizing_compile_dispatcher();
+
+  // Fill the queue with jobs for increasingly hot functions.
+  const int kCapacity = FLAG_concurrent_recompilation_queue_length;
+  std::vector<Handle<JSFunction>> queued;
+  for (int i = 0; i < kCapacity; i++) {
+    queued.push_back(OptimizeConcurrently(i, 10 + i));
+    CHECK(queued.back()->IsInOptimizationQueue());
+  }
+
+  // A function that is colder than all queued ones has to wait.
+  Handle<JSFunction> cold = OptimizeConcurrently(kCapacity, 1);
+  CHECK(!cold->IsInOptimizationQueue());
+  for (Handle<JSFunction> function : queued) {
+    CHECK(function->IsInOptimizationQueue());
+  }
+
+  // A hotter function evicts the coldest queued job, which restores the
+  // unoptimized code of its function.
+  Handle<JSFunction> hot = OptimizeConcurrently(kCapacity + 1, 100);
+  CHECK(hot->IsInOptimizationQueue());
+  CHECK(!queued[0]->IsInOptimizationQueue());
+  CHECK_EQ(queued[0]->shared()->code(), queued[0]->code());
+  for (int i = 1; i < kCapacity; i++) {
+    CHECK(queued[i]->IsInOptimizationQueue());
+  }
+
+  // Raising the priority of a queued job protects it from eviction, the next
+  // coldest job is evicted instead.
+  dispatcher->UpdatePriority(*queued[1], 200);
+  Handle<JSFunction> hotter = OptimizeConcurrently(kCapacity + 2, 101);
+  CHECK(hotter->IsInOptimizationQueue());
+  CHECK(queued[1]->IsInOptimizationQueue());
+  CHECK(!queued[2]->IsInOptimizationQueue());
+
+  // Jobs held back by --block-concurrent-recompilation are never evicted for
+  // having waited too long.
+  FLAG_concurrent_recompilation_max_queue_time = 1;
+  dispatcher->AgeQueuedJobsForTesting(v8::base::TimeDelta::FromSeconds(1));
+  dispatcher->InstallOptimizedFunctions();
+  CHECK(hot->IsInOptimizationQueue());
+  CHECK(hotter->IsInOptimizationQueue());
+  CHECK(queued[1]->IsInOptimizationQueue());
+  FLAG_concurrent_recompilation_max_queue_time = 0;
+
+  // Once unblocked, all remaining jobs are compiled and installed.
+  dispatcher->Unblock();
+  queued.push_back(hot);
+  queued.push_back(hotter);
+  for (Handle<JSFunction> function : queued) {
+    while (function->IsInOptimizationQueue()) {
+      dispatcher->InstallOptimizedFunctions();
+      v8::base::OS::Sleep(v8::base::TimeDelta::FromMilliseconds(10));
+    }
+  }
+}
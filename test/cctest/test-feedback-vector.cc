@@ -216,11 +216,11 @@ TEST(VectorCallICStates) {
   CHECK(!nexus.FindFirstMap());
 
   CompileRun("f(function() { return 16; })");
-  CHECK_EQ(GENERIC, nexus.StateFromFeedback());
+  CHECK_EQ(POLYMORPHIC, nexus.StateFromFeedback());
 
-  // After a collection, state should remain GENERIC.
+  // After a collection, state should remain POLYMORPHIC.
   heap->CollectAllGarbage();
-  CHECK_EQ(GENERIC, nexus.StateFromFeedback());
+  CHECK_EQ(POLYMORPHIC, nexus.StateFromFeedback());
 
   // A call to Array is special, it contains an AllocationSite as feedback.
   // Clear the IC manually in order to test this case.
@@ -233,6 +233,56 @@ TEST(VectorCallICStates) {
   CHECK_EQ(MONOMORPHIC, nexus.StateFromFeedback());
 }
 
+TEST(VectorCallICPolymorphic) {
+  if (i::FLAG_always_opt) return;
+  CcTest::InitializeVM();
+  LocalContext context;
+  v8::HandleScope scope(context->GetIsolate());
+  Isolate* isolate = CcTest::i_isolate();
+
+  // Make sure function f has a call that uses a type feedback slot.
+  CompileRun(
+      "function foo() { return 17; }"
+      "function bar() { return 16; }"
+      "function f(a) { a(); } f(foo); f(foo); f(bar);");
+  Handle<JSFunction> f = GetFunction("f");
+  // There should be one IC.
+  Handle<TypeFeedbackVector> feedback_vector =
+      Handle<TypeFeedbackVector>(f->feedback_vector(), isolate);
+  FeedbackVectorSlot slot(0);
+  CallICNexus nexus(feedback_vector, slot);
+  CHECK_EQ(POLYMORPHIC, nexus.StateFromFeedback());
+
+  const int kLength = CallICNexus::kMaxCallTargets;
+  Handle<JSFunction> targets[kLength];
+  int counts[kLength];
+  CHECK_EQ(2, nexus.ExtractCallTargets(targets, counts, kLength));
+  CHECK(targets[0].is_identical_to(GetFunction("foo")));
+  CHECK_EQ(2, counts[0]);
+  CHECK(targets[1].is_identical_to(GetFunction("bar")));
+  CHECK_EQ(1, counts[1]);
+  CHECK_EQ(3, nexus.ExtractCallCount());
+
+  // Once enough calls are sampled, the CallIC goes GENERIC, but keeps the
+  // targets that it has seen.
+  CompileRun("for (var i = 0; i < 100; i++) f(bar);");
+  CHECK_EQ(GENERIC, nexus.StateFromFeedback());
+  CHECK_EQ(2, nexus.ExtractCallTargets(targets, counts, kLength));
+  CHECK_EQ(2, counts[0]);
+  CHECK_EQ(CallICNexus::kPolymorphicCallSamples, counts[1]);
+
+  // Too many targets make the CallIC GENERIC without any targets.
+  CompileRun(
+      "function g(a) { a(); }"
+      "for (var i = 0; i < 5; i++) g(function() {});");
+  Handle<JSFunction> g = GetFunction("g");
+  feedback_vector = Handle<TypeFeedbackVector>(g->feedback_vector(), isolate);
+  CallICNexus g_nexus(feedback_vector, slot);
+  CHECK_EQ(GENERIC, g_nexus.StateFromFeedback());
+  CHECK_EQ(0, g_nexus.ExtractCallTargets(targets, counts, kLength));
+}
+
+
 TEST(VectorCallCounts) {
   if (i::FLAG_always_opt) return;
   CcTest::InitializeVM();
@@ -1809,6 +1809,85 @@ TEST(CodeSerializerEagerCompilationAndPreAge) {
   isolate2->Dispose();
 }
 
+TEST(CodeSerializerOptimizationHints) {
+  if (FLAG_ignition || !FLAG_crankshaft) return;
+
+  FLAG_allow_natives_syntax = true;
+  FLAG_serialize_toplevel = true;
+  FLAG_serialize_optimization_hints = true;
+
+  static const char* source =
+      "function f(x) { return x + 1; }"
+      "function g(x) { return x - 1; }"
+      "f(1); f(2); %OptimizeFunctionOnNextCall(f); f(3); g(1);"
+      "'abcdef';";
+
+  v8::ScriptCompiler::CachedData* cache;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    // Run the script first, then produce the cache from the warm copy in the
+    // compilation cache.
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source warm_source(v8_str(source), origin);
+    v8::ScriptCompiler::CompileUnboundScript(isolate1, &warm_source)
+        .ToLocalChecked()
+        ->BindToCurrentContext()
+        ->Run(context)
+        .ToLocalChecked();
+
+    v8::ScriptCompiler::Source cold_source(v8_str(source), origin);
+    v8::ScriptCompiler::CompileUnboundScript(
+        isolate1, &cold_source, v8::ScriptCompiler::kProduceCodeCache)
+        .ToLocalChecked();
+    const v8::ScriptCompiler::CachedData* data = cold_source.GetCachedData();
+    CHECK(data);
+    uint8_t* buffer = NewArray<uint8_t>(data->length);
+    MemCopy(buffer, data->data, data->length);
+    cache = new v8::ScriptCompiler::CachedData(
+        buffer, data->length, v8::ScriptCompiler::CachedData::BufferOwned);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source_with_cache(v8_str(source), origin,
+                                                 cache);
+    v8::Local<v8::UnboundScript> unbound =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source_with_cache, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+
+    Isolate* i_isolate = reinterpret_cast<Isolate*>(isolate2);
+    HandleScope i_scope(i_isolate);
+    Handle<SharedFunctionInfo> toplevel = v8::Utils::OpenHandle(*unbound);
+    Handle<Script> script(Script::cast(toplevel->script()));
+    WeakFixedArray::Iterator iterator(script->shared_function_infos());
+    // Only the function that was optimized before carries the hint.
+    int count = 0;
+    while (SharedFunctionInfo* shared = iterator.Next<SharedFunctionInfo>()) {
+      if (!shared->optimization_hint()) continue;
+      CHECK(String::cast(shared->name())->IsUtf8EqualTo(CStrVector("f")));
+      count++;
+    }
+    CHECK_EQ(1, count);
+  }
+  isolate2->Dispose();
+}
+
 TEST(Regress503552) {
   // Test that the code serializer can deal with weak cells that form a linked
   // list during incremental marking.
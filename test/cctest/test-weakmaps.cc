@@ -256,3 +256,41 @@ TEST(Regress399527) {
   // marking bits which makes the weak map garbage.
   heap->CollectAllGarbage();
 }
+
+
+TEST(ParallelClearing) {
+  FLAG_incremental_marking = false;
+  FLAG_parallel_weak_clearing = true;
+  LocalContext context;
+  Isolate* isolate = GetIsolateFrom(&context);
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  // Enough weak maps to be split up into several tasks.
+  const int kNumberOfWeakMaps = 64;
+  Handle<FixedArray> weakmaps = factory->NewFixedArray(kNumberOfWeakMaps);
+  Handle<Object> live_key = factory->NewJSObjectFromMap(
+      factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize));
+  int32_t live_hash = Object::GetOrCreateHash(isolate, live_key)->value();
+  for (int i = 0; i < kNumberOfWeakMaps; i++) {
+    HandleScope scope(isolate);
+    Handle<JSWeakMap> weakmap = AllocateJSWeakMap(isolate);
+    Handle<Map> map = factory->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+    Handle<JSObject> dead_key = factory->NewJSObjectFromMap(map);
+    Handle<Smi> smi(Smi::FromInt(i), isolate);
+    int32_t dead_hash = Object::GetOrCreateHash(isolate, dead_key)->value();
+    JSWeakCollection::Set(weakmap, dead_key, smi, dead_hash);
+    JSWeakCollection::Set(weakmap, live_key, smi, live_hash);
+    weakmaps->set(i, *weakmap);
+  }
+
+  heap->CollectAllGarbage(false);
+  for (int i = 0; i < kNumberOfWeakMaps; i++) {
+    ObjectHashTable* table =
+        ObjectHashTable::cast(JSWeakMap::cast(weakmaps->get(i))->table());
+    CHECK_EQ(1, table->NumberOfElements());
+    CHECK_EQ(1, table->NumberOfDeletedElements());
+    CHECK_EQ(Smi::FromInt(i), table->Lookup(live_key));
+  }
+}
@@ -0,0 +1,75 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('Temporary-Objects', [1000], [
+  new Benchmark('Temporary-Objects', false, false, 0,
+                TemporaryObjects, AllocationSetup, AllocationTearDown)
+]);
+
+new BenchmarkSuite('Temporary-Arrays', [1000], [
+  new Benchmark('Temporary-Arrays', false, false, 0,
+                TemporaryArrays, AllocationSetup, AllocationTearDown)
+]);
+
+new BenchmarkSuite('Arguments-Object', [1000], [
+  new Benchmark('Arguments-Object', false, false, 0,
+                ArgumentsObject, AllocationSetup, AllocationTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+var kIterations = 1000;
+var result;
+
+function AllocationSetup() {
+  result = 0;
+}
+
+function Point(x, y) {
+  this.x = x;
+  this.y = y;
+}
+
+function add(a, b) {
+  return new Point(a.x + b.x, a.y + b.y);
+}
+
+// Every iteration allocates two points that never leave the loop body.
+function TemporaryObjects() {
+  var sum = 0;
+  for (var i = 0; i < kIterations; i++) {
+    var p = add(new Point(i, 1), new Point(1, i));
+    sum += p.x - p.y;
+  }
+  result = sum;
+}
+
+function swap(pair) {
+  return [pair[1], pair[0]];
+}
+
+function TemporaryArrays() {
+  var sum = 0;
+  for (var i = 0; i < kIterations; i++) {
+    var pair = swap([i, 1]);
+    sum += pair[1] - pair[0];
+  }
+  result = sum;
+}
+
+function first() {
+  return arguments[0];
+}
+
+function ArgumentsObject() {
+  var sum = 0;
+  for (var i = 0; i < kIterations; i++) {
+    sum += first(i, 1, 2) - i;
+  }
+  result = sum;
+}
+
+function AllocationTearDown() {
+  return result === 0 || result === 498500;
+}
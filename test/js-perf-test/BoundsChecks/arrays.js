@@ -0,0 +1,47 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('Array-Sum', [1000], [
+  new Benchmark('Array-Sum', false, false, 0,
+                ArraySum, ArraySetup, ArrayTearDown)
+]);
+
+new BenchmarkSuite('Array-Scale', [1000], [
+  new Benchmark('Array-Scale', false, false, 0,
+                ArrayScale, ArraySetup, ArrayTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+var array;
+var result;
+
+function ArraySetup() {
+  array = [];
+  for (var i = 0; i < 1000; i++) array.push(i);
+}
+
+function ArraySum() {
+  var a = array;
+  var sum = 0;
+  for (var i = 0; i < a.length; i++) {
+    sum += a[i];
+  }
+  result = sum;
+}
+
+function ArrayScale() {
+  var a = array;
+  for (var i = 0; i < a.length; i++) {
+    a[i] = a[i] * 2;
+  }
+  for (var i = 0; i < a.length; i++) {
+    a[i] = a[i] / 2;
+  }
+  result = a[a.length - 1];
+}
+
+function ArrayTearDown() {
+  return result === 499500 || result === 999;
+}
@@ -0,0 +1,44 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('TypedArray-Sum', [1000], [
+  new Benchmark('TypedArray-Sum', false, false, 0,
+                TypedArraySum, TypedArraySetup, TypedArrayTearDown)
+]);
+
+new BenchmarkSuite('TypedArray-Stencil', [1000], [
+  new Benchmark('TypedArray-Stencil', false, false, 0,
+                TypedArrayStencil, TypedArraySetup, TypedArrayTearDown)
+]);
+
+// ----------------------------------------------------------------------------
+
+var kSize = 1024;
+var src = new Float64Array(kSize);
+var dst = new Float64Array(kSize);
+var result;
+
+function TypedArraySetup() {
+  for (var i = 0; i < kSize; i++) src[i] = i;
+}
+
+function TypedArraySum() {
+  var sum = 0;
+  for (var i = 0; i < kSize; i++) {
+    sum += src[i];
+  }
+  result = sum;
+}
+
+// One relaxation step of the diffusion solver in navier-stokes.js.
+function TypedArrayStencil() {
+  for (var i = 1; i < kSize - 1; i++) {
+    dst[i] = (src[i - 1] + src[i] + src[i + 1]) / 3;
+  }
+  result = dst[kSize - 2];
+}
+
+function TypedArrayTearDown() {
+  return result === 523776 || result === kSize - 2;
+}
@@ -0,0 +1,77 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-escape
+
+// Nested virtual objects are materialized with all of their fields.
+(function testNested() {
+  function f(deopt) {
+    var inner = { a: 1.5, b: "b" };
+    var outer = { x: inner, y: 2 };
+    if (deopt) %DeoptimizeNow();
+    return outer.x.a + outer.y;
+  }
+  assertEquals(3.5, f(false));
+  assertEquals(3.5, f(false));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3.5, f(false));
+  assertEquals(3.5, f(true));
+})();
+
+// Objects whose fields are only known on some paths are not virtualized
+// across a deoptimization point.
+(function testPartial() {
+  function f(c, deopt) {
+    var o = { a: 1, b: 2 };
+    if (c) o.a = 3;
+    if (deopt) %DeoptimizeNow();
+    return o.a + o.b;
+  }
+  assertEquals(5, f(true, false));
+  assertEquals(3, f(false, false));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(5, f(true, false));
+  assertEquals(3, f(false, true));
+})();
+
+// Identity of a virtual object is preserved.
+(function testIdentity() {
+  function f() {
+    var o = { a: 1 };
+    var p = o;
+    return o === p;
+  }
+  assertTrue(f());
+  assertTrue(f());
+  %OptimizeFunctionOnNextCall(f);
+  assertTrue(f());
+})();
+
+// Objects that are updated in a loop stay virtual.
+(function testLoop() {
+  function f(n, deopt) {
+    var o = { sum: 0 };
+    for (var i = 0; i < n; i++) {
+      o.sum += i;
+      if (deopt && i == 5) %DeoptimizeNow();
+    }
+    return o.sum;
+  }
+  assertEquals(45, f(10, false));
+  assertEquals(45, f(10, false));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(45, f(10, false));
+  assertEquals(45, f(10, true));
+})();
+
+// Constant index accesses to inlined arguments objects.
+(function testArguments() {
+  function g() { return arguments[0] + arguments[1]; }
+  function f(a, b) { return g(a, b); }
+  assertEquals(3, f(1, 2));
+  assertEquals(3, f(1, 2));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(3, f(1, 2));
+  assertEquals("ab", f("a", "b"));
+})();
@@ -0,0 +1,31 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-polymorphic-inlining
+
+function add(a, b) { return a + b; }
+function sub(a, b) { return a - b; }
+function mul(a, b) { return a * b; }
+function div(a, b) { return a / b; }
+
+function apply(f, a, b) { return f(a, b); }
+
+for (var i = 0; i < 64; i++) {
+  assertEquals(9, apply(add, 4, 5));
+  assertEquals(-1, apply(sub, 4, 5));
+  assertEquals(20, apply(mul, 4, 5));
+}
+%OptimizeFunctionOnNextCall(apply);
+assertEquals(9, apply(add, 4, 5));
+assertEquals(-1, apply(sub, 4, 5));
+assertEquals(20, apply(mul, 4, 5));
+
+// Targets that were not recorded go through the generic call.
+assertEquals(0.8, apply(div, 4, 5));
+assertEquals(7, apply(function(a, b) { return a + b - 2; }, 4, 5));
+assertEquals(9, apply(add, 4, 5));
+
+// Exceptions thrown by the inlined targets propagate as usual.
+function thrower() { throw new Error("boom"); }
+assertThrows(function() { apply(thrower, 4, 5); });
@@ -0,0 +1,106 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-licm
+
+// Field loads and map checks must not be hoisted out of loops that change
+// the field or the map.
+
+(function FieldStoredInLoop() {
+  function f(o, n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+      sum += o.x;
+      o.x = i;
+    }
+    return sum;
+  }
+
+  assertEquals(10, f({x: 10}, 1));
+  assertEquals(10, f({x: 10}, 1));
+  %OptimizeFunctionOnNextCall(f);
+  // 10 + 0 + 1 + ... + 8
+  assertEquals(46, f({x: 10}, 10));
+})();
+
+
+(function MapChangedInLoop() {
+  function f(o, n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+      sum += o.x;
+      if (i == 5) o.y = 1;
+    }
+    return sum;
+  }
+
+  assertEquals(3, f({x: 1}, 3));
+  assertEquals(3, f({x: 1}, 3));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(10, f({x: 1}, 10));
+  // Changing the representation of the field changes the map as well.
+  var o = {x: 1};
+  function g(o, n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+      sum += o.x;
+      if (i == 2) o.x = 0.5;
+    }
+    return sum;
+  }
+  assertEquals(2, g({x: 1}, 2));
+  assertEquals(2, g({x: 1}, 2));
+  %OptimizeFunctionOnNextCall(g);
+  assertEquals(4.5, g(o, 6));
+})();
+
+
+(function FieldChangedByCall() {
+  var counter = {x: 0};
+  function bump() {
+    counter.x++;
+  }
+  %NeverOptimizeFunction(bump);
+
+  function f(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+      sum += counter.x;
+      bump();
+    }
+    return sum;
+  }
+
+  assertEquals(0, f(1));
+  counter.x = 0;
+  assertEquals(0, f(1));
+  counter.x = 0;
+  %OptimizeFunctionOnNextCall(f);
+  // 0 + 1 + ... + 9
+  assertEquals(45, f(10));
+})();
+
+
+(function MapChangedByCall() {
+  var o = {x: 1};
+  function transition(i) {
+    if (i == 3) o.y = 2;
+  }
+  %NeverOptimizeFunction(transition);
+
+  function f(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+      sum += o.x;
+      transition(i);
+    }
+    return sum;
+  }
+
+  assertEquals(2, f(2));
+  assertEquals(2, f(2));
+  %OptimizeFunctionOnNextCall(f);
+  assertEquals(6, f(6));
+  assertEquals(2, o.y);
+})();
@@ -0,0 +1,51 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-loop-variable
+
+// Loop bounds that depend on the induction variable itself or on values
+// updated in the loop must not keep the typer from terminating.
+
+function selfReferentialBound() {
+  var count = 0;
+  for (var i = 0; i < i + 10; i++) {
+    if (++count > 100) break;
+  }
+  return i;
+}
+
+assertEquals(100, selfReferentialBound());
+assertEquals(100, selfReferentialBound());
+%OptimizeFunctionOnNextCall(selfReferentialBound);
+assertEquals(100, selfReferentialBound());
+
+function boundUpdatedInLoop(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) {
+    if (i < 50) n++;
+    sum += i;
+  }
+  return sum;
+}
+
+assertEquals(2415, boundUpdatedInLoop(20));
+assertEquals(2415, boundUpdatedInLoop(20));
+%OptimizeFunctionOnNextCall(boundUpdatedInLoop);
+assertEquals(2415, boundUpdatedInLoop(20));
+assertEquals(4950, boundUpdatedInLoop(50));
+
+function boundDependsOnOtherPhi(a) {
+  var j = 1;
+  for (var i = 0; i < j * 2; i++) {
+    j = (j + a[i & 3]) | 0;
+    if (j > 1000) break;
+  }
+  return i;
+}
+
+var values = [1, 2, 3, 4];
+var expected = boundDependsOnOtherPhi(values);
+assertEquals(expected, boundDependsOnOtherPhi(values));
+%OptimizeFunctionOnNextCall(boundDependsOnOtherPhi);
+assertEquals(expected, boundDependsOnOtherPhi(values));
@@ -0,0 +1,180 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo --turbo-loop-vectorization
+
+// Vectorized loops over typed arrays have to compute exactly what the scalar
+// loops compute.
+
+var kLength = 16;
+
+function fill(array, seed) {
+  for (var i = 0; i < array.length; i++) {
+    array[i] = (i + seed) / 3;
+  }
+}
+
+function assertArrayEquals(expected, actual) {
+  assertEquals(expected.length, actual.length);
+  for (var i = 0; i < expected.length; i++) {
+    assertEquals(expected[i], actual[i], "index " + i);
+  }
+}
+
+
+// Trip counts that are not a multiple of the vector width leave elements for
+// the scalar epilogue.
+(function TripCounts() {
+  var a = new Float64Array(kLength);
+  var b = new Float64Array(kLength);
+  var c = new Float64Array(kLength);
+  fill(b, 1);
+  fill(c, 2);
+
+  function add(from, to) {
+    for (var i = from; i < to; i++) {
+      a[i] = b[i] + c[i];
+    }
+  }
+
+  add(0, kLength);
+  add(0, kLength);
+  %OptimizeFunctionOnNextCall(add);
+  for (var from = 0; from < 4; from++) {
+    for (var to = from; to <= kLength; to++) {
+      a.fill(-1);
+      add(from, to);
+      for (var i = 0; i < kLength; i++) {
+        var expected = (i >= from && i < to) ? b[i] + c[i] : -1;
+        assertEquals(expected, a[i], "[" + from + ", " + to + ") at " + i);
+      }
+    }
+  }
+})();
+
+
+// Float32 loops have to round like the scalar code, which computes in float64
+// and only rounds when storing.
+(function Float32Rounding() {
+  var a = new Float32Array(kLength);
+  var b = new Float32Array(kLength);
+  var c = new Float32Array(kLength);
+  fill(b, 1);
+  fill(c, 7);
+  var f = 0.1;
+
+  function mul(n) {
+    for (var i = 0; i < n; i++) {
+      a[i] = b[i] * c[i];
+    }
+  }
+
+  function muladd(n) {
+    for (var i = 0; i < n; i++) {
+      a[i] = b[i] * c[i] + f;
+    }
+  }
+
+  function roundedMuladd(n) {
+    for (var i = 0; i < n; i++) {
+      a[i] = Math.fround(b[i] * c[i]) + Math.fround(f);
+    }
+  }
+
+  function test(fun) {
+    var reference = eval("(" + fun.toString() + ")");
+    %NeverOptimizeFunction(reference);
+    fun(kLength);
+    fun(kLength);
+    %OptimizeFunctionOnNextCall(fun);
+    for (var n = 0; n <= kLength; n++) {
+      a.fill(0);
+      reference(n);
+      var expected = new Float32Array(a);
+      a.fill(0);
+      fun(n);
+      assertArrayEquals(expected, a);
+    }
+  }
+
+  test(mul);
+  test(muladd);
+  test(roundedMuladd);
+})();
+
+
+// Overlapping views of one buffer form a loop carried dependency, so the loop
+// has to take the scalar path.
+(function OverlappingViews() {
+  function add(a, b, c, n) {
+    for (var i = 0; i < n; i++) {
+      a[i] = b[i] + c[i];
+    }
+  }
+
+  function reference(n, offset) {
+    var buffer = [];
+    for (var i = 0; i < kLength + 1; i++) buffer[i] = i;
+    for (var i = 0; i < n; i++) {
+      buffer[i + offset] = buffer[i + 1 - offset] + 1;
+    }
+    return buffer;
+  }
+
+  function run(n, offset) {
+    var buffer = new Float64Array(kLength + 1);
+    for (var i = 0; i < buffer.length; i++) buffer[i] = i;
+    var ones = new Float64Array(kLength).fill(1);
+    // With offset 1 every element depends on the one stored right before.
+    add(buffer.subarray(offset, offset + kLength),
+        buffer.subarray(1 - offset, 1 - offset + kLength), ones, n);
+    assertArrayEquals(reference(n, offset), buffer);
+  }
+
+  run(kLength, 0);
+  run(kLength, 1);
+  %OptimizeFunctionOnNextCall(add);
+  for (var n = 0; n <= kLength; n++) {
+    run(n, 1);
+    run(n, 0);
+  }
+})();
+
+
+// Deoptimizing in the middle of the loop has to resume with the elements that
+// are not done yet.
+(function DeoptimizeInLoop() {
+  var a = new Float64Array(kLength);
+  var b = new Float64Array(kLength);
+  fill(b, 3);
+
+  function scale(n) {
+    for (var i = 0; i < n; i++) {
+      a[i] = b[i] * 2;
+    }
+  }
+
+  scale(kLength);
+  scale(kLength);
+  %OptimizeFunctionOnNextCall(scale);
+  a.fill(0);
+  scale(kLength - 1);
+  for (var i = 0; i < kLength; i++) {
+    assertEquals(i < kLength - 1 ? b[i] * 2 : 0, a[i]);
+  }
+
+  // Reading past the end of {b} and comparing against a non-Smi bound both
+  // deoptimize inside the loop.
+  a.fill(0);
+  scale(kLength + 5);
+  for (var i = 0; i < kLength; i++) {
+    assertEquals(b[i] * 2, a[i]);
+  }
+  %OptimizeFunctionOnNextCall(scale);
+  a.fill(0);
+  scale(kLength - 0.5);
+  for (var i = 0; i < kLength; i++) {
+    assertEquals(b[i] * 2, a[i]);
+  }
+})();
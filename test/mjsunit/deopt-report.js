@@ -0,0 +1,42 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --track-deopt-reasons
+
+function findEntry(name) {
+  var report = %GetDeoptimizationReport(100);
+  for (var i = 0; i < report.length; i++) {
+    if (report[i].name == name) return report[i];
+  }
+  return undefined;
+}
+
+function storm(x) { return x.a + 1; }
+
+assertEquals(undefined, findEntry("storm"));
+
+var shapes = [{ a: 1 }, { b: 0, a: 1 }, { c: 0, a: 1 }];
+for (var i = 0; i < shapes.length; i++) {
+  storm(shapes[i]);
+  storm(shapes[i]);
+  %OptimizeFunctionOnNextCall(storm);
+  storm(shapes[i]);
+  assertEquals(2, storm(shapes[(i + 1) % shapes.length]));
+}
+
+var entry = findEntry("storm");
+assertTrue(entry !== undefined);
+assertTrue(entry.count > 0);
+
+// Every deoptimization is attributed to exactly one reason.
+var total = 0;
+for (var reason in entry.reasons) total += entry.reasons[reason];
+assertEquals(entry.count, total);
+
+// The report is sorted by the number of deoptimizations.
+var report = %GetDeoptimizationReport(100);
+for (var i = 1; i < report.length; i++) {
+  assertTrue(report[i - 1].count >= report[i].count);
+}
+assertTrue(%GetDeoptimizationReport(1).length <= 1);
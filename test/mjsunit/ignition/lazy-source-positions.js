@@ -0,0 +1,39 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --ignition --lazy-source-positions
+
+// Source positions omitted for the bytecode of inner functions are collected
+// when a stack trace needs them.
+function outer() {
+  function inner(x) {
+    var y = x + 1;
+    return new Error("at inner " + y);
+  }
+  return inner(1);
+}
+var stack = outer().stack.split("\n");
+assertTrue(stack[1].indexOf("at inner (") >= 0);
+assertTrue(stack[1].indexOf("lazy-source-positions.js:12:12)") >= 0);
+assertTrue(stack[2].indexOf("lazy-source-positions.js:14:10)") >= 0);
+
+// The same holds for exceptions thrown from closures and for the location of
+// messages.
+var g = (function() {
+  var captured = 3;
+  return function() { return captured.foo.bar; };
+})();
+try {
+  g();
+  assertUnreachable();
+} catch (e) {
+  assertTrue(e instanceof TypeError);
+  assertTrue(e.stack.indexOf("lazy-source-positions.js:25:") >= 0);
+}
+
+// Functions called through eval report the position of the eval call.
+function evaluate() {
+  return eval("new Error()");
+}
+assertTrue(evaluate().stack.indexOf("at eval (eval at evaluate") >= 0);
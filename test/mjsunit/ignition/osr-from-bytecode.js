@@ -0,0 +1,58 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --ignition --ignition-osr --turbo-from-bytecode
+// Flags: --use-osr --interrupt-budget=1000
+
+function f() {
+  var sum = 0;
+  for (var i = 0; i < 100000; i++) {
+    var x = i + 2;
+    var y = x + 5;
+    var z = y + 3;
+    sum += z;
+    if (i == 11) %OptimizeOsr();
+  }
+  return sum;
+}
+for (var i = 0; i < 2; i++) {
+  assertEquals(5000950000, f());
+}
+
+// Parameters, the receiver and values held in a context survive the entry.
+function g(n, k) {
+  var o = { sum: 0 };
+  var add = function(v) { o.sum += v * k; };
+  for (var i = 0; i < n; i++) {
+    add(i);
+    if (i == 11) %OptimizeOsr();
+  }
+  return this.base + o.sum;
+}
+assertEquals(10 + 2 * 4999950000, g.call({ base: 10 }, 100000, 2));
+
+// The entry is at the inner loop, the outer loop is peeled.
+function h() {
+  var sum = 0;
+  for (var i = 0; i < 10; i++) {
+    for (var j = 0; j < 10000; j++) {
+      sum += i;
+      if (i == 1 && j == 11) %OptimizeOsr();
+    }
+  }
+  return sum;
+}
+assertEquals(450000, h());
+
+// Deoptimizing from the OSR code resumes the interpreted loop.
+function d(deopt) {
+  var sum = 0;
+  for (var i = 0; i < 100000; i++) {
+    sum += i;
+    if (i == 11) %OptimizeOsr();
+    if (deopt && i == 90000) sum += deopt.x;
+  }
+  return sum;
+}
+assertEquals(4999950000 + 1, d({ x: 1 }));
@@ -189,6 +189,7 @@ class EscapeAnalysisTest : public GraphTest {
   }
 
   SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+  JSGraph* jsgraph() { return &jsgraph_; }
 
   Node* effect() { return effect_; }
   Node* control() { return control_; }
@@ -512,6 +513,139 @@ TEST_F(EscapeAnalysisTest, DeoptReplacementIdentity) {
   ASSERT_EQ(object_state, object_state2);
 }
 
+
+TEST_F(EscapeAnalysisTest, DeoptIncompleteObject) {
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize * 2));
+  Store(FieldAccessAtIndex(0), allocation, object1);
+  Node* finish = FinishRegion(allocation);
+  Branch();
+  Node* ifFalse = IfFalse();
+  Node* state_values1 = graph()->NewNode(common()->StateValues(1), finish);
+  Node* state_values2 = graph()->NewNode(common()->StateValues(0));
+  Node* state_values3 = graph()->NewNode(common()->StateValues(0));
+  Node* frame_state = graph()->NewNode(
+      common()->FrameState(BailoutId::None(), OutputFrameStateCombine::Ignore(),
+                           nullptr),
+      state_values1, state_values2, state_values3, UndefinedConstant(),
+      graph()->start(), graph()->start());
+  Node* deopt = graph()->NewNode(common()->Deoptimize(DeoptimizeKind::kEager),
+                                 frame_state, finish, ifFalse);
+  Node* ifTrue = IfTrue();
+  Node* load = Load(FieldAccessAtIndex(0), finish, finish, ifTrue);
+  Node* result = Return(load, finish, ifTrue);
+  EndGraph();
+  graph()->end()->AppendInput(zone(), deopt);
+  Analysis();
+
+  ExpectEscaped(allocation);
+  ExpectEscaped(finish);
+  ExpectReplacement(load, object1);
+
+  Transformation();
+
+  ASSERT_EQ(object1, NodeProperties::GetValueInput(result, 0));
+  ASSERT_EQ(finish, NodeProperties::GetValueInput(state_values1, 0));
+}
+
+
+TEST_F(EscapeAnalysisTest, DeoptNestedReplacement) {
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation1 = Allocate(Constant(kPointerSize));
+  Store(FieldAccessAtIndex(0), allocation1, object1);
+  Node* finish1 = FinishRegion(allocation1);
+  BeginRegion();
+  Node* allocation2 = Allocate(Constant(kPointerSize * 2));
+  Store(FieldAccessAtIndex(0), allocation2, object1);
+  Store(FieldAccessAtIndex(kPointerSize), allocation2, finish1);
+  Node* finish2 = FinishRegion(allocation2);
+  Branch();
+  Node* ifFalse = IfFalse();
+  Node* state_values1 = graph()->NewNode(common()->StateValues(1), finish2);
+  Node* state_values2 = graph()->NewNode(common()->StateValues(0));
+  Node* state_values3 = graph()->NewNode(common()->StateValues(0));
+  Node* frame_state = graph()->NewNode(
+      common()->FrameState(BailoutId::None(), OutputFrameStateCombine::Ignore(),
+                           nullptr),
+      state_values1, state_values2, state_values3, UndefinedConstant(),
+      graph()->start(), graph()->start());
+  Node* deopt = graph()->NewNode(common()->Deoptimize(DeoptimizeKind::kEager),
+                                 frame_state, finish2, ifFalse);
+  Node* ifTrue = IfTrue();
+  Node* load = Load(FieldAccessAtIndex(0), finish2, finish2, ifTrue);
+  Node* result = Return(load, finish2, ifTrue);
+  EndGraph();
+  graph()->end()->AppendInput(zone(), deopt);
+  Analysis();
+
+  ExpectVirtual(allocation1);
+  ExpectVirtual(allocation2);
+  ExpectReplacement(load, object1);
+
+  Transformation();
+
+  ASSERT_EQ(object1, NodeProperties::GetValueInput(result, 0));
+  Node* object_state = NodeProperties::GetValueInput(state_values1, 0);
+  ASSERT_EQ(IrOpcode::kObjectState, object_state->opcode());
+  ASSERT_EQ(2, object_state->op()->ValueInputCount());
+  ASSERT_EQ(object1, NodeProperties::GetValueInput(object_state, 0));
+  Node* nested_state = NodeProperties::GetValueInput(object_state, 1);
+  ASSERT_EQ(IrOpcode::kObjectState, nested_state->opcode());
+  ASSERT_EQ(1, nested_state->op()->ValueInputCount());
+  ASSERT_EQ(object1, NodeProperties::GetValueInput(nested_state, 0));
+}
+
+
+TEST_F(EscapeAnalysisTest, ReferenceEqualSameObject) {
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize));
+  Store(FieldAccessAtIndex(0), allocation, object1);
+  Node* finish = FinishRegion(allocation);
+  Node* compare = graph()->NewNode(simplified()->ReferenceEqual(Type::Any()),
+                                   finish, finish);
+  Node* result = Return(compare);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation);
+
+  Transformation();
+
+  ASSERT_EQ(jsgraph()->TrueConstant(),
+            NodeProperties::GetValueInput(result, 0));
+}
+
+
+TEST_F(EscapeAnalysisTest, LoadElementThroughCheckBounds) {
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(kPointerSize * 2));
+  StoreElement(MakeElementAccess(0), allocation, Constant(0), object1);
+  StoreElement(MakeElementAccess(0), allocation, Constant(1), object2);
+  Node* finish = FinishRegion(allocation);
+  Node* index = graph()->NewNode(simplified()->CheckBounds(), Constant(1),
+                                 Constant(2), effect(), control());
+  Node* load =
+      graph()->NewNode(simplified()->LoadElement(MakeElementAccess(0)), finish,
+                       index, index, control());
+  Node* result = Return(load, index);
+  EndGraph();
+
+  Analysis();
+
+  ExpectVirtual(allocation);
+  ExpectReplacement(load, object2);
+
+  Transformation();
+
+  ASSERT_EQ(object2, NodeProperties::GetValueInput(result, 0));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,209 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/linkage.h"
+#include "src/compiler/loop-invariant-code-motion.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+using testing::_;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopInvariantCodeMotionTest : public GraphTest {
+ public:
+  LoopInvariantCodeMotionTest()
+      : GraphTest(3),
+        javascript_(zone()),
+        machine_(zone()),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_) {}
+  ~LoopInvariantCodeMotionTest() override {}
+
+ protected:
+  // Builds the header of a loop over {object} whose effect chain starts with
+  //
+  //   Checkpoint; CheckTaggedPointer(object); LoadField[map](check)
+  //
+  // and leaves the effect and control at the start of the loop body. The loop
+  // exit continues from the end of the header.
+  void BuildLoopHeader(Node* object) {
+    Node* const start = graph()->start();
+    loop_ = graph()->NewNode(common()->Loop(2), start, start);
+    effect_phi_ = graph()->NewNode(common()->EffectPhi(2), start, start, loop_);
+    checkpoint_ = graph()->NewNode(common()->Checkpoint(), EmptyFrameState(),
+                                   effect_phi_, loop_);
+    check_ = graph()->NewNode(simplified()->CheckTaggedPointer(), object,
+                              checkpoint_, loop_);
+    load_ = graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                             check_, check_, loop_);
+    Node* const branch = graph()->NewNode(common()->Branch(), Parameter(1),
+                                          loop_);
+    if_false_ = graph()->NewNode(common()->IfFalse(), branch);
+    effect_ = load_;
+    control_ = graph()->NewNode(common()->IfTrue(), branch);
+  }
+
+  // Closes the loop with the current effect and control and returns {value}
+  // after the loop.
+  void CloseLoop(Node* value) {
+    loop_->ReplaceInput(1, control_);
+    effect_phi_->ReplaceInput(1, effect_);
+    Node* const ret =
+        graph()->NewNode(common()->Return(), value, load_, if_false_);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+  }
+
+  // Appends a call to an unknown code object to the loop body.
+  void AddCall() {
+    MachineType kMachineSignature[] = {MachineType::AnyTagged(),
+                                       MachineType::AnyTagged()};
+    LinkageLocation kLocationSignature[] = {LinkageLocation::ForRegister(0),
+                                            LinkageLocation::ForRegister(1)};
+    const CallDescriptor* kCallDescriptor = new (zone()) CallDescriptor(
+        CallDescriptor::kCallCodeObject, MachineType::AnyTagged(),
+        LinkageLocation::ForRegister(0),
+        new (zone()) MachineSignature(1, 1, kMachineSignature),
+        new (zone()) LocationSignature(1, 1, kLocationSignature), 0,
+        Operator::kNoProperties, 0, 0, CallDescriptor::kNoFlags);
+    Node* const call =
+        graph()->NewNode(common()->Call(kCallDescriptor), Parameter(2),
+                         Parameter(0), effect_, control_);
+    effect_ = call;
+    control_ = graph()->NewNode(common()->IfSuccess(), call);
+  }
+
+  void Run() {
+    LoopInvariantCodeMotion licm(jsgraph(), zone());
+    licm.Run();
+  }
+
+  // Checks that the header nodes built by BuildLoopHeader stayed in the loop.
+  void ExpectNotHoisted() {
+    EXPECT_EQ(loop_, NodeProperties::GetControlInput(check_));
+    EXPECT_THAT(load_, IsLoadField(AccessBuilder::ForMap(), check_, check_,
+                                   loop_));
+    EXPECT_EQ(graph()->start(), NodeProperties::GetEffectInput(effect_phi_));
+    EXPECT_EQ(graph()->start(), NodeProperties::GetControlInput(loop_));
+  }
+
+  JSGraph* jsgraph() { return &jsgraph_; }
+  JSOperatorBuilder* javascript() { return &javascript_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  Node* loop_ = nullptr;
+  Node* effect_phi_ = nullptr;
+  Node* checkpoint_ = nullptr;
+  Node* check_ = nullptr;
+  Node* load_ = nullptr;
+  Node* if_false_ = nullptr;
+  Node* effect_ = nullptr;
+  Node* control_ = nullptr;
+
+ private:
+  JSOperatorBuilder javascript_;
+  MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+};
+
+
+TEST_F(LoopInvariantCodeMotionTest, HoistCheckAndLoadField) {
+  BuildLoopHeader(Parameter(0));
+  CloseLoop(load_);
+  Run();
+
+  // The check deoptimizes to a new checkpoint on loop entry.
+  Node* const checkpoint = NodeProperties::GetEffectInput(check_);
+  EXPECT_EQ(IrOpcode::kCheckpoint, checkpoint->opcode());
+  EXPECT_EQ(graph()->start(), NodeProperties::GetEffectInput(checkpoint));
+  EXPECT_EQ(graph()->start(), NodeProperties::GetControlInput(check_));
+  EXPECT_THAT(load_, IsLoadField(AccessBuilder::ForMap(), check_, check_,
+                                 graph()->start()));
+  EXPECT_EQ(load_, NodeProperties::GetEffectInput(effect_phi_));
+  EXPECT_EQ(graph()->start(), NodeProperties::GetControlInput(loop_));
+  // The header keeps its checkpoint for the nodes that stay in the loop.
+  EXPECT_EQ(effect_phi_, NodeProperties::GetEffectInput(checkpoint_));
+  EXPECT_EQ(checkpoint_, NodeProperties::GetEffectInput(effect_phi_, 1));
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, NoHoistingWithStoreField) {
+  BuildLoopHeader(Parameter(0));
+  effect_ = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForMap()), Parameter(0),
+      Parameter(2), effect_, control_);
+  CloseLoop(load_);
+  Run();
+  ExpectNotHoisted();
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, NoHoistingWithCall) {
+  BuildLoopHeader(Parameter(0));
+  AddCall();
+  CloseLoop(load_);
+  Run();
+  ExpectNotHoisted();
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, NoHoistingWithStackCheck) {
+  BuildLoopHeader(Parameter(0));
+  effect_ = graph()->NewNode(javascript()->StackCheck(), Parameter(2),
+                             EmptyFrameState(), effect_, control_);
+  CloseLoop(load_);
+  Run();
+  ExpectNotHoisted();
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, NoHoistingOfVariantObject) {
+  BuildLoopHeader(Parameter(0));
+  // The object changes in every iteration.
+  Node* const phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                       Parameter(0), load_, loop_);
+  check_->ReplaceInput(0, phi);
+  CloseLoop(load_);
+  Run();
+  ExpectNotHoisted();
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, RemoveRedundantNodes) {
+  Node* const object = Parameter(0);
+  BuildLoopHeader(object);
+  // The body repeats the check and the load of the header.
+  Node* const body_check = graph()->NewNode(simplified()->CheckTaggedPointer(),
+                                            object, effect_, control_);
+  Node* const body_load =
+      graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                       body_check, body_check, control_);
+  effect_ = body_load;
+  Node* const value =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                       Parameter(2), body_load, loop_);
+  CloseLoop(value);
+  Run();
+
+  EXPECT_TRUE(body_check->IsDead());
+  EXPECT_TRUE(body_load->IsDead());
+  EXPECT_EQ(load_, value->InputAt(1));
+  EXPECT_EQ(load_, NodeProperties::GetEffectInput(effect_phi_));
+  EXPECT_EQ(checkpoint_, NodeProperties::GetEffectInput(effect_phi_, 1));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
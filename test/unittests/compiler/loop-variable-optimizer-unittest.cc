@@ -0,0 +1,239 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-reducer-unittest.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+using testing::_;
+using testing::StrictMock;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVariableOptimizerTest : public TypedGraphTest {
+ public:
+  LoopVariableOptimizerTest()
+      : TypedGraphTest(3),
+        javascript_(zone()),
+        machine_(zone()),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_) {}
+  ~LoopVariableOptimizerTest() override {}
+
+ protected:
+  Reduction Reduce(Node* node) {
+    StrictMock<MockAdvancedReducerEditor> editor;
+    EXPECT_CALL(editor, ReplaceWithValue(node, _, _, _))
+        .Times(testing::AnyNumber());
+    LoopVariableOptimizer reducer(&editor, jsgraph());
+    return reducer.Reduce(node);
+  }
+
+  // Builds a loop with the induction variable
+  //
+  //   for (var i = 0; i < bound; i++) { ... }
+  //
+  // and leaves the control and effect at the start of the loop body.
+  Node* BuildLoop(Node* bound, Type* index_type) {
+    Node* const start = graph()->start();
+    loop_ = graph()->NewNode(common()->Loop(2), start, start);
+    effect_phi_ =
+        graph()->NewNode(common()->EffectPhi(2), start, start, loop_);
+    Node* const zero = jsgraph()->ZeroConstant();
+    phi_ = graph()->NewNode(
+        common()->Phi(MachineRepresentation::kTagged, 2), zero, zero, loop_);
+    Node* const increment = graph()->NewNode(simplified()->NumberAdd(), phi_,
+                                             jsgraph()->OneConstant());
+    phi_->ReplaceInput(1, increment);
+    NodeProperties::SetType(phi_, index_type);
+    Node* const check =
+        graph()->NewNode(simplified()->NumberLessThan(), phi_, bound);
+    Node* const branch = graph()->NewNode(common()->Branch(), check, loop_);
+    control_ = graph()->NewNode(common()->IfTrue(), branch);
+    effect_ = effect_phi_;
+    return phi_;
+  }
+
+  JSGraph* jsgraph() { return &jsgraph_; }
+  MachineOperatorBuilder* machine() { return &machine_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+  Node* loop_ = nullptr;
+  Node* phi_ = nullptr;
+  Node* effect_phi_ = nullptr;
+  Node* effect_ = nullptr;
+  Node* control_ = nullptr;
+
+ private:
+  JSOperatorBuilder javascript_;
+  MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+};
+
+
+// -----------------------------------------------------------------------------
+// InductionVariable
+
+
+TEST_F(LoopVariableOptimizerTest, MatchIncrement) {
+  Node* const bound = Parameter(Type::Range(0.0, 100.0, zone()), 0);
+  Node* const index = BuildLoop(bound, Type::Range(0.0, 100.0, zone()));
+  InductionVariable induction_var;
+  ASSERT_TRUE(InductionVariable::Match(index, &induction_var));
+  EXPECT_EQ(index, induction_var.phi());
+  EXPECT_EQ(loop_, induction_var.loop());
+  EXPECT_EQ(1.0, induction_var.step());
+  bool strict;
+  EXPECT_EQ(bound, induction_var.FindBound(control_, &strict));
+  EXPECT_TRUE(strict);
+}
+
+
+TEST_F(LoopVariableOptimizerTest, MatchFailsForNonConstantStep) {
+  Node* const step = Parameter(Type::Range(1.0, 2.0, zone()), 0);
+  Node* const bound = Parameter(Type::Range(0.0, 100.0, zone()), 1);
+  Node* const index = BuildLoop(bound, Type::Range(0.0, 100.0, zone()));
+  index->InputAt(1)->ReplaceInput(1, step);
+  InductionVariable induction_var;
+  EXPECT_FALSE(InductionVariable::Match(index, &induction_var));
+}
+
+
+// -----------------------------------------------------------------------------
+// CheckBounds
+
+
+TEST_F(LoopVariableOptimizerTest, CheckBoundsWithSameLength) {
+  Node* const length = Parameter(Type::Range(0.0, 1000.0, zone()), 0);
+  Node* const index = BuildLoop(length, Type::Range(0.0, 1000.0, zone()));
+  Node* const check = graph()->NewNode(simplified()->CheckBounds(), index,
+                                       length, effect_, control_);
+  Reduction const r = Reduce(check);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(index, r.replacement());
+}
+
+
+TEST_F(LoopVariableOptimizerTest, CheckBoundsWithSmallerBound) {
+  Node* const bound = Parameter(Type::Range(0.0, 10.0, zone()), 0);
+  Node* const length = Parameter(Type::Range(10.0, 20.0, zone()), 1);
+  Node* const index = BuildLoop(bound, Type::Range(0.0, 10.0, zone()));
+  Node* const check = graph()->NewNode(simplified()->CheckBounds(), index,
+                                       length, effect_, control_);
+  Reduction const r = Reduce(check);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_EQ(index, r.replacement());
+}
+
+
+TEST_F(LoopVariableOptimizerTest, CheckBoundsWithLargerBound) {
+  Node* const bound = Parameter(Type::Range(0.0, 21.0, zone()), 0);
+  Node* const length = Parameter(Type::Range(10.0, 20.0, zone()), 1);
+  Node* const index = BuildLoop(bound, Type::Range(0.0, 21.0, zone()));
+  Node* const check = graph()->NewNode(simplified()->CheckBounds(), index,
+                                       length, effect_, control_);
+  Reduction const r = Reduce(check);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+TEST_F(LoopVariableOptimizerTest, CheckBoundsWithNumberBound) {
+  Node* const length = Parameter(Type::Number(), 0);
+  Node* const index = BuildLoop(length, Type::Range(0.0, 1000.0, zone()));
+  Node* const check = graph()->NewNode(simplified()->CheckBounds(), index,
+                                       length, effect_, control_);
+  Reduction const r = Reduce(check);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+TEST_F(LoopVariableOptimizerTest, CheckBoundsWithNegativeIndex) {
+  Node* const length = Parameter(Type::Range(0.0, 1000.0, zone()), 0);
+  Node* const index = BuildLoop(length, Type::Range(-1.0, 1000.0, zone()));
+  Node* const check = graph()->NewNode(simplified()->CheckBounds(), index,
+                                       length, effect_, control_);
+  Reduction const r = Reduce(check);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+TEST_F(LoopVariableOptimizerTest, CheckBoundsOutsideOfLoopCondition) {
+  Node* const length = Parameter(Type::Range(0.0, 1000.0, zone()), 0);
+  Node* const index = BuildLoop(length, Type::Range(0.0, 1000.0, zone()));
+  Node* const check = graph()->NewNode(simplified()->CheckBounds(), index,
+                                       length, effect_, loop_);
+  Reduction const r = Reduce(check);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+// -----------------------------------------------------------------------------
+// LoadBuffer and StoreBuffer
+
+
+TEST_F(LoopVariableOptimizerTest, LoadBufferWithinLength) {
+  Node* const buffer = Parameter(Type::Any(), 0);
+  Node* const bound = Parameter(Type::Range(0.0, 256.0, zone()), 1);
+  Node* const index = BuildLoop(bound, Type::Range(0.0, 256.0, zone()));
+  BufferAccess const access(kExternalInt32Array);
+  Node* const offset = graph()->NewNode(machine()->Word32Shl(), index,
+                                        jsgraph()->Int32Constant(2));
+  Node* const load = graph()->NewNode(
+      simplified()->LoadBuffer(access), buffer, offset,
+      jsgraph()->Constant(1024), effect_, control_);
+  Reduction const r = Reduce(load);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_THAT(r.replacement(),
+              IsLoadElement(AccessBuilder::ForTypedArrayElement(
+                                kExternalInt32Array, true),
+                            buffer, index, control_, effect_));
+}
+
+
+TEST_F(LoopVariableOptimizerTest, LoadBufferBeyondLength) {
+  Node* const buffer = Parameter(Type::Any(), 0);
+  Node* const bound = Parameter(Type::Range(0.0, 257.0, zone()), 1);
+  Node* const index = BuildLoop(bound, Type::Range(0.0, 257.0, zone()));
+  BufferAccess const access(kExternalInt32Array);
+  Node* const offset = graph()->NewNode(machine()->Word32Shl(), index,
+                                        jsgraph()->Int32Constant(2));
+  Node* const load = graph()->NewNode(
+      simplified()->LoadBuffer(access), buffer, offset,
+      jsgraph()->Constant(1024), effect_, control_);
+  Reduction const r = Reduce(load);
+  ASSERT_FALSE(r.Changed());
+}
+
+
+TEST_F(LoopVariableOptimizerTest, StoreBufferWithinLength) {
+  Node* const buffer = Parameter(Type::Any(), 0);
+  Node* const bound = Parameter(Type::Range(0.0, 1024.0, zone()), 1);
+  Node* const value = Parameter(Type::Number(), 2);
+  Node* const index = BuildLoop(bound, Type::Range(0.0, 1024.0, zone()));
+  BufferAccess const access(kExternalUint8Array);
+  Node* const store = graph()->NewNode(
+      simplified()->StoreBuffer(access), buffer, index,
+      jsgraph()->Constant(1024), value, effect_, control_);
+  Reduction const r = Reduce(store);
+  ASSERT_TRUE(r.Changed());
+  EXPECT_THAT(r.replacement(),
+              IsStoreElement(AccessBuilder::ForTypedArrayElement(
+                                 kExternalUint8Array, true),
+                             buffer, index, value, effect_, control_));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
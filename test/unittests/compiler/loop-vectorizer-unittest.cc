@@ -0,0 +1,206 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/js-graph.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/loop-vectorizer.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+using testing::_;
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVectorizerTest : public GraphTest {
+ public:
+  LoopVectorizerTest()
+      : GraphTest(3),
+        javascript_(zone()),
+        machine_(zone(), MachineType::PointerRepresentation(),
+                 MachineOperatorBuilder::kSimd128FloatArithmetic),
+        simplified_(zone()),
+        jsgraph_(isolate(), graph(), common(), &javascript_, &simplified_,
+                 &machine_) {}
+  ~LoopVectorizerTest() override {}
+
+ protected:
+  // Builds the graph of
+  //
+  //   for (var i = 0; i < 1024; i++) c[i] = a[i] + b[i];
+  //
+  // on elements of representation {rep} the way it looks after memory
+  // optimization, apart from the stack check.
+  void BuildLoop(Node* a, Node* b, Node* c, MachineRepresentation rep) {
+    Node* const start = graph()->start();
+    loop_ = graph()->NewNode(common()->Loop(2), start, start);
+    effect_phi_ = graph()->NewNode(common()->EffectPhi(2), start, start, loop_);
+    Node* const zero = jsgraph()->Int32Constant(0);
+    phi_ = graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 2),
+                            zero, zero, loop_);
+    Node* const increment = graph()->NewNode(machine()->Int32Add(), phi_,
+                                             jsgraph()->Int32Constant(1));
+    phi_->ReplaceInput(1, increment);
+    check_ = graph()->NewNode(machine()->Int32LessThan(), phi_,
+                              jsgraph()->Int32Constant(1024));
+    Node* const branch = graph()->NewNode(common()->Branch(), check_, loop_);
+    Node* const if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* const if_false = graph()->NewNode(common()->IfFalse(), branch);
+
+    bool const is_float32 = rep == MachineRepresentation::kFloat32;
+    MachineType const type =
+        is_float32 ? MachineType::Float32() : MachineType::Float64();
+    Node* const index = graph()->NewNode(
+        machine()->ChangeUint32ToUint64(),
+        graph()->NewNode(machine()->Word32Shl(), phi_,
+                         jsgraph()->Int32Constant(is_float32 ? 2 : 3)));
+    Node* const load_a = graph()->NewNode(machine()->Load(type), a, index,
+                                          effect_phi_, if_true);
+    Node* const load_b =
+        graph()->NewNode(machine()->Load(type), b, index, load_a, if_true);
+    Node* sum;
+    if (is_float32) {
+      sum = graph()->NewNode(
+          machine()->TruncateFloat64ToFloat32(),
+          graph()->NewNode(
+              machine()->Float64Add(),
+              graph()->NewNode(machine()->ChangeFloat32ToFloat64(), load_a),
+              graph()->NewNode(machine()->ChangeFloat32ToFloat64(), load_b)));
+    } else {
+      sum = graph()->NewNode(machine()->Float64Add(), load_a, load_b);
+    }
+    Node* const store = graph()->NewNode(
+        machine()->Store(StoreRepresentation(rep, kNoWriteBarrier)), c, index,
+        sum, load_b, if_true);
+    loop_->ReplaceInput(1, if_true);
+    effect_phi_->ReplaceInput(1, store);
+
+    Node* const ret =
+        graph()->NewNode(common()->Return(), phi_, effect_phi_, if_false);
+    graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+  }
+
+  void Vectorize() {
+    LoopVectorizer vectorizer(jsgraph(), zone());
+    vectorizer.Run();
+  }
+
+  // Returns the vector loop in front of the original loop.
+  Node* VectorLoop() {
+    Node* const exit = NodeProperties::GetControlInput(loop_, 0);
+    Node* const branch = NodeProperties::GetControlInput(
+        exit->opcode() == IrOpcode::kMerge ? exit->InputAt(0) : exit);
+    return NodeProperties::GetControlInput(branch);
+  }
+
+  // Returns the store at the end of the vector loop.
+  Node* VectorStore() {
+    for (Node* use : VectorLoop()->uses()) {
+      if (use->opcode() == IrOpcode::kEffectPhi) {
+        return NodeProperties::GetEffectInput(use, 1);
+      }
+    }
+    return nullptr;
+  }
+
+  JSGraph* jsgraph() { return &jsgraph_; }
+  MachineOperatorBuilder* machine() { return &machine_; }
+
+  Node* loop_ = nullptr;
+  Node* phi_ = nullptr;
+  Node* effect_phi_ = nullptr;
+  Node* check_ = nullptr;
+
+ private:
+  JSOperatorBuilder javascript_;
+  MachineOperatorBuilder machine_;
+  SimplifiedOperatorBuilder simplified_;
+  JSGraph jsgraph_;
+};
+
+
+TEST_F(LoopVectorizerTest, Float64Add) {
+  Node* const a = jsgraph()->Int64Constant(0x10000);
+  Node* const b = jsgraph()->Int64Constant(0x20000);
+  Node* const c = jsgraph()->Int64Constant(0x30000);
+  BuildLoop(a, b, c, MachineRepresentation::kFloat64);
+  Vectorize();
+  Node* const vector_loop = VectorLoop();
+  EXPECT_THAT(vector_loop, IsLoop(graph()->start(), _));
+  EXPECT_THAT(loop_, IsLoop(IsIfFalse(IsBranch(_, vector_loop)), _));
+  EXPECT_THAT(phi_, IsPhi(MachineRepresentation::kWord32,
+                          IsPhi(MachineRepresentation::kWord32, _, _,
+                                vector_loop),
+                          _, loop_));
+  Node* const store = VectorStore();
+  ASSERT_THAT(store,
+              IsStore(StoreRepresentation(MachineRepresentation::kSimd128,
+                                          kNoWriteBarrier),
+                      c, _, _, _, _));
+  Node* const sum = NodeProperties::GetValueInput(store, 2);
+  EXPECT_EQ(IrOpcode::kFloat64x2Add, sum->opcode());
+  EXPECT_THAT(sum->InputAt(0), IsLoad(MachineType::Simd128(), a, _, _, _));
+  EXPECT_THAT(sum->InputAt(1), IsLoad(MachineType::Simd128(), b, _, _, _));
+}
+
+
+TEST_F(LoopVectorizerTest, Float32Add) {
+  Node* const a = jsgraph()->Int64Constant(0x10000);
+  Node* const b = jsgraph()->Int64Constant(0x20000);
+  Node* const c = jsgraph()->Int64Constant(0x30000);
+  BuildLoop(a, b, c, MachineRepresentation::kFloat32);
+  Vectorize();
+  Node* const store = VectorStore();
+  ASSERT_THAT(store,
+              IsStore(StoreRepresentation(MachineRepresentation::kSimd128,
+                                          kNoWriteBarrier),
+                      c, _, _, _, _));
+  Node* const sum = NodeProperties::GetValueInput(store, 2);
+  EXPECT_EQ(IrOpcode::kFloat32x4Add, sum->opcode());
+  EXPECT_THAT(sum->InputAt(0), IsLoad(MachineType::Simd128(), a, _, _, _));
+  EXPECT_THAT(sum->InputAt(1), IsLoad(MachineType::Simd128(), b, _, _, _));
+}
+
+
+TEST_F(LoopVectorizerTest, OverlappingConstantArrays) {
+  Node* const a = jsgraph()->Int64Constant(0x10000);
+  Node* const b = jsgraph()->Int64Constant(0x20000);
+  Node* const c = jsgraph()->Int64Constant(0x10008);
+  BuildLoop(a, b, c, MachineRepresentation::kFloat64);
+  Vectorize();
+  EXPECT_THAT(loop_, IsLoop(graph()->start(), _));
+}
+
+
+TEST_F(LoopVectorizerTest, UnknownArraysAreChecked) {
+  Node* const a = Parameter(0);
+  Node* const b = Parameter(1);
+  Node* const c = Parameter(2);
+  BuildLoop(a, b, c, MachineRepresentation::kFloat64);
+  Vectorize();
+  Node* const vector_loop = VectorLoop();
+  EXPECT_THAT(vector_loop, IsLoop(IsIfTrue(IsBranch(_, graph()->start())), _));
+  EXPECT_THAT(loop_, IsLoop(IsMerge(IsIfFalse(IsBranch(_, vector_loop)),
+                                    IsIfFalse(IsBranch(_, graph()->start()))),
+                            _));
+}
+
+
+TEST_F(LoopVectorizerTest, ShortLoop) {
+  Node* const a = jsgraph()->Int64Constant(0x10000);
+  Node* const b = jsgraph()->Int64Constant(0x20000);
+  Node* const c = jsgraph()->Int64Constant(0x30000);
+  BuildLoop(a, b, c, MachineRepresentation::kFloat64);
+  check_->ReplaceInput(1, jsgraph()->Int32Constant(3));
+  Vectorize();
+  EXPECT_THAT(loop_, IsLoop(graph()->start(), _));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -700,6 +700,121 @@ TEST_F(RegisterAllocatorTest, MultipleDeferredBlockSpills) {
 }
 
 
+class GreedyRegisterAllocatorTest : public RegisterAllocatorTest {
+ public:
+  GreedyRegisterAllocatorTest()
+      : old_greedy_regalloc_(FLAG_turbo_greedy_regalloc),
+        old_min_ticks_(FLAG_turbo_greedy_regalloc_min_ticks) {
+    FLAG_turbo_greedy_regalloc = true;
+    FLAG_turbo_greedy_regalloc_min_ticks = 0;
+  }
+  ~GreedyRegisterAllocatorTest() override {
+    FLAG_turbo_greedy_regalloc = old_greedy_regalloc_;
+    FLAG_turbo_greedy_regalloc_min_ticks = old_min_ticks_;
+  }
+
+ private:
+  bool old_greedy_regalloc_;
+  int old_min_ticks_;
+};
+
+
+TEST_F(GreedyRegisterAllocatorTest, CanAllocateThreeRegisters) {
+  StartBlock();
+  auto a_reg = Parameter();
+  auto b_reg = Parameter();
+  auto c_reg = EmitOI(Reg(1), Reg(a_reg, 1), Reg(b_reg, 0));
+  Return(c_reg);
+  EndBlock(Last());
+
+  Allocate();
+}
+
+
+TEST_F(GreedyRegisterAllocatorTest, LoopWithHighRegisterPressure) {
+  const size_t kNumRegs = 3;
+  const size_t kValues = kNumRegs + 2;
+  SetNumRegs(kNumRegs, kNumRegs);
+
+  StartBlock();
+  auto outside = EmitOI(Reg());
+  VReg values[kValues];
+  for (size_t i = 0; i < arraysize(values); ++i) {
+    values[i] = DefineConstant();
+  }
+  EndBlock();
+
+  PhiInstruction* phis[kValues];
+  {
+    StartLoop(2);
+
+    StartBlock();
+    for (size_t i = 0; i < arraysize(values); ++i) {
+      phis[i] = Phi(values[i], 2);
+    }
+    for (size_t i = 0; i < arraysize(values); ++i) {
+      auto result = EmitOI(Same(), Reg(phis[i]), Reg(phis[0]));
+      SetInput(phis[i], 1, result);
+    }
+    EndBlock(Branch(Reg(DefineConstant()), 1, 2));
+
+    StartBlock();
+    EndBlock(Jump(-1));
+
+    EndLoop();
+  }
+
+  StartBlock();
+  Return(Reg(outside));
+  EndBlock();
+
+  Allocate();
+}
+
+
+TEST_F(GreedyRegisterAllocatorTest, DiamondWithCall) {
+  StartBlock();
+  auto x = EmitOI(Reg(0));
+  EndBlock(Branch(Reg(x), 1, 2));
+
+  StartBlock();
+  EmitCall(Slot(-1));
+  auto occupy = EmitOI(Reg(0));
+  EndBlock(Jump(2));
+
+  StartBlock();
+  EndBlock(FallThrough());
+
+  StartBlock();
+  Use(occupy);
+  Return(Reg(x));
+  EndBlock();
+  Allocate();
+}
+
+
+TEST_F(GreedyRegisterAllocatorTest, SpillPhi) {
+  StartBlock();
+  EndBlock(Branch(Imm(), 1, 2));
+
+  StartBlock();
+  auto left = Define(Reg(0));
+  EndBlock(Jump(2));
+
+  StartBlock();
+  auto right = Define(Reg(0));
+  EndBlock();
+
+  StartBlock();
+  auto phi = Phi(left, right);
+  EmitCall(Slot(-1));
+  Return(Reg(phi));
+  EndBlock();
+
+  Allocate();
+}
+
+
 namespace {
 
 enum class ParameterType { kFixedSlot, kSlot, kRegister, kFixedRegister };
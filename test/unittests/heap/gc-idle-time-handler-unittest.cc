@@ -4,6 +4,7 @@
 
 #include <limits>
 
+#include "src/flags.h"
 #include "src/heap/gc-idle-time-handler.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -24,6 +25,12 @@ class GCIdleTimeHandlerTest : public ::testing::Test {
     result.contexts_disposed = 0;
     result.contexts_disposal_rate = GCIdleTimeHandler::kHighContextDisposalRate;
     result.incremental_marking_stopped = false;
+    result.used_new_space_size = 0;
+    result.new_space_capacity = kNewSpaceCapacity;
+    result.scavenge_speed_in_bytes_per_ms = kScavengeSpeed;
+    result.mark_compact_speed_in_bytes_per_ms = kMarkCompactSpeed;
+    result.can_start_incremental_marking = false;
+    result.high_fragmentation = false;
     return result;
   }
 
@@ -31,6 +38,8 @@ class GCIdleTimeHandlerTest : public ::testing::Test {
   static const size_t kMarkCompactSpeed = 200 * KB;
   static const size_t kMarkingSpeed = 200 * KB;
   static const int kMaxNotifications = 100;
+  static const size_t kNewSpaceCapacity = 16 * MB;
+  static const size_t kScavengeSpeed = 1 * MB;
 
  private:
   GCIdleTimeHandler handler_;
@@ -215,5 +224,70 @@ TEST_F(GCIdleTimeHandlerTest, DoneIfNotMakingProgressOnIncrementalMarking) {
   EXPECT_EQ(DONE, action.type);
 }
 
+
+TEST_F(GCIdleTimeHandlerTest, LatencyBudgetScavenge) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.used_new_space_size = kNewSpaceCapacity * 3 / 4;
+  double scavenge_time_ms =
+      static_cast<double>(heap_state.used_new_space_size) / kScavengeSpeed;
+  GCIdleTimeAction action = handler()->ComputeWithLatencyBudget(
+      1000, 2 * scavenge_time_ms, heap_state);
+  EXPECT_EQ(DO_SCAVENGE, action.type);
+  // The scavenge does not fit into the latency budget.
+  action = handler()->ComputeWithLatencyBudget(1000, scavenge_time_ms / 2,
+                                               heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_STEP, action.type);
+  // The scavenge does not fit into the idle time.
+  action = handler()->ComputeWithLatencyBudget(scavenge_time_ms / 2, 1000,
+                                               heap_state);
+  EXPECT_EQ(DO_INCREMENTAL_STEP, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, LatencyBudgetNoScavengeOfEmptyNewSpace) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.used_new_space_size = kNewSpaceCapacity / 4;
+  GCIdleTimeAction action =
+      handler()->ComputeWithLatencyBudget(1000, 1000, heap_state);
+  EXPECT_EQ(DONE, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, LatencyBudgetCompaction) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.size_of_objects = kSizeOfObjects;
+  heap_state.high_fragmentation = true;
+  double mark_compact_time_ms =
+      static_cast<double>(kSizeOfObjects) / kMarkCompactSpeed;
+  GCIdleTimeAction action = handler()->ComputeWithLatencyBudget(
+      2 * mark_compact_time_ms, 2 * mark_compact_time_ms, heap_state);
+  EXPECT_EQ(DO_FULL_GC, action.type);
+  action = handler()->ComputeWithLatencyBudget(
+      2 * mark_compact_time_ms, mark_compact_time_ms / 2, heap_state);
+  EXPECT_EQ(DONE, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, LatencyBudgetStartIncrementalMarking) {
+  if (!FLAG_incremental_marking) return;
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.incremental_marking_stopped = true;
+  heap_state.can_start_incremental_marking = true;
+  GCIdleTimeAction action =
+      handler()->ComputeWithLatencyBudget(10, 1, heap_state);
+  EXPECT_EQ(DO_START_INCREMENTAL_MARKING, action.type);
+}
+
+
+TEST_F(GCIdleTimeHandlerTest, LatencyBudgetZero) {
+  GCIdleTimeHeapState heap_state = DefaultHeapState();
+  heap_state.used_new_space_size = kNewSpaceCapacity;
+  GCIdleTimeAction action =
+      handler()->ComputeWithLatencyBudget(10, 0, heap_state);
+  EXPECT_EQ(DO_NOTHING, action.type);
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -139,6 +139,45 @@ TEST(SlotSet, RemoveRange) {
   }
 }
 
+TEST(SlotSet, AdaptiveBuckets) {
+  SlotSet set;
+  set.SetPageStart(0);
+  const int kBucketSize = 1024 * kPointerSize;
+  // A single slot uses a sparse bucket.
+  set.Insert(0);
+  size_t sparse_bytes = set.AllocatedBucketMemory();
+  EXPECT_LT(0u, sparse_bytes);
+  // Many slots use a dense bucket.
+  for (int i = 0; i < kBucketSize; i += 2 * kPointerSize) {
+    set.Insert(i);
+  }
+  size_t dense_bytes = set.AllocatedBucketMemory();
+  EXPECT_LT(sparse_bytes, dense_bytes);
+  // A completely filled bucket does not need any storage.
+  for (int i = 0; i < kBucketSize; i += kPointerSize) {
+    set.Insert(i);
+  }
+  EXPECT_EQ(0u, set.AllocatedBucketMemory());
+  for (int i = 0; i < kBucketSize; i += kPointerSize) {
+    EXPECT_TRUE(set.Lookup(i));
+  }
+  EXPECT_FALSE(set.Lookup(kBucketSize));
+  // Removing a slot from a full bucket makes it dense again.
+  set.Remove(kPointerSize);
+  EXPECT_EQ(dense_bytes, set.AllocatedBucketMemory());
+  EXPECT_FALSE(set.Lookup(kPointerSize));
+  // Iteration that keeps only a few slots makes the bucket sparse again.
+  int count = set.Iterate([](Address slot_address) {
+    uintptr_t intaddr = reinterpret_cast<uintptr_t>(slot_address);
+    return intaddr < 2 * kPointerSize ? KEEP_SLOT : REMOVE_SLOT;
+  });
+  EXPECT_EQ(1, count);
+  EXPECT_EQ(sparse_bytes, set.AllocatedBucketMemory());
+  EXPECT_TRUE(set.Lookup(0));
+  set.RemoveRange(0, kPointerSize);
+  EXPECT_EQ(0u, set.AllocatedBucketMemory());
+}
+
 TEST(TypedSlotSet, Iterate) {
   TypedSlotSet set(0);
   const int kDelta = 10000001;
@@ -386,6 +386,13 @@ TEST_F(BytecodeArrayBuilderTest, AllBytecodesGenerated) {
   // Insert entry for nop bytecode as this often gets optimized out.
   scorecard[Bytecodes::ToByte(Bytecode::kNop)] = 1;
 
+  // Insert entries for superinstructions, which are only emitted by the
+  // peephole optimizer with --ignition-superinstructions.
+#define MARK_SUPERINSTRUCTION(Name, ...) \
+  scorecard[Bytecodes::ToByte(Bytecode::k##Name)] = 1;
+  SUPERINSTRUCTION_LIST(MARK_SUPERINSTRUCTION)
+#undef MARK_SUPERINSTRUCTION
+
   if (!FLAG_ignition_peephole) {
     // Insert entries for bytecodes only emitted by peephole optimizer.
     scorecard[Bytecodes::ToByte(Bytecode::kLdrNamedProperty)] = 1;
@@ -489,6 +489,86 @@ TEST_F(BytecodePeepholeOptimizerTest, MergeLdaUndefinedStar) {
   CHECK_EQ(last_written().bytecode(), third.bytecode());
 }
 
+// Tests covering superinstructions.
+
+class BytecodeSuperinstructionTest : public BytecodePeepholeOptimizerTest {
+ public:
+  BytecodeSuperinstructionTest()
+      : old_superinstructions_(FLAG_ignition_superinstructions) {
+    FLAG_ignition_superinstructions = true;
+  }
+  ~BytecodeSuperinstructionTest() override {
+    FLAG_ignition_superinstructions = old_superinstructions_;
+  }
+
+ private:
+  bool old_superinstructions_;
+};
+
+TEST_F(BytecodeSuperinstructionTest, FuseLdarAdd) {
+  BytecodeNode first(Bytecode::kLdar, Register(1).ToOperand());
+  BytecodeNode second(Bytecode::kAdd, Register(2).ToOperand());
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  CHECK_EQ(write_count(), 0);
+  Flush();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kLdarAdd);
+  CHECK_EQ(last_written().operand(0),
+           static_cast<uint32_t>(Register(1).ToOperand()));
+  CHECK_EQ(last_written().operand(1),
+           static_cast<uint32_t>(Register(2).ToOperand()));
+}
+
+TEST_F(BytecodeSuperinstructionTest, FuseKeepsSourcePosition) {
+  BytecodeNode first(Bytecode::kLdar, Register(1).ToOperand());
+  BytecodeNode second(Bytecode::kSub, Register(2).ToOperand());
+  second.source_info().MakeExpressionPosition(3);
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  Flush();
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kLdarSub);
+  CHECK_EQ(last_written().source_info(), second.source_info());
+}
+
+TEST_F(BytecodeSuperinstructionTest, NoFuseWithTwoSourcePositions) {
+  BytecodeNode first(Bytecode::kLdar, Register(1).ToOperand());
+  first.source_info().MakeStatementPosition(0);
+  BytecodeNode second(Bytecode::kAdd, Register(2).ToOperand());
+  second.source_info().MakeExpressionPosition(3);
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(last_written(), first);
+  Flush();
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(last_written(), second);
+}
+
+TEST_F(BytecodeSuperinstructionTest, FusedTestLessThanRemovesToBoolean) {
+  BytecodeNode first(Bytecode::kLdar, Register(1).ToOperand());
+  BytecodeNode second(Bytecode::kTestLessThan, Register(2).ToOperand());
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  CHECK_EQ(write_count(), 0);
+
+  BytecodeLabel target;
+  BytecodeNode jump(Bytecode::kJumpIfToBooleanFalse, 0);
+  optimizer()->WriteJump(&jump, &target);
+  CHECK_EQ(write_count(), 2);
+  CHECK_EQ(last_written().bytecode(), Bytecode::kJumpIfFalse);
+}
+
+TEST_F(BytecodePeepholeOptimizerTest, NoFuseWithoutFlag) {
+  BytecodeNode first(Bytecode::kLdar, Register(1).ToOperand());
+  BytecodeNode second(Bytecode::kAdd, Register(2).ToOperand());
+  optimizer()->Write(&first);
+  optimizer()->Write(&second);
+  CHECK_EQ(write_count(), 1);
+  CHECK_EQ(last_written(), first);
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
@@ -173,6 +173,18 @@ TEST(Bytecodes, DebugBreakExistForEachBytecode) {
 #undef CHECK_DEBUG_BREAK_SIZE
 }
 
+TEST(Bytecodes, StarLookaheadOnlyAfterAccumulatorWrites) {
+#define CHECK_STAR_LOOKAHEAD(Name, ...)                                       \
+  if (Bytecodes::IsStarLookahead(Bytecode::k##Name, OperandScale::kSingle)) { \
+    CHECK(Bytecodes::WritesAccumulator(Bytecode::k##Name));                   \
+    CHECK(!Bytecodes::IsJump(Bytecode::k##Name));                             \
+  }                                                                           \
+  CHECK(!Bytecodes::IsStarLookahead(Bytecode::k##Name, OperandScale::kDouble));
+  BYTECODE_LIST(CHECK_STAR_LOOKAHEAD)
+#undef CHECK_STAR_LOOKAHEAD
+  CHECK(!Bytecodes::IsStarLookahead(Bytecode::kStar, OperandScale::kSingle));
+}
+
 TEST(Bytecodes, DecodeBytecodeAndOperands) {
   struct BytecodesAndResult {
     const uint8_t bytecode[32];
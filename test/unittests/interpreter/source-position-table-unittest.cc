@@ -5,6 +5,7 @@
 #include "src/v8.h"
 
 #include "src/interpreter/source-position-table.h"
+#include "src/objects-inl.h"
 #include "test/unittests/test-utils.h"
 
 namespace v8 {
@@ -82,6 +83,70 @@ TEST_F(SourcePositionTableTest, EncodeAscending) {
   CHECK(!builder.ToSourcePositionTable().is_null());
 }
 
+// Returns the size of the zig-zag variable-length encoding of {value} with 7
+// bits of payload per byte.
+static int LongEncodedSize(int value) {
+  static const int kShift = kIntSize * kBitsPerByte - 1;
+  unsigned int encoded = static_cast<unsigned int>((value << 1) ^
+                                                   (value >> kShift));
+  int size = 1;
+  while (encoded > 0x7f) {
+    encoded >>= 7;
+    size++;
+  }
+  return size;
+}
+
+TEST_F(SourcePositionTableTest, EncodeShortExpressions) {
+  SourcePositionTableBuilder builder(isolate(), zone());
+
+  // Expression positions close to their predecessor use the one byte form.
+  // Cover the bytecode and source deltas at the boundaries of that form and
+  // interleave statements, which always use the long form.
+  static const struct {
+    int bytecode_delta;
+    int source_delta;
+    bool is_statement;
+  } deltas[] = {{0, 100, true}, {0, 0, false},  {7, 7, false},
+                {8, 7, false},  {7, 8, false},  {1, -8, false},
+                {1, -9, false}, {0, 0, true},   {7, -8, false},
+                {8, -9, false}, {3, 1, true},   {1, -1, false},
+                {7, 0, false},  {8, 0, false},  {0, 7, false},
+                {0, 8, false},  {0, -8, false}, {0, -9, false},
+                {2, 3, false}};
+
+  PositionTableEntry expected[arraysize(deltas)];
+  // The size of the table if every entry used the long form, that is the
+  // bytecode delta with the statement bit and the source delta, both in the
+  // variable-length encoding.
+  int long_size = 0;
+  int code_offset = 0;
+  int source_position = 0;
+  for (size_t i = 0; i < arraysize(deltas); i++) {
+    code_offset += deltas[i].bytecode_delta;
+    source_position += deltas[i].source_delta;
+    builder.AddPosition(code_offset, source_position, deltas[i].is_statement);
+    expected[i] = PositionTableEntry(code_offset, source_position,
+                                     deltas[i].is_statement);
+    long_size += LongEncodedSize(deltas[i].is_statement
+                                     ? deltas[i].bytecode_delta
+                                     : -deltas[i].bytecode_delta - 1);
+    long_size += LongEncodedSize(deltas[i].source_delta);
+  }
+
+  Handle<ByteArray> table = builder.ToSourcePositionTable();
+  size_t i = 0;
+  for (SourcePositionTableIterator iterator(*table); !iterator.done();
+       iterator.Advance(), i++) {
+    CHECK_LT(i, arraysize(expected));
+    CHECK_EQ(expected[i].bytecode_offset, iterator.bytecode_offset());
+    CHECK_EQ(expected[i].source_position, iterator.source_position());
+    CHECK_EQ(expected[i].is_statement, iterator.is_statement());
+  }
+  CHECK_EQ(arraysize(expected), i);
+  CHECK_LT(table->length(), long_size);
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,67 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/optimizing-compile-dispatcher.h"
+
+#include "src/base/atomicops.h"
+#include "src/isolate.h"
+#include "test/unittests/test-utils.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+class CountingSubJob final : public CompilationSubJob {
+ public:
+  explicit CountingSubJob(base::Atomic32* counter) : counter_(counter) {}
+
+  void Run() final {
+    base::NoBarrier_AtomicIncrement(counter_, 1);
+    ++runs_;
+  }
+
+  int runs() const { return runs_; }
+
+ private:
+  base::Atomic32* counter_;
+  int runs_ = 0;
+};
+
+}  // namespace
+
+typedef TestWithIsolate OptimizingCompileDispatcherTest;
+
+TEST_F(OptimizingCompileDispatcherTest, RunSingleSubJob) {
+  OptimizingCompileDispatcher dispatcher(isolate());
+  base::Atomic32 counter = 0;
+  CountingSubJob job(&counter);
+  CompilationSubJob* sub_jobs[] = {&job};
+  dispatcher.RunSubJobs(sub_jobs, arraysize(sub_jobs));
+  EXPECT_EQ(1, job.runs());
+  EXPECT_EQ(1, base::Acquire_Load(&counter));
+}
+
+TEST_F(OptimizingCompileDispatcherTest, RunSubJobsOnce) {
+  OptimizingCompileDispatcher dispatcher(isolate());
+  for (int round = 0; round < 100; round++) {
+    base::Atomic32 counter = 0;
+    CountingSubJob job0(&counter);
+    CountingSubJob job1(&counter);
+    CountingSubJob job2(&counter);
+    CountingSubJob job3(&counter);
+    CompilationSubJob* sub_jobs[] = {&job0, &job1, &job2, &job3};
+    dispatcher.RunSubJobs(sub_jobs, arraysize(sub_jobs));
+    // All sub-jobs are done when RunSubJobs returns.
+    EXPECT_EQ(4, base::Acquire_Load(&counter));
+    EXPECT_EQ(1, job0.runs());
+    EXPECT_EQ(1, job1.runs());
+    EXPECT_EQ(1, job2.runs());
+    EXPECT_EQ(1, job3.runs());
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
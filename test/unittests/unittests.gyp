@@ -73,7 +73,10 @@
         'compiler/liveness-analyzer-unittest.cc',
         'compiler/live-range-unittest.cc',
         'compiler/load-elimination-unittest.cc',
+        'compiler/loop-invariant-code-motion-unittest.cc',
         'compiler/loop-peeling-unittest.cc',
+        'compiler/loop-variable-optimizer-unittest.cc',
+        'compiler/loop-vectorizer-unittest.cc',
         'compiler/machine-operator-reducer-unittest.cc',
         'compiler/machine-operator-unittest.cc',
         'compiler/move-optimizer-unittest.cc',
@@ -120,6 +123,7 @@
         'heap/scavenge-job-unittest.cc',
         'heap/slot-set-unittest.cc',
         'locked-queue-unittest.cc',
+        'optimizing-compile-dispatcher-unittest.cc',
         'register-configuration-unittest.cc',
         'run-all-unittests.cc',
         'test-utils.h',